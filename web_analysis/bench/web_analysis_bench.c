@@ -0,0 +1,413 @@
+// End-to-end scaling benchmark: generates synthetic corpora of increasing
+// size and times analyze_project_type_ex over each with pools of different
+// sizes. Results go to stdout as JSON (or CSV); progress goes to stderr.
+//
+//   web_analysis_bench --sizes 1000,10000 --threads 1,2,4,8 --layout yarn
+
+#include "web_corpus.h"
+#include "web_resource_analyzer.h"
+#include "web_thread_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+#define BENCH_MAX_LIST 16
+#define BENCH_PATH_SIZE 1024
+
+typedef struct {
+    CorpusSpec spec;
+    const char* corpus_dir;
+    int sizes[BENCH_MAX_LIST];
+    int size_count;
+    int threads[BENCH_MAX_LIST];
+    int thread_count;
+    int repeat;
+    int csv;
+} BenchConfig;
+
+typedef struct {
+    int corpus_files;
+    int threads;
+    long long files;         // Files the analysis merged
+    long long bytes;         // Content bytes it analyzed
+    double best_seconds;
+    double mean_seconds;
+    long long peak_rss_kb;
+    double speedup;          // Against the first thread count for this size
+    double efficiency;       // speedup per added thread, 1.0 is linear
+} BenchResult;
+
+typedef struct {
+    long long files;
+    long long bytes;
+} FileTally;
+
+static double now_seconds(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER counter;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)freq.QuadPart;
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec / 1.0e9;
+#endif
+}
+
+// Linux can reset the high-water mark between runs, so each run reports its
+// own peak. Elsewhere the value is the process peak so far.
+static int peak_rss_is_per_run(void) {
+#ifdef __linux__
+    static int supported = -1;
+    if (supported < 0) {
+        FILE* f = fopen("/proc/self/clear_refs", "w");
+        supported = f && fputs("5", f) >= 0;
+        if (f && fclose(f) != 0) supported = 0;
+    }
+    return supported;
+#else
+    return 0;
+#endif
+}
+
+static void reset_peak_rss(void) {
+#ifdef __linux__
+    if (!peak_rss_is_per_run()) return;
+    FILE* f = fopen("/proc/self/clear_refs", "w");
+    if (f) {
+        fputs("5", f);
+        fclose(f);
+    }
+#endif
+}
+
+static long long peak_rss_kb(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS counters;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+        return (long long)(counters.PeakWorkingSetSize / 1024);
+    }
+    return 0;
+#else
+#ifdef __linux__
+    if (peak_rss_is_per_run()) {
+        FILE* f = fopen("/proc/self/status", "r");
+        char line[256];
+        long long value = -1;
+        while (f && fgets(line, sizeof(line), f)) {
+            if (sscanf(line, "VmHWM: %lld", &value) == 1) break;
+        }
+        if (f) fclose(f);
+        if (value >= 0) return value;
+    }
+#endif
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return (long long)usage.ru_maxrss / 1024;    // Bytes on macOS
+#else
+    return (long long)usage.ru_maxrss;
+#endif
+#endif
+}
+
+static void count_file(const char* path, ParsedKind kind, size_t bytes, void* user_data) {
+    FileTally* tally = (FileTally*)user_data;
+    tally->files++;
+    tally->bytes += (long long)bytes;
+}
+
+// Replaces the traversal's stdout progress; snapshots are not needed here
+static void ignore_progress(const AnalysisProgress* progress, void* user_data) {
+}
+
+static int parse_list(const char* text, int* out, int max) {
+    int count = 0;
+    while (*text && count < max) {
+        char* end;
+        long value = strtol(text, &end, 10);
+        if (end == text || value <= 0) return -1;
+        out[count++] = (int)value;
+        text = *end == ',' ? end + 1 : end;
+        if (end == text && *text) return -1;
+    }
+    return count;
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --corpus DIR        Where corpora are generated (default web_analysis_bench_corpus)\n"
+            "  --sizes N,N,...     Corpus file counts (default 1000,5000,20000)\n"
+            "  --threads N,N,...   Worker counts (default 1,2,4 and the processor count)\n"
+            "  --framework NAME    react, vue or angular (default react)\n"
+            "  --layout NAME       single, yarn, lerna, nx, rush or pnpm (default single)\n"
+            "  --packages N        Workspace packages for monorepo layouts (default 8)\n"
+            "  --depth N           Directory levels under each src (default 3)\n"
+            "  --fan-out N         Subdirectories per level (default 4)\n"
+            "  --min-bytes N       Smallest generated file (default 512)\n"
+            "  --max-bytes N       Largest generated file (default 8192)\n"
+            "  --seed N            Generator seed (default 1)\n"
+            "  --repeat N          Timed runs per configuration (default 3)\n"
+            "  --csv               CSV instead of JSON\n",
+            program);
+}
+
+static int parse_args(int argc, char* argv[], BenchConfig* config) {
+    memset(config, 0, sizeof(*config));
+    corpus_spec_init(&config->spec);
+    config->corpus_dir = "web_analysis_bench_corpus";
+    config->repeat = 3;
+    config->size_count = parse_list("1000,5000,20000", config->sizes, BENCH_MAX_LIST);
+
+    int cpus = thread_pool_default_worker_count();
+    int defaults[] = { 1, 2, 4 };
+    for (int i = 0; i < 3 && defaults[i] < cpus; i++) config->threads[config->thread_count++] = defaults[i];
+    config->threads[config->thread_count++] = cpus;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--csv") == 0) {
+            config->csv = 1;
+            continue;
+        }
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) return -1;
+        if (!value) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return -1;
+        }
+        i++;
+
+        if (strcmp(arg, "--corpus") == 0) {
+            config->corpus_dir = value;
+        } else if (strcmp(arg, "--sizes") == 0) {
+            config->size_count = parse_list(value, config->sizes, BENCH_MAX_LIST);
+        } else if (strcmp(arg, "--threads") == 0) {
+            config->thread_count = parse_list(value, config->threads, BENCH_MAX_LIST);
+        } else if (strcmp(arg, "--framework") == 0) {
+            int framework = corpus_framework_from_name(value);
+            if (framework < 0) {
+                fprintf(stderr, "Unknown framework: %s\n", value);
+                return -1;
+            }
+            config->spec.framework = (CorpusFramework)framework;
+        } else if (strcmp(arg, "--layout") == 0) {
+            int layout = corpus_layout_from_name(value);
+            if (layout < 0) {
+                fprintf(stderr, "Unknown layout: %s\n", value);
+                return -1;
+            }
+            config->spec.layout = (CorpusLayout)layout;
+        } else if (strcmp(arg, "--packages") == 0) {
+            config->spec.package_count = atoi(value);
+        } else if (strcmp(arg, "--depth") == 0) {
+            config->spec.depth = atoi(value);
+        } else if (strcmp(arg, "--fan-out") == 0) {
+            config->spec.fan_out = atoi(value);
+        } else if (strcmp(arg, "--min-bytes") == 0) {
+            config->spec.min_file_bytes = (size_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--max-bytes") == 0) {
+            config->spec.max_file_bytes = (size_t)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--seed") == 0) {
+            config->spec.seed = (unsigned int)strtoul(value, NULL, 10);
+        } else if (strcmp(arg, "--repeat") == 0) {
+            config->repeat = atoi(value);
+        } else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return -1;
+        }
+    }
+
+    if (config->size_count <= 0 || config->thread_count <= 0 || config->repeat <= 0 ||
+        config->spec.depth < 0 || config->spec.max_file_bytes < config->spec.min_file_bytes) {
+        fprintf(stderr, "Invalid benchmark configuration\n");
+        return -1;
+    }
+    return 0;
+}
+
+// A corpus is regenerated unless its directory holds a stamp for the same spec
+static int prepare_corpus(const BenchConfig* config, int files, char* root, size_t root_size) {
+    CorpusSpec spec = config->spec;
+    spec.file_count = files;
+    int length = snprintf(root, root_size, "%s/%s-%s-%d", config->corpus_dir,
+                          corpus_framework_name(spec.framework), corpus_layout_name(spec.layout), files);
+
+    char stamp_path[BENCH_PATH_SIZE];
+    char expected[256];
+    char found[256] = "";
+    if (length < 0 || (size_t)length >= root_size ||
+        snprintf(stamp_path, sizeof(stamp_path), "%s/.corpus_spec", root) >= (int)sizeof(stamp_path)) {
+        fprintf(stderr, "Corpus directory path too long: %s\n", config->corpus_dir);
+        return -1;
+    }
+    snprintf(expected, sizeof(expected), "files=%d packages=%d depth=%d fan_out=%d bytes=%zu-%zu seed=%u\n",
+             spec.file_count, spec.package_count, spec.depth, spec.fan_out,
+             spec.min_file_bytes, spec.max_file_bytes, spec.seed);
+
+    FILE* f = fopen(stamp_path, "r");
+    if (f) {
+        if (!fgets(found, sizeof(found), f)) found[0] = '\0';
+        fclose(f);
+    }
+    if (strcmp(found, expected) == 0) return 0;
+
+    CorpusStats stats;
+    double start = now_seconds();
+    if (corpus_generate(root, &spec, &stats) != 0) return -1;
+    fprintf(stderr, "Generated %s: %d files, %d directories, %.1f MB in %.2f s\n",
+            root, stats.files, stats.directories, stats.bytes / (1024.0 * 1024.0), now_seconds() - start);
+
+    f = fopen(stamp_path, "w");
+    if (f) {
+        fputs(expected, f);
+        fclose(f);
+    }
+    return 0;
+}
+
+static int run_once(const char* root, ThreadPool* pool, FileTally* tally, double* seconds) {
+    AnalysisOptions options;
+    memset(&options, 0, sizeof(options));
+    options.pool = pool;
+    options.on_progress = ignore_progress;
+    options.on_file = count_file;
+    options.callback_data = tally;
+    options.progress_interval = 3600.0;
+
+    memset(tally, 0, sizeof(*tally));
+    double start = now_seconds();
+    ProjectType* project = analyze_project_type_ex(root, &options);
+    *seconds = now_seconds() - start;
+    if (!project) return -1;
+    free_project_type(project);
+    return 0;
+}
+
+static int run_configuration(const char* root, int threads, int repeat, BenchResult* result) {
+    ThreadPool* pool = thread_pool_create(threads);
+    if (!pool) return -1;
+
+    FileTally tally;
+    double seconds;
+
+    // Untimed pass to fault in the pool's threads and warm the page cache
+    int failed = run_once(root, pool, &tally, &seconds);
+
+    result->threads = threads;
+    result->best_seconds = 0.0;
+    result->mean_seconds = 0.0;
+    reset_peak_rss();
+    for (int i = 0; i < repeat && !failed; i++) {
+        failed = run_once(root, pool, &tally, &seconds);
+        if (i == 0 || seconds < result->best_seconds) result->best_seconds = seconds;
+        result->mean_seconds += seconds / repeat;
+    }
+    result->peak_rss_kb = peak_rss_kb();
+    result->files = tally.files;
+    result->bytes = tally.bytes;
+
+    thread_pool_destroy(pool);
+    return failed ? -1 : 0;
+}
+
+static void print_json(const BenchConfig* config, const BenchResult* results, int count) {
+    printf("{\n  \"benchmark\": \"analyze_project_type\",\n");
+    printf("  \"framework\": \"%s\",\n  \"layout\": \"%s\",\n",
+           corpus_framework_name(config->spec.framework), corpus_layout_name(config->spec.layout));
+    printf("  \"packages\": %d,\n  \"depth\": %d,\n  \"fan_out\": %d,\n",
+           config->spec.layout == CORPUS_LAYOUT_SINGLE ? 1 : config->spec.package_count,
+           config->spec.depth, config->spec.fan_out);
+    printf("  \"min_file_bytes\": %zu,\n  \"max_file_bytes\": %zu,\n  \"seed\": %u,\n",
+           config->spec.min_file_bytes, config->spec.max_file_bytes, config->spec.seed);
+    printf("  \"repeat\": %d,\n  \"peak_rss_scope\": \"%s\",\n  \"results\": [\n",
+           config->repeat, peak_rss_is_per_run() ? "run" : "process");
+
+    for (int i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        printf("    {\"corpus_files\": %d, \"threads\": %d, \"files\": %lld, \"bytes\": %lld, "
+               "\"best_seconds\": %.6f, \"mean_seconds\": %.6f, \"files_per_second\": %.1f, "
+               "\"mb_per_second\": %.2f, \"peak_rss_kb\": %lld, \"speedup\": %.3f, \"efficiency\": %.3f}%s\n",
+               r->corpus_files, r->threads, r->files, r->bytes, r->best_seconds, r->mean_seconds,
+               r->best_seconds > 0 ? r->files / r->best_seconds : 0.0,
+               r->best_seconds > 0 ? r->bytes / (1024.0 * 1024.0) / r->best_seconds : 0.0,
+               r->peak_rss_kb, r->speedup, r->efficiency, i + 1 < count ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
+
+static void print_csv(const BenchResult* results, int count) {
+    printf("corpus_files,threads,files,bytes,best_seconds,mean_seconds,files_per_second,"
+           "mb_per_second,peak_rss_kb,speedup,efficiency\n");
+    for (int i = 0; i < count; i++) {
+        const BenchResult* r = &results[i];
+        printf("%d,%d,%lld,%lld,%.6f,%.6f,%.1f,%.2f,%lld,%.3f,%.3f\n",
+               r->corpus_files, r->threads, r->files, r->bytes, r->best_seconds, r->mean_seconds,
+               r->best_seconds > 0 ? r->files / r->best_seconds : 0.0,
+               r->best_seconds > 0 ? r->bytes / (1024.0 * 1024.0) / r->best_seconds : 0.0,
+               r->peak_rss_kb, r->speedup, r->efficiency);
+    }
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    if (parse_args(argc, argv, &config) != 0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    BenchResult* results = calloc((size_t)config.size_count * config.thread_count, sizeof(BenchResult));
+    if (!results) {
+        fprintf(stderr, "Memory allocation failed for benchmark results\n");
+        return 1;
+    }
+
+    int count = 0;
+    int status = 0;
+    for (int s = 0; s < config.size_count && status == 0; s++) {
+        char root[BENCH_PATH_SIZE];
+        if (prepare_corpus(&config, config.sizes[s], root, sizeof(root)) != 0) {
+            fprintf(stderr, "Failed to generate corpus of %d files\n", config.sizes[s]);
+            status = 1;
+            break;
+        }
+
+        const BenchResult* baseline = NULL;
+        for (int t = 0; t < config.thread_count; t++) {
+            BenchResult* result = &results[count];
+            result->corpus_files = config.sizes[s];
+            if (run_configuration(root, config.threads[t], config.repeat, result) != 0) {
+                fprintf(stderr, "Analysis failed for %s with %d threads\n", root, config.threads[t]);
+                status = 1;
+                break;
+            }
+            if (!baseline) baseline = result;
+            result->speedup = result->best_seconds > 0 ? baseline->best_seconds / result->best_seconds : 0.0;
+            result->efficiency = result->speedup * baseline->threads / result->threads;
+            count++;
+
+            fprintf(stderr, "%6d files, %3d threads: %8.3f s, %10.1f files/s, %5.2fx\n",
+                    result->corpus_files, result->threads, result->best_seconds,
+                    result->best_seconds > 0 ? result->files / result->best_seconds : 0.0,
+                    result->speedup);
+        }
+    }
+
+    if (config.csv) print_csv(results, count);
+    else print_json(&config, results, count);
+
+    free(results);
+    return status;
+}
@@ -0,0 +1,624 @@
+#include "web_corpus.h"
+#include <errno.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <direct.h>
+#define make_dir(path) _mkdir(path)
+#else
+#include <sys/stat.h>
+#define make_dir(path) mkdir(path, 0755)
+#endif
+
+#define CORPUS_PATH_SIZE 1024
+
+static const char* framework_names[CORPUS_FRAMEWORK_COUNT] = { "react", "vue", "angular" };
+static const char* layout_names[CORPUS_LAYOUT_COUNT] = { "single", "yarn", "lerna", "nx", "rush", "pnpm" };
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} TextBuffer;
+
+typedef struct {
+    const CorpusSpec* spec;
+    unsigned int rng;
+    TextBuffer text;
+    CorpusStats* stats;
+} Corpus;
+
+// A file kind is written as header, then blocks until the target size, then
+// footer. Each part gets the file number n and, for blocks, the block number k.
+typedef void (*PartWriter)(TextBuffer* text, int n, int k);
+
+typedef struct {
+    const char* suffix;
+    int weight;
+    PartWriter header;
+    PartWriter block;
+    PartWriter footer;
+} FileKind;
+
+void corpus_spec_init(CorpusSpec* spec) {
+    memset(spec, 0, sizeof(*spec));
+    spec->framework = CORPUS_REACT;
+    spec->layout = CORPUS_LAYOUT_SINGLE;
+    spec->file_count = 1000;
+    spec->package_count = 8;
+    spec->depth = 3;
+    spec->fan_out = 4;
+    spec->min_file_bytes = 512;
+    spec->max_file_bytes = 8192;
+    spec->seed = 1;
+}
+
+const char* corpus_framework_name(CorpusFramework framework) {
+    return (framework >= 0 && framework < CORPUS_FRAMEWORK_COUNT) ? framework_names[framework] : "unknown";
+}
+
+const char* corpus_layout_name(CorpusLayout layout) {
+    return (layout >= 0 && layout < CORPUS_LAYOUT_COUNT) ? layout_names[layout] : "unknown";
+}
+
+int corpus_framework_from_name(const char* name) {
+    for (int i = 0; i < CORPUS_FRAMEWORK_COUNT; i++) {
+        if (strcmp(name, framework_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+int corpus_layout_from_name(const char* name) {
+    for (int i = 0; i < CORPUS_LAYOUT_COUNT; i++) {
+        if (strcmp(name, layout_names[i]) == 0) return i;
+    }
+    return -1;
+}
+
+// xorshift32; the stream depends only on the seed
+static unsigned int next_random(Corpus* corpus) {
+    unsigned int x = corpus->rng;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    corpus->rng = x;
+    return x;
+}
+
+static unsigned int random_below(Corpus* corpus, unsigned int bound) {
+    return bound ? next_random(corpus) % bound : 0;
+}
+
+static void text_append(TextBuffer* text, const char* fmt, ...) {
+    for (;;) {
+        va_list args;
+        va_start(args, fmt);
+        size_t remaining = text->capacity - text->length;
+        int n = vsnprintf(text->data + text->length, remaining, fmt, args);
+        va_end(args);
+        if (n < 0) return;
+        if ((size_t)n < remaining) {
+            text->length += (size_t)n;
+            return;
+        }
+
+        size_t capacity = text->capacity * 2;
+        while (capacity - text->length <= (size_t)n) capacity *= 2;
+        char* data = realloc(text->data, capacity);
+        if (!data) return;
+        text->data = data;
+        text->capacity = capacity;
+    }
+}
+
+// --- React ---
+
+static void jsx_header(TextBuffer* t, int n, int k) {
+    text_append(t, "import React, { useState, useEffect } from 'react';\n"
+                   "import PropTypes from 'prop-types';\n"
+                   "import './Component%d.css';\n\n", n);
+}
+
+static void jsx_block(TextBuffer* t, int n, int k) {
+    text_append(t, "export function Widget%d_%d({ items, onSelect }) {\n"
+                   "    const [count, setCount] = useState(%d);\n"
+                   "    useEffect(() => {\n"
+                   "        document.title = `Widget %d: ${count}`;\n"
+                   "    }, [count]);\n"
+                   "    return (\n"
+                   "        <div className=\"widget-%d\">\n"
+                   "            <h2>{items.length} items</h2>\n"
+                   "            <img src=\"/assets/widget-%d.png\" alt=\"\" />\n"
+                   "            <button onClick={() => setCount(count + 1)}>Add</button>\n"
+                   "            <ul>{items.map(item => <li key={item.id} onClick={() => onSelect(item)}>{item.name}</li>)}</ul>\n"
+                   "        </div>\n"
+                   "    );\n"
+                   "}\n"
+                   "Widget%d_%d.propTypes = { items: PropTypes.array, onSelect: PropTypes.func };\n\n",
+                n, k, k, k, k, k, n, k);
+}
+
+static void jsx_footer(TextBuffer* t, int n, int k) {
+    text_append(t, "export default Widget%d_0;\n", n);
+}
+
+// --- Shared script, style and markup kinds ---
+
+static void js_header(TextBuffer* t, int n, int k) {
+    text_append(t, "import axios from 'axios';\n"
+                   "import { debounce } from 'lodash';\n\n"
+                   "const BASE_URL = '/api/v%d';\n\n", n % 3 + 1);
+}
+
+static void js_block(TextBuffer* t, int n, int k) {
+    text_append(t, "export async function fetchItems%d_%d(id, options = {}) {\n"
+                   "    const response = await axios.get(`${BASE_URL}/items/${id}`, { params: options });\n"
+                   "    if (response.status !== 200) {\n"
+                   "        throw new Error('Request failed: ' + response.status);\n"
+                   "    }\n"
+                   "    return response.data.filter(item => item.active).map(item => ({ ...item, index: %d }));\n"
+                   "}\n"
+                   "export const search%d_%d = debounce(query => fetchItems%d_%d(query), %d);\n\n",
+                n, k, k, n, k, n, k, 100 + k % 400);
+}
+
+static void js_footer(TextBuffer* t, int n, int k) {
+    text_append(t, "export default { fetchItems%d_0 };\n", n);
+}
+
+static void ts_header(TextBuffer* t, int n, int k) {
+    text_append(t, "import { Observable, of } from 'rxjs';\n\n");
+}
+
+static void ts_block(TextBuffer* t, int n, int k) {
+    text_append(t, "export interface Model%d_%d {\n"
+                   "    id: number;\n"
+                   "    name: string;\n"
+                   "    tags?: string[];\n"
+                   "}\n\n"
+                   "export function mapModels%d_%d(input: Model%d_%d[]): Observable<string[]> {\n"
+                   "    return of(input.filter(m => m.id > %d).map(m => m.name.toUpperCase()));\n"
+                   "}\n\n",
+                n, k, n, k, n, k, k);
+}
+
+static void ts_footer(TextBuffer* t, int n, int k) {
+}
+
+static void css_header(TextBuffer* t, int n, int k) {
+    text_append(t, ":root {\n    --primary-%d: #%06x;\n}\n\n", n, (unsigned)(n * 2654435761u) & 0xffffff);
+}
+
+static void css_block(TextBuffer* t, int n, int k) {
+    text_append(t, ".widget-%d-%d {\n"
+                   "    display: flex;\n"
+                   "    padding: %dpx;\n"
+                   "    color: var(--primary-%d);\n"
+                   "    background: url('/assets/bg-%d.jpg') no-repeat;\n"
+                   "}\n"
+                   "@media (max-width: %dpx) {\n"
+                   "    .widget-%d-%d { flex-direction: column; }\n"
+                   "}\n\n",
+                n, k, 4 + k % 16, n, k % 8, 480 + (k % 4) * 160, n, k);
+}
+
+static void html_header(TextBuffer* t, int n, int k) {
+    text_append(t, "<!DOCTYPE html>\n<html lang=\"en\">\n<head>\n"
+                   "    <meta charset=\"utf-8\">\n"
+                   "    <title>Page %d</title>\n"
+                   "    <link rel=\"stylesheet\" href=\"https://cdn.example.com/lib-%d.css\">\n"
+                   "    <script src=\"https://cdn.example.com/lib-%d.js\"></script>\n"
+                   "</head>\n<body>\n    <div id=\"root\"></div>\n", n, n % 5, n % 5);
+}
+
+static void html_block(TextBuffer* t, int n, int k) {
+    text_append(t, "    <section class=\"section-%d\">\n"
+                   "        <h2>Section %d</h2>\n"
+                   "        <img src=\"images/photo-%d.png\" alt=\"Photo %d\">\n"
+                   "        <form action=\"/submit\"><input type=\"text\" name=\"q%d\"><button>Go</button></form>\n"
+                   "    </section>\n",
+                k, k, k, k, k);
+}
+
+static void html_footer(TextBuffer* t, int n, int k) {
+    text_append(t, "    <script src=\"main.js\"></script>\n</body>\n</html>\n");
+}
+
+// --- Vue ---
+
+static void vue_header(TextBuffer* t, int n, int k) {
+    text_append(t, "<template>\n  <div class=\"component-%d\">\n", n);
+}
+
+static void vue_block(TextBuffer* t, int n, int k) {
+    text_append(t, "    <div v-for=\"item in items%d\" :key=\"item.id\" class=\"row-%d\">\n"
+                   "      <span>{{ item.name }}</span>\n"
+                   "      <img :src=\"'/assets/icon-' + item.id + '.svg'\" />\n"
+                   "      <button @click=\"select(item)\">Select</button>\n"
+                   "    </div>\n",
+                k, k);
+}
+
+static void vue_footer(TextBuffer* t, int n, int k) {
+    text_append(t, "  </div>\n</template>\n\n"
+                   "<script>\n"
+                   "import { ref, computed } from 'vue';\n"
+                   "import axios from 'axios';\n\n"
+                   "export default {\n"
+                   "  name: 'Component%d',\n"
+                   "  props: { limit: { type: Number, default: %d } },\n"
+                   "  setup(props, { emit }) {\n"
+                   "    const selected = ref(null);\n"
+                   "    const label = computed(() => selected.value ? selected.value.name : 'none');\n"
+                   "    const select = item => { selected.value = item; emit('select', item); };\n"
+                   "    return { selected, label, select };\n"
+                   "  }\n"
+                   "};\n"
+                   "</script>\n\n"
+                   "<style scoped>\n.component-%d { display: grid; gap: 8px; }\n</style>\n",
+                n, k, n);
+}
+
+// --- Angular ---
+
+static void ng_component_header(TextBuffer* t, int n, int k) {
+    text_append(t, "import { Component, OnInit, Input, Output, EventEmitter } from '@angular/core';\n"
+                   "import { Item%dService } from './item%d.service';\n\n"
+                   "@Component({\n"
+                   "  selector: 'app-item-%d',\n"
+                   "  templateUrl: './item%d.component.html',\n"
+                   "  styleUrls: ['./item%d.component.css']\n"
+                   "})\n"
+                   "export class Item%dComponent implements OnInit {\n"
+                   "  @Input() items: any[] = [];\n"
+                   "  @Output() selected = new EventEmitter<any>();\n\n"
+                   "  constructor(private service: Item%dService) {}\n\n"
+                   "  ngOnInit(): void {\n"
+                   "    this.service.load().subscribe(items => this.items = items);\n"
+                   "  }\n\n",
+                n, n, n, n, n, n, n);
+}
+
+static void ng_component_block(TextBuffer* t, int n, int k) {
+    text_append(t, "  handle%d(item: any): void {\n"
+                   "    if (item && item.id > %d) {\n"
+                   "      this.selected.emit({ ...item, source: 'handle%d' });\n"
+                   "    }\n"
+                   "  }\n\n",
+                k, k, k);
+}
+
+static void ng_component_footer(TextBuffer* t, int n, int k) {
+    text_append(t, "}\n");
+}
+
+static void ng_service_header(TextBuffer* t, int n, int k) {
+    text_append(t, "import { Injectable } from '@angular/core';\n"
+                   "import { HttpClient } from '@angular/common/http';\n"
+                   "import { Observable } from 'rxjs';\n\n"
+                   "@Injectable({ providedIn: 'root' })\n"
+                   "export class Item%dService {\n"
+                   "  constructor(private http: HttpClient) {}\n\n"
+                   "  load(): Observable<any[]> {\n"
+                   "    return this.http.get<any[]>('/api/items/%d');\n"
+                   "  }\n\n",
+                n, n);
+}
+
+static void ng_service_block(TextBuffer* t, int n, int k) {
+    text_append(t, "  update%d(id: number, body: any): Observable<any> {\n"
+                   "    return this.http.put(`/api/items/%d/${id}`, body);\n"
+                   "  }\n\n",
+                k, k);
+}
+
+static void ng_template_header(TextBuffer* t, int n, int k) {
+    text_append(t, "<div class=\"item-list-%d\">\n", n);
+}
+
+static void ng_template_block(TextBuffer* t, int n, int k) {
+    text_append(t, "  <div *ngFor=\"let item of items\" class=\"row-%d\" [class.active]=\"item.active\">\n"
+                   "    <span>{{ item.name | titlecase }}</span>\n"
+                   "    <img [src]=\"'assets/item-' + item.id + '.png'\">\n"
+                   "    <button (click)=\"handle%d(item)\">Open</button>\n"
+                   "  </div>\n",
+                k, k);
+}
+
+static void ng_template_footer(TextBuffer* t, int n, int k) {
+    text_append(t, "</div>\n");
+}
+
+static const FileKind react_kinds[] = {
+    { "Component%d.jsx", 45, jsx_header, jsx_block, jsx_footer },
+    { "api%d.js", 25, js_header, js_block, js_footer },
+    { "model%d.ts", 10, ts_header, ts_block, ts_footer },
+    { "Component%d.css", 15, css_header, css_block, ts_footer },
+    { "page%d.html", 5, html_header, html_block, html_footer },
+};
+
+static const FileKind vue_kinds[] = {
+    { "Component%d.vue", 50, vue_header, vue_block, vue_footer },
+    { "api%d.js", 25, js_header, js_block, js_footer },
+    { "model%d.ts", 10, ts_header, ts_block, ts_footer },
+    { "theme%d.css", 10, css_header, css_block, ts_footer },
+    { "page%d.html", 5, html_header, html_block, html_footer },
+};
+
+static const FileKind angular_kinds[] = {
+    { "item%d.component.ts", 35, ng_component_header, ng_component_block, ng_component_footer },
+    { "item%d.service.ts", 20, ng_service_header, ng_service_block, ng_component_footer },
+    { "item%d.component.html", 25, ng_template_header, ng_template_block, ng_template_footer },
+    { "item%d.component.css", 15, css_header, css_block, ts_footer },
+    { "model%d.ts", 5, ts_header, ts_block, ts_footer },
+};
+
+static const FileKind* framework_kinds(CorpusFramework framework, int* count) {
+    switch (framework) {
+        case CORPUS_VUE:
+            *count = (int)(sizeof(vue_kinds) / sizeof(vue_kinds[0]));
+            return vue_kinds;
+        case CORPUS_ANGULAR:
+            *count = (int)(sizeof(angular_kinds) / sizeof(angular_kinds[0]));
+            return angular_kinds;
+        default:
+            *count = (int)(sizeof(react_kinds) / sizeof(react_kinds[0]));
+            return react_kinds;
+    }
+}
+
+static const FileKind* pick_kind(Corpus* corpus) {
+    int count;
+    const FileKind* kinds = framework_kinds(corpus->spec->framework, &count);
+    int total = 0;
+    for (int i = 0; i < count; i++) total += kinds[i].weight;
+
+    int roll = (int)random_below(corpus, (unsigned int)total);
+    for (int i = 0; i < count; i++) {
+        if (roll < kinds[i].weight) return &kinds[i];
+        roll -= kinds[i].weight;
+    }
+    return &kinds[0];
+}
+
+// Creates every missing directory along path
+static int make_dirs(Corpus* corpus, const char* path) {
+    char partial[CORPUS_PATH_SIZE];
+    size_t length = strlen(path);
+    if (length >= sizeof(partial)) return -1;
+    memcpy(partial, path, length + 1);
+
+    for (size_t i = 1; i <= length; i++) {
+        if (partial[i] != '/' && partial[i] != '\0') continue;
+        char saved = partial[i];
+        partial[i] = '\0';
+        if (make_dir(partial) == 0) {
+            if (corpus->stats) corpus->stats->directories++;
+        } else if (errno != EEXIST) {
+            fprintf(stderr, "Failed to create directory: %s\n", partial);
+            return -1;
+        }
+        partial[i] = saved;
+    }
+    return 0;
+}
+
+// Formats into a CORPUS_PATH_SIZE buffer. Returns -1 if the path does not fit.
+static int format_path(char* path, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    int length = vsnprintf(path, CORPUS_PATH_SIZE, fmt, args);
+    va_end(args);
+    if (length < 0 || length >= CORPUS_PATH_SIZE) {
+        fprintf(stderr, "Corpus path too long: %s...\n", path);
+        return -1;
+    }
+    return 0;
+}
+
+static int write_text(Corpus* corpus, const char* path) {
+    FILE* f = fopen(path, "wb");
+    if (!f) {
+        fprintf(stderr, "Failed to create file: %s\n", path);
+        return -1;
+    }
+    size_t written = fwrite(corpus->text.data, 1, corpus->text.length, f);
+    int failed = fclose(f) != 0 || written != corpus->text.length;
+    if (failed) {
+        fprintf(stderr, "Failed to write file: %s\n", path);
+        return -1;
+    }
+    if (corpus->stats) {
+        corpus->stats->files++;
+        corpus->stats->bytes += (long long)written;
+    }
+    return 0;
+}
+
+static void write_dependencies(Corpus* corpus) {
+    TextBuffer* t = &corpus->text;
+    switch (corpus->spec->framework) {
+        case CORPUS_VUE:
+            text_append(t, "    \"vue\": \"^3.3.4\",\n    \"vue-router\": \"^4.2.4\",\n    \"pinia\": \"^2.1.6\",\n");
+            break;
+        case CORPUS_ANGULAR:
+            text_append(t, "    \"@angular/core\": \"^16.2.0\",\n    \"@angular/common\": \"^16.2.0\",\n"
+                           "    \"@angular/router\": \"^16.2.0\",\n    \"rxjs\": \"~7.8.0\",\n");
+            break;
+        default:
+            text_append(t, "    \"react\": \"^18.2.0\",\n    \"react-dom\": \"^18.2.0\",\n    \"prop-types\": \"^15.8.1\",\n");
+            break;
+    }
+    text_append(t, "    \"axios\": \"^1.5.0\",\n    \"lodash\": \"^4.17.21\"");
+}
+
+static int write_package_manifest(Corpus* corpus, const char* dir, const char* name, int package_index) {
+    TextBuffer* t = &corpus->text;
+    t->length = 0;
+    text_append(t, "{\n  \"name\": \"%s\",\n  \"version\": \"1.0.0\",\n", name);
+    text_append(t, "  \"scripts\": {\n    \"build\": \"webpack --mode production\",\n    \"test\": \"jest\"\n  },\n");
+    text_append(t, "  \"dependencies\": {\n");
+    write_dependencies(corpus);
+
+    // Each package depends on its predecessor and maybe one earlier package,
+    // so the workspace graph is acyclic
+    const char* range = corpus->spec->layout == CORPUS_LAYOUT_PNPM ? "workspace:*" : "^1.0.0";
+    if (package_index > 0) {
+        text_append(t, ",\n    \"@corpus/pkg-%d\": \"%s\"", package_index - 1, range);
+    }
+    if (package_index > 1 && random_below(corpus, 2)) {
+        text_append(t, ",\n    \"@corpus/pkg-%u\": \"%s\"",
+                    random_below(corpus, (unsigned int)package_index - 1), range);
+    }
+
+    text_append(t, "\n  },\n  \"devDependencies\": {\n"
+                   "    \"typescript\": \"^5.2.2\",\n    \"webpack\": \"^5.88.2\",\n"
+                   "    \"jest\": \"^29.6.4\",\n    \"eslint\": \"^8.48.0\"\n  }\n}\n");
+
+    char path[CORPUS_PATH_SIZE];
+    if (format_path(path, "%s/package.json", dir) != 0) return -1;
+    return write_text(corpus, path);
+}
+
+// Writes count source files under dir/src, spread over the directory tree
+static int write_sources(Corpus* corpus, const char* dir, int count, int* file_number) {
+    const CorpusSpec* spec = corpus->spec;
+    size_t span = spec->max_file_bytes > spec->min_file_bytes ?
+                  spec->max_file_bytes - spec->min_file_bytes : 0;
+
+    for (int i = 0; i < count; i++) {
+        int n = (*file_number)++;
+        char path[CORPUS_PATH_SIZE];
+        int length = snprintf(path, sizeof(path), "%s/src", dir);
+
+        int levels = (int)random_below(corpus, (unsigned int)spec->depth + 1);
+        for (int level = 0; level < levels && length < (int)sizeof(path); level++) {
+            length += snprintf(path + length, sizeof(path) - length, "/%s%u",
+                               level == 0 ? "feature" : "part",
+                               random_below(corpus, (unsigned int)(spec->fan_out > 0 ? spec->fan_out : 1)));
+        }
+        if (length >= (int)sizeof(path) || make_dirs(corpus, path) != 0) return -1;
+
+        const FileKind* kind = pick_kind(corpus);
+        size_t target = spec->min_file_bytes + (span ? random_below(corpus, (unsigned int)span + 1) : 0);
+
+        TextBuffer* t = &corpus->text;
+        t->length = 0;
+        kind->header(t, n, 0);
+        int k = 0;
+        while (t->length < target) kind->block(t, n, k++);
+        kind->footer(t, n, k);
+
+        length += snprintf(path + length, sizeof(path) - length, "/");
+        if (length < (int)sizeof(path)) length += snprintf(path + length, sizeof(path) - length, kind->suffix, n);
+        if (length >= (int)sizeof(path)) {
+            fprintf(stderr, "Corpus path too long: %s...\n", path);
+            return -1;
+        }
+        if (write_text(corpus, path) != 0) return -1;
+    }
+    return 0;
+}
+
+static int write_root_config(Corpus* corpus, const char* root, const char* file) {
+    char path[CORPUS_PATH_SIZE];
+    if (format_path(path, "%s/%s", root, file) != 0) return -1;
+    return write_text(corpus, path);
+}
+
+static int write_workspace_root(Corpus* corpus, const char* root, int packages) {
+    const CorpusSpec* spec = corpus->spec;
+    TextBuffer* t = &corpus->text;
+
+    // Root manifest; yarn, lerna and nx list their workspaces here as well
+    t->length = 0;
+    text_append(t, "{\n  \"name\": \"corpus-%s-%s\",\n  \"private\": true,\n",
+                corpus_framework_name(spec->framework), corpus_layout_name(spec->layout));
+    if (spec->layout == CORPUS_LAYOUT_YARN || spec->layout == CORPUS_LAYOUT_LERNA ||
+        spec->layout == CORPUS_LAYOUT_NX) {
+        text_append(t, "  \"workspaces\": [\"packages/*\"],\n");
+    }
+    text_append(t, "  \"devDependencies\": {\n    \"typescript\": \"^5.2.2\"");
+    if (spec->layout == CORPUS_LAYOUT_LERNA) text_append(t, ",\n    \"lerna\": \"^7.2.0\"");
+    if (spec->layout == CORPUS_LAYOUT_NX) text_append(t, ",\n    \"nx\": \"^16.8.1\"");
+    text_append(t, "\n  }\n}\n");
+    if (write_root_config(corpus, root, "package.json") != 0) return -1;
+
+    t->length = 0;
+    switch (spec->layout) {
+        case CORPUS_LAYOUT_LERNA:
+            text_append(t, "{\n  \"version\": \"independent\",\n  \"npmClient\": \"yarn\",\n"
+                           "  \"useWorkspaces\": true,\n  \"packages\": [\"packages/*\"]\n}\n");
+            return write_root_config(corpus, root, "lerna.json");
+        case CORPUS_LAYOUT_NX:
+            text_append(t, "{\n  \"npmScope\": \"corpus\",\n  \"projects\": {\n");
+            for (int i = 0; i < packages; i++) {
+                text_append(t, "    \"pkg-%d\": { \"root\": \"packages/pkg-%d\" }%s\n",
+                            i, i, i + 1 < packages ? "," : "");
+            }
+            text_append(t, "  }\n}\n");
+            return write_root_config(corpus, root, "nx.json");
+        case CORPUS_LAYOUT_RUSH:
+            text_append(t, "{\n  \"rushVersion\": \"5.107.0\",\n  \"pnpmVersion\": \"8.7.0\",\n  \"projects\": [\n");
+            for (int i = 0; i < packages; i++) {
+                text_append(t, "    { \"packageName\": \"@corpus/pkg-%d\", \"projectFolder\": \"packages/pkg-%d\" }%s\n",
+                            i, i, i + 1 < packages ? "," : "");
+            }
+            text_append(t, "  ]\n}\n");
+            return write_root_config(corpus, root, "rush.json");
+        case CORPUS_LAYOUT_PNPM:
+            text_append(t, "packages:\n  - 'packages/*'\n");
+            return write_root_config(corpus, root, "pnpm-workspace.yaml");
+        default:
+            return 0;
+    }
+}
+
+int corpus_generate(const char* root, const CorpusSpec* spec, CorpusStats* stats) {
+    if (!root || !spec || spec->file_count < 0) return -1;
+
+    Corpus corpus = { spec, spec->seed ? spec->seed : 1, { NULL, 0, 0 }, stats };
+    if (stats) memset(stats, 0, sizeof(*stats));
+
+    corpus.text.capacity = 16384;
+    corpus.text.data = malloc(corpus.text.capacity);
+    if (!corpus.text.data) return -1;
+
+    int result = make_dirs(&corpus, root);
+    int file_number = 0;
+
+    if (result == 0 && spec->layout == CORPUS_LAYOUT_SINGLE) {
+        char name[128];
+        snprintf(name, sizeof(name), "corpus-%s", corpus_framework_name(spec->framework));
+        result = write_package_manifest(&corpus, root, name, 0);
+        if (result == 0) result = write_sources(&corpus, root, spec->file_count, &file_number);
+    } else if (result == 0) {
+        int packages = spec->package_count > 0 ? spec->package_count : 1;
+        result = write_workspace_root(&corpus, root, packages);
+
+        for (int i = 0; result == 0 && i < packages; i++) {
+            char dir[CORPUS_PATH_SIZE];
+            char name[64];
+            snprintf(name, sizeof(name), "@corpus/pkg-%d", i);
+
+            result = format_path(dir, "%s/packages/pkg-%d", root, i);
+            if (result == 0) result = make_dirs(&corpus, dir);
+            if (result == 0) result = write_package_manifest(&corpus, dir, name, i);
+            if (result == 0 && spec->layout == CORPUS_LAYOUT_NX) {
+                corpus.text.length = 0;
+                text_append(&corpus.text, "{\n  \"name\": \"pkg-%d\",\n  \"sourceRoot\": \"packages/pkg-%d/src\"\n}\n", i, i);
+                result = write_root_config(&corpus, dir, "project.json");
+            }
+
+            // Files are split evenly, the remainder going to the first packages
+            int count = spec->file_count / packages + (i < spec->file_count % packages ? 1 : 0);
+            if (result == 0) result = write_sources(&corpus, dir, count, &file_number);
+        }
+    }
+
+    free(corpus.text.data);
+    return result;
+}
@@ -0,0 +1,59 @@
+#ifndef WEB_CORPUS_H
+#define WEB_CORPUS_H
+
+#include <stddef.h>
+
+// Deterministic synthetic project trees for benchmarks. The same spec and
+// seed always produce byte-identical files, so timings from different builds
+// are comparable.
+
+typedef enum {
+    CORPUS_REACT,
+    CORPUS_VUE,
+    CORPUS_ANGULAR,
+    CORPUS_FRAMEWORK_COUNT
+} CorpusFramework;
+
+typedef enum {
+    CORPUS_LAYOUT_SINGLE,    // One package at the root
+    CORPUS_LAYOUT_YARN,      // package.json "workspaces"
+    CORPUS_LAYOUT_LERNA,     // lerna.json
+    CORPUS_LAYOUT_NX,        // nx.json with per-package project.json
+    CORPUS_LAYOUT_RUSH,      // rush.json
+    CORPUS_LAYOUT_PNPM,      // pnpm-workspace.yaml
+    CORPUS_LAYOUT_COUNT
+} CorpusLayout;
+
+typedef struct {
+    CorpusFramework framework;
+    CorpusLayout layout;
+    int file_count;          // Source files across all packages
+    int package_count;       // Workspace packages, ignored for CORPUS_LAYOUT_SINGLE
+    int depth;               // Directory levels below each package's src
+    int fan_out;             // Subdirectories per directory level
+    size_t min_file_bytes;
+    size_t max_file_bytes;
+    unsigned int seed;
+} CorpusSpec;
+
+typedef struct {
+    int files;               // Every file written, manifests included
+    int directories;
+    long long bytes;
+} CorpusStats;
+
+void corpus_spec_init(CorpusSpec* spec);
+
+// Writes the tree under root, creating it if needed. Existing files with the
+// same names are overwritten; nothing else is removed. Returns 0, or -1 after
+// reporting the first failure to stderr.
+int corpus_generate(const char* root, const CorpusSpec* spec, CorpusStats* stats);
+
+const char* corpus_framework_name(CorpusFramework framework);
+const char* corpus_layout_name(CorpusLayout layout);
+
+// Inverse of the name functions; -1 if the name is unknown
+int corpus_framework_from_name(const char* name);
+int corpus_layout_from_name(const char* name);
+
+#endif // WEB_CORPUS_H
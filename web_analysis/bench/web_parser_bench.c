@@ -0,0 +1,563 @@
+// Per-parser throughput benchmark. Each case generates a deterministic input,
+// warms up, then times repeated calls to one parse_* function and reports
+// MB/s with latency percentiles. Cases cover typical sources and the shapes
+// that stress the scanners: minified bundles, deep nesting and huge
+// generated declaration files.
+//
+// A baseline file stores one "case mb_per_second" line per case. With
+// --baseline, a case whose median throughput falls more than --threshold
+// below its stored value is a regression and the exit status is 3.
+//
+//   web_parser_bench --save-baseline parsers.baseline
+//   web_parser_bench --baseline parsers.baseline --threshold 0.15
+
+#include "web_parsers.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define BENCH_EXIT_REGRESSION 3
+#define BENCH_MAX_CASES 64
+#define BENCH_NAME_SIZE 64
+
+typedef enum {
+    PARSER_HTML,
+    PARSER_CSS,
+    PARSER_JS,
+    PARSER_JSON,
+    PARSER_TS,
+    PARSER_JSX,
+    PARSER_VUE,
+    PARSER_XML
+} ParserId;
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} TextBuffer;
+
+typedef void (*InputGenerator)(TextBuffer* text, size_t bytes);
+
+typedef struct {
+    const char* name;
+    ParserId parser;
+    size_t bytes;            // Input size before --scale
+    InputGenerator generate;
+} BenchCase;
+
+typedef struct {
+    const char* name;
+    size_t bytes;
+    int iterations;
+    long long min_ns;
+    long long p50_ns;
+    long long p90_ns;
+    long long p99_ns;
+    long long max_ns;
+    double mb_per_second;    // At the median
+    double baseline_mb_per_second;  // 0 when there is no baseline entry
+    int regressed;
+} CaseResult;
+
+typedef struct {
+    const char* filter;
+    const char* baseline_path;
+    const char* save_path;
+    double threshold;
+    double scale;
+    int warmup;
+    int iterations;
+    int json;
+} BenchConfig;
+
+// Keeps the parse results observable so calls cannot be dropped
+static volatile long long result_sink;
+
+static long long now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER counter;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+    return (long long)((double)counter.QuadPart * 1.0e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+static void text_append(TextBuffer* text, const char* fmt, ...) {
+    for (;;) {
+        va_list args;
+        va_start(args, fmt);
+        size_t remaining = text->capacity - text->length;
+        int n = vsnprintf(text->data + text->length, remaining, fmt, args);
+        va_end(args);
+        if (n < 0) return;
+        if ((size_t)n < remaining) {
+            text->length += (size_t)n;
+            return;
+        }
+
+        size_t capacity = text->capacity ? text->capacity * 2 : 65536;
+        while (capacity - text->length <= (size_t)n) capacity *= 2;
+        char* data = realloc(text->data, capacity);
+        if (!data) return;
+        text->data = data;
+        text->capacity = capacity;
+    }
+}
+
+static void text_repeat(TextBuffer* text, const char* s, size_t count) {
+    for (size_t i = 0; i < count; i++) text_append(text, "%s", s);
+}
+
+// --- Inputs ---
+
+static void html_page(TextBuffer* t, size_t bytes) {
+    text_append(t, "<!DOCTYPE html>\n<html>\n<head>\n"
+                   "<link rel=\"stylesheet\" href=\"https://cdn.example.com/site.css\">\n"
+                   "<script src=\"https://cdn.example.com/react.production.min.js\"></script>\n"
+                   "</head>\n<body>\n");
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, "<section class=\"s%d\" id=\"section-%d\">\n"
+                       "  <app-card-%d title=\"Card %d\"><h2>Heading %d</h2></app-card-%d>\n"
+                       "  <p>Paragraph <a href=\"/page/%d\">link</a> <img src=\"img/%d.png\" alt=\"\"></p>\n"
+                       "  <ul><li>One</li><li>Two</li><li>Three</li></ul>\n"
+                       "</section>\n",
+                    k, k, k % 40, k, k, k % 40, k, k);
+    }
+    text_append(t, "</body>\n</html>\n");
+}
+
+static void html_deep_nesting(TextBuffer* t, size_t bytes) {
+    size_t depth = bytes / (strlen("<div class=\"n\">") + strlen("</div>"));
+    text_append(t, "<html><body>");
+    text_repeat(t, "<div class=\"n\">", depth);
+    text_append(t, "leaf");
+    text_repeat(t, "</div>", depth);
+    text_append(t, "</body></html>");
+}
+
+static void css_stylesheet(TextBuffer* t, size_t bytes) {
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, ".component-%d > .item:hover, .component-%d .title {\n"
+                       "    display: flex;\n    margin: %dpx auto;\n    color: #%06x;\n"
+                       "    transition: opacity 0.2s ease-in-out;\n}\n",
+                    k, k, k % 24, (k * 2654435761u) & 0xffffff);
+        if (k % 10 == 0) {
+            text_append(t, "@media (max-width: %dpx) {\n    .component-%d { display: block; }\n}\n",
+                        480 + k % 400, k);
+        }
+        if (k % 50 == 0) {
+            text_append(t, "@keyframes fade-%d { from { opacity: 0; } to { opacity: 1; } }\n", k);
+        }
+    }
+}
+
+static void css_minified(TextBuffer* t, size_t bytes) {
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, ".c%x>.i:hover,.c%x .t{display:flex;margin:%dpx auto;color:#%06x}"
+                       "@media(max-width:%dpx){.c%x{display:block}}",
+                    k, k, k % 24, (k * 2654435761u) & 0xffffff, 480 + k % 400, k);
+    }
+}
+
+static void js_module(TextBuffer* t, size_t bytes) {
+    text_append(t, "import axios from 'axios';\nimport { debounce } from 'lodash';\n\n");
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, "export class Store%d {\n"
+                       "    constructor(api) {\n        this.api = api;\n        this.items = [];\n    }\n"
+                       "    async load(id) {\n"
+                       "        const response = await this.api.get(`/items/${id}`);\n"
+                       "        this.items = response.data.map(item => ({ ...item, loaded: true }));\n"
+                       "        return new Promise(resolve => setTimeout(() => resolve(this.items), %d));\n"
+                       "    }\n}\n"
+                       "function handler%d(event) {\n    let target = event.target;\n    var count = %d;\n"
+                       "    return () => target.dataset.count = ++count;\n}\n"
+                       "document.addEventListener('click', handler%d);\n\n",
+                    k, k % 100, k, k, k);
+    }
+}
+
+// One line, short identifiers, no whitespace, as emitted by a minifier
+static void js_minified_bundle(TextBuffer* t, size_t bytes) {
+    text_append(t, "!function(e){var t={};function n(r){if(t[r])return t[r].exports;}");
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, "function a%x(b,c){var d=b+c*%d;return d>%d?\"s%x\\\"q\":d}"
+                       "var e%x=a%x(%d,%d),f%x=function(g){return g.map(function(h){return h*2})};"
+                       "window.addEventListener(\"load\",function(){e%x++},!1);",
+                    k, k % 97, k % 13, k, k, k, k % 7, k % 11, k, k);
+    }
+    text_append(t, "}([]);");
+}
+
+static void json_package(TextBuffer* t, size_t bytes) {
+    text_append(t, "{\n  \"name\": \"bench\",\n  \"version\": \"1.0.0\",\n  \"dependencies\": {\n");
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, "    \"package-%d\": \"^%d.%d.%d\",\n", k, k % 20, k % 10, k % 7);
+    }
+    text_append(t, "    \"last\": \"1.0.0\"\n  },\n  \"files\": [\"dist\", \"lib\"]\n}\n");
+}
+
+static void json_deep_nesting(TextBuffer* t, size_t bytes) {
+    size_t depth = bytes / (strlen("{\"k\":[") + strlen("]}"));
+    text_repeat(t, "{\"k\":[", depth);
+    text_append(t, "\"leaf \\\"quoted\\\"\"");
+    text_repeat(t, "]}", depth);
+}
+
+static void ts_module(TextBuffer* t, size_t bytes) {
+    text_append(t, "import { Injectable } from '@angular/core';\n\n");
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, "export interface Model%d<T = unknown> {\n    id: number;\n    value: T;\n}\n"
+                       "export type Key%d = keyof Model%d<string>;\n"
+                       "export enum State%d { Idle, Loading, Done }\n"
+                       "export class Service%d<T extends object> {\n"
+                       "    private cache = new Map<number, Model%d<T>>();\n"
+                       "    get(id: number): Model%d<T> | undefined {\n        return this.cache.get(id);\n    }\n}\n\n",
+                    k, k, k, k, k, k, k);
+    }
+}
+
+// The shape of a bundled lib.d.ts or a generated API client
+static void ts_generated_declarations(TextBuffer* t, size_t bytes) {
+    text_append(t, "declare namespace Generated {\n");
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, "    interface I%d<T extends Record<string, unknown> = {}> {\n"
+                       "        readonly p%d?: Array<Map<string, T>>;\n"
+                       "        m%d(a: number, b?: Partial<I%d<T>>): Promise<void>;\n"
+                       "    }\n"
+                       "    type A%d = I%d<any> | null | undefined;\n"
+                       "    const enum E%d { A = %d, B, C }\n",
+                    k, k, k, k, k, k, k, k);
+    }
+    text_append(t, "}\n");
+}
+
+static void jsx_component(TextBuffer* t, size_t bytes) {
+    text_append(t, "import React, { useState, useEffect, useMemo } from 'react';\n\n");
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, "export function Panel%d({ items, ...rest }) {\n"
+                       "    const [open, setOpen] = useState(false);\n"
+                       "    const sorted = useMemo(() => [...items].sort(), [items]);\n"
+                       "    useEffect(() => { document.title = 'Panel %d'; }, []);\n"
+                       "    return (\n"
+                       "        <Layout {...rest}>\n"
+                       "            <Header title=\"Panel %d\" onToggle={() => setOpen(!open)} />\n"
+                       "            {open && <List>{sorted.map(i => <Row key={i} value={i} />)}</List>}\n"
+                       "        </Layout>\n"
+                       "    );\n}\n\n",
+                    k, k, k);
+    }
+}
+
+static void vue_sfc(TextBuffer* t, size_t bytes) {
+    text_append(t, "<template>\n  <div class=\"app\">\n");
+    for (int k = 0; t->length < bytes / 2; k++) {
+        text_append(t, "    <item-row v-for=\"item in list%d\" :key=\"item.id\" :value=\"item.value\""
+                       " @click=\"select(item)\" v-if=\"visible%d\" />\n",
+                    k, k);
+    }
+    text_append(t, "  </div>\n</template>\n\n<script setup>\n"
+                   "import { ref, computed, watch, provide, inject } from 'vue';\n"
+                   "const emit = defineEmits(['select']);\n");
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, "const value%d = ref(%d);\n"
+                       "const double%d = computed(() => value%d.value * 2);\n"
+                       "watch(value%d, v => emit('select', v));\n",
+                    k, k, k, k, k);
+    }
+    text_append(t, "</script>\n\n<style scoped>\n.app { display: grid; }\n</style>\n");
+}
+
+static void xml_document(TextBuffer* t, size_t bytes) {
+    text_append(t, "<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                   "<CustomObject xmlns=\"http://soap.sforce.com/2006/04/metadata\" "
+                   "xmlns:xsi=\"http://www.w3.org/2001/XMLSchema-instance\">\n");
+    for (int k = 0; t->length < bytes; k++) {
+        text_append(t, "    <fields>\n        <fullName>Field_%d__c</fullName>\n"
+                       "        <label type=\"text\" required=\"%s\">Field %d</label>\n"
+                       "        <length>%d</length>\n    </fields>\n",
+                    k, k % 2 ? "true" : "false", k, 16 + k % 240);
+    }
+    text_append(t, "</CustomObject>\n");
+}
+
+static void xml_deep_nesting(TextBuffer* t, size_t bytes) {
+    size_t depth = bytes / (strlen("<node level=\"x\">") + strlen("</node>"));
+    text_append(t, "<?xml version=\"1.0\"?>\n");
+    text_repeat(t, "<node level=\"x\">", depth);
+    text_repeat(t, "</node>", depth);
+}
+
+#define KB(n) ((size_t)(n) * 1024)
+
+static const BenchCase bench_cases[] = {
+    { "html/page", PARSER_HTML, KB(256), html_page },
+    { "html/deep_nesting", PARSER_HTML, KB(1024), html_deep_nesting },
+    { "css/stylesheet", PARSER_CSS, KB(256), css_stylesheet },
+    { "css/minified", PARSER_CSS, KB(1024), css_minified },
+    { "javascript/module", PARSER_JS, KB(256), js_module },
+    { "javascript/minified_bundle", PARSER_JS, KB(2048), js_minified_bundle },
+    { "json/package", PARSER_JSON, KB(256), json_package },
+    { "json/deep_nesting", PARSER_JSON, KB(1024), json_deep_nesting },
+    { "typescript/module", PARSER_TS, KB(256), ts_module },
+    { "typescript/generated_dts", PARSER_TS, KB(4096), ts_generated_declarations },
+    { "jsx/component", PARSER_JSX, KB(256), jsx_component },
+    { "vue/sfc", PARSER_VUE, KB(256), vue_sfc },
+    { "xml/document", PARSER_XML, KB(256), xml_document },
+    { "xml/deep_nesting", PARSER_XML, KB(256), xml_deep_nesting },
+};
+
+#define BENCH_CASE_COUNT ((int)(sizeof(bench_cases) / sizeof(bench_cases[0])))
+
+static void run_parser(ParserId parser, const char* input) {
+    switch (parser) {
+        case PARSER_HTML: result_sink += parse_html(input).tag_count; break;
+        case PARSER_CSS: result_sink += parse_css(input).rule_count; break;
+        case PARSER_JS: result_sink += parse_javascript(input).function_count; break;
+        case PARSER_JSON: result_sink += parse_json(input).key_count; break;
+        case PARSER_TS: result_sink += parse_typescript(input).interface_count; break;
+        case PARSER_JSX: result_sink += parse_jsx(input).hook_count; break;
+        case PARSER_VUE: result_sink += parse_vue(input).directive_count; break;
+        case PARSER_XML: result_sink += parse_xml(input).element_count; break;
+    }
+}
+
+static int compare_ns(const void* a, const void* b) {
+    long long x = *(const long long*)a;
+    long long y = *(const long long*)b;
+    return (x > y) - (x < y);
+}
+
+// Nearest-rank percentile of sorted samples
+static long long percentile(const long long* sorted, int count, double p) {
+    int rank = (int)(p * count + 0.999999);
+    if (rank < 1) rank = 1;
+    if (rank > count) rank = count;
+    return sorted[rank - 1];
+}
+
+static int run_case(const BenchCase* bench, const BenchConfig* config, CaseResult* result) {
+    TextBuffer input = { NULL, 0, 0 };
+    bench->generate(&input, (size_t)(bench->bytes * config->scale));
+    long long* samples = malloc((size_t)config->iterations * sizeof(long long));
+    if (!input.data || !samples) {
+        fprintf(stderr, "Memory allocation failed for case %s\n", bench->name);
+        free(input.data);
+        free(samples);
+        return -1;
+    }
+
+    for (int i = 0; i < config->warmup; i++) run_parser(bench->parser, input.data);
+    for (int i = 0; i < config->iterations; i++) {
+        long long start = now_ns();
+        run_parser(bench->parser, input.data);
+        samples[i] = now_ns() - start;
+    }
+    qsort(samples, (size_t)config->iterations, sizeof(long long), compare_ns);
+
+    memset(result, 0, sizeof(*result));
+    result->name = bench->name;
+    result->bytes = input.length;
+    result->iterations = config->iterations;
+    result->min_ns = samples[0];
+    result->p50_ns = percentile(samples, config->iterations, 0.50);
+    result->p90_ns = percentile(samples, config->iterations, 0.90);
+    result->p99_ns = percentile(samples, config->iterations, 0.99);
+    result->max_ns = samples[config->iterations - 1];
+    result->mb_per_second = result->p50_ns > 0 ?
+        (double)input.length / (1024.0 * 1024.0) / (result->p50_ns / 1.0e9) : 0.0;
+
+    free(input.data);
+    free(samples);
+    return 0;
+}
+
+static int load_baseline(const char* path, CaseResult* results, int count) {
+    FILE* f = fopen(path, "r");
+    if (!f) {
+        fprintf(stderr, "Failed to open baseline file: %s\n", path);
+        return -1;
+    }
+
+    char line[256];
+    while (fgets(line, sizeof(line), f)) {
+        char name[BENCH_NAME_SIZE];
+        double mb_per_second;
+        if (line[0] == '#' || sscanf(line, "%63s %lf", name, &mb_per_second) != 2) continue;
+        for (int i = 0; i < count; i++) {
+            if (strcmp(results[i].name, name) == 0) results[i].baseline_mb_per_second = mb_per_second;
+        }
+    }
+    fclose(f);
+    return 0;
+}
+
+static int save_baseline(const char* path, const CaseResult* results, int count) {
+    FILE* f = fopen(path, "w");
+    if (!f) {
+        fprintf(stderr, "Failed to write baseline file: %s\n", path);
+        return -1;
+    }
+    fprintf(f, "# web_parser_bench baseline: case median_mb_per_second\n");
+    for (int i = 0; i < count; i++) {
+        fprintf(f, "%s %.3f\n", results[i].name, results[i].mb_per_second);
+    }
+    int failed = ferror(f);
+    fclose(f);
+    return failed ? -1 : 0;
+}
+
+static void print_table(const CaseResult* results, int count, int with_baseline) {
+    printf("%-28s %10s %10s %10s %10s %10s %10s", "case", "KB", "MB/s", "min ms", "p50 ms", "p90 ms", "p99 ms");
+    if (with_baseline) printf(" %10s %8s", "base MB/s", "change");
+    printf("\n");
+
+    for (int i = 0; i < count; i++) {
+        const CaseResult* r = &results[i];
+        printf("%-28s %10zu %10.2f %10.3f %10.3f %10.3f %10.3f", r->name, r->bytes / 1024,
+               r->mb_per_second, r->min_ns / 1.0e6, r->p50_ns / 1.0e6, r->p90_ns / 1.0e6, r->p99_ns / 1.0e6);
+        if (with_baseline && r->baseline_mb_per_second > 0) {
+            printf(" %10.2f %+7.1f%%%s", r->baseline_mb_per_second,
+                   (r->mb_per_second / r->baseline_mb_per_second - 1.0) * 100.0,
+                   r->regressed ? "  REGRESSION" : "");
+        } else if (with_baseline) {
+            printf(" %10s %8s", "-", "-");
+        }
+        printf("\n");
+    }
+}
+
+static void print_json(const BenchConfig* config, const CaseResult* results, int count) {
+    printf("{\n  \"benchmark\": \"parsers\",\n  \"warmup\": %d,\n  \"iterations\": %d,\n"
+           "  \"threshold\": %.3f,\n  \"cases\": [\n",
+           config->warmup, config->iterations, config->threshold);
+    for (int i = 0; i < count; i++) {
+        const CaseResult* r = &results[i];
+        printf("    {\"case\": \"%s\", \"bytes\": %zu, \"mb_per_second\": %.3f, \"min_ns\": %lld, "
+               "\"p50_ns\": %lld, \"p90_ns\": %lld, \"p99_ns\": %lld, \"max_ns\": %lld",
+               r->name, r->bytes, r->mb_per_second, r->min_ns, r->p50_ns, r->p90_ns, r->p99_ns, r->max_ns);
+        if (r->baseline_mb_per_second > 0) {
+            printf(", \"baseline_mb_per_second\": %.3f, \"regressed\": %s",
+                   r->baseline_mb_per_second, r->regressed ? "true" : "false");
+        }
+        printf("}%s\n", i + 1 < count ? "," : "");
+    }
+    printf("  ]\n}\n");
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --filter TEXT         Run only cases whose name contains TEXT\n"
+            "  --warmup N            Untimed runs per case (default 3)\n"
+            "  --iterations N        Timed runs per case (default 21)\n"
+            "  --scale X             Multiply every input size (default 1.0)\n"
+            "  --baseline FILE       Compare against stored throughput\n"
+            "  --threshold X         Allowed slowdown before failing (default 0.10)\n"
+            "  --save-baseline FILE  Store this run's throughput\n"
+            "  --json                JSON instead of a table\n"
+            "  --list                Print the case names and exit\n",
+            program);
+}
+
+static int parse_args(int argc, char* argv[], BenchConfig* config) {
+    memset(config, 0, sizeof(*config));
+    config->threshold = 0.10;
+    config->scale = 1.0;
+    config->warmup = 3;
+    config->iterations = 21;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--json") == 0) {
+            config->json = 1;
+            continue;
+        }
+        if (strcmp(arg, "--list") == 0) {
+            for (int c = 0; c < BENCH_CASE_COUNT; c++) printf("%s\n", bench_cases[c].name);
+            exit(0);
+        }
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) return -1;
+        if (!value) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return -1;
+        }
+        i++;
+
+        if (strcmp(arg, "--filter") == 0) config->filter = value;
+        else if (strcmp(arg, "--warmup") == 0) config->warmup = atoi(value);
+        else if (strcmp(arg, "--iterations") == 0) config->iterations = atoi(value);
+        else if (strcmp(arg, "--scale") == 0) config->scale = atof(value);
+        else if (strcmp(arg, "--baseline") == 0) config->baseline_path = value;
+        else if (strcmp(arg, "--threshold") == 0) config->threshold = atof(value);
+        else if (strcmp(arg, "--save-baseline") == 0) config->save_path = value;
+        else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return -1;
+        }
+    }
+
+    if (config->warmup < 0 || config->iterations <= 0 || config->scale <= 0 ||
+        config->threshold < 0 || config->threshold >= 1) {
+        fprintf(stderr, "Invalid benchmark configuration\n");
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    BenchConfig config;
+    if (parse_args(argc, argv, &config) != 0) {
+        print_usage(argv[0]);
+        return 2;
+    }
+
+    CaseResult results[BENCH_MAX_CASES];
+    int count = 0;
+    for (int c = 0; c < BENCH_CASE_COUNT; c++) {
+        if (config.filter && !strstr(bench_cases[c].name, config.filter)) continue;
+        if (run_case(&bench_cases[c], &config, &results[count]) != 0) return 1;
+        count++;
+    }
+    if (count == 0) {
+        fprintf(stderr, "No cases match: %s\n", config.filter);
+        return 2;
+    }
+
+    int regressions = 0;
+    if (config.baseline_path) {
+        if (load_baseline(config.baseline_path, results, count) != 0) return 1;
+        for (int i = 0; i < count; i++) {
+            CaseResult* r = &results[i];
+            if (r->baseline_mb_per_second <= 0) {
+                fprintf(stderr, "No baseline for %s\n", r->name);
+                continue;
+            }
+            r->regressed = r->mb_per_second < r->baseline_mb_per_second * (1.0 - config.threshold);
+            regressions += r->regressed;
+        }
+    }
+
+    if (config.json) print_json(&config, results, count);
+    else print_table(results, count, config.baseline_path != NULL);
+
+    if (config.save_path && save_baseline(config.save_path, results, count) != 0) return 1;
+    if (regressions) {
+        fprintf(stderr, "%d case(s) regressed more than %.0f%%\n", regressions, config.threshold * 100.0);
+        return BENCH_EXIT_REGRESSION;
+    }
+    return 0;
+}
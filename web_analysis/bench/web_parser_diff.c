@@ -0,0 +1,870 @@
+// Differential harness for parser engines. Every registered engine runs
+// next to the reference parse_* function for its language over a corpus
+// directory and over seeded random inputs. The Info structs are then compared
+// field by field, and the run reports which fields differ, on how many inputs,
+// and the engine's throughput relative to the reference.
+//
+// Alternative engines (SIMD scanners, fused or tokenizing parsers) are added
+// to the engines table below, with the fields they are known to disagree on.
+// Known deltas are reported but do not fail the run; any other difference
+// makes the exit status 1, so the harness can run as a test.
+//
+//   web_parser_diff --random 200 --seed 7
+//   web_parser_diff --corpus ~/src/app --engine polled --verbose
+
+#include "web_parsers.h"
+#include "tinydir.h"
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#define DIFF_EXIT_MISMATCH 1
+#define DIFF_MAX_DELTAS 256
+#define DIFF_PATH_SIZE 96
+#define DIFF_VALUE_SIZE 72
+#define DIFF_INPUT_NAME_SIZE 256
+#define DIFF_MAX_FILE_BYTES (16 * 1024 * 1024)
+
+typedef enum {
+    PARSER_HTML,
+    PARSER_CSS,
+    PARSER_JS,
+    PARSER_JSON,
+    PARSER_TS,
+    PARSER_JSX,
+    PARSER_VUE,
+    PARSER_XML,
+    PARSER_COUNT
+} ParserId;
+
+// --- Info layouts ---
+
+typedef enum {
+    FIELD_INT,
+    FIELD_TEXT,              // Fixed char array
+    FIELD_STRING_ID,
+    FIELD_FRAMEWORK,         // Nested FrameworkInfo
+    FIELD_ISSUES,            // PotentialIssue array
+    FIELD_CUSTOM_ELEMENTS,
+    FIELD_RESOURCES,
+    FIELD_COMPONENTS         // StringId array
+} FieldKind;
+
+typedef struct {
+    const char* name;
+    FieldKind kind;
+    size_t offset;
+    size_t size;             // FIELD_TEXT: array size
+    size_t count_offset;     // Array kinds: the int holding the element count
+} FieldDesc;
+
+#define INT_FIELD(type, f) { #f, FIELD_INT, offsetof(type, f), 0, 0 }
+#define TEXT_FIELD(type, f) { #f, FIELD_TEXT, offsetof(type, f), sizeof(((type*)0)->f), 0 }
+#define ARRAY_FIELD(type, f, kind, count) { #f, kind, offsetof(type, f), 0, offsetof(type, count) }
+#define FRAMEWORK_FIELD(type) { "framework", FIELD_FRAMEWORK, offsetof(type, framework), 0, 0 }
+#define ISSUE_FIELDS(type) \
+    INT_FIELD(type, potential_issue_count), \
+    ARRAY_FIELD(type, potential_issues, FIELD_ISSUES, potential_issue_count)
+
+static const FieldDesc framework_fields[] = {
+    INT_FIELD(FrameworkInfo, has_react), INT_FIELD(FrameworkInfo, has_vue),
+    INT_FIELD(FrameworkInfo, has_angular), INT_FIELD(FrameworkInfo, has_svelte),
+    INT_FIELD(FrameworkInfo, has_nodejs), INT_FIELD(FrameworkInfo, has_nextjs),
+    INT_FIELD(FrameworkInfo, has_nuxtjs), INT_FIELD(FrameworkInfo, react_hooks_count),
+    INT_FIELD(FrameworkInfo, vue_composition_api), INT_FIELD(FrameworkInfo, uses_typescript),
+    INT_FIELD(FrameworkInfo, has_bundler), INT_FIELD(FrameworkInfo, has_testing),
+    INT_FIELD(FrameworkInfo, has_state_management), INT_FIELD(FrameworkInfo, has_routing),
+    INT_FIELD(FrameworkInfo, has_css_framework), INT_FIELD(FrameworkInfo, has_ui_library),
+    INT_FIELD(FrameworkInfo, has_form_library),
+    TEXT_FIELD(FrameworkInfo, typescript_version), TEXT_FIELD(FrameworkInfo, node_version),
+    TEXT_FIELD(FrameworkInfo, primary_bundler), TEXT_FIELD(FrameworkInfo, primary_ui_library),
+    TEXT_FIELD(FrameworkInfo, css_solution),
+    INT_FIELD(FrameworkInfo, uses_css_modules), INT_FIELD(FrameworkInfo, uses_css_in_js),
+    INT_FIELD(FrameworkInfo, uses_tailwind), INT_FIELD(FrameworkInfo, uses_sass),
+    INT_FIELD(FrameworkInfo, uses_less), INT_FIELD(FrameworkInfo, has_e2e_testing),
+    INT_FIELD(FrameworkInfo, has_unit_testing), INT_FIELD(FrameworkInfo, has_component_testing),
+    INT_FIELD(FrameworkInfo, has_linting), INT_FIELD(FrameworkInfo, has_formatting),
+    INT_FIELD(FrameworkInfo, has_ci_cd), INT_FIELD(FrameworkInfo, has_docker),
+    INT_FIELD(FrameworkInfo, has_deployment_config), INT_FIELD(FrameworkInfo, has_hot_reload),
+    INT_FIELD(FrameworkInfo, has_dev_server), INT_FIELD(FrameworkInfo, has_debug_config),
+    INT_FIELD(FrameworkInfo, uses_npm), INT_FIELD(FrameworkInfo, uses_yarn),
+    INT_FIELD(FrameworkInfo, uses_pnpm),
+};
+
+static const FieldDesc html_fields[] = {
+    INT_FIELD(HTMLInfo, tag_count), INT_FIELD(HTMLInfo, script_count),
+    INT_FIELD(HTMLInfo, style_count), INT_FIELD(HTMLInfo, link_count),
+    INT_FIELD(HTMLInfo, is_zephyr), INT_FIELD(HTMLInfo, is_react), INT_FIELD(HTMLInfo, is_vue),
+    INT_FIELD(HTMLInfo, is_angular), INT_FIELD(HTMLInfo, is_svelte),
+    INT_FIELD(HTMLInfo, custom_element_count),
+    ARRAY_FIELD(HTMLInfo, custom_elements, FIELD_CUSTOM_ELEMENTS, custom_element_count),
+    INT_FIELD(HTMLInfo, external_resource_count),
+    ARRAY_FIELD(HTMLInfo, external_resources, FIELD_RESOURCES, external_resource_count),
+    INT_FIELD(HTMLInfo, framework_component_count),
+    ARRAY_FIELD(HTMLInfo, framework_components, FIELD_COMPONENTS, framework_component_count),
+    ISSUE_FIELDS(HTMLInfo),
+};
+
+static const FieldDesc css_fields[] = {
+    INT_FIELD(CSSInfo, rule_count), INT_FIELD(CSSInfo, selector_count),
+    INT_FIELD(CSSInfo, property_count), INT_FIELD(CSSInfo, media_query_count),
+    INT_FIELD(CSSInfo, keyframe_count), ISSUE_FIELDS(CSSInfo),
+};
+
+static const FieldDesc js_fields[] = {
+    INT_FIELD(JSInfo, function_count), INT_FIELD(JSInfo, variable_count),
+    INT_FIELD(JSInfo, class_count), INT_FIELD(JSInfo, react_component_count),
+    INT_FIELD(JSInfo, vue_instance_count), INT_FIELD(JSInfo, angular_module_count),
+    INT_FIELD(JSInfo, event_listener_count), INT_FIELD(JSInfo, async_function_count),
+    INT_FIELD(JSInfo, promise_count), INT_FIELD(JSInfo, closure_count),
+    FRAMEWORK_FIELD(JSInfo), ISSUE_FIELDS(JSInfo),
+};
+
+static const FieldDesc json_fields[] = {
+    INT_FIELD(JSONInfo, object_count), INT_FIELD(JSONInfo, array_count),
+    INT_FIELD(JSONInfo, key_count), INT_FIELD(JSONInfo, max_nesting_level),
+    ISSUE_FIELDS(JSONInfo),
+};
+
+static const FieldDesc ts_fields[] = {
+    INT_FIELD(TSInfo, interface_count), INT_FIELD(TSInfo, type_definition_count),
+    INT_FIELD(TSInfo, type_alias_count), INT_FIELD(TSInfo, generic_type_count),
+    INT_FIELD(TSInfo, enum_count), FRAMEWORK_FIELD(TSInfo), ISSUE_FIELDS(TSInfo),
+};
+
+static const FieldDesc jsx_fields[] = {
+    INT_FIELD(JSXInfo, custom_component_count), INT_FIELD(JSXInfo, hook_count),
+    INT_FIELD(JSXInfo, prop_spreading_count), INT_FIELD(JSXInfo, max_component_nesting),
+    FRAMEWORK_FIELD(JSXInfo), ISSUE_FIELDS(JSXInfo),
+};
+
+static const FieldDesc vue_fields[] = {
+    INT_FIELD(VueInfo, has_template), INT_FIELD(VueInfo, has_script),
+    INT_FIELD(VueInfo, has_style), INT_FIELD(VueInfo, uses_script_setup),
+    INT_FIELD(VueInfo, uses_scoped_styles), INT_FIELD(VueInfo, directive_count),
+    INT_FIELD(VueInfo, computed_property_count), INT_FIELD(VueInfo, watcher_count),
+    INT_FIELD(VueInfo, event_binding_count), INT_FIELD(VueInfo, prop_binding_count),
+    INT_FIELD(VueInfo, emit_count), INT_FIELD(VueInfo, provide_inject_count),
+    FRAMEWORK_FIELD(VueInfo), ISSUE_FIELDS(VueInfo),
+};
+
+static const FieldDesc xml_fields[] = {
+    INT_FIELD(XMLInfo, element_count), INT_FIELD(XMLInfo, attribute_count),
+    INT_FIELD(XMLInfo, namespace_count), INT_FIELD(XMLInfo, max_nesting_level),
+    INT_FIELD(XMLInfo, has_xml_declaration), ISSUE_FIELDS(XMLInfo),
+};
+
+#define FIELDS(table) table, (int)(sizeof(table) / sizeof(table[0]))
+
+// --- Engines ---
+
+typedef void (*ParseFunction)(const char* input, void* info);
+
+typedef struct {
+    const char* name;
+    const char* extensions;  // Space separated, matched like classify_file
+    size_t info_size;
+    const FieldDesc* fields;
+    int field_count;
+    ParseFunction reference;
+    const char* const* tokens;  // Vocabulary for random inputs
+} ParserKind;
+
+typedef struct {
+    const char* name;
+    ParserId parser;
+    ParseFunction parse;
+    // Comma separated field paths this engine is known to disagree on. A path
+    // covers its children: "potential_issues" includes "potential_issues[2].location".
+    const char* known_deltas;
+} ParserEngine;
+
+static int never_stop(void* context) {
+    (void)context;
+    return 0;
+}
+
+// The reference engine, and the same parser with a stop check installed that
+// never fires, which must not change results
+#define PARSER_FUNCTIONS(fn, type) \
+    static void reference_##fn(const char* input, void* info) { *(type*)info = fn(input); } \
+    static void polled_##fn(const char* input, void* info) { \
+        parser_set_stop_check(never_stop, NULL); \
+        *(type*)info = fn(input); \
+        parser_set_stop_check(NULL, NULL); \
+    }
+
+PARSER_FUNCTIONS(parse_html, HTMLInfo)
+PARSER_FUNCTIONS(parse_css, CSSInfo)
+PARSER_FUNCTIONS(parse_javascript, JSInfo)
+PARSER_FUNCTIONS(parse_json, JSONInfo)
+PARSER_FUNCTIONS(parse_typescript, TSInfo)
+PARSER_FUNCTIONS(parse_jsx, JSXInfo)
+PARSER_FUNCTIONS(parse_vue, VueInfo)
+PARSER_FUNCTIONS(parse_xml, XMLInfo)
+
+static const char* const html_tokens[] = {
+    "<div>", "</div>", "<div class=\"a\">", "<script>", "</script>", "<style>", "</style>",
+    "<link rel=\"stylesheet\" href=\"https://cdn.example.com/a.css\">",
+    "<script src=\"https://cdn.example.com/react.js\"></script>", "<my-widget>", "</my-widget>",
+    "<app-root>", "<!-- c -->", "<img src=\"a.png\">", "data-reactroot", "v-if=\"x\"", "ng-app",
+    "svelte", "zephyr", "<", ">", "\"", "=", "text", "\n", NULL
+};
+
+static const char* const css_tokens[] = {
+    ".a", "#b", "div", ">", ",", "{", "}", ":", ";", "color: red;", "margin: 0 auto;",
+    "@media (max-width: 600px)", "@keyframes k", "from", "to", "!important", "/* c */",
+    "*", "::before", "url(\"x.png\")", "\n", " ", NULL
+};
+
+static const char* const js_tokens[] = {
+    "function", "f", "(", ")", "{", "}", "=>", "var", "let", "const", "class", "extends",
+    "async", "await", "new Promise", ".then(", "addEventListener(", "'click'", "React",
+    "useState(", "useEffect(", "new Vue(", "angular.module(", "import", "from", "'react'",
+    "require(", "eval(", "document.write(", "\"", "'", "`", "${", "//", "/*", "*/", ";",
+    "=", "\n", " ", NULL
+};
+
+static const char* const json_tokens[] = {
+    "{", "}", "[", "]", ":", ",", "\"key\"", "\"value\"", "\"dependencies\"", "\"react\"",
+    "\"^1.0.0\"", "1", "-2.5e3", "true", "false", "null", "\"\\\"esc\\\"\"", "\\", "\n", " ", NULL
+};
+
+static const char* const ts_tokens[] = {
+    "interface", "I", "type", "T", "=", "<", ">", "extends", "enum", "E", "{", "}", ":",
+    "string", "number", "any", "|", "&", "?", ";", "declare", "namespace", "class", "implements",
+    "import", "from", "'@angular/core'", "@Component(", "readonly", "//", "\n", " ", NULL
+};
+
+static const char* const jsx_tokens[] = {
+    "<Panel>", "</Panel>", "<Row />", "<div>", "</div>", "{...props}", "useState(", "useEffect(",
+    "useMemo(", "useCallback(", "useRef(", "{", "}", "(", ")", "=>", "return", "const",
+    "function", "import React from 'react';", "<", ">", "/>", "\n", " ", NULL
+};
+
+static const char* const vue_tokens[] = {
+    "<template>", "</template>", "<script>", "<script setup>", "</script>", "<style scoped>",
+    "</style>", "<div", ">", "</div>", "v-if=\"a\"", "v-for=\"i in l\"", ":value=\"v\"",
+    "@click=\"f\"", "computed(", "watch(", "emit(", "provide(", "inject(", "ref(", "defineEmits(",
+    "{", "}", "\n", " ", NULL
+};
+
+static const char* const xml_tokens[] = {
+    "<?xml version=\"1.0\"?>", "<a>", "</a>", "<b attr=\"1\">", "</b>", "<c/>", "xmlns=\"urn:x\"",
+    "xmlns:p=\"urn:p\"", "<p:d>", "</p:d>", "<!-- c -->", "<![CDATA[x]]>", "<", ">", "/", "=",
+    "\"", "text", "\n", " ", NULL
+};
+
+static const ParserKind parser_kinds[PARSER_COUNT] = {
+    { "html", ".html .htm", sizeof(HTMLInfo), FIELDS(html_fields), reference_parse_html, html_tokens },
+    { "css", ".css", sizeof(CSSInfo), FIELDS(css_fields), reference_parse_css, css_tokens },
+    { "javascript", ".js .mjs", sizeof(JSInfo), FIELDS(js_fields), reference_parse_javascript, js_tokens },
+    { "json", ".json", sizeof(JSONInfo), FIELDS(json_fields), reference_parse_json, json_tokens },
+    { "typescript", ".ts", sizeof(TSInfo), FIELDS(ts_fields), reference_parse_typescript, ts_tokens },
+    { "jsx", ".jsx", sizeof(JSXInfo), FIELDS(jsx_fields), reference_parse_jsx, jsx_tokens },
+    { "vue", ".vue", sizeof(VueInfo), FIELDS(vue_fields), reference_parse_vue, vue_tokens },
+    { "xml", ".xml .object", sizeof(XMLInfo), FIELDS(xml_fields), reference_parse_xml, xml_tokens },
+};
+
+// Engines under evaluation. The polled entries keep the harness itself
+// honest: they run the reference code with the stop check armed.
+static const ParserEngine engines[] = {
+    { "polled", PARSER_HTML, polled_parse_html, NULL },
+    { "polled", PARSER_CSS, polled_parse_css, NULL },
+    { "polled", PARSER_JS, polled_parse_javascript, NULL },
+    { "polled", PARSER_JSON, polled_parse_json, NULL },
+    { "polled", PARSER_TS, polled_parse_typescript, NULL },
+    { "polled", PARSER_JSX, polled_parse_jsx, NULL },
+    { "polled", PARSER_VUE, polled_parse_vue, NULL },
+    { "polled", PARSER_XML, polled_parse_xml, NULL },
+};
+
+#define ENGINE_COUNT ((int)(sizeof(engines) / sizeof(engines[0])))
+
+// --- Results ---
+
+typedef struct {
+    char path[DIFF_PATH_SIZE];
+    int inputs;              // Inputs on which this field differed
+    int known;               // Listed in the engine's known_deltas
+    char first_input[DIFF_INPUT_NAME_SIZE];
+    char reference_value[DIFF_VALUE_SIZE];
+    char engine_value[DIFF_VALUE_SIZE];
+} FieldDelta;
+
+typedef struct {
+    const ParserEngine* engine;
+    int inputs;
+    int differing_inputs;
+    int unexpected_inputs;   // Differed outside known_deltas
+    long long bytes;
+    long long reference_ns;
+    long long engine_ns;
+    FieldDelta deltas[DIFF_MAX_DELTAS];
+    int delta_count;
+} EngineResult;
+
+typedef struct {
+    const char* corpus_dir;
+    const char* engine_filter;
+    int random_inputs;       // Per parser
+    size_t max_random_bytes;
+    unsigned int seed;
+    int repeat;
+    int verbose;
+} DiffConfig;
+
+// Fields already counted for the current input, so a field counts once per input
+typedef struct {
+    EngineResult* result;
+    const char* input_name;
+    int seen[DIFF_MAX_DELTAS];
+    int differed;
+    int unexpected;
+} InputDiff;
+
+static long long now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER counter;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+    return (long long)((double)counter.QuadPart * 1.0e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+static int is_known_delta(const char* known, const char* path) {
+    if (!known) return 0;
+    const char* p = known;
+    while (*p) {
+        while (*p == ',' || *p == ' ') p++;
+        size_t length = strcspn(p, ", ");
+        if (length > 0 && strncmp(p, path, length) == 0 &&
+            (path[length] == '\0' || path[length] == '.' || path[length] == '[')) {
+            return 1;
+        }
+        p += length;
+    }
+    return 0;
+}
+
+static void record_delta(InputDiff* diff, const char* path, const char* reference, const char* engine) {
+    EngineResult* result = diff->result;
+    int index = -1;
+    for (int i = 0; i < result->delta_count; i++) {
+        if (strcmp(result->deltas[i].path, path) == 0) {
+            index = i;
+            break;
+        }
+    }
+
+    if (index < 0) {
+        if (result->delta_count == DIFF_MAX_DELTAS) return;
+        index = result->delta_count++;
+        FieldDelta* delta = &result->deltas[index];
+        memset(delta, 0, sizeof(*delta));
+        snprintf(delta->path, sizeof(delta->path), "%s", path);
+        snprintf(delta->first_input, sizeof(delta->first_input), "%s", diff->input_name);
+        snprintf(delta->reference_value, sizeof(delta->reference_value), "%s", reference);
+        snprintf(delta->engine_value, sizeof(delta->engine_value), "%s", engine);
+        delta->known = is_known_delta(result->engine->known_deltas, path);
+    }
+
+    if (!diff->seen[index]) {
+        diff->seen[index] = 1;
+        result->deltas[index].inputs++;
+    }
+    diff->differed = 1;
+    if (!result->deltas[index].known) diff->unexpected = 1;
+}
+
+// The Info structs are packed, so every read goes through memcpy
+static int read_int(const void* base, size_t offset) {
+    int value;
+    memcpy(&value, (const char*)base + offset, sizeof(value));
+    return value;
+}
+
+static StringId read_string_id(const void* base, size_t offset) {
+    StringId value;
+    memcpy(&value, (const char*)base + offset, sizeof(value));
+    return value;
+}
+
+static size_t read_size(const void* base, size_t offset) {
+    size_t value;
+    memcpy(&value, (const char*)base + offset, sizeof(value));
+    return value;
+}
+
+// Compares a bounded char field, quoting both sides for the report
+static void compare_text(InputDiff* diff, const char* path, const char* a, const char* b, size_t size) {
+    if (strncmp(a, b, size) == 0) return;
+    char reference[DIFF_VALUE_SIZE], engine[DIFF_VALUE_SIZE];
+    snprintf(reference, sizeof(reference), "\"%.*s\"", (int)strnlen(a, size), a);
+    snprintf(engine, sizeof(engine), "\"%.*s\"", (int)strnlen(b, size), b);
+    record_delta(diff, path, reference, engine);
+}
+
+static void compare_string_ids(InputDiff* diff, const char* path, StringId a, StringId b) {
+    if (a == b) return;
+    const char* reference = string_pool_get(a);
+    const char* engine = string_pool_get(b);
+    compare_text(diff, path, reference ? reference : "", engine ? engine : "", DIFF_VALUE_SIZE);
+}
+
+static void compare_int(InputDiff* diff, const char* path, long long a, long long b) {
+    if (a == b) return;
+    char reference[DIFF_VALUE_SIZE], engine[DIFF_VALUE_SIZE];
+    snprintf(reference, sizeof(reference), "%lld", a);
+    snprintf(engine, sizeof(engine), "%lld", b);
+    record_delta(diff, path, reference, engine);
+}
+
+// Elements past either count are left out; the count field reports those
+static int common_count(const FieldDesc* field, const void* a, const void* b, int capacity) {
+    int count_a = read_int(a, field->count_offset);
+    int count_b = read_int(b, field->count_offset);
+    int count = count_a < count_b ? count_a : count_b;
+    if (count < 0) count = 0;
+    return count < capacity ? count : capacity;
+}
+
+static void compare_fields(InputDiff* diff, const char* prefix, const FieldDesc* fields, int field_count,
+                           const void* a, const void* b) {
+    char path[DIFF_PATH_SIZE];
+    for (int f = 0; f < field_count; f++) {
+        const FieldDesc* field = &fields[f];
+        const char* pa = (const char*)a + field->offset;
+        const char* pb = (const char*)b + field->offset;
+        snprintf(path, sizeof(path), "%s%s", prefix, field->name);
+
+        switch (field->kind) {
+            case FIELD_INT:
+                compare_int(diff, path, read_int(a, field->offset), read_int(b, field->offset));
+                break;
+            case FIELD_TEXT:
+                compare_text(diff, path, pa, pb, field->size);
+                break;
+            case FIELD_STRING_ID:
+                compare_string_ids(diff, path, read_string_id(a, field->offset), read_string_id(b, field->offset));
+                break;
+            case FIELD_FRAMEWORK: {
+                char nested[DIFF_PATH_SIZE + 1];
+                snprintf(nested, sizeof(nested), "%s.", path);
+                compare_fields(diff, nested, FIELDS(framework_fields), pa, pb);
+                break;
+            }
+            case FIELD_ISSUES: {
+                int count = common_count(field, a, b, MAX_POTENTIAL_ISSUES);
+                for (int i = 0; i < count; i++) {
+                    const PotentialIssue* ia = (const PotentialIssue*)pa + i;
+                    const PotentialIssue* ib = (const PotentialIssue*)pb + i;
+                    char element[DIFF_PATH_SIZE + 24];
+                    snprintf(element, sizeof(element), "%s[%d].description", path, i);
+                    compare_text(diff, element, ia->description, ib->description, sizeof(ia->description));
+                    snprintf(element, sizeof(element), "%s[%d].location", path, i);
+                    compare_text(diff, element, ia->location, ib->location, sizeof(ia->location));
+                }
+                break;
+            }
+            case FIELD_CUSTOM_ELEMENTS: {
+                int count = common_count(field, a, b, MAX_CUSTOM_ELEMENTS);
+                for (int i = 0; i < count; i++) {
+                    const char* ea = pa + i * sizeof(CustomElement);
+                    const char* eb = pb + i * sizeof(CustomElement);
+                    char element[DIFF_PATH_SIZE + 24];
+                    snprintf(element, sizeof(element), "%s[%d].name", path, i);
+                    compare_string_ids(diff, element, read_string_id(ea, offsetof(CustomElement, name)),
+                                       read_string_id(eb, offsetof(CustomElement, name)));
+                    snprintf(element, sizeof(element), "%s[%d].count", path, i);
+                    compare_int(diff, element, read_int(ea, offsetof(CustomElement, count)),
+                                read_int(eb, offsetof(CustomElement, count)));
+                }
+                break;
+            }
+            case FIELD_RESOURCES: {
+                int count = common_count(field, a, b, MAX_EXTERNAL_RESOURCES);
+                for (int i = 0; i < count; i++) {
+                    const ExternalResource* ra = (const ExternalResource*)pa + i;
+                    const ExternalResource* rb = (const ExternalResource*)pb + i;
+                    char element[DIFF_PATH_SIZE + 24];
+                    snprintf(element, sizeof(element), "%s[%d].url", path, i);
+                    compare_text(diff, element, ra->url, rb->url, sizeof(ra->url));
+                    snprintf(element, sizeof(element), "%s[%d].type", path, i);
+                    compare_text(diff, element, ra->type, rb->type, sizeof(ra->type));
+                    snprintf(element, sizeof(element), "%s[%d].size", path, i);
+                    compare_int(diff, element,
+                                (long long)read_size(ra, offsetof(ExternalResource, size)),
+                                (long long)read_size(rb, offsetof(ExternalResource, size)));
+                }
+                break;
+            }
+            case FIELD_COMPONENTS: {
+                int count = common_count(field, a, b, MAX_FRAMEWORK_COMPONENTS);
+                for (int i = 0; i < count; i++) {
+                    char element[DIFF_PATH_SIZE + 24];
+                    snprintf(element, sizeof(element), "%s[%d]", path, i);
+                    compare_string_ids(diff, element, read_string_id(pa, i * sizeof(StringId)),
+                                       read_string_id(pb, i * sizeof(StringId)));
+                }
+                break;
+            }
+        }
+    }
+}
+
+// --- Inputs ---
+
+typedef struct {
+    char* data;
+    size_t length;
+    size_t capacity;
+} TextBuffer;
+
+static int text_append_n(TextBuffer* text, const char* s, size_t n) {
+    if (text->length + n + 1 > text->capacity) {
+        size_t capacity = text->capacity ? text->capacity * 2 : 4096;
+        while (capacity < text->length + n + 1) capacity *= 2;
+        char* data = realloc(text->data, capacity);
+        if (!data) return -1;
+        text->data = data;
+        text->capacity = capacity;
+    }
+    memcpy(text->data + text->length, s, n);
+    text->length += n;
+    text->data[text->length] = '\0';
+    return 0;
+}
+
+static unsigned int next_random(unsigned int* state) {
+    unsigned int x = *state;
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+    return *state = x;
+}
+
+// Token soup from the parser's vocabulary with stray bytes mixed in, so the
+// scanners see both the constructs they match and truncated or broken ones
+static int random_input(const ParserKind* kind, unsigned int* state, size_t max_bytes, TextBuffer* text) {
+    int token_count = 0;
+    while (kind->tokens[token_count]) token_count++;
+
+    text->length = 0;
+    if (text_append_n(text, "", 0) != 0) return -1;
+    size_t target = 1 + next_random(state) % max_bytes;
+    while (text->length < target) {
+        unsigned int r = next_random(state);
+        if (r % 16 == 0) {
+            char byte = (char)(1 + (r >> 8) % 255);  // Anything but the terminator
+            if (text_append_n(text, &byte, 1) != 0) return -1;
+        } else {
+            const char* token = kind->tokens[(r >> 4) % (unsigned int)token_count];
+            if (text_append_n(text, token, strlen(token)) != 0) return -1;
+            if (r % 3 == 0 && text_append_n(text, " ", 1) != 0) return -1;
+        }
+    }
+    return 0;
+}
+
+// Same extension rules as the analyzer's classify_file, minus package.json
+static int parser_for_file(const char* name) {
+    static const ParserId order[] = {
+        PARSER_HTML, PARSER_CSS, PARSER_JSX, PARSER_TS, PARSER_VUE, PARSER_JS, PARSER_XML, PARSER_JSON
+    };
+    for (size_t i = 0; i < sizeof(order) / sizeof(order[0]); i++) {
+        const char* extensions = parser_kinds[order[i]].extensions;
+        char extension[16];
+        for (const char* p = extensions; *p; ) {
+            size_t length = strcspn(p, " ");
+            if (length < sizeof(extension)) {
+                memcpy(extension, p, length);
+                extension[length] = '\0';
+                if (strstr(name, extension)) return order[i];
+            }
+            p += length;
+            while (*p == ' ') p++;
+        }
+    }
+    return -1;
+}
+
+static char* read_file(const char* path, size_t* length) {
+    FILE* f = fopen(path, "rb");
+    if (!f) return NULL;
+    fseek(f, 0, SEEK_END);
+    long size = ftell(f);
+    fseek(f, 0, SEEK_SET);
+    if (size < 0 || size > DIFF_MAX_FILE_BYTES) {
+        fclose(f);
+        return NULL;
+    }
+
+    char* data = malloc((size_t)size + 1);
+    if (!data) {
+        fclose(f);
+        return NULL;
+    }
+    size_t read = fread(data, 1, (size_t)size, f);
+    fclose(f);
+    data[read] = '\0';
+    *length = strlen(data);  // The parsers stop at the first NUL too
+    return data;
+}
+
+// --- Running ---
+
+// Best of repeat runs, so one scheduler hiccup does not skew the ratio
+static long long time_parse(ParseFunction parse, const char* input, void* info, int repeat) {
+    long long best = -1;
+    for (int r = 0; r < repeat; r++) {
+        long long start = now_ns();
+        parse(input, info);
+        long long elapsed = now_ns() - start;
+        if (best < 0 || elapsed < best) best = elapsed;
+    }
+    return best;
+}
+
+static int run_input(const DiffConfig* config, EngineResult* results, ParserId parser,
+                     const char* name, const char* input, size_t length) {
+    const ParserKind* kind = &parser_kinds[parser];
+    void* reference = calloc(1, kind->info_size);
+    void* candidate = calloc(1, kind->info_size);
+    if (!reference || !candidate) {
+        fprintf(stderr, "Memory allocation failed for %s\n", name);
+        free(reference);
+        free(candidate);
+        return -1;
+    }
+
+    long long reference_ns = -1;
+    for (int e = 0; e < ENGINE_COUNT; e++) {
+        const ParserEngine* engine = &engines[e];
+        if (engine->parser != parser) continue;
+        if (config->engine_filter && strcmp(engine->name, config->engine_filter) != 0) continue;
+
+        // Padding bytes differ between calls, so both sides start zeroed
+        if (reference_ns < 0) {
+            memset(reference, 0, kind->info_size);
+            reference_ns = time_parse(kind->reference, input, reference, config->repeat);
+        }
+        memset(candidate, 0, kind->info_size);
+        long long engine_ns = time_parse(engine->parse, input, candidate, config->repeat);
+
+        EngineResult* result = &results[e];
+        InputDiff diff;
+        memset(&diff, 0, sizeof(diff));
+        diff.result = result;
+        diff.input_name = name;
+        compare_fields(&diff, "", kind->fields, kind->field_count, reference, candidate);
+
+        result->inputs++;
+        result->bytes += (long long)length;
+        result->reference_ns += reference_ns;
+        result->engine_ns += engine_ns;
+        if (diff.differed) result->differing_inputs++;
+        if (diff.unexpected) {
+            result->unexpected_inputs++;
+            if (config->verbose) fprintf(stderr, "%s/%s differs on %s\n", kind->name, engine->name, name);
+        }
+    }
+
+    free(reference);
+    free(candidate);
+    return 0;
+}
+
+static int run_corpus(const DiffConfig* config, EngineResult* results, const char* dir_path, int* files) {
+    tinydir_dir dir;
+    if (tinydir_open(&dir, dir_path) == -1) {
+        fprintf(stderr, "Failed to open directory: %s\n", dir_path);
+        return -1;
+    }
+
+    while (dir.has_next) {
+        tinydir_file file;
+        if (tinydir_readfile(&dir, &file) == -1) break;
+
+        if (file.is_dir) {
+            if (file.name[0] != '.' && strcmp(file.name, "node_modules") != 0) {
+                run_corpus(config, results, file.path, files);
+            }
+        } else {
+            int parser = parser_for_file(file.name);
+            size_t length = 0;
+            char* content = parser >= 0 ? read_file(file.path, &length) : NULL;
+            if (content) {
+                run_input(config, results, (ParserId)parser, file.path, content, length);
+                free(content);
+                (*files)++;
+            }
+        }
+        if (tinydir_next(&dir) == -1) break;
+    }
+    tinydir_close(&dir);
+    return 0;
+}
+
+static int run_random(const DiffConfig* config, EngineResult* results) {
+    TextBuffer text = { NULL, 0, 0 };
+    for (int p = 0; p < PARSER_COUNT; p++) {
+        // Per-parser streams, so adding an engine or parser keeps old inputs
+        unsigned int state = config->seed * 2654435761u + (unsigned int)p * 40503u + 1u;
+        if (state == 0) state = 1;
+        for (int i = 0; i < config->random_inputs; i++) {
+            char name[DIFF_INPUT_NAME_SIZE];
+            snprintf(name, sizeof(name), "random:%s:%u:%d", parser_kinds[p].name, config->seed, i);
+            if (random_input(&parser_kinds[p], &state, config->max_random_bytes, &text) != 0 ||
+                run_input(config, results, (ParserId)p, name, text.data, text.length) != 0) {
+                free(text.data);
+                return -1;
+            }
+        }
+    }
+    free(text.data);
+    return 0;
+}
+
+static void print_report(const EngineResult* results) {
+    printf("%-12s %-10s %8s %10s %10s %12s %12s %8s\n",
+           "parser", "engine", "inputs", "differing", "unexpected", "ref MB/s", "engine MB/s", "ratio");
+    for (int e = 0; e < ENGINE_COUNT; e++) {
+        const EngineResult* r = &results[e];
+        if (r->inputs == 0) continue;
+        double mb = r->bytes / (1024.0 * 1024.0);
+        double reference = r->reference_ns > 0 ? mb / (r->reference_ns / 1.0e9) : 0.0;
+        double engine = r->engine_ns > 0 ? mb / (r->engine_ns / 1.0e9) : 0.0;
+        printf("%-12s %-10s %8d %10d %10d %12.2f %12.2f %7.2fx\n",
+               parser_kinds[r->engine->parser].name, r->engine->name, r->inputs,
+               r->differing_inputs, r->unexpected_inputs, reference, engine,
+               reference > 0 ? engine / reference : 0.0);
+    }
+
+    int header = 0;
+    for (int e = 0; e < ENGINE_COUNT; e++) {
+        const EngineResult* r = &results[e];
+        for (int d = 0; d < r->delta_count; d++) {
+            const FieldDelta* delta = &r->deltas[d];
+            if (!header) {
+                printf("\n%-12s %-10s %-40s %8s  %s\n", "parser", "engine", "field", "inputs", "first difference");
+                header = 1;
+            }
+            printf("%-12s %-10s %-40s %8d  %s: %s vs %s%s\n",
+                   parser_kinds[r->engine->parser].name, r->engine->name, delta->path, delta->inputs,
+                   delta->first_input, delta->reference_value, delta->engine_value,
+                   delta->known ? " (known)" : "");
+        }
+        if (r->delta_count == DIFF_MAX_DELTAS) {
+            printf("%-12s %-10s more differing fields not shown\n",
+                   parser_kinds[r->engine->parser].name, r->engine->name);
+        }
+    }
+}
+
+static void print_usage(const char* program) {
+    fprintf(stderr,
+            "Usage: %s [options]\n"
+            "  --corpus DIR       Also compare on every parsable file under DIR\n"
+            "  --random N         Random inputs per parser (default 100)\n"
+            "  --max-bytes N      Largest random input (default 8192)\n"
+            "  --seed N           Random input seed (default 1)\n"
+            "  --repeat N         Timed runs per input, best kept (default 3)\n"
+            "  --engine NAME      Compare only engines with this name\n"
+            "  --verbose          Name every input with unexpected differences\n"
+            "  --list             Print the registered engines and exit\n",
+            program);
+}
+
+static int parse_args(int argc, char* argv[], DiffConfig* config) {
+    memset(config, 0, sizeof(*config));
+    config->random_inputs = 100;
+    config->max_random_bytes = 8192;
+    config->seed = 1;
+    config->repeat = 3;
+
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+
+        if (strcmp(arg, "--verbose") == 0) {
+            config->verbose = 1;
+            continue;
+        }
+        if (strcmp(arg, "--list") == 0) {
+            for (int e = 0; e < ENGINE_COUNT; e++) {
+                printf("%s %s%s%s\n", parser_kinds[engines[e].parser].name, engines[e].name,
+                       engines[e].known_deltas ? " known: " : "",
+                       engines[e].known_deltas ? engines[e].known_deltas : "");
+            }
+            exit(0);
+        }
+        if (strcmp(arg, "--help") == 0 || strcmp(arg, "-h") == 0) return -1;
+        if (!value) {
+            fprintf(stderr, "Missing value for %s\n", arg);
+            return -1;
+        }
+        i++;
+
+        if (strcmp(arg, "--corpus") == 0) config->corpus_dir = value;
+        else if (strcmp(arg, "--random") == 0) config->random_inputs = atoi(value);
+        else if (strcmp(arg, "--max-bytes") == 0) config->max_random_bytes = (size_t)atol(value);
+        else if (strcmp(arg, "--seed") == 0) config->seed = (unsigned int)strtoul(value, NULL, 10);
+        else if (strcmp(arg, "--repeat") == 0) config->repeat = atoi(value);
+        else if (strcmp(arg, "--engine") == 0) config->engine_filter = value;
+        else {
+            fprintf(stderr, "Unknown option: %s\n", arg);
+            return -1;
+        }
+    }
+
+    if (config->random_inputs < 0 || config->max_random_bytes == 0 || config->repeat <= 0) {
+        fprintf(stderr, "Invalid harness configuration\n");
+        return -1;
+    }
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+    DiffConfig config;
+    if (parse_args(argc, argv, &config) != 0) {
+        print_usage(argv[0]);
+        return EXIT_FAILURE;
+    }
+
+    EngineResult* results = calloc(ENGINE_COUNT, sizeof(EngineResult));
+    if (!results) {
+        fprintf(stderr, "Memory allocation failed for results\n");
+        return EXIT_FAILURE;
+    }
+    for (int e = 0; e < ENGINE_COUNT; e++) results[e].engine = &engines[e];
+
+    int files = 0;
+    if (config.corpus_dir && run_corpus(&config, results, config.corpus_dir, &files) != 0) {
+        free(results);
+        return EXIT_FAILURE;
+    }
+    if (run_random(&config, results) != 0) {
+        free(results);
+        return EXIT_FAILURE;
+    }
+
+    if (config.corpus_dir) fprintf(stderr, "Compared %d corpus files\n", files);
+    print_report(results);
+
+    int unexpected = 0;
+    for (int e = 0; e < ENGINE_COUNT; e++) unexpected += results[e].unexpected_inputs;
+    free(results);
+    return unexpected > 0 ? DIFF_EXIT_MISMATCH : 0;
+}
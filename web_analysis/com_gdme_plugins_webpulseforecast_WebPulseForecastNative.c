@@ -1,786 +1,979 @@
 #include "com_gdme_plugins_webpulseforecast_WebPulseForecastNative.h"
 #include "web_resource_analyzer.h"
+#include "web_result_format.h"
 #include <string.h>
 #include <stdio.h>
+#include <stdint.h>
+#include <limits.h>
+#ifdef _WIN32
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
+
+// Class, field and method IDs used by the bridge. They are resolved once in
+// JNI_OnLoad and held as global class references until JNI_OnUnload, so the
+// conversion helpers never look anything up by name. Each *_FIELDS list holds
+// X(javaFieldName, signature) entries.
+#define JNI_PACKAGE "com/gdme/webpulseforecast/WebPulseForecastNative$"
+#define JNI_STRING "Ljava/lang/String;"
+#define JNI_TYPE(name) "L" JNI_PACKAGE name ";"
+#define JNI_ARRAY(name) "[L" JNI_PACKAGE name ";"
+
+#define PROJECT_TYPE_FIELDS(X) \
+    X(dependencies, JNI_TYPE("DependencyList")) \
+    X(frameworkInfo, JNI_TYPE("FrameworkInfo")) \
+    X(htmlFileCount, "I") \
+    X(cssFileCount, "I") \
+    X(jsFileCount, "I") \
+    X(jsonFileCount, "I") \
+    X(tsFileCount, "I") \
+    X(jsxFileCount, "I") \
+    X(vueFileCount, "I") \
+    X(xmlFileCount, "I") \
+    X(imageFileCount, "I") \
+    X(reactComponentCount, "I") \
+    X(customElementCount, "I") \
+    X(externalResourceCount, "I") \
+    X(totalHtmlInfo, JNI_TYPE("HTMLInfo")) \
+    X(totalCssInfo, JNI_TYPE("CSSInfo")) \
+    X(workspaceInfo, JNI_TYPE("WorkspaceInfo")) \
+    X(usesCommonjs, "Z") \
+    X(usesEsmodules, "Z") \
+    X(hasWebpack, "Z") \
+    X(hasVite, "Z") \
+    X(hasBabel, "Z") \
+    X(hasCi, "Z") \
+    X(hasEnvConfig, "Z") \
+    X(hasTypescript, "Z") \
+    X(isMonorepo, "Z") \
+    X(modulePathCount, "I") \
+    X(modulePaths, "[" JNI_STRING) \
+    X(framework, JNI_STRING) \
+    X(totalJsInfo, JNI_TYPE("JSInfo")) \
+    X(totalJsonInfo, JNI_TYPE("JSONInfo")) \
+    X(externalResources, JNI_ARRAY("ExternalResource")) \
+    X(isIncomplete, "Z") \
+    X(coverage, "D") \
+    X(potentialIssueCount, "I") \
+    X(potentialIssues, JNI_ARRAY("PotentialIssue"))
+
+#define FRAMEWORK_INFO_FIELDS(X) \
+    X(hasReact, "Z") \
+    X(hasVue, "Z") \
+    X(hasAngular, "Z") \
+    X(hasSvelte, "Z") \
+    X(hasNodejs, "Z") \
+    X(hasNextjs, "Z") \
+    X(hasNuxtjs, "Z") \
+    X(reactHooksCount, "I") \
+    X(vueCompositionApi, "Z") \
+    X(typescriptVersion, JNI_STRING) \
+    X(usesTypescript, "Z") \
+    X(hasBundler, "Z") \
+    X(hasTesting, "Z") \
+    X(hasStateManagement, "Z") \
+    X(hasRouting, "Z") \
+    X(hasCssFramework, "Z") \
+    X(hasUiLibrary, "Z") \
+    X(hasFormLibrary, "Z") \
+    X(nodeVersion, JNI_STRING) \
+    X(primaryBundler, JNI_STRING) \
+    X(primaryUiLibrary, JNI_STRING) \
+    X(cssSolution, JNI_STRING) \
+    X(usesCssModules, "Z") \
+    X(usesCssInJs, "Z") \
+    X(usesTailwind, "Z") \
+    X(usesSass, "Z") \
+    X(usesLess, "Z") \
+    X(hasE2eTesting, "Z") \
+    X(hasUnitTesting, "Z") \
+    X(hasComponentTesting, "Z") \
+    X(hasLinting, "Z") \
+    X(hasFormatting, "Z") \
+    X(hasCiCd, "Z") \
+    X(hasDocker, "Z") \
+    X(hasDeploymentConfig, "Z") \
+    X(hasHotReload, "Z") \
+    X(hasDevServer, "Z") \
+    X(hasDebugConfig, "Z") \
+    X(usesNpm, "Z") \
+    X(usesYarn, "Z") \
+    X(usesPnpm, "Z")
+
+#define DEPENDENCY_LIST_FIELDS(X) \
+    X(count, "I") \
+    X(items, JNI_ARRAY("Dependency"))
+
+#define DEPENDENCY_FIELDS(X) \
+    X(name, JNI_STRING) \
+    X(version, JNI_STRING) \
+    X(isDevDependency, "Z")
+
+#define PACKAGE_FIELDS(X) \
+    X(name, JNI_STRING) \
+    X(version, JNI_STRING) \
+    X(path, JNI_STRING) \
+    X(dependencies, JNI_TYPE("DependencyList")) \
+    X(frameworkInfo, JNI_TYPE("FrameworkInfo")) \
+    X(config, JNI_TYPE("PackageConfig"))
+
+#define PACKAGE_CONFIG_FIELDS(X) \
+    X(buildOutputPath, JNI_STRING) \
+    X(testOutputPath, JNI_STRING) \
+    X(nodeVersion, JNI_STRING) \
+    X(hasSharedConfigs, "Z") \
+    X(usesTypescript, "Z") \
+    X(usesEslint, "Z") \
+    X(usesPrettier, "Z") \
+    X(usesJest, "Z") \
+    X(refCount, "I") \
+    X(refs, JNI_ARRAY("PackageReference")) \
+    X(scriptCount, "I") \
+    X(scripts, JNI_ARRAY("PackageScript"))
+
+#define PACKAGE_REFERENCE_FIELDS(X) \
+    X(source, JNI_STRING) \
+    X(target, JNI_STRING)
+
+#define PACKAGE_SCRIPT_FIELDS(X) \
+    X(scriptName, JNI_STRING) \
+    X(command, JNI_STRING)
+
+#define WORKSPACE_INFO_FIELDS(X) \
+    X(rootPath, JNI_STRING) \
+    X(isLerna, "Z") \
+    X(isYarnWorkspace, "Z") \
+    X(isPnpmWorkspace, "Z") \
+    X(isNxWorkspace, "Z") \
+    X(isRush, "Z") \
+    X(hasHoisting, "Z") \
+    X(usesNpmWorkspaces, "Z") \
+    X(usesChangesets, "Z") \
+    X(usesTurborepo, "Z") \
+    X(packageCount, "I") \
+    X(packages, JNI_ARRAY("Package")) \
+    X(name, JNI_STRING) \
+    X(sharedDependencies, JNI_TYPE("DependencyList")) \
+    X(workspaceGlobs, "[" JNI_STRING) \
+    X(hasWorkspacesPrefix, "Z") \
+    X(hasSharedConfigs, "Z") \
+    X(usesConventionalCommits, "Z") \
+    X(usesGitTags, "Z") \
+    X(taskGroups, JNI_ARRAY("TaskGroup")) \
+    X(buildCachePath, JNI_STRING) \
+    X(tsconfigPath, JNI_STRING) \
+    X(eslintConfigPath, JNI_STRING) \
+    X(prettierConfigPath, JNI_STRING) \
+    X(jestConfigPath, JNI_STRING) \
+    X(babelConfigPath, JNI_STRING) \
+    X(versionStrategy, JNI_STRING) \
+    X(usesSemanticRelease, "Z")
+
+#define TASK_GROUP_FIELDS(X) \
+    X(name, JNI_STRING) \
+    X(type, JNI_STRING) \
+    X(packages, "[" JNI_STRING) \
+    X(packageCount, "I")
+
+#define HTML_INFO_FIELDS(X) \
+    X(tagCount, "I") \
+    X(scriptCount, "I") \
+    X(styleCount, "I") \
+    X(linkCount, "I") \
+    X(customElements, JNI_ARRAY("CustomElement"))
+
+#define CUSTOM_ELEMENT_FIELDS(X) \
+    X(name, JNI_STRING) \
+    X(count, "I")
+
+#define CSS_INFO_FIELDS(X) \
+    X(ruleCount, "I") \
+    X(selectorCount, "I") \
+    X(propertyCount, "I") \
+    X(mediaQueryCount, "I") \
+    X(keyframeCount, "I")
+
+#define JS_INFO_FIELDS(X) \
+    X(functionCount, "I") \
+    X(variableCount, "I") \
+    X(classCount, "I") \
+    X(reactComponentCount, "I") \
+    X(vueInstanceCount, "I") \
+    X(angularModuleCount, "I") \
+    X(eventListenerCount, "I") \
+    X(asyncFunctionCount, "I") \
+    X(promiseCount, "I") \
+    X(closureCount, "I") \
+    X(framework, JNI_TYPE("FrameworkInfo"))
+
+#define JSON_INFO_FIELDS(X) \
+    X(objectCount, "I") \
+    X(arrayCount, "I") \
+    X(keyCount, "I") \
+    X(maxNestingLevel, "I")
+
+#define EXTERNAL_RESOURCE_FIELDS(X) \
+    X(url, JNI_STRING) \
+    X(type, JNI_STRING) \
+    X(size, "J")
+
+#define RESOURCE_ESTIMATION_FIELDS(X) \
+    X(jsHeapSize, "J") \
+    X(transferredData, "J") \
+    X(resourceSize, "J") \
+    X(domContentLoaded, "I") \
+    X(largestContentfulPaint, "I")
+
+#define POTENTIAL_ISSUE_FIELDS(X) \
+    X(description, JNI_STRING)
+
+#define JNI_DECLARE_FIELD(name, sig) jfieldID name;
+
+// Every cached class has a no-argument constructor
+#define JNI_DECLARE_CLASS(Type, FIELDS) \
+    typedef struct { \
+        jclass cls; \
+        jmethodID init; \
+        FIELDS(JNI_DECLARE_FIELD) \
+    } Jni##Type;
+
+JNI_DECLARE_CLASS(ProjectType, PROJECT_TYPE_FIELDS)
+JNI_DECLARE_CLASS(FrameworkInfo, FRAMEWORK_INFO_FIELDS)
+JNI_DECLARE_CLASS(DependencyList, DEPENDENCY_LIST_FIELDS)
+JNI_DECLARE_CLASS(Dependency, DEPENDENCY_FIELDS)
+JNI_DECLARE_CLASS(Package, PACKAGE_FIELDS)
+JNI_DECLARE_CLASS(PackageConfig, PACKAGE_CONFIG_FIELDS)
+JNI_DECLARE_CLASS(PackageReference, PACKAGE_REFERENCE_FIELDS)
+JNI_DECLARE_CLASS(PackageScript, PACKAGE_SCRIPT_FIELDS)
+JNI_DECLARE_CLASS(WorkspaceInfo, WORKSPACE_INFO_FIELDS)
+JNI_DECLARE_CLASS(TaskGroup, TASK_GROUP_FIELDS)
+JNI_DECLARE_CLASS(HTMLInfo, HTML_INFO_FIELDS)
+JNI_DECLARE_CLASS(CustomElement, CUSTOM_ELEMENT_FIELDS)
+JNI_DECLARE_CLASS(CSSInfo, CSS_INFO_FIELDS)
+JNI_DECLARE_CLASS(JSInfo, JS_INFO_FIELDS)
+JNI_DECLARE_CLASS(JSONInfo, JSON_INFO_FIELDS)
+JNI_DECLARE_CLASS(ExternalResource, EXTERNAL_RESOURCE_FIELDS)
+JNI_DECLARE_CLASS(ResourceEstimation, RESOURCE_ESTIMATION_FIELDS)
+JNI_DECLARE_CLASS(PotentialIssue, POTENTIAL_ISSUE_FIELDS)
+
+typedef struct {
+    jclass cls;
+    jmethodID onProgress;
+    jmethodID onFileAnalyzed;
+    jmethodID onComplete;
+} JniAnalysisListener;
+
+typedef struct {
+    jclass cls;
+    jmethodID onLog;
+} JniLogListener;
+
+typedef struct {
+    jclass cls;
+    jmethodID position;
+    jmethodID limit;
+} JniBuffer;
+
+static struct {
+    JavaVM *vm;
+    jclass string_cls;
+    jclass illegal_argument_cls;
+    jclass unsupported_cls;
+    jclass illegal_state_cls;
+    JniProjectType project_type;
+    JniFrameworkInfo framework_info;
+    JniDependencyList dependency_list;
+    JniDependency dependency;
+    JniPackage package;
+    JniPackageConfig package_config;
+    JniPackageReference package_reference;
+    JniPackageScript package_script;
+    JniWorkspaceInfo workspace_info;
+    JniTaskGroup task_group;
+    JniHTMLInfo html_info;
+    JniCustomElement custom_element;
+    JniCSSInfo css_info;
+    JniJSInfo js_info;
+    JniJSONInfo json_info;
+    JniExternalResource external_resource;
+    JniResourceEstimation resource_estimation;
+    JniPotentialIssue potential_issue;
+    JniBuffer buffer;
+    JniAnalysisListener analysis_listener;  // Optional, see jni_optional
+    JniLogListener log_listener;            // Optional
+} jni;
+
+// Global reference to the listener installed by setLogListener, if any
+static jobject log_listener;
+
+static int jni_missing(JNIEnv *env, const char *owner, const char *member) {
+    (*env)->ExceptionClear(env);
+    fprintf(stderr, "WebPulseForecast JNI: cannot resolve %s%s%s\n",
+            owner, member ? "." : "", member ? member : "");
+    return 0;
+}
 
-// Helper function to extract dependency list (complete implementation)
-static void extract_dependency_list(JNIEnv *env, jobject jProjectType, DependencyList *cDependencyList) {
-    TRACE("Entering extract_dependency_list");
-    jclass cls = (*env)->GetObjectClass(env, jProjectType);
-
-    jfieldID depsField = (*env)->GetFieldID(env, cls, "dependencies",
-                                            "Lcom/gdme/webpulseforecast/WebPulseForecastNative$DependencyList;");
-    jobject dependencyList = (*env)->GetObjectField(env, jProjectType, depsField);
+static int jni_load_class(JNIEnv *env, const char *name, jclass *out) {
+    jclass local = (*env)->FindClass(env, name);
+    if (!local) return jni_missing(env, name, NULL);
+    *out = (jclass)(*env)->NewGlobalRef(env, local);
+    (*env)->DeleteLocalRef(env, local);
+    return *out != NULL;
+}
 
-    if (!dependencyList) {
-        TRACE("No dependency list found");
-        return;
+#define JNI_RESOLVE_FIELD(name, sig) \
+    ids->name = (*env)->GetFieldID(env, ids->cls, #name, sig); \
+    if (!ids->name) return jni_missing(env, javaName, #name);
+
+#define JNI_DEFINE_RESOLVER(Type, FIELDS) \
+    static int jni_resolve_##Type(JNIEnv *env, Jni##Type *ids) { \
+        const char *javaName = JNI_PACKAGE #Type; \
+        if (!jni_load_class(env, javaName, &ids->cls)) return 0; \
+        ids->init = (*env)->GetMethodID(env, ids->cls, "<init>", "()V"); \
+        if (!ids->init) return jni_missing(env, javaName, "<init>"); \
+        FIELDS(JNI_RESOLVE_FIELD) \
+        return 1; \
     }
 
-    jclass depListCls = (*env)->GetObjectClass(env, dependencyList);
+JNI_DEFINE_RESOLVER(ProjectType, PROJECT_TYPE_FIELDS)
+JNI_DEFINE_RESOLVER(FrameworkInfo, FRAMEWORK_INFO_FIELDS)
+JNI_DEFINE_RESOLVER(DependencyList, DEPENDENCY_LIST_FIELDS)
+JNI_DEFINE_RESOLVER(Dependency, DEPENDENCY_FIELDS)
+JNI_DEFINE_RESOLVER(Package, PACKAGE_FIELDS)
+JNI_DEFINE_RESOLVER(PackageConfig, PACKAGE_CONFIG_FIELDS)
+JNI_DEFINE_RESOLVER(PackageReference, PACKAGE_REFERENCE_FIELDS)
+JNI_DEFINE_RESOLVER(PackageScript, PACKAGE_SCRIPT_FIELDS)
+JNI_DEFINE_RESOLVER(WorkspaceInfo, WORKSPACE_INFO_FIELDS)
+JNI_DEFINE_RESOLVER(TaskGroup, TASK_GROUP_FIELDS)
+JNI_DEFINE_RESOLVER(HTMLInfo, HTML_INFO_FIELDS)
+JNI_DEFINE_RESOLVER(CustomElement, CUSTOM_ELEMENT_FIELDS)
+JNI_DEFINE_RESOLVER(CSSInfo, CSS_INFO_FIELDS)
+JNI_DEFINE_RESOLVER(JSInfo, JS_INFO_FIELDS)
+JNI_DEFINE_RESOLVER(JSONInfo, JSON_INFO_FIELDS)
+JNI_DEFINE_RESOLVER(ExternalResource, EXTERNAL_RESOURCE_FIELDS)
+JNI_DEFINE_RESOLVER(ResourceEstimation, RESOURCE_ESTIMATION_FIELDS)
+JNI_DEFINE_RESOLVER(PotentialIssue, POTENTIAL_ISSUE_FIELDS)
+
+static int jni_resolve_AnalysisListener(JNIEnv *env, JniAnalysisListener *ids) {
+    const char *javaName = JNI_PACKAGE "AnalysisListener";
+    if (!jni_load_class(env, javaName, &ids->cls)) return 0;
+    ids->onProgress = (*env)->GetMethodID(env, ids->cls, "onProgress",
+                                          "(JJJJD" JNI_STRING "Z)V");
+    if (!ids->onProgress) return jni_missing(env, javaName, "onProgress");
+    ids->onFileAnalyzed = (*env)->GetMethodID(env, ids->cls, "onFileAnalyzed",
+                                              "(" JNI_STRING "IJ)V");
+    if (!ids->onFileAnalyzed) return jni_missing(env, javaName, "onFileAnalyzed");
+    ids->onComplete = (*env)->GetMethodID(env, ids->cls, "onComplete", "(JZ)V");
+    if (!ids->onComplete) return jni_missing(env, javaName, "onComplete");
+    return 1;
+}
 
-    // Get count
-    jfieldID countField = (*env)->GetFieldID(env, depListCls, "count", "I");
-    cDependencyList->count = (*env)->GetIntField(env, dependencyList, countField);
+static int jni_resolve_Buffer(JNIEnv *env, JniBuffer *ids) {
+    const char *javaName = "java/nio/Buffer";
+    if (!jni_load_class(env, javaName, &ids->cls)) return 0;
+    ids->position = (*env)->GetMethodID(env, ids->cls, "position", "()I");
+    if (!ids->position) return jni_missing(env, javaName, "position");
+    ids->limit = (*env)->GetMethodID(env, ids->cls, "limit", "()I");
+    if (!ids->limit) return jni_missing(env, javaName, "limit");
+    return 1;
+}
 
-    // Get items array
-    jfieldID itemsField = (*env)->GetFieldID(env, depListCls, "items",
-                                             "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$Dependency;");
-    jobjectArray items = (*env)->GetObjectField(env, dependencyList, itemsField);
+static int jni_resolve_LogListener(JNIEnv *env, JniLogListener *ids) {
+    const char *javaName = JNI_PACKAGE "LogListener";
+    if (!jni_load_class(env, javaName, &ids->cls)) return 0;
+    ids->onLog = (*env)->GetMethodID(env, ids->cls, "onLog", "(I" JNI_STRING "J" JNI_STRING ")V");
+    if (!ids->onLog) return jni_missing(env, javaName, "onLog");
+    return 1;
+}
 
-    if (items) {
-        jsize length = (*env)->GetArrayLength(env, items);
-        int count = (length > MAX_DEPENDENCIES) ? MAX_DEPENDENCIES : length;
+// The listener interfaces are optional. A host built without them still loads,
+// and only the calls that take a listener are unavailable. A class that was
+// found but does not match is dropped too, so its cls reads NULL.
+static void jni_optional(JNIEnv *env, int resolved, jclass *cls) {
+    if (resolved || !*cls) return;
+    (*env)->DeleteGlobalRef(env, *cls);
+    *cls = NULL;
+}
 
-        for (int i = 0; i < count; i++) {
-            jobject dep = (*env)->GetObjectArrayElement(env, items, i);
-            if (!dep) continue;
+// Throws UnsupportedOperationException if an optional class is missing
+static int jni_available(JNIEnv *env, jclass cls, const char *what) {
+    if (cls) return 1;
+    (*env)->ThrowNew(env, jni.unsupported_cls, what);
+    return 0;
+}
 
-            jclass depCls = (*env)->GetObjectClass(env, dep);
+static void jni_release(JNIEnv *env) {
+    jclass *classes[] = {
+        &jni.string_cls,
+        &jni.illegal_argument_cls,
+        &jni.unsupported_cls,
+        &jni.illegal_state_cls,
+        &jni.project_type.cls,
+        &jni.framework_info.cls,
+        &jni.dependency_list.cls,
+        &jni.dependency.cls,
+        &jni.package.cls,
+        &jni.package_config.cls,
+        &jni.package_reference.cls,
+        &jni.package_script.cls,
+        &jni.workspace_info.cls,
+        &jni.task_group.cls,
+        &jni.html_info.cls,
+        &jni.custom_element.cls,
+        &jni.css_info.cls,
+        &jni.js_info.cls,
+        &jni.json_info.cls,
+        &jni.external_resource.cls,
+        &jni.resource_estimation.cls,
+        &jni.potential_issue.cls,
+        &jni.buffer.cls,
+        &jni.analysis_listener.cls,
+        &jni.log_listener.cls,
+    };
+    for (size_t i = 0; i < sizeof(classes) / sizeof(classes[0]); i++) {
+        if (*classes[i]) (*env)->DeleteGlobalRef(env, *classes[i]);
+    }
+    memset(&jni, 0, sizeof(jni));
+}
 
-            // Get name
-            jfieldID nameField = (*env)->GetFieldID(env, depCls, "name", "Ljava/lang/String;");
-            jstring name = (*env)->GetObjectField(env, dep, nameField);
-            if (name) {
-                const char* cName = (*env)->GetStringUTFChars(env, name, NULL);
-                strncpy(cDependencyList->items[i].name, cName, sizeof(cDependencyList->items[i].name) - 1);
-                (*env)->ReleaseStringUTFChars(env, name, cName);
-                (*env)->DeleteLocalRef(env, name);
-            }
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM *vm, void *reserved) {
+    JNIEnv *env;
+    if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_6) != JNI_OK) {
+        return JNI_ERR;
+    }
 
-            // Get version
-            jfieldID versionField = (*env)->GetFieldID(env, depCls, "version", "Ljava/lang/String;");
-            jstring version = (*env)->GetObjectField(env, dep, versionField);
-            if (version) {
-                const char* cVersion = (*env)->GetStringUTFChars(env, version, NULL);
-                strncpy(cDependencyList->items[i].version, cVersion, sizeof(cDependencyList->items[i].version) - 1);
-                (*env)->ReleaseStringUTFChars(env, version, cVersion);
-                (*env)->DeleteLocalRef(env, version);
-            }
+    int ok = jni_load_class(env, "java/lang/String", &jni.string_cls)
+        && jni_load_class(env, "java/lang/IllegalArgumentException", &jni.illegal_argument_cls)
+        && jni_load_class(env, "java/lang/UnsupportedOperationException", &jni.unsupported_cls)
+        && jni_load_class(env, "java/lang/IllegalStateException", &jni.illegal_state_cls)
+        && jni_resolve_ProjectType(env, &jni.project_type)
+        && jni_resolve_FrameworkInfo(env, &jni.framework_info)
+        && jni_resolve_DependencyList(env, &jni.dependency_list)
+        && jni_resolve_Dependency(env, &jni.dependency)
+        && jni_resolve_Package(env, &jni.package)
+        && jni_resolve_PackageConfig(env, &jni.package_config)
+        && jni_resolve_PackageReference(env, &jni.package_reference)
+        && jni_resolve_PackageScript(env, &jni.package_script)
+        && jni_resolve_WorkspaceInfo(env, &jni.workspace_info)
+        && jni_resolve_TaskGroup(env, &jni.task_group)
+        && jni_resolve_HTMLInfo(env, &jni.html_info)
+        && jni_resolve_CustomElement(env, &jni.custom_element)
+        && jni_resolve_CSSInfo(env, &jni.css_info)
+        && jni_resolve_JSInfo(env, &jni.js_info)
+        && jni_resolve_JSONInfo(env, &jni.json_info)
+        && jni_resolve_ExternalResource(env, &jni.external_resource)
+        && jni_resolve_ResourceEstimation(env, &jni.resource_estimation)
+        && jni_resolve_PotentialIssue(env, &jni.potential_issue)
+        && jni_resolve_Buffer(env, &jni.buffer);
+    if (!ok) {
+        jni_release(env);
+        return JNI_ERR;
+    }
+    jni_optional(env, jni_resolve_AnalysisListener(env, &jni.analysis_listener), &jni.analysis_listener.cls);
+    jni_optional(env, jni_resolve_LogListener(env, &jni.log_listener), &jni.log_listener.cls);
 
-            // Get isDevDependency
-            jfieldID isDevField = (*env)->GetFieldID(env, depCls, "isDevDependency", "Z");
-            cDependencyList->items[i].is_dev_dependency = (*env)->GetBooleanField(env, dep, isDevField);
+    jni.vm = vm;
+    return JNI_VERSION_1_6;
+}
 
-            (*env)->DeleteLocalRef(env, dep);
-        }
-        (*env)->DeleteLocalRef(env, items);
+JNIEXPORT void JNICALL JNI_OnUnload(JavaVM *vm, void *reserved) {
+    JNIEnv *env;
+    if ((*vm)->GetEnv(vm, (void **)&env, JNI_VERSION_1_6) == JNI_OK) {
+        // The log writer thread must not outlive the library
+        web_log_set_sink(NULL, NULL);
+        web_log_shutdown();
+        if (log_listener) (*env)->DeleteGlobalRef(env, log_listener);
+        log_listener = NULL;
+        jni_release(env);
     }
-    (*env)->DeleteLocalRef(env, dependencyList);
-    TRACE("Exiting extract_dependency_list");
 }
 
-// Helper function to extract FrameworkInfo from Java object
-void extract_framework_info(JNIEnv *env, jobject jFrameworkInfo, FrameworkInfo *cFrameworkInfo) {
-    jclass cls = (*env)->GetObjectClass(env, jFrameworkInfo);
-
-    // Core frameworks
-    jfieldID field;
-    field = (*env)->GetFieldID(env, cls, "hasReact", "Z");
-    cFrameworkInfo->has_react = (*env)->GetBooleanField(env, jFrameworkInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "hasVue", "Z");
-    cFrameworkInfo->has_vue = (*env)->GetBooleanField(env, jFrameworkInfo, field);
+// Local references are scoped with PushLocalFrame/PopLocalFrame rather than
+// paired DeleteLocalRef calls. Each create_* helper opens a frame for the
+// references it makes itself and pops it with its result, so only that object
+// reaches the caller. Array elements are converted JNI_ARRAY_CHUNK at a time,
+// each chunk in its own frame, so a 1000-entry dependency list or a workspace of
+// thousands of packages never holds more than one chunk of references at once. Element
+// factories that need more than JNI_ELEMENT_REFS references open their own frame.
+#define JNI_OBJECT_FRAME 16
+#define JNI_ARRAY_CHUNK 64
+#define JNI_ELEMENT_REFS 4
+
+typedef jobject (*JniElementFactory)(JNIEnv *env, const void *item);
+typedef void (*JniElementReader)(JNIEnv *env, jobject element, void *item);
+
+// Builds a Java array of count elements, element i made from
+// items + i * stride. Returns a local reference in the caller's frame.
+static jobjectArray create_object_array(JNIEnv *env, jclass cls, int count, const void *items,
+                                        size_t stride, JniElementFactory create) {
+    if (count < 0) count = 0;
+    jobjectArray array = (*env)->NewObjectArray(env, count, cls, NULL);
+    if (!array) return NULL;
+
+    for (int start = 0; start < count; start += JNI_ARRAY_CHUNK) {
+        int end = (count - start > JNI_ARRAY_CHUNK) ? start + JNI_ARRAY_CHUNK : count;
+        if ((*env)->PushLocalFrame(env, JNI_ARRAY_CHUNK * JNI_ELEMENT_REFS) != 0) break;
+        for (int i = start; i < end; i++) {
+            jobject element = create(env, (const char *)items + (size_t)i * stride);
+            if (element) (*env)->SetObjectArrayElement(env, array, i, element);
+        }
+        (*env)->PopLocalFrame(env, NULL);
+    }
+    return array;
+}
 
-    field = (*env)->GetFieldID(env, cls, "hasAngular", "Z");
-    cFrameworkInfo->has_angular = (*env)->GetBooleanField(env, jFrameworkInfo, field);
+// Reads up to max_count non-null elements of a Java array into
+// items + i * stride. Returns the array length clamped to max_count.
+static int read_object_array(JNIEnv *env, jobjectArray array, int max_count, void *items,
+                             size_t stride, JniElementReader read) {
+    if (!array) return 0;
+    jsize length = (*env)->GetArrayLength(env, array);
+    int count = (length > max_count) ? max_count : length;
+
+    for (int start = 0; start < count; start += JNI_ARRAY_CHUNK) {
+        int end = (count - start > JNI_ARRAY_CHUNK) ? start + JNI_ARRAY_CHUNK : count;
+        if ((*env)->PushLocalFrame(env, JNI_ARRAY_CHUNK * JNI_ELEMENT_REFS) != 0) break;
+        for (int i = start; i < end; i++) {
+            jobject element = (*env)->GetObjectArrayElement(env, array, i);
+            if (element) read(env, element, (char *)items + (size_t)i * stride);
+        }
+        (*env)->PopLocalFrame(env, NULL);
+    }
+    return count;
+}
 
-    field = (*env)->GetFieldID(env, cls, "hasSvelte", "Z");
-    cFrameworkInfo->has_svelte = (*env)->GetBooleanField(env, jFrameworkInfo, field);
+// Copies a String field into a fixed-size buffer, leaving it untouched if null
+static void copy_string_field(JNIEnv *env, jobject obj, jfieldID field, char *out, size_t size) {
+    jstring value = (jstring)(*env)->GetObjectField(env, obj, field);
+    if (!value) return;
+    const char *chars = (*env)->GetStringUTFChars(env, value, NULL);
+    strncpy(out, chars, size - 1);
+    (*env)->ReleaseStringUTFChars(env, value, chars);
+    (*env)->DeleteLocalRef(env, value);
+}
 
-    field = (*env)->GetFieldID(env, cls, "hasNodejs", "Z");
-    cFrameworkInfo->has_nodejs = (*env)->GetBooleanField(env, jFrameworkInfo, field);
+// Interns a String field, keeping the current ID if the field is null
+static void intern_string_field(JNIEnv *env, jobject obj, jfieldID field, StringId *out) {
+    jstring value = (jstring)(*env)->GetObjectField(env, obj, field);
+    if (!value) return;
+    const char *chars = (*env)->GetStringUTFChars(env, value, NULL);
+    *out = string_pool_intern(chars);
+    (*env)->ReleaseStringUTFChars(env, value, chars);
+    (*env)->DeleteLocalRef(env, value);
+}
 
-    // Meta frameworks
-    field = (*env)->GetFieldID(env, cls, "hasNextjs", "Z");
-    cFrameworkInfo->has_nextjs = (*env)->GetBooleanField(env, jFrameworkInfo, field);
+static void read_dependency(JNIEnv *env, jobject dep, void *item) {
+    Dependency *dependency = (Dependency *)item;
+    intern_string_field(env, dep, jni.dependency.name, &dependency->name);
+    intern_string_field(env, dep, jni.dependency.version, &dependency->version);
+    dependency->is_dev_dependency = (*env)->GetBooleanField(env, dep, jni.dependency.isDevDependency);
+}
 
-    field = (*env)->GetFieldID(env, cls, "hasNuxtjs", "Z");
-    cFrameworkInfo->has_nuxtjs = (*env)->GetBooleanField(env, jFrameworkInfo, field);
+// Helper function to extract a DependencyList object (complete implementation).
+// Takes the list itself since both ProjectType and Package carry one.
+static void extract_dependency_list(JNIEnv *env, jobject dependencyList, DependencyList *cDependencyList) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering extract_dependency_list");
 
-    // Framework features
-    field = (*env)->GetFieldID(env, cls, "reactHooksCount", "I");
-    cFrameworkInfo->react_hooks_count = (*env)->GetIntField(env, jFrameworkInfo, field);
+    if (!dependencyList) {
+        LOG_TRACE(LOG_CAT_JNI, "No dependency list found");
+        return;
+    }
 
-    field = (*env)->GetFieldID(env, cls, "vueCompositionApi", "Z");
-    cFrameworkInfo->vue_composition_api = (*env)->GetBooleanField(env, jFrameworkInfo, field);
+    cDependencyList->count = (*env)->GetIntField(env, dependencyList, jni.dependency_list.count);
 
-    // Extract version strings
-    field = (*env)->GetFieldID(env, cls, "typescriptVersion", "Ljava/lang/String;");
-    jstring tsVersion = (jstring)(*env)->GetObjectField(env, jFrameworkInfo, field);
-    if (tsVersion) {
-        const char* cTsVersion = (*env)->GetStringUTFChars(env, tsVersion, NULL);
-        strncpy(cFrameworkInfo->typescript_version, cTsVersion, sizeof(cFrameworkInfo->typescript_version) - 1);
-        (*env)->ReleaseStringUTFChars(env, tsVersion, cTsVersion);
-    }
+    jobjectArray items = (*env)->GetObjectField(env, dependencyList, jni.dependency_list.items);
+    read_object_array(env, items, MAX_DEPENDENCIES, cDependencyList->items, sizeof(Dependency),
+                      read_dependency);
+    if (items) (*env)->DeleteLocalRef(env, items);
+    LOG_TRACE(LOG_CAT_JNI, "Exiting extract_dependency_list");
 }
 
-static void extract_package_config(JNIEnv *env, jobject config, PackageConfig *cConfig) {
-    TRACE("Entering extract_package_config");
-    if (!config || !cConfig) return;
+// Reads up to max_count elements of a Java array into a new arena array.
+// Sets *count to the number read and returns the array, NULL if empty.
+static void *read_arena_array(JNIEnv *env, jobjectArray array, int max_count, Arena *arena,
+                              size_t stride, JniElementReader read, int *count) {
+    *count = 0;
+    if (!array || !arena) return NULL;
+    jsize length = (*env)->GetArrayLength(env, array);
+    if (length < max_count) max_count = length;
+    if (max_count <= 0) return NULL;
+
+    void *items = arena_alloc(arena, (size_t)max_count * stride);
+    if (!items) return NULL;
+    *count = read_object_array(env, array, max_count, items, stride, read);
+    return items;
+}
 
-    jclass cls = (*env)->GetObjectClass(env, config);
+// Helper function to extract FrameworkInfo from Java object
+void extract_framework_info(JNIEnv *env, jobject jFrameworkInfo, FrameworkInfo *cFrameworkInfo) {
+    // Core frameworks
+    cFrameworkInfo->has_react = (*env)->GetBooleanField(env, jFrameworkInfo, jni.framework_info.hasReact);
+    cFrameworkInfo->has_vue = (*env)->GetBooleanField(env, jFrameworkInfo, jni.framework_info.hasVue);
+    cFrameworkInfo->has_angular = (*env)->GetBooleanField(env, jFrameworkInfo, jni.framework_info.hasAngular);
+    cFrameworkInfo->has_svelte = (*env)->GetBooleanField(env, jFrameworkInfo, jni.framework_info.hasSvelte);
+    cFrameworkInfo->has_nodejs = (*env)->GetBooleanField(env, jFrameworkInfo, jni.framework_info.hasNodejs);
 
-    // Extract build paths
-    jfieldID field = (*env)->GetFieldID(env, cls, "buildOutputPath", "Ljava/lang/String;");
-    jstring buildPath = (*env)->GetObjectField(env, config, field);
-    if (buildPath) {
-        const char* cBuildPath = (*env)->GetStringUTFChars(env, buildPath, NULL);
-        strncpy(cConfig->build_output_path, cBuildPath, MAX_PATH - 1);
-        (*env)->ReleaseStringUTFChars(env, buildPath, cBuildPath);
-        (*env)->DeleteLocalRef(env, buildPath);
-    }
+    // Meta frameworks
+    cFrameworkInfo->has_nextjs = (*env)->GetBooleanField(env, jFrameworkInfo, jni.framework_info.hasNextjs);
+    cFrameworkInfo->has_nuxtjs = (*env)->GetBooleanField(env, jFrameworkInfo, jni.framework_info.hasNuxtjs);
 
-    // Extract test output path
-    field = (*env)->GetFieldID(env, cls, "testOutputPath", "Ljava/lang/String;");
-    jstring testPath = (*env)->GetObjectField(env, config, field);
-    if (testPath) {
-        const char* cTestPath = (*env)->GetStringUTFChars(env, testPath, NULL);
-        strncpy(cConfig->test_output_path, cTestPath, MAX_PATH - 1);
-        (*env)->ReleaseStringUTFChars(env, testPath, cTestPath);
-        (*env)->DeleteLocalRef(env, testPath);
-    }
+    // Framework features
+    cFrameworkInfo->react_hooks_count = (*env)->GetIntField(env, jFrameworkInfo, jni.framework_info.reactHooksCount);
+    cFrameworkInfo->vue_composition_api = (*env)->GetBooleanField(env, jFrameworkInfo, jni.framework_info.vueCompositionApi);
 
-    // Extract node version
-    field = (*env)->GetFieldID(env, cls, "nodeVersion", "Ljava/lang/String;");
-    jstring nodeVersion = (*env)->GetObjectField(env, config, field);
-    if (nodeVersion) {
-        const char* cNodeVersion = (*env)->GetStringUTFChars(env, nodeVersion, NULL);
-        strncpy(cConfig->node_version, cNodeVersion, sizeof(cConfig->node_version) - 1);
-        (*env)->ReleaseStringUTFChars(env, nodeVersion, cNodeVersion);
-        (*env)->DeleteLocalRef(env, nodeVersion);
-    }
+    // Extract version strings
+    copy_string_field(env, jFrameworkInfo, jni.framework_info.typescriptVersion,
+                      cFrameworkInfo->typescript_version, sizeof(cFrameworkInfo->typescript_version));
+}
 
-    // Extract flags
-    field = (*env)->GetFieldID(env, cls, "hasSharedConfigs", "Z");
-    cConfig->has_shared_configs = (*env)->GetBooleanField(env, config, field);
+static void read_package_reference(JNIEnv *env, jobject ref, void *item) {
+    PackageReference *reference = (PackageReference *)item;
+    intern_string_field(env, ref, jni.package_reference.source, &reference->source);
+    intern_string_field(env, ref, jni.package_reference.target, &reference->target);
+}
 
-    field = (*env)->GetFieldID(env, cls, "usesTypescript", "Z");
-    cConfig->uses_typescript = (*env)->GetBooleanField(env, config, field);
+static void read_package_script(JNIEnv *env, jobject script, void *item) {
+    PackageScript *packageScript = (PackageScript *)item;
+    intern_string_field(env, script, jni.package_script.scriptName, &packageScript->script_name);
+    intern_string_field(env, script, jni.package_script.command, &packageScript->command);
+}
 
-    field = (*env)->GetFieldID(env, cls, "usesEslint", "Z");
-    cConfig->uses_eslint = (*env)->GetBooleanField(env, config, field);
+// References and scripts are read into the workspace arena
+static void extract_package_config(JNIEnv *env, jobject config, PackageConfig *cConfig, Arena *arena) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering extract_package_config");
+    if (!config || !cConfig) return;
 
-    field = (*env)->GetFieldID(env, cls, "usesPrettier", "Z");
-    cConfig->uses_prettier = (*env)->GetBooleanField(env, config, field);
+    // Extract paths and node version
+    intern_string_field(env, config, jni.package_config.buildOutputPath, &cConfig->build_output_path);
+    intern_string_field(env, config, jni.package_config.testOutputPath, &cConfig->test_output_path);
+    intern_string_field(env, config, jni.package_config.nodeVersion, &cConfig->node_version);
 
-    field = (*env)->GetFieldID(env, cls, "usesJest", "Z");
-    cConfig->uses_jest = (*env)->GetBooleanField(env, config, field);
+    // Extract flags
+    cConfig->has_shared_configs = (*env)->GetBooleanField(env, config, jni.package_config.hasSharedConfigs);
+    cConfig->uses_typescript = (*env)->GetBooleanField(env, config, jni.package_config.usesTypescript);
+    cConfig->uses_eslint = (*env)->GetBooleanField(env, config, jni.package_config.usesEslint);
+    cConfig->uses_prettier = (*env)->GetBooleanField(env, config, jni.package_config.usesPrettier);
+    cConfig->uses_jest = (*env)->GetBooleanField(env, config, jni.package_config.usesJest);
 
     // Extract package references
-    field = (*env)->GetFieldID(env, cls, "refCount", "I");
-    cConfig->ref_count = (*env)->GetIntField(env, config, field);
-
-    field = (*env)->GetFieldID(env, cls, "refs", "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$PackageReference;");
-    jobjectArray refs = (*env)->GetObjectField(env, config, field);
-    if (refs) {
-        jsize length = (*env)->GetArrayLength(env, refs);
-        int count = (length > MAX_PACKAGES) ? MAX_PACKAGES : length;
-
-        for (int i = 0; i < count; i++) {
-            jobject ref = (*env)->GetObjectArrayElement(env, refs, i);
-            if (ref) {
-                jclass refCls = (*env)->GetObjectClass(env, ref);
-
-                // Get source
-                jfieldID sourceField = (*env)->GetFieldID(env, refCls, "source", "Ljava/lang/String;");
-                jstring source = (*env)->GetObjectField(env, ref, sourceField);
-                if (source) {
-                    const char* cSource = (*env)->GetStringUTFChars(env, source, NULL);
-                    strncpy(cConfig->refs[i].source, cSource, sizeof(cConfig->refs[i].source) - 1);
-                    (*env)->ReleaseStringUTFChars(env, source, cSource);
-                    (*env)->DeleteLocalRef(env, source);
-                }
-
-                // Get target
-                jfieldID targetField = (*env)->GetFieldID(env, refCls, "target", "Ljava/lang/String;");
-                jstring target = (*env)->GetObjectField(env, ref, targetField);
-                if (target) {
-                    const char* cTarget = (*env)->GetStringUTFChars(env, target, NULL);
-                    strncpy(cConfig->refs[i].target, cTarget, sizeof(cConfig->refs[i].target) - 1);
-                    (*env)->ReleaseStringUTFChars(env, target, cTarget);
-                    (*env)->DeleteLocalRef(env, target);
-                }
-
-                (*env)->DeleteLocalRef(env, ref);
-            }
-        }
-        (*env)->DeleteLocalRef(env, refs);
-    }
+    int count;
+    jint refCount = (*env)->GetIntField(env, config, jni.package_config.refCount);
+    jobjectArray refs = (*env)->GetObjectField(env, config, jni.package_config.refs);
+    cConfig->refs = read_arena_array(env, refs, refCount, arena, sizeof(PackageReference),
+                                     read_package_reference, &count);
+    cConfig->ref_count = count;
+    if (refs) (*env)->DeleteLocalRef(env, refs);
 
     // Extract scripts
-    field = (*env)->GetFieldID(env, cls, "scriptCount", "I");
-    cConfig->script_count = (*env)->GetIntField(env, config, field);
-
-    field = (*env)->GetFieldID(env, cls, "scripts", "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$PackageScript;");
-    jobjectArray scripts = (*env)->GetObjectField(env, config, field);
-    if (scripts) {
-        jsize length = (*env)->GetArrayLength(env, scripts);
-        int count = (length > 50) ? 50 : length;  // Maximum 50 scripts as defined in struct
-
-        for (int i = 0; i < count; i++) {
-            jobject script = (*env)->GetObjectArrayElement(env, scripts, i);
-            if (script) {
-                jclass scriptCls = (*env)->GetObjectClass(env, script);
-
-                // Get script name
-                jfieldID nameField = (*env)->GetFieldID(env, scriptCls, "scriptName", "Ljava/lang/String;");
-                jstring scriptName = (*env)->GetObjectField(env, script, nameField);
-                if (scriptName) {
-                    const char* cScriptName = (*env)->GetStringUTFChars(env, scriptName, NULL);
-                    strncpy(cConfig->scripts[i].script_name, cScriptName, 49);
-                    (*env)->ReleaseStringUTFChars(env, scriptName, cScriptName);
-                    (*env)->DeleteLocalRef(env, scriptName);
-                }
-
-                // Get command
-                jfieldID cmdField = (*env)->GetFieldID(env, scriptCls, "command", "Ljava/lang/String;");
-                jstring command = (*env)->GetObjectField(env, script, cmdField);
-                if (command) {
-                    const char* cCommand = (*env)->GetStringUTFChars(env, command, NULL);
-                    strncpy(cConfig->scripts[i].command, cCommand, 255);
-                    (*env)->ReleaseStringUTFChars(env, command, cCommand);
-                    (*env)->DeleteLocalRef(env, command);
-                }
-
-                (*env)->DeleteLocalRef(env, script);
-            }
-        }
-        (*env)->DeleteLocalRef(env, scripts);
-    }
-
-    TRACE("Exiting extract_package_config");
+    jint scriptCount = (*env)->GetIntField(env, config, jni.package_config.scriptCount);
+    jobjectArray scripts = (*env)->GetObjectField(env, config, jni.package_config.scripts);
+    cConfig->scripts = read_arena_array(env, scripts, scriptCount, arena, sizeof(PackageScript),
+                                        read_package_script, &count);
+    cConfig->script_count = count;
+    if (scripts) (*env)->DeleteLocalRef(env, scripts);
+
+    LOG_TRACE(LOG_CAT_JNI, "Exiting extract_package_config");
 }
 
-// Helper function to extract package info
-static void extract_package_info(JNIEnv *env, jobject package, Package *cPackage) {
-    TRACE("Entering extract_package_info");
+// Helper function to extract package info. Each package gets its own frame so
+// its nested lists are released in one pop.
+static void extract_package_info(JNIEnv *env, jobject package, Package *cPackage, Arena *arena) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering extract_package_info");
     if (!package || !cPackage) return;
-
-    jclass cls = (*env)->GetObjectClass(env, package);
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return;
 
     // Extract basic package info
-    jfieldID field = (*env)->GetFieldID(env, cls, "name", "Ljava/lang/String;");
-    jstring name = (*env)->GetObjectField(env, package, field);
-    if (name) {
-        const char* cName = (*env)->GetStringUTFChars(env, name, NULL);
-        strncpy(cPackage->name, cName, sizeof(cPackage->name) - 1);
-        (*env)->ReleaseStringUTFChars(env, name, cName);
-        (*env)->DeleteLocalRef(env, name);
-    }
-
-    field = (*env)->GetFieldID(env, cls, "version", "Ljava/lang/String;");
-    jstring version = (*env)->GetObjectField(env, package, field);
-    if (version) {
-        const char* cVersion = (*env)->GetStringUTFChars(env, version, NULL);
-        strncpy(cPackage->version, cVersion, sizeof(cPackage->version) - 1);
-        (*env)->ReleaseStringUTFChars(env, version, cVersion);
-        (*env)->DeleteLocalRef(env, version);
-    }
-
-    field = (*env)->GetFieldID(env, cls, "path", "Ljava/lang/String;");
-    jstring path = (*env)->GetObjectField(env, package, field);
-    if (path) {
-        const char* cPath = (*env)->GetStringUTFChars(env, path, NULL);
-        strncpy(cPackage->path, cPath, MAX_PATH - 1);
-        (*env)->ReleaseStringUTFChars(env, path, cPath);
-        (*env)->DeleteLocalRef(env, path);
-    }
+    intern_string_field(env, package, jni.package.name, &cPackage->name);
+    intern_string_field(env, package, jni.package.version, &cPackage->version);
+    intern_string_field(env, package, jni.package.path, &cPackage->path);
 
     // Extract dependencies
-    field = (*env)->GetFieldID(env, cls, "dependencies",
-                               "Lcom/gdme/webpulseforecast/WebPulseForecastNative$DependencyList;");
-    jobject dependencies = (*env)->GetObjectField(env, package, field);
+    jobject dependencies = (*env)->GetObjectField(env, package, jni.package.dependencies);
     if (dependencies) {
-        extract_dependency_list(env, dependencies, &cPackage->dependencies);
-        (*env)->DeleteLocalRef(env, dependencies);
+        int count;
+        jint dependencyCount = (*env)->GetIntField(env, dependencies, jni.dependency_list.count);
+        jobjectArray items = (*env)->GetObjectField(env, dependencies, jni.dependency_list.items);
+        cPackage->dependencies = read_arena_array(env, items, dependencyCount, arena, sizeof(Dependency),
+                                                  read_dependency, &count);
+        cPackage->dependency_count = count;
     }
 
     // Extract framework info
-    field = (*env)->GetFieldID(env, cls, "frameworkInfo",
-                               "Lcom/gdme/webpulseforecast/WebPulseForecastNative$FrameworkInfo;");
-    jobject frameworkInfo = (*env)->GetObjectField(env, package, field);
+    jobject frameworkInfo = (*env)->GetObjectField(env, package, jni.package.frameworkInfo);
     if (frameworkInfo) {
         extract_framework_info(env, frameworkInfo, &cPackage->framework_info);
-        (*env)->DeleteLocalRef(env, frameworkInfo);
     }
 
     // Extract package config
-    field = (*env)->GetFieldID(env, cls, "config",
-                               "Lcom/gdme/webpulseforecast/WebPulseForecastNative$PackageConfig;");
-    jobject config = (*env)->GetObjectField(env, package, field);
+    jobject config = (*env)->GetObjectField(env, package, jni.package.config);
     if (config) {
-        extract_package_config(env, config, &cPackage->config);
-        (*env)->DeleteLocalRef(env, config);
+        extract_package_config(env, config, &cPackage->config, arena);
     }
 
-    TRACE("Exiting extract_package_info");
+    (*env)->PopLocalFrame(env, NULL);
+    LOG_TRACE(LOG_CAT_JNI, "Exiting extract_package_info");
 }
 
 // Helper function to extract workspace info
 static void extract_workspace_info(JNIEnv *env, jobject workspaceInfo, WorkspaceInfo *cWorkspaceInfo) {
-    TRACE("Entering extract_workspace_info");
+    LOG_TRACE(LOG_CAT_JNI, "Entering extract_workspace_info");
     if (!workspaceInfo || !cWorkspaceInfo) {
-        TRACE("NULL parameter provided to extract_workspace_info");
+        LOG_TRACE(LOG_CAT_JNI, "NULL parameter provided to extract_workspace_info");
         return;
     }
 
-    jclass cls = (*env)->GetObjectClass(env, workspaceInfo);
-
     // Extract root path
-    jfieldID field = (*env)->GetFieldID(env, cls, "rootPath", "Ljava/lang/String;");
-    jstring rootPath = (*env)->GetObjectField(env, workspaceInfo, field);
-    if (rootPath) {
-        const char* cRootPath = (*env)->GetStringUTFChars(env, rootPath, NULL);
-        strncpy(cWorkspaceInfo->root_path, cRootPath, MAX_PATH - 1);
-        (*env)->ReleaseStringUTFChars(env, rootPath, cRootPath);
-        (*env)->DeleteLocalRef(env, rootPath);
-    }
+    copy_string_field(env, workspaceInfo, jni.workspace_info.rootPath,
+                      cWorkspaceInfo->root_path, sizeof(cWorkspaceInfo->root_path));
 
     // Extract workspace flags
-    field = (*env)->GetFieldID(env, cls, "isLerna", "Z");
-    cWorkspaceInfo->is_lerna = (*env)->GetBooleanField(env, workspaceInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "isYarnWorkspace", "Z");
-    cWorkspaceInfo->is_yarn_workspace = (*env)->GetBooleanField(env, workspaceInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "isPnpmWorkspace", "Z");
-    cWorkspaceInfo->is_pnpm_workspace = (*env)->GetBooleanField(env, workspaceInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "isNxWorkspace", "Z");
-    cWorkspaceInfo->is_nx_workspace = (*env)->GetBooleanField(env, workspaceInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "isRush", "Z");
-    cWorkspaceInfo->is_rush = (*env)->GetBooleanField(env, workspaceInfo, field);
+    cWorkspaceInfo->is_lerna = (*env)->GetBooleanField(env, workspaceInfo, jni.workspace_info.isLerna);
+    cWorkspaceInfo->is_yarn_workspace = (*env)->GetBooleanField(env, workspaceInfo, jni.workspace_info.isYarnWorkspace);
+    cWorkspaceInfo->is_pnpm_workspace = (*env)->GetBooleanField(env, workspaceInfo, jni.workspace_info.isPnpmWorkspace);
+    cWorkspaceInfo->is_nx_workspace = (*env)->GetBooleanField(env, workspaceInfo, jni.workspace_info.isNxWorkspace);
+    cWorkspaceInfo->is_rush = (*env)->GetBooleanField(env, workspaceInfo, jni.workspace_info.isRush);
 
     // Extract workspace features
-    field = (*env)->GetFieldID(env, cls, "hasHoisting", "Z");
-    cWorkspaceInfo->has_hoisting = (*env)->GetBooleanField(env, workspaceInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "usesNpmWorkspaces", "Z");
-    cWorkspaceInfo->uses_npm_workspaces = (*env)->GetBooleanField(env, workspaceInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "usesChangesets", "Z");
-    cWorkspaceInfo->uses_changesets = (*env)->GetBooleanField(env, workspaceInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "usesTurborepo", "Z");
-    cWorkspaceInfo->uses_turborepo = (*env)->GetBooleanField(env, workspaceInfo, field);
-
-    // Extract workspace packages
-    field = (*env)->GetFieldID(env, cls, "packageCount", "I");
-    cWorkspaceInfo->package_count = (*env)->GetIntField(env, workspaceInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "packages", "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$Package;");
-    jobjectArray packages = (*env)->GetObjectField(env, workspaceInfo, field);
+    cWorkspaceInfo->has_hoisting = (*env)->GetBooleanField(env, workspaceInfo, jni.workspace_info.hasHoisting);
+    cWorkspaceInfo->uses_npm_workspaces = (*env)->GetBooleanField(env, workspaceInfo, jni.workspace_info.usesNpmWorkspaces);
+    cWorkspaceInfo->uses_changesets = (*env)->GetBooleanField(env, workspaceInfo, jni.workspace_info.usesChangesets);
+    cWorkspaceInfo->uses_turborepo = (*env)->GetBooleanField(env, workspaceInfo, jni.workspace_info.usesTurborepo);
+
+    // Extract workspace packages into an arena the project owns; each package
+    // opens its own frame, so elements are released as they are read
+    jint packageCount = (*env)->GetIntField(env, workspaceInfo, jni.workspace_info.packageCount);
+    jobjectArray packages = (*env)->GetObjectField(env, workspaceInfo, jni.workspace_info.packages);
     if (packages) {
         jsize length = (*env)->GetArrayLength(env, packages);
-        int count = (length > MAX_PACKAGES) ? MAX_PACKAGES : length;
-
-        for (int i = 0; i < count; i++) {
-            jobject pkg = (*env)->GetObjectArrayElement(env, packages, i);
-            if (pkg) {
-                extract_package_info(env, pkg, &cWorkspaceInfo->packages[i]);
-                (*env)->DeleteLocalRef(env, pkg);
+        if (packageCount > length) packageCount = length;
+    } else {
+        packageCount = 0;
+    }
+    if (packageCount > 0) {
+        if (!cWorkspaceInfo->arena) {
+            cWorkspaceInfo->arena = arena_create(PROFILE_PHASE_JNI_CONVERSION, 0);
+        }
+        cWorkspaceInfo->packages = arena_alloc(cWorkspaceInfo->arena, (size_t)packageCount * sizeof(Package));
+        if (cWorkspaceInfo->packages) {
+            cWorkspaceInfo->package_count = packageCount;
+            cWorkspaceInfo->package_capacity = packageCount;
+            for (jint i = 0; i < packageCount; i++) {
+                jobject package = (*env)->GetObjectArrayElement(env, packages, i);
+                if (!package) continue;
+                extract_package_info(env, package, &cWorkspaceInfo->packages[i], cWorkspaceInfo->arena);
+                (*env)->DeleteLocalRef(env, package);
             }
         }
-        (*env)->DeleteLocalRef(env, packages);
     }
+    if (packages) (*env)->DeleteLocalRef(env, packages);
 
-    TRACE("Exiting extract_workspace_info");
+    LOG_TRACE(LOG_CAT_JNI, "Exiting extract_workspace_info");
 }
 
 // Helper function to create Java FrameworkInfo object
 jobject create_framework_info_object(JNIEnv *env, const FrameworkInfo *cFrameworkInfo) {
-    TRACE("Entering create_framework_info_object");
+    LOG_TRACE(LOG_CAT_JNI, "Entering create_framework_info_object");
 
     if (!cFrameworkInfo) {
-        TRACE("NULL cFrameworkInfo pointer provided");
-        return NULL;
-    }
-
-    // Find the FrameworkInfo class
-    jclass cls = (*env)->FindClass(env, "com/gdme/webpulseforecast/WebPulseForecastNative$FrameworkInfo");
-    if (!cls) {
-        TRACE("Failed to find FrameworkInfo class");
-        return NULL;
-    }
-
-    // Get the constructor
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    if (!constructor) {
-        TRACE("Failed to get FrameworkInfo constructor");
+        LOG_TRACE(LOG_CAT_JNI, "NULL cFrameworkInfo pointer provided");
         return NULL;
     }
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return NULL;
 
-    // Create new object
-    jobject obj = (*env)->NewObject(env, cls, constructor);
+    jobject obj = (*env)->NewObject(env, jni.framework_info.cls, jni.framework_info.init);
     if (!obj) {
-        TRACE("Failed to create new FrameworkInfo object");
-        return NULL;
+        LOG_ERROR(LOG_CAT_JNI, "Failed to create new FrameworkInfo object");
+        return (*env)->PopLocalFrame(env, NULL);
     }
 
-    // Get all field IDs
-    jfieldID field;
-
     // Core frameworks
-    field = (*env)->GetFieldID(env, cls, "hasReact", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_react);
-
-    field = (*env)->GetFieldID(env, cls, "hasVue", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_vue);
-
-    field = (*env)->GetFieldID(env, cls, "hasAngular", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_angular);
-
-    field = (*env)->GetFieldID(env, cls, "hasSvelte", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_svelte);
-
-    field = (*env)->GetFieldID(env, cls, "hasNodejs", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_nodejs);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasReact, cFrameworkInfo->has_react);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasVue, cFrameworkInfo->has_vue);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasAngular, cFrameworkInfo->has_angular);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasSvelte, cFrameworkInfo->has_svelte);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasNodejs, cFrameworkInfo->has_nodejs);
 
     // Meta frameworks
-    field = (*env)->GetFieldID(env, cls, "hasNextjs", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_nextjs);
-
-    field = (*env)->GetFieldID(env, cls, "hasNuxtjs", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_nuxtjs);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasNextjs, cFrameworkInfo->has_nextjs);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasNuxtjs, cFrameworkInfo->has_nuxtjs);
 
     // Framework features
-    field = (*env)->GetFieldID(env, cls, "reactHooksCount", "I");
-    (*env)->SetIntField(env, obj, field, cFrameworkInfo->react_hooks_count);
-
-    field = (*env)->GetFieldID(env, cls, "vueCompositionApi", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->vue_composition_api);
-
-    field = (*env)->GetFieldID(env, cls, "usesTypescript", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->uses_typescript);
-
-    field = (*env)->GetFieldID(env, cls, "hasBundler", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_bundler);
-
-    field = (*env)->GetFieldID(env, cls, "hasTesting", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_testing);
+    (*env)->SetIntField(env, obj, jni.framework_info.reactHooksCount, cFrameworkInfo->react_hooks_count);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.vueCompositionApi, cFrameworkInfo->vue_composition_api);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.usesTypescript, cFrameworkInfo->uses_typescript);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasBundler, cFrameworkInfo->has_bundler);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasTesting, cFrameworkInfo->has_testing);
 
     // Architecture and state
-    field = (*env)->GetFieldID(env, cls, "hasStateManagement", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_state_management);
-
-    field = (*env)->GetFieldID(env, cls, "hasRouting", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_routing);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasStateManagement, cFrameworkInfo->has_state_management);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasRouting, cFrameworkInfo->has_routing);
 
     // UI and styling
-    field = (*env)->GetFieldID(env, cls, "hasCssFramework", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_css_framework);
-
-    field = (*env)->GetFieldID(env, cls, "hasUiLibrary", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_ui_library);
-
-    field = (*env)->GetFieldID(env, cls, "hasFormLibrary", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_form_library);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasCssFramework, cFrameworkInfo->has_css_framework);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasUiLibrary, cFrameworkInfo->has_ui_library);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasFormLibrary, cFrameworkInfo->has_form_library);
 
     // Version strings
-    field = (*env)->GetFieldID(env, cls, "typescriptVersion", "Ljava/lang/String;");
-    jstring tsVersion = (*env)->NewStringUTF(env, cFrameworkInfo->typescript_version);
-    (*env)->SetObjectField(env, obj, field, tsVersion);
-
-    field = (*env)->GetFieldID(env, cls, "nodeVersion", "Ljava/lang/String;");
-    jstring nodeVersion = (*env)->NewStringUTF(env, cFrameworkInfo->node_version);
-    (*env)->SetObjectField(env, obj, field, nodeVersion);
-
-    field = (*env)->GetFieldID(env, cls, "primaryBundler", "Ljava/lang/String;");
-    jstring bundler = (*env)->NewStringUTF(env, cFrameworkInfo->primary_bundler);
-    (*env)->SetObjectField(env, obj, field, bundler);
-
-    field = (*env)->GetFieldID(env, cls, "primaryUiLibrary", "Ljava/lang/String;");
-    jstring uiLib = (*env)->NewStringUTF(env, cFrameworkInfo->primary_ui_library);
-    (*env)->SetObjectField(env, obj, field, uiLib);
-
-    field = (*env)->GetFieldID(env, cls, "cssSolution", "Ljava/lang/String;");
-    jstring css = (*env)->NewStringUTF(env, cFrameworkInfo->css_solution);
-    (*env)->SetObjectField(env, obj, field, css);
+    (*env)->SetObjectField(env, obj, jni.framework_info.typescriptVersion,
+                           (*env)->NewStringUTF(env, cFrameworkInfo->typescript_version));
+    (*env)->SetObjectField(env, obj, jni.framework_info.nodeVersion,
+                           (*env)->NewStringUTF(env, cFrameworkInfo->node_version));
+    (*env)->SetObjectField(env, obj, jni.framework_info.primaryBundler,
+                           (*env)->NewStringUTF(env, cFrameworkInfo->primary_bundler));
+    (*env)->SetObjectField(env, obj, jni.framework_info.primaryUiLibrary,
+                           (*env)->NewStringUTF(env, cFrameworkInfo->primary_ui_library));
+    (*env)->SetObjectField(env, obj, jni.framework_info.cssSolution,
+                           (*env)->NewStringUTF(env, cFrameworkInfo->css_solution));
 
     // CSS related flags
-    field = (*env)->GetFieldID(env, cls, "usesCssModules", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->uses_css_modules);
-
-    field = (*env)->GetFieldID(env, cls, "usesCssInJs", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->uses_css_in_js);
-
-    field = (*env)->GetFieldID(env, cls, "usesTailwind", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->uses_tailwind);
-
-    field = (*env)->GetFieldID(env, cls, "usesSass", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->uses_sass);
-
-    field = (*env)->GetFieldID(env, cls, "usesLess", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->uses_less);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.usesCssModules, cFrameworkInfo->uses_css_modules);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.usesCssInJs, cFrameworkInfo->uses_css_in_js);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.usesTailwind, cFrameworkInfo->uses_tailwind);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.usesSass, cFrameworkInfo->uses_sass);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.usesLess, cFrameworkInfo->uses_less);
 
     // Testing and quality
-    field = (*env)->GetFieldID(env, cls, "hasE2eTesting", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_e2e_testing);
-
-    field = (*env)->GetFieldID(env, cls, "hasUnitTesting", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_unit_testing);
-
-    field = (*env)->GetFieldID(env, cls, "hasComponentTesting", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_component_testing);
-
-    field = (*env)->GetFieldID(env, cls, "hasLinting", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_linting);
-
-    field = (*env)->GetFieldID(env, cls, "hasFormatting", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_formatting);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasE2eTesting, cFrameworkInfo->has_e2e_testing);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasUnitTesting, cFrameworkInfo->has_unit_testing);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasComponentTesting, cFrameworkInfo->has_component_testing);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasLinting, cFrameworkInfo->has_linting);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasFormatting, cFrameworkInfo->has_formatting);
 
     // Build and deployment
-    field = (*env)->GetFieldID(env, cls, "hasCiCd", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_ci_cd);
-
-    field = (*env)->GetFieldID(env, cls, "hasDocker", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_docker);
-
-    field = (*env)->GetFieldID(env, cls, "hasDeploymentConfig", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_deployment_config);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasCiCd, cFrameworkInfo->has_ci_cd);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasDocker, cFrameworkInfo->has_docker);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasDeploymentConfig, cFrameworkInfo->has_deployment_config);
 
     // Development tools
-    field = (*env)->GetFieldID(env, cls, "hasHotReload", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_hot_reload);
-
-    field = (*env)->GetFieldID(env, cls, "hasDevServer", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_dev_server);
-
-    field = (*env)->GetFieldID(env, cls, "hasDebugConfig", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->has_debug_config);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasHotReload, cFrameworkInfo->has_hot_reload);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasDevServer, cFrameworkInfo->has_dev_server);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.hasDebugConfig, cFrameworkInfo->has_debug_config);
 
     // Package management
-    field = (*env)->GetFieldID(env, cls, "usesNpm", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->uses_npm);
-
-    field = (*env)->GetFieldID(env, cls, "usesYarn", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->uses_yarn);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.usesNpm, cFrameworkInfo->uses_npm);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.usesYarn, cFrameworkInfo->uses_yarn);
+    (*env)->SetBooleanField(env, obj, jni.framework_info.usesPnpm, cFrameworkInfo->uses_pnpm);
 
-    field = (*env)->GetFieldID(env, cls, "usesPnpm", "Z");
-    (*env)->SetBooleanField(env, obj, field, cFrameworkInfo->uses_pnpm);
-
-    // Clean up local references
-    (*env)->DeleteLocalRef(env, tsVersion);
-    (*env)->DeleteLocalRef(env, nodeVersion);
-    (*env)->DeleteLocalRef(env, bundler);
-    (*env)->DeleteLocalRef(env, uiLib);
-    (*env)->DeleteLocalRef(env, css);
+    LOG_TRACE(LOG_CAT_JNI, "Exiting create_framework_info_object successfully");
+    return (*env)->PopLocalFrame(env, obj);
+}
 
-    TRACE("Exiting create_framework_info_object successfully");
-    return obj;
+static void read_custom_element(JNIEnv *env, jobject element, void *item) {
+    CustomElement *customElement = (CustomElement *)item;
+    intern_string_field(env, element, jni.custom_element.name, &customElement->name);
+    customElement->count = (*env)->GetIntField(env, element, jni.custom_element.count);
 }
 
 // Helper function to extract HTML info from Java object
 static void extract_html_info(JNIEnv *env, jobject htmlInfo, HTMLInfo *cHtmlInfo) {
     if (!htmlInfo) return;
-    jclass cls = (*env)->GetObjectClass(env, htmlInfo);
-
-    jfieldID field;
-    field = (*env)->GetFieldID(env, cls, "tagCount", "I");
-    cHtmlInfo->tag_count = (*env)->GetIntField(env, htmlInfo, field);
 
-    field = (*env)->GetFieldID(env, cls, "scriptCount", "I");
-    cHtmlInfo->script_count = (*env)->GetIntField(env, htmlInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "styleCount", "I");
-    cHtmlInfo->style_count = (*env)->GetIntField(env, htmlInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "linkCount", "I");
-    cHtmlInfo->link_count = (*env)->GetIntField(env, htmlInfo, field);
+    cHtmlInfo->tag_count = (*env)->GetIntField(env, htmlInfo, jni.html_info.tagCount);
+    cHtmlInfo->script_count = (*env)->GetIntField(env, htmlInfo, jni.html_info.scriptCount);
+    cHtmlInfo->style_count = (*env)->GetIntField(env, htmlInfo, jni.html_info.styleCount);
+    cHtmlInfo->link_count = (*env)->GetIntField(env, htmlInfo, jni.html_info.linkCount);
 
     // Extract custom elements
-    jfieldID customElementsField = (*env)->GetFieldID(env, cls, "customElements",
-                                                      "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$CustomElement;");
-    jobjectArray customElements = (*env)->GetObjectField(env, htmlInfo, customElementsField);
-
+    jobjectArray customElements = (*env)->GetObjectField(env, htmlInfo, jni.html_info.customElements);
     if (customElements) {
-        jsize length = (*env)->GetArrayLength(env, customElements);
-        cHtmlInfo->custom_element_count = (length > MAX_CUSTOM_ELEMENTS) ? MAX_CUSTOM_ELEMENTS : length;
-
-        for (int i = 0; i < cHtmlInfo->custom_element_count; i++) {
-            jobject element = (*env)->GetObjectArrayElement(env, customElements, i);
-            jclass elementCls = (*env)->GetObjectClass(env, element);
-
-            // Get name
-            jfieldID nameField = (*env)->GetFieldID(env, elementCls, "name", "Ljava/lang/String;");
-            jstring name = (*env)->GetObjectField(env, element, nameField);
-            const char* cName = (*env)->GetStringUTFChars(env, name, NULL);
-            strncpy(cHtmlInfo->custom_elements[i].name, cName, 49);
-            (*env)->ReleaseStringUTFChars(env, name, cName);
-
-            // Get count
-            jfieldID countField = (*env)->GetFieldID(env, elementCls, "count", "I");
-            cHtmlInfo->custom_elements[i].count = (*env)->GetIntField(env, element, countField);
-
-            (*env)->DeleteLocalRef(env, element);
-            (*env)->DeleteLocalRef(env, name);
-        }
+        cHtmlInfo->custom_element_count = read_object_array(env, customElements, MAX_CUSTOM_ELEMENTS,
+                                                            cHtmlInfo->custom_elements,
+                                                            sizeof(CustomElement), read_custom_element);
+        (*env)->DeleteLocalRef(env, customElements);
     }
 }
 
 static void extract_css_info(JNIEnv *env, jobject cssInfo, CSSInfo *cCssInfo) {
     if (!cssInfo) return;
-    jclass cls = (*env)->GetObjectClass(env, cssInfo);
 
-    jfieldID field;
-    field = (*env)->GetFieldID(env, cls, "ruleCount", "I");
-    cCssInfo->rule_count = (*env)->GetIntField(env, cssInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "selectorCount", "I");
-    cCssInfo->selector_count = (*env)->GetIntField(env, cssInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "propertyCount", "I");
-    cCssInfo->property_count = (*env)->GetIntField(env, cssInfo, field);
-
-    field = (*env)->GetFieldID(env, cls, "mediaQueryCount", "I");
-    cCssInfo->media_query_count = (*env)->GetIntField(env, cssInfo, field);
+    cCssInfo->rule_count = (*env)->GetIntField(env, cssInfo, jni.css_info.ruleCount);
+    cCssInfo->selector_count = (*env)->GetIntField(env, cssInfo, jni.css_info.selectorCount);
+    cCssInfo->property_count = (*env)->GetIntField(env, cssInfo, jni.css_info.propertyCount);
+    cCssInfo->media_query_count = (*env)->GetIntField(env, cssInfo, jni.css_info.mediaQueryCount);
+    cCssInfo->keyframe_count = (*env)->GetIntField(env, cssInfo, jni.css_info.keyframeCount);
+}
 
-    field = (*env)->GetFieldID(env, cls, "keyframeCount", "I");
-    cCssInfo->keyframe_count = (*env)->GetIntField(env, cssInfo, field);
+static void read_pooled_string(JNIEnv *env, jobject str, void *item) {
+    const char *chars = (*env)->GetStringUTFChars(env, (jstring)str, NULL);
+    *(StringId *)item = string_pool_intern(chars);
+    (*env)->ReleaseStringUTFChars(env, (jstring)str, chars);
 }
 
 void extract_project_type(JNIEnv *env, jobject jProjectType, ProjectType *cProjectType) {
-    TRACE("Entering extract_project_type");
+    LOG_TRACE(LOG_CAT_JNI, "Entering extract_project_type");
     if (!jProjectType || !cProjectType) {
-        TRACE("NULL parameter provided to extract_project_type");
+        LOG_TRACE(LOG_CAT_JNI, "NULL parameter provided to extract_project_type");
         return;
     }
 
     // Initialize the C structure
     memset(cProjectType, 0, sizeof(ProjectType));
-
-    jclass cls = (*env)->GetObjectClass(env, jProjectType);
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return;
+    PROFILE_START(conversion_mark);
 
     // Extract framework info
-    jfieldID frameworkInfoField = (*env)->GetFieldID(env, cls, "frameworkInfo",
-                                                     "Lcom/gdme/webpulseforecast/WebPulseForecastNative$FrameworkInfo;");
-    jobject frameworkInfo = (*env)->GetObjectField(env, jProjectType, frameworkInfoField);
+    jobject frameworkInfo = (*env)->GetObjectField(env, jProjectType, jni.project_type.frameworkInfo);
     if (frameworkInfo) {
         extract_framework_info(env, frameworkInfo, &cProjectType->framework_info);
-        (*env)->DeleteLocalRef(env, frameworkInfo);
     }
 
     // Extract file counts
-    jfieldID field;
-    field = (*env)->GetFieldID(env, cls, "htmlFileCount", "I");
-    cProjectType->html_file_count = (*env)->GetIntField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "cssFileCount", "I");
-    cProjectType->css_file_count = (*env)->GetIntField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "jsFileCount", "I");
-    cProjectType->js_file_count = (*env)->GetIntField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "jsonFileCount", "I");
-    cProjectType->json_file_count = (*env)->GetIntField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "tsFileCount", "I");
-    cProjectType->ts_file_count = (*env)->GetIntField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "jsxFileCount", "I");
-    cProjectType->jsx_file_count = (*env)->GetIntField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "vueFileCount", "I");
-    cProjectType->vue_file_count = (*env)->GetIntField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "xmlFileCount", "I");
-    cProjectType->xml_file_count = (*env)->GetIntField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "imageFileCount", "I");
-    cProjectType->image_file_count = (*env)->GetIntField(env, jProjectType, field);
+    cProjectType->html_file_count = (*env)->GetIntField(env, jProjectType, jni.project_type.htmlFileCount);
+    cProjectType->css_file_count = (*env)->GetIntField(env, jProjectType, jni.project_type.cssFileCount);
+    cProjectType->js_file_count = (*env)->GetIntField(env, jProjectType, jni.project_type.jsFileCount);
+    cProjectType->json_file_count = (*env)->GetIntField(env, jProjectType, jni.project_type.jsonFileCount);
+    cProjectType->ts_file_count = (*env)->GetIntField(env, jProjectType, jni.project_type.tsFileCount);
+    cProjectType->jsx_file_count = (*env)->GetIntField(env, jProjectType, jni.project_type.jsxFileCount);
+    cProjectType->vue_file_count = (*env)->GetIntField(env, jProjectType, jni.project_type.vueFileCount);
+    cProjectType->xml_file_count = (*env)->GetIntField(env, jProjectType, jni.project_type.xmlFileCount);
+    cProjectType->image_file_count = (*env)->GetIntField(env, jProjectType, jni.project_type.imageFileCount);
 
     // Extract component tracking
-    field = (*env)->GetFieldID(env, cls, "reactComponentCount", "I");
-    cProjectType->react_component_count = (*env)->GetIntField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "customElementCount", "I");
-    cProjectType->custom_element_count = (*env)->GetIntField(env, jProjectType, field);
+    cProjectType->react_component_count = (*env)->GetIntField(env, jProjectType, jni.project_type.reactComponentCount);
+    cProjectType->custom_element_count = (*env)->GetIntField(env, jProjectType, jni.project_type.customElementCount);
 
     // Extract external resources
-    field = (*env)->GetFieldID(env, cls, "externalResourceCount", "I");
-    cProjectType->external_resource_count = (*env)->GetIntField(env, jProjectType, field);
+    cProjectType->external_resource_count = (*env)->GetIntField(env, jProjectType, jni.project_type.externalResourceCount);
 
     // Extract Parser Results
-    // HTML Info
-    field = (*env)->GetFieldID(env, cls, "totalHtmlInfo",
-                               "Lcom/gdme/webpulseforecast/WebPulseForecastNative$HTMLInfo;");
-    jobject htmlInfo = (*env)->GetObjectField(env, jProjectType, field);
-    if (htmlInfo) {
-        extract_html_info(env, htmlInfo, &cProjectType->total_html_info);
-        (*env)->DeleteLocalRef(env, htmlInfo);
-    }
-
-    // CSS Info
-    field = (*env)->GetFieldID(env, cls, "totalCssInfo",
-                               "Lcom/gdme/webpulseforecast/WebPulseForecastNative$CSSInfo;");
-    jobject cssInfo = (*env)->GetObjectField(env, jProjectType, field);
-    if (cssInfo) {
-        extract_css_info(env, cssInfo, &cProjectType->total_css_info);
-        (*env)->DeleteLocalRef(env, cssInfo);
-    }
+    extract_html_info(env, (*env)->GetObjectField(env, jProjectType, jni.project_type.totalHtmlInfo),
+                      &cProjectType->total_html_info);
+    extract_css_info(env, (*env)->GetObjectField(env, jProjectType, jni.project_type.totalCssInfo),
+                     &cProjectType->total_css_info);
 
     // Extract workspace info if present
-    field = (*env)->GetFieldID(env, cls, "workspaceInfo",
-                               "Lcom/gdme/webpulseforecast/WebPulseForecastNative$WorkspaceInfo;");
-    jobject workspaceInfo = (*env)->GetObjectField(env, jProjectType, field);
+    jobject workspaceInfo = (*env)->GetObjectField(env, jProjectType, jni.project_type.workspaceInfo);
     if (workspaceInfo) {
         extract_workspace_info(env, workspaceInfo, &cProjectType->workspace);
-        (*env)->DeleteLocalRef(env, workspaceInfo);
     }
 
     // Extract flags
-    field = (*env)->GetFieldID(env, cls, "usesCommonjs", "Z");
-    cProjectType->uses_commonjs = (*env)->GetBooleanField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "usesEsmodules", "Z");
-    cProjectType->uses_esmodules = (*env)->GetBooleanField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "hasWebpack", "Z");
-    cProjectType->has_webpack = (*env)->GetBooleanField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "hasVite", "Z");
-    cProjectType->has_vite = (*env)->GetBooleanField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "hasBabel", "Z");
-    cProjectType->has_babel = (*env)->GetBooleanField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "hasCi", "Z");
-    cProjectType->has_ci = (*env)->GetBooleanField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "hasEnvConfig", "Z");
-    cProjectType->has_env_config = (*env)->GetBooleanField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "hasTypescript", "Z");
-    cProjectType->has_typescript = (*env)->GetBooleanField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "isMonorepo", "Z");
-    cProjectType->is_monorepo = (*env)->GetBooleanField(env, jProjectType, field);
+    cProjectType->uses_commonjs = (*env)->GetBooleanField(env, jProjectType, jni.project_type.usesCommonjs);
+    cProjectType->uses_esmodules = (*env)->GetBooleanField(env, jProjectType, jni.project_type.usesEsmodules);
+    cProjectType->has_webpack = (*env)->GetBooleanField(env, jProjectType, jni.project_type.hasWebpack);
+    cProjectType->has_vite = (*env)->GetBooleanField(env, jProjectType, jni.project_type.hasVite);
+    cProjectType->has_babel = (*env)->GetBooleanField(env, jProjectType, jni.project_type.hasBabel);
+    cProjectType->has_ci = (*env)->GetBooleanField(env, jProjectType, jni.project_type.hasCi);
+    cProjectType->has_env_config = (*env)->GetBooleanField(env, jProjectType, jni.project_type.hasEnvConfig);
+    cProjectType->has_typescript = (*env)->GetBooleanField(env, jProjectType, jni.project_type.hasTypescript);
+    cProjectType->is_monorepo = (*env)->GetBooleanField(env, jProjectType, jni.project_type.isMonorepo);
 
     // Extract dependencies
-    extract_dependency_list(env, jProjectType, &cProjectType->dependencies);
-
-    // Extract module paths
-    field = (*env)->GetFieldID(env, cls, "modulePathCount", "I");
-    cProjectType->module_path_count = (*env)->GetIntField(env, jProjectType, field);
-
-    field = (*env)->GetFieldID(env, cls, "modulePaths", "[Ljava/lang/String;");
-    jobjectArray modulePaths = (*env)->GetObjectField(env, jProjectType, field);
-    if (modulePaths) {
-        jsize length = (*env)->GetArrayLength(env, modulePaths);
-        int count = (length > MAX_IMPORT_PATHS) ? MAX_IMPORT_PATHS : length;
-
-        for (int i = 0; i < count; i++) {
-            jstring path = (*env)->GetObjectArrayElement(env, modulePaths, i);
-            const char* cPath = (*env)->GetStringUTFChars(env, path, NULL);
-            strncpy(cProjectType->module_paths[i], cPath, MAX_PATH - 1);
-            (*env)->ReleaseStringUTFChars(env, path, cPath);
-            (*env)->DeleteLocalRef(env, path);
-        }
+    jobject dependencies = (*env)->GetObjectField(env, jProjectType, jni.project_type.dependencies);
+    if (dependencies) {
+        extract_dependency_list(env, dependencies, &cProjectType->dependencies);
     }
 
-    TRACE("Exiting extract_project_type");
+    // Extract module paths
+    cProjectType->module_path_count = (*env)->GetIntField(env, jProjectType, jni.project_type.modulePathCount);
+    jobjectArray modulePaths = (*env)->GetObjectField(env, jProjectType, jni.project_type.modulePaths);
+    read_object_array(env, modulePaths, MAX_IMPORT_PATHS, cProjectType->module_paths, sizeof(StringId),
+                      read_pooled_string);
+
+    (*env)->PopLocalFrame(env, NULL);
+    PROFILE_END(PROFILE_PHASE_JNI_CONVERSION, conversion_mark, 0, 1);
+    LOG_TRACE(LOG_CAT_JNI, "Exiting extract_project_type");
 }
 
 // Helper function to create a Java String from a C string
@@ -788,965 +981,703 @@ jstring create_jstring(JNIEnv *env, const char *str) {
     return (*env)->NewStringUTF(env, str);
 }
 
-// Helper function to create Custom Element object
-static jobject create_custom_element_object(JNIEnv *env, const CustomElement *element) {
-    TRACE("Entering create_custom_element_object");
-    if (!element) return NULL;
+// Element factories for create_object_array
+static jobject create_fixed_string(JNIEnv *env, const void *item) {
+    return (*env)->NewStringUTF(env, (const char *)item);
+}
 
-    jclass cls = (*env)->FindClass(env,
-                                   "com/gdme/webpulseforecast/WebPulseForecastNative$CustomElement");
-    if (!cls) return NULL;
+static jobject create_pooled_string(JNIEnv *env, const void *item) {
+    return (*env)->NewStringUTF(env, string_pool_get(*(const StringId *)item));
+}
 
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
+// Helper function to create Custom Element object
+static jobject create_custom_element_object(JNIEnv *env, const void *item) {
+    const CustomElement *element = (const CustomElement *)item;
+    jobject obj = (*env)->NewObject(env, jni.custom_element.cls, jni.custom_element.init);
     if (!obj) return NULL;
 
-    // Set name
-    jfieldID field = (*env)->GetFieldID(env, cls, "name", "Ljava/lang/String;");
-    jstring name = (*env)->NewStringUTF(env, element->name);
-    (*env)->SetObjectField(env, obj, field, name);
-    (*env)->DeleteLocalRef(env, name);
-
-    // Set count
-    field = (*env)->GetFieldID(env, cls, "count", "I");
-    (*env)->SetIntField(env, obj, field, element->count);
-
-    TRACE("Exiting create_custom_element_object");
+    (*env)->SetObjectField(env, obj, jni.custom_element.name,
+                           (*env)->NewStringUTF(env, string_pool_get(element->name)));
+    (*env)->SetIntField(env, obj, jni.custom_element.count, element->count);
     return obj;
 }
 
-// Helper function to create HTML Info object
-static jobject create_html_info_object(JNIEnv *env, const HTMLInfo *cHtmlInfo) {
-    TRACE("Entering create_html_info_object");
+// Helper function to create HTML Info object. Custom elements are left null
+// unless with_elements is set; getCustomElements fetches them on demand.
+static jobject create_html_info_object(JNIEnv *env, const HTMLInfo *cHtmlInfo, int with_elements) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering create_html_info_object");
     if (!cHtmlInfo) return NULL;
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return NULL;
 
-    jclass cls = (*env)->FindClass(env, "com/gdme/webpulseforecast/WebPulseForecastNative$HTMLInfo");
-    if (!cls) return NULL;
-
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
-    if (!obj) return NULL;
+    jobject obj = (*env)->NewObject(env, jni.html_info.cls, jni.html_info.init);
+    if (!obj) return (*env)->PopLocalFrame(env, NULL);
 
     // Set basic counts
-    jfieldID field = (*env)->GetFieldID(env, cls, "tagCount", "I");
-    (*env)->SetIntField(env, obj, field, cHtmlInfo->tag_count);
-
-    field = (*env)->GetFieldID(env, cls, "scriptCount", "I");
-    (*env)->SetIntField(env, obj, field, cHtmlInfo->script_count);
-
-    field = (*env)->GetFieldID(env, cls, "styleCount", "I");
-    (*env)->SetIntField(env, obj, field, cHtmlInfo->style_count);
-
-    field = (*env)->GetFieldID(env, cls, "linkCount", "I");
-    (*env)->SetIntField(env, obj, field, cHtmlInfo->link_count);
+    (*env)->SetIntField(env, obj, jni.html_info.tagCount, cHtmlInfo->tag_count);
+    (*env)->SetIntField(env, obj, jni.html_info.scriptCount, cHtmlInfo->script_count);
+    (*env)->SetIntField(env, obj, jni.html_info.styleCount, cHtmlInfo->style_count);
+    (*env)->SetIntField(env, obj, jni.html_info.linkCount, cHtmlInfo->link_count);
 
     // Create custom elements array
-    jclass elementCls = (*env)->FindClass(env,
-                                          "com/gdme/webpulseforecast/WebPulseForecastNative$CustomElement");
-    jobjectArray customElements = (*env)->NewObjectArray(env,
-                                                         cHtmlInfo->custom_element_count, elementCls, NULL);
-
-    for (int i = 0; i < cHtmlInfo->custom_element_count; i++) {
-        jobject element = create_custom_element_object(env, &cHtmlInfo->custom_elements[i]);
-        if (element) {
-            (*env)->SetObjectArrayElement(env, customElements, i, element);
-            (*env)->DeleteLocalRef(env, element);
-        }
+    if (with_elements) {
+        (*env)->SetObjectField(env, obj, jni.html_info.customElements,
+                               create_object_array(env, jni.custom_element.cls, cHtmlInfo->custom_element_count,
+                                                   cHtmlInfo->custom_elements, sizeof(CustomElement),
+                                                   create_custom_element_object));
     }
 
-    field = (*env)->GetFieldID(env, cls, "customElements",
-                               "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$CustomElement;");
-    (*env)->SetObjectField(env, obj, field, customElements);
-    (*env)->DeleteLocalRef(env, customElements);
-
-    TRACE("Exiting create_html_info_object");
-    return obj;
+    LOG_TRACE(LOG_CAT_JNI, "Exiting create_html_info_object");
+    return (*env)->PopLocalFrame(env, obj);
 }
 
 // Helper function to create CSS Info object
 static jobject create_css_info_object(JNIEnv *env, const CSSInfo *cCssInfo) {
-    TRACE("Entering create_css_info_object");
+    LOG_TRACE(LOG_CAT_JNI, "Entering create_css_info_object");
     if (!cCssInfo) return NULL;
 
-    jclass cls = (*env)->FindClass(env, "com/gdme/webpulseforecast/WebPulseForecastNative$CSSInfo");
-    if (!cls) return NULL;
-
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
+    jobject obj = (*env)->NewObject(env, jni.css_info.cls, jni.css_info.init);
     if (!obj) return NULL;
 
-    jfieldID field = (*env)->GetFieldID(env, cls, "ruleCount", "I");
-    (*env)->SetIntField(env, obj, field, cCssInfo->rule_count);
-
-    field = (*env)->GetFieldID(env, cls, "selectorCount", "I");
-    (*env)->SetIntField(env, obj, field, cCssInfo->selector_count);
-
-    field = (*env)->GetFieldID(env, cls, "propertyCount", "I");
-    (*env)->SetIntField(env, obj, field, cCssInfo->property_count);
-
-    field = (*env)->GetFieldID(env, cls, "mediaQueryCount", "I");
-    (*env)->SetIntField(env, obj, field, cCssInfo->media_query_count);
+    (*env)->SetIntField(env, obj, jni.css_info.ruleCount, cCssInfo->rule_count);
+    (*env)->SetIntField(env, obj, jni.css_info.selectorCount, cCssInfo->selector_count);
+    (*env)->SetIntField(env, obj, jni.css_info.propertyCount, cCssInfo->property_count);
+    (*env)->SetIntField(env, obj, jni.css_info.mediaQueryCount, cCssInfo->media_query_count);
+    (*env)->SetIntField(env, obj, jni.css_info.keyframeCount, cCssInfo->keyframe_count);
 
-    field = (*env)->GetFieldID(env, cls, "keyframeCount", "I");
-    (*env)->SetIntField(env, obj, field, cCssInfo->keyframe_count);
-
-    TRACE("Exiting create_css_info_object");
+    LOG_TRACE(LOG_CAT_JNI, "Exiting create_css_info_object");
     return obj;
 }
 
 // Helper function to create JS Info object
 static jobject create_js_info_object(JNIEnv *env, const JSInfo *cJsInfo) {
-    TRACE("Entering create_js_info_object");
+    LOG_TRACE(LOG_CAT_JNI, "Entering create_js_info_object");
     if (!cJsInfo) return NULL;
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return NULL;
 
-    jclass cls = (*env)->FindClass(env, "com/gdme/webpulseforecast/WebPulseForecastNative$JSInfo");
-    if (!cls) return NULL;
-
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
-    if (!obj) return NULL;
+    jobject obj = (*env)->NewObject(env, jni.js_info.cls, jni.js_info.init);
+    if (!obj) return (*env)->PopLocalFrame(env, NULL);
 
     // Set basic counts
-    jfieldID field = (*env)->GetFieldID(env, cls, "functionCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsInfo->function_count);
-
-    field = (*env)->GetFieldID(env, cls, "variableCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsInfo->variable_count);
-
-    field = (*env)->GetFieldID(env, cls, "classCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsInfo->class_count);
-
-    field = (*env)->GetFieldID(env, cls, "reactComponentCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsInfo->react_component_count);
-
-    field = (*env)->GetFieldID(env, cls, "vueInstanceCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsInfo->vue_instance_count);
-
-    field = (*env)->GetFieldID(env, cls, "angularModuleCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsInfo->angular_module_count);
-
-    field = (*env)->GetFieldID(env, cls, "eventListenerCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsInfo->event_listener_count);
-
-    field = (*env)->GetFieldID(env, cls, "asyncFunctionCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsInfo->async_function_count);
-
-    field = (*env)->GetFieldID(env, cls, "promiseCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsInfo->promise_count);
-
-    field = (*env)->GetFieldID(env, cls, "closureCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsInfo->closure_count);
+    (*env)->SetIntField(env, obj, jni.js_info.functionCount, cJsInfo->function_count);
+    (*env)->SetIntField(env, obj, jni.js_info.variableCount, cJsInfo->variable_count);
+    (*env)->SetIntField(env, obj, jni.js_info.classCount, cJsInfo->class_count);
+    (*env)->SetIntField(env, obj, jni.js_info.reactComponentCount, cJsInfo->react_component_count);
+    (*env)->SetIntField(env, obj, jni.js_info.vueInstanceCount, cJsInfo->vue_instance_count);
+    (*env)->SetIntField(env, obj, jni.js_info.angularModuleCount, cJsInfo->angular_module_count);
+    (*env)->SetIntField(env, obj, jni.js_info.eventListenerCount, cJsInfo->event_listener_count);
+    (*env)->SetIntField(env, obj, jni.js_info.asyncFunctionCount, cJsInfo->async_function_count);
+    (*env)->SetIntField(env, obj, jni.js_info.promiseCount, cJsInfo->promise_count);
+    (*env)->SetIntField(env, obj, jni.js_info.closureCount, cJsInfo->closure_count);
 
     // Set framework info
-    jobject frameworkInfo = create_framework_info_object(env, &cJsInfo->framework);
-    if (frameworkInfo) {
-        field = (*env)->GetFieldID(env, cls, "framework",
-                                   "Lcom/gdme/webpulseforecast/WebPulseForecastNative$FrameworkInfo;");
-        (*env)->SetObjectField(env, obj, field, frameworkInfo);
-        (*env)->DeleteLocalRef(env, frameworkInfo);
-    }
+    (*env)->SetObjectField(env, obj, jni.js_info.framework,
+                           create_framework_info_object(env, &cJsInfo->framework));
 
-    TRACE("Exiting create_js_info_object");
-    return obj;
+    LOG_TRACE(LOG_CAT_JNI, "Exiting create_js_info_object");
+    return (*env)->PopLocalFrame(env, obj);
 }
 
 // Helper function to create JSON Info object
 static jobject create_json_info_object(JNIEnv *env, const JSONInfo *cJsonInfo) {
-    TRACE("Entering create_json_info_object");
+    LOG_TRACE(LOG_CAT_JNI, "Entering create_json_info_object");
     if (!cJsonInfo) return NULL;
 
-    jclass cls = (*env)->FindClass(env, "com/gdme/webpulseforecast/WebPulseForecastNative$JSONInfo");
-    if (!cls) return NULL;
-
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
+    jobject obj = (*env)->NewObject(env, jni.json_info.cls, jni.json_info.init);
     if (!obj) return NULL;
 
-    jfieldID field = (*env)->GetFieldID(env, cls, "objectCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsonInfo->object_count);
+    (*env)->SetIntField(env, obj, jni.json_info.objectCount, cJsonInfo->object_count);
+    (*env)->SetIntField(env, obj, jni.json_info.arrayCount, cJsonInfo->array_count);
+    (*env)->SetIntField(env, obj, jni.json_info.keyCount, cJsonInfo->key_count);
+    (*env)->SetIntField(env, obj, jni.json_info.maxNestingLevel, cJsonInfo->max_nesting_level);
 
-    field = (*env)->GetFieldID(env, cls, "arrayCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsonInfo->array_count);
-
-    field = (*env)->GetFieldID(env, cls, "keyCount", "I");
-    (*env)->SetIntField(env, obj, field, cJsonInfo->key_count);
-
-    field = (*env)->GetFieldID(env, cls, "maxNestingLevel", "I");
-    (*env)->SetIntField(env, obj, field, cJsonInfo->max_nesting_level);
-
-    TRACE("Exiting create_json_info_object");
+    LOG_TRACE(LOG_CAT_JNI, "Exiting create_json_info_object");
     return obj;
 }
 
-// Helper function to create Dependency object
-static jobject create_dependency_object(JNIEnv *env, const Dependency *dependency) {
-    TRACE("Entering create_dependency_object");
-    if (!dependency) return NULL;
-
-    jclass cls = (*env)->FindClass(env,
-                                   "com/gdme/webpulseforecast/WebPulseForecastNative$Dependency");
-    if (!cls) return NULL;
-
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
+// Helper function to create Dependency object. Called per element inside the
+// chunk frame of create_object_array, so it leaves its strings to that frame.
+static jobject create_dependency_object(JNIEnv *env, const void *item) {
+    const Dependency *dependency = (const Dependency *)item;
+    jobject obj = (*env)->NewObject(env, jni.dependency.cls, jni.dependency.init);
     if (!obj) return NULL;
 
-    // Set name
-    jfieldID field = (*env)->GetFieldID(env, cls, "name", "Ljava/lang/String;");
-    jstring name = (*env)->NewStringUTF(env, dependency->name);
-    (*env)->SetObjectField(env, obj, field, name);
-    (*env)->DeleteLocalRef(env, name);
-
-    // Set version
-    field = (*env)->GetFieldID(env, cls, "version", "Ljava/lang/String;");
-    jstring version = (*env)->NewStringUTF(env, dependency->version);
-    (*env)->SetObjectField(env, obj, field, version);
-    (*env)->DeleteLocalRef(env, version);
-
-    // Set isDevDependency
-    field = (*env)->GetFieldID(env, cls, "isDevDependency", "Z");
-    (*env)->SetBooleanField(env, obj, field, dependency->is_dev_dependency);
-
-    TRACE("Exiting create_dependency_object");
+    (*env)->SetObjectField(env, obj, jni.dependency.name,
+                           (*env)->NewStringUTF(env, string_pool_get(dependency->name)));
+    (*env)->SetObjectField(env, obj, jni.dependency.version,
+                           (*env)->NewStringUTF(env, string_pool_get(dependency->version)));
+    (*env)->SetBooleanField(env, obj, jni.dependency.isDevDependency, dependency->is_dev_dependency);
     return obj;
 }
 
 // Helper function to create External Resource object
-static jobject create_external_resource_object(JNIEnv *env, const ExternalResource *resource) {
-    TRACE("Entering create_external_resource_object");
-    if (!resource) return NULL;
-
-    jclass cls = (*env)->FindClass(env,
-                                   "com/gdme/webpulseforecast/WebPulseForecastNative$ExternalResource");
-    if (!cls) return NULL;
-
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
+static jobject create_external_resource_object(JNIEnv *env, const void *item) {
+    const ExternalResource *resource = (const ExternalResource *)item;
+    jobject obj = (*env)->NewObject(env, jni.external_resource.cls, jni.external_resource.init);
     if (!obj) return NULL;
 
-    // Set URL
-    jfieldID field = (*env)->GetFieldID(env, cls, "url", "Ljava/lang/String;");
-    jstring url = (*env)->NewStringUTF(env, resource->url);
-    (*env)->SetObjectField(env, obj, field, url);
-    (*env)->DeleteLocalRef(env, url);
-
-    // Set type
-    field = (*env)->GetFieldID(env, cls, "type", "Ljava/lang/String;");
-    jstring type = (*env)->NewStringUTF(env, resource->type);
-    (*env)->SetObjectField(env, obj, field, type);
-    (*env)->DeleteLocalRef(env, type);
-
-    // Set size
-    field = (*env)->GetFieldID(env, cls, "size", "J");
-    (*env)->SetLongField(env, obj, field, resource->size);
-
-    TRACE("Exiting create_external_resource_object");
+    (*env)->SetObjectField(env, obj, jni.external_resource.url, (*env)->NewStringUTF(env, resource->url));
+    (*env)->SetObjectField(env, obj, jni.external_resource.type, (*env)->NewStringUTF(env, resource->type));
+    (*env)->SetLongField(env, obj, jni.external_resource.size, resource->size);
     return obj;
 }
 
 // Helper function to create a TaskGroup object
-static jobject create_task_group_object(JNIEnv *env, const TaskGroup *taskGroup) {
-    TRACE("Entering create_task_group_object");
-    if (!taskGroup) return NULL;
-
-    jclass cls = (*env)->FindClass(env,
-                                   "com/gdme/webpulseforecast/WebPulseForecastNative$TaskGroup");
-    if (!cls) return NULL;
-
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
-    if (!obj) return NULL;
+static jobject create_task_group_object(JNIEnv *env, const void *item) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering create_task_group_object");
+    const TaskGroup *taskGroup = (const TaskGroup *)item;
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return NULL;
 
-    // Set name
-    jfieldID field = (*env)->GetFieldID(env, cls, "name", "Ljava/lang/String;");
-    jstring name = (*env)->NewStringUTF(env, taskGroup->name);
-    (*env)->SetObjectField(env, obj, field, name);
-    (*env)->DeleteLocalRef(env, name);
+    jobject obj = (*env)->NewObject(env, jni.task_group.cls, jni.task_group.init);
+    if (!obj) return (*env)->PopLocalFrame(env, NULL);
 
-    // Set type
-    field = (*env)->GetFieldID(env, cls, "type", "Ljava/lang/String;");
-    jstring type = (*env)->NewStringUTF(env, taskGroup->type);
-    (*env)->SetObjectField(env, obj, field, type);
-    (*env)->DeleteLocalRef(env, type);
+    (*env)->SetObjectField(env, obj, jni.task_group.name, (*env)->NewStringUTF(env, taskGroup->name));
+    (*env)->SetObjectField(env, obj, jni.task_group.type, (*env)->NewStringUTF(env, taskGroup->type));
 
     // Create and set packages array
-    jclass stringCls = (*env)->FindClass(env, "java/lang/String");
-    jobjectArray packages = (*env)->NewObjectArray(env, taskGroup->package_count, stringCls, NULL);
+    (*env)->SetObjectField(env, obj, jni.task_group.packages,
+                           create_object_array(env, jni.string_cls, taskGroup->package_count,
+                                               taskGroup->packages, sizeof(StringId),
+                                               create_pooled_string));
+    (*env)->SetIntField(env, obj, jni.task_group.packageCount, taskGroup->package_count);
+
+    LOG_TRACE(LOG_CAT_JNI, "Exiting create_task_group_object");
+    return (*env)->PopLocalFrame(env, obj);
+}
 
-    for (int i = 0; i < taskGroup->package_count; i++) {
-        jstring pkg = (*env)->NewStringUTF(env, taskGroup->packages[i]);
-        (*env)->SetObjectArrayElement(env, packages, i, pkg);
-        (*env)->DeleteLocalRef(env, pkg);
-    }
+static jobject create_package_reference_object(JNIEnv *env, const void *item) {
+    const PackageReference *reference = (const PackageReference *)item;
+    jobject ref = (*env)->NewObject(env, jni.package_reference.cls, jni.package_reference.init);
+    if (!ref) return NULL;
 
-    field = (*env)->GetFieldID(env, cls, "packages", "[Ljava/lang/String;");
-    (*env)->SetObjectField(env, obj, field, packages);
-    (*env)->DeleteLocalRef(env, packages);
+    (*env)->SetObjectField(env, ref, jni.package_reference.source,
+                           (*env)->NewStringUTF(env, string_pool_get(reference->source)));
+    (*env)->SetObjectField(env, ref, jni.package_reference.target,
+                           (*env)->NewStringUTF(env, string_pool_get(reference->target)));
+    return ref;
+}
 
-    field = (*env)->GetFieldID(env, cls, "packageCount", "I");
-    (*env)->SetIntField(env, obj, field, taskGroup->package_count);
+static jobject create_package_script_object(JNIEnv *env, const void *item) {
+    const PackageScript *packageScript = (const PackageScript *)item;
+    jobject script = (*env)->NewObject(env, jni.package_script.cls, jni.package_script.init);
+    if (!script) return NULL;
 
-    TRACE("Exiting create_task_group_object");
-    return obj;
+    (*env)->SetObjectField(env, script, jni.package_script.scriptName,
+                           (*env)->NewStringUTF(env, string_pool_get(packageScript->script_name)));
+    (*env)->SetObjectField(env, script, jni.package_script.command,
+                           (*env)->NewStringUTF(env, string_pool_get(packageScript->command)));
+    return script;
 }
 
 static jobject create_package_config_object(JNIEnv *env, const PackageConfig *config) {
-    TRACE("Entering create_package_config_object");
+    LOG_TRACE(LOG_CAT_JNI, "Entering create_package_config_object");
     if (!config) {
-        TRACE("NULL config pointer provided");
-        return NULL;
-    }
-
-    jclass cls = (*env)->FindClass(env,
-                                   "com/gdme/webpulseforecast/WebPulseForecastNative$PackageConfig");
-    if (!cls) {
-        TRACE("Failed to find PackageConfig class");
-        return NULL;
-    }
-
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    if (!constructor) {
-        TRACE("Failed to get PackageConfig constructor");
+        LOG_TRACE(LOG_CAT_JNI, "NULL config pointer provided");
         return NULL;
     }
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return NULL;
 
-    jobject obj = (*env)->NewObject(env, cls, constructor);
+    jobject obj = (*env)->NewObject(env, jni.package_config.cls, jni.package_config.init);
     if (!obj) {
-        TRACE("Failed to create new PackageConfig object");
-        return NULL;
+        LOG_ERROR(LOG_CAT_JNI, "Failed to create new PackageConfig object");
+        return (*env)->PopLocalFrame(env, NULL);
     }
 
     // Set package references
-    jclass refCls = (*env)->FindClass(env,
-                                      "com/gdme/webpulseforecast/WebPulseForecastNative$PackageReference");
-    jobjectArray refs = (*env)->NewObjectArray(env, config->ref_count, refCls, NULL);
-
-    for (int i = 0; i < config->ref_count; i++) {
-        jobject ref = (*env)->NewObject(env, refCls,
-                                        (*env)->GetMethodID(env, refCls, "<init>", "()V"));
-
-        if (ref) {
-            // Set source
-            jfieldID field = (*env)->GetFieldID(env, refCls, "source", "Ljava/lang/String;");
-            jstring source = (*env)->NewStringUTF(env, config->refs[i].source);
-            (*env)->SetObjectField(env, ref, field, source);
-            (*env)->DeleteLocalRef(env, source);
-
-            // Set target
-            field = (*env)->GetFieldID(env, refCls, "target", "Ljava/lang/String;");
-            jstring target = (*env)->NewStringUTF(env, config->refs[i].target);
-            (*env)->SetObjectField(env, ref, field, target);
-            (*env)->DeleteLocalRef(env, target);
-
-            (*env)->SetObjectArrayElement(env, refs, i, ref);
-            (*env)->DeleteLocalRef(env, ref);
-        }
-    }
-
-    jfieldID field = (*env)->GetFieldID(env, cls, "refs",
-                                        "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$PackageReference;");
-    (*env)->SetObjectField(env, obj, field, refs);
-    (*env)->DeleteLocalRef(env, refs);
-
-    field = (*env)->GetFieldID(env, cls, "refCount", "I");
-    (*env)->SetIntField(env, obj, field, config->ref_count);
+    (*env)->SetObjectField(env, obj, jni.package_config.refs,
+                           create_object_array(env, jni.package_reference.cls, config->ref_count,
+                                               config->refs, sizeof(PackageReference),
+                                               create_package_reference_object));
+    (*env)->SetIntField(env, obj, jni.package_config.refCount, config->ref_count);
 
     // Set scripts
-    jclass scriptCls = (*env)->FindClass(env,
-                                         "com/gdme/webpulseforecast/WebPulseForecastNative$PackageScript");
-    jobjectArray scripts = (*env)->NewObjectArray(env, config->script_count, scriptCls, NULL);
-
-    for (int i = 0; i < config->script_count; i++) {
-        jobject script = (*env)->NewObject(env, scriptCls,
-                                           (*env)->GetMethodID(env, scriptCls, "<init>", "()V"));
-
-        if (script) {
-            // Set script name
-            jfieldID scriptField = (*env)->GetFieldID(env, scriptCls, "scriptName", "Ljava/lang/String;");
-            jstring scriptName = (*env)->NewStringUTF(env, config->scripts[i].script_name);
-            (*env)->SetObjectField(env, script, scriptField, scriptName);
-            (*env)->DeleteLocalRef(env, scriptName);
-
-            // Set command
-            scriptField = (*env)->GetFieldID(env, scriptCls, "command", "Ljava/lang/String;");
-            jstring command = (*env)->NewStringUTF(env, config->scripts[i].command);
-            (*env)->SetObjectField(env, script, scriptField, command);
-            (*env)->DeleteLocalRef(env, command);
-
-            (*env)->SetObjectArrayElement(env, scripts, i, script);
-            (*env)->DeleteLocalRef(env, script);
-        }
-    }
-
-    field = (*env)->GetFieldID(env, cls, "scripts",
-                               "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$PackageScript;");
-    (*env)->SetObjectField(env, obj, field, scripts);
-    (*env)->DeleteLocalRef(env, scripts);
-
-    field = (*env)->GetFieldID(env, cls, "scriptCount", "I");
-    (*env)->SetIntField(env, obj, field, config->script_count);
+    (*env)->SetObjectField(env, obj, jni.package_config.scripts,
+                           create_object_array(env, jni.package_script.cls, config->script_count,
+                                               config->scripts, sizeof(PackageScript),
+                                               create_package_script_object));
+    (*env)->SetIntField(env, obj, jni.package_config.scriptCount, config->script_count);
 
     // Set paths
-    field = (*env)->GetFieldID(env, cls, "buildOutputPath", "Ljava/lang/String;");
-    jstring buildPath = (*env)->NewStringUTF(env, config->build_output_path);
-    (*env)->SetObjectField(env, obj, field, buildPath);
-    (*env)->DeleteLocalRef(env, buildPath);
-
-    field = (*env)->GetFieldID(env, cls, "testOutputPath", "Ljava/lang/String;");
-    jstring testPath = (*env)->NewStringUTF(env, config->test_output_path);
-    (*env)->SetObjectField(env, obj, field, testPath);
-    (*env)->DeleteLocalRef(env, testPath);
+    (*env)->SetObjectField(env, obj, jni.package_config.buildOutputPath,
+                           (*env)->NewStringUTF(env, string_pool_get(config->build_output_path)));
+    (*env)->SetObjectField(env, obj, jni.package_config.testOutputPath,
+                           (*env)->NewStringUTF(env, string_pool_get(config->test_output_path)));
 
     // Set configuration flags
-    field = (*env)->GetFieldID(env, cls, "hasSharedConfigs", "Z");
-    (*env)->SetBooleanField(env, obj, field, config->has_shared_configs);
+    (*env)->SetBooleanField(env, obj, jni.package_config.hasSharedConfigs, config->has_shared_configs);
+    (*env)->SetBooleanField(env, obj, jni.package_config.usesTypescript, config->uses_typescript);
+    (*env)->SetBooleanField(env, obj, jni.package_config.usesEslint, config->uses_eslint);
+    (*env)->SetBooleanField(env, obj, jni.package_config.usesPrettier, config->uses_prettier);
+    (*env)->SetBooleanField(env, obj, jni.package_config.usesJest, config->uses_jest);
 
-    field = (*env)->GetFieldID(env, cls, "usesTypescript", "Z");
-    (*env)->SetBooleanField(env, obj, field, config->uses_typescript);
+    // Set Node version
+    (*env)->SetObjectField(env, obj, jni.package_config.nodeVersion,
+                           (*env)->NewStringUTF(env, string_pool_get(config->node_version)));
 
-    field = (*env)->GetFieldID(env, cls, "usesEslint", "Z");
-    (*env)->SetBooleanField(env, obj, field, config->uses_eslint);
+    LOG_TRACE(LOG_CAT_JNI, "Exiting create_package_config_object");
+    return (*env)->PopLocalFrame(env, obj);
+}
 
-    field = (*env)->GetFieldID(env, cls, "usesPrettier", "Z");
-    (*env)->SetBooleanField(env, obj, field, config->uses_prettier);
+// Helper function to create Dependency List object. Takes the entries rather
+// than a DependencyList since packages keep theirs in the workspace arena.
+static jobject create_dependency_list_object(JNIEnv *env, const Dependency *items, int count) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering create_dependency_list_object");
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return NULL;
 
-    field = (*env)->GetFieldID(env, cls, "usesJest", "Z");
-    (*env)->SetBooleanField(env, obj, field, config->uses_jest);
+    jobject obj = (*env)->NewObject(env, jni.dependency_list.cls, jni.dependency_list.init);
+    if (!obj) return (*env)->PopLocalFrame(env, NULL);
 
-    // Set Node version
-    field = (*env)->GetFieldID(env, cls, "nodeVersion", "Ljava/lang/String;");
-    jstring nodeVersion = (*env)->NewStringUTF(env, config->node_version);
-    (*env)->SetObjectField(env, obj, field, nodeVersion);
-    (*env)->DeleteLocalRef(env, nodeVersion);
+    (*env)->SetIntField(env, obj, jni.dependency_list.count, count);
+    (*env)->SetObjectField(env, obj, jni.dependency_list.items,
+                           create_object_array(env, jni.dependency.cls, count, items, sizeof(Dependency),
+                                               create_dependency_object));
 
-    TRACE("Exiting create_package_config_object");
-    return obj;
+    LOG_TRACE(LOG_CAT_JNI, "Exiting create_dependency_list_object");
+    return (*env)->PopLocalFrame(env, obj);
 }
 
-// Helper function to create Dependency List object
-static jobject create_dependency_list_object(JNIEnv *env, const DependencyList *dependencies) {
-    TRACE("Entering create_dependency_list_object");
-    if (!dependencies) return NULL;
+// Helper function to create a Package object
+static jobject create_package_object(JNIEnv *env, const void *item) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering create_package_object");
+    const Package *package = (const Package *)item;
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return NULL;
 
-    jclass cls = (*env)->FindClass(env,
-                                   "com/gdme/webpulseforecast/WebPulseForecastNative$DependencyList");
-    if (!cls) return NULL;
+    jobject obj = (*env)->NewObject(env, jni.package.cls, jni.package.init);
+    if (!obj) return (*env)->PopLocalFrame(env, NULL);
 
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
-    if (!obj) return NULL;
+    // Set basic fields
+    (*env)->SetObjectField(env, obj, jni.package.name,
+                           (*env)->NewStringUTF(env, string_pool_get(package->name)));
+    (*env)->SetObjectField(env, obj, jni.package.version,
+                           (*env)->NewStringUTF(env, string_pool_get(package->version)));
+    (*env)->SetObjectField(env, obj, jni.package.path,
+                           (*env)->NewStringUTF(env, string_pool_get(package->path)));
+
+    // Set dependencies, framework info and config
+    (*env)->SetObjectField(env, obj, jni.package.dependencies,
+                           create_dependency_list_object(env, package->dependencies, package->dependency_count));
+    (*env)->SetObjectField(env, obj, jni.package.frameworkInfo,
+                           create_framework_info_object(env, &package->framework_info));
+    (*env)->SetObjectField(env, obj, jni.package.config,
+                           create_package_config_object(env, &package->config));
+
+    LOG_TRACE(LOG_CAT_JNI, "Exiting create_package_object");
+    return (*env)->PopLocalFrame(env, obj);
+}
 
-    // Set count
-    jfieldID field = (*env)->GetFieldID(env, cls, "count", "I");
-    (*env)->SetIntField(env, obj, field, dependencies->count);
+// Main function to create workspace info object. Packages are left null unless
+// with_packages is set; getWorkspacePackage fetches them one at a time.
+static jobject create_workspace_info_object(JNIEnv *env, const WorkspaceInfo *workspace, int with_packages) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering create_workspace_info_object");
+    if (!workspace) return NULL;
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return NULL;
 
-    // Create and set dependencies array
-    jclass depCls = (*env)->FindClass(env,
-                                      "com/gdme/webpulseforecast/WebPulseForecastNative$Dependency");
-    jobjectArray items = (*env)->NewObjectArray(env, dependencies->count, depCls, NULL);
+    jobject obj = (*env)->NewObject(env, jni.workspace_info.cls, jni.workspace_info.init);
+    if (!obj) return (*env)->PopLocalFrame(env, NULL);
 
-    for (int i = 0; i < dependencies->count; i++) {
-        jobject dep = create_dependency_object(env, &dependencies->items[i]);
-        if (dep) {
-            (*env)->SetObjectArrayElement(env, items, i, dep);
-            (*env)->DeleteLocalRef(env, dep);
-        }
+    // Set root path and name
+    (*env)->SetObjectField(env, obj, jni.workspace_info.rootPath, (*env)->NewStringUTF(env, workspace->root_path));
+    (*env)->SetObjectField(env, obj, jni.workspace_info.name, (*env)->NewStringUTF(env, workspace->name));
+
+    // Create and set packages array, one frame per chunk of packages
+    if (with_packages) {
+        (*env)->SetObjectField(env, obj, jni.workspace_info.packages,
+                               create_object_array(env, jni.package.cls, workspace->package_count,
+                                                   workspace->packages, sizeof(Package),
+                                                   create_package_object));
     }
+    (*env)->SetIntField(env, obj, jni.workspace_info.packageCount, workspace->package_count);
 
-    field = (*env)->GetFieldID(env, cls, "items",
-                               "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$Dependency;");
-    (*env)->SetObjectField(env, obj, field, items);
-    (*env)->DeleteLocalRef(env, items);
+    // Set shared dependencies
+    (*env)->SetObjectField(env, obj, jni.workspace_info.sharedDependencies,
+                           create_dependency_list_object(env, workspace->shared_dependencies.items,
+                                                         workspace->shared_dependencies.count));
 
-    TRACE("Exiting create_dependency_list_object");
-    return obj;
-}
+    // Create and set workspace globs array
+    (*env)->SetObjectField(env, obj, jni.workspace_info.workspaceGlobs,
+                           create_object_array(env, jni.string_cls, workspace->workspace_count,
+                                               workspace->workspace_globs, sizeof(StringId),
+                                               create_pooled_string));
 
-// Helper function to create a Package object
-static jobject create_package_object(JNIEnv *env, const Package *package) {
-    TRACE("Entering create_package_object");
-    if (!package) return NULL;
+    // Set all boolean flags
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.isLerna, workspace->is_lerna);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.isYarnWorkspace, workspace->is_yarn_workspace);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.isPnpmWorkspace, workspace->is_pnpm_workspace);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.isNxWorkspace, workspace->is_nx_workspace);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.isRush, workspace->is_rush);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.hasHoisting, workspace->has_hoisting);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.hasWorkspacesPrefix, workspace->has_workspaces_prefix);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.usesNpmWorkspaces, workspace->uses_npm_workspaces);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.usesChangesets, workspace->uses_changesets);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.usesTurborepo, workspace->uses_turborepo);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.hasSharedConfigs, workspace->has_shared_configs);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.usesConventionalCommits, workspace->uses_conventional_commits);
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.usesGitTags, workspace->uses_git_tags);
 
-    jclass cls = (*env)->FindClass(env,
-                                   "com/gdme/webpulseforecast/WebPulseForecastNative$Package");
-    if (!cls) return NULL;
+    // Create and set task groups array
+    (*env)->SetObjectField(env, obj, jni.workspace_info.taskGroups,
+                           create_object_array(env, jni.task_group.cls, workspace->task_group_count,
+                                               workspace->task_groups, sizeof(TaskGroup),
+                                               create_task_group_object));
 
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
-    if (!obj) return NULL;
+    // Set configuration paths
+    (*env)->SetObjectField(env, obj, jni.workspace_info.buildCachePath,
+                           (*env)->NewStringUTF(env, workspace->build_cache_path));
+    (*env)->SetObjectField(env, obj, jni.workspace_info.tsconfigPath,
+                           (*env)->NewStringUTF(env, workspace->tsconfig_path));
+    (*env)->SetObjectField(env, obj, jni.workspace_info.eslintConfigPath,
+                           (*env)->NewStringUTF(env, workspace->eslint_config_path));
+    (*env)->SetObjectField(env, obj, jni.workspace_info.prettierConfigPath,
+                           (*env)->NewStringUTF(env, workspace->prettier_config_path));
+    (*env)->SetObjectField(env, obj, jni.workspace_info.jestConfigPath,
+                           (*env)->NewStringUTF(env, workspace->jest_config_path));
+    (*env)->SetObjectField(env, obj, jni.workspace_info.babelConfigPath,
+                           (*env)->NewStringUTF(env, workspace->babel_config_path));
 
-    // Set basic fields
-    jfieldID field = (*env)->GetFieldID(env, cls, "name", "Ljava/lang/String;");
-    jstring name = (*env)->NewStringUTF(env, package->name);
-    (*env)->SetObjectField(env, obj, field, name);
-    (*env)->DeleteLocalRef(env, name);
-
-    field = (*env)->GetFieldID(env, cls, "version", "Ljava/lang/String;");
-    jstring version = (*env)->NewStringUTF(env, package->version);
-    (*env)->SetObjectField(env, obj, field, version);
-    (*env)->DeleteLocalRef(env, version);
-
-    field = (*env)->GetFieldID(env, cls, "path", "Ljava/lang/String;");
-    jstring path = (*env)->NewStringUTF(env, package->path);
-    (*env)->SetObjectField(env, obj, field, path);
-    (*env)->DeleteLocalRef(env, path);
-
-    // Set dependencies
-    jobject dependencies = create_dependency_list_object(env, &package->dependencies);
-    if (dependencies) {
-        field = (*env)->GetFieldID(env, cls, "dependencies",
-                                   "Lcom/gdme/webpulseforecast/WebPulseForecastNative$DependencyList;");
-        (*env)->SetObjectField(env, obj, field, dependencies);
-        (*env)->DeleteLocalRef(env, dependencies);
-    }
+    // Set version management info
+    (*env)->SetObjectField(env, obj, jni.workspace_info.versionStrategy,
+                           (*env)->NewStringUTF(env, workspace->version_strategy));
+    (*env)->SetBooleanField(env, obj, jni.workspace_info.usesSemanticRelease, workspace->uses_semantic_release);
 
-    // Set framework info
-    jobject frameworkInfo = create_framework_info_object(env, &package->framework_info);
-    if (frameworkInfo) {
-        field = (*env)->GetFieldID(env, cls, "frameworkInfo",
-                                   "Lcom/gdme/webpulseforecast/WebPulseForecastNative$FrameworkInfo;");
-        (*env)->SetObjectField(env, obj, field, frameworkInfo);
-        (*env)->DeleteLocalRef(env, frameworkInfo);
-    }
+    LOG_TRACE(LOG_CAT_JNI, "Exiting create_workspace_info_object");
+    return (*env)->PopLocalFrame(env, obj);
+}
 
-    // Set package config
-    jobject config = create_package_config_object(env, &package->config);
-    if (config) {
-        field = (*env)->GetFieldID(env, cls, "config",
-                                   "Lcom/gdme/webpulseforecast/WebPulseForecastNative$PackageConfig;");
-        (*env)->SetObjectField(env, obj, field, config);
-        (*env)->DeleteLocalRef(env, config);
+// Builds a ProjectType Java object. With sections unset only the headline
+// fields are filled: workspace packages, dependency lists, custom elements,
+// external resources and module paths stay null for the handle accessors.
+static jobject build_project_type_object(JNIEnv *env, const ProjectType *project, int sections) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering build_project_type_object");
+    PROFILE_START(conversion_mark);
+
+    if (!project) {
+        LOG_TRACE(LOG_CAT_JNI, "NULL project pointer provided");
+        return NULL;
     }
+    if ((*env)->PushLocalFrame(env, JNI_OBJECT_FRAME) != 0) return NULL;
 
-    TRACE("Exiting create_package_object");
-    return obj;
-}
+    jobject obj = (*env)->NewObject(env, jni.project_type.cls, jni.project_type.init);
+    if (obj == NULL) {
+        LOG_ERROR(LOG_CAT_JNI, "Failed to create new ProjectType object");
+        return (*env)->PopLocalFrame(env, NULL);
+    }
 
-// Main function to create workspace info object
-static jobject create_workspace_info_object(JNIEnv *env, const WorkspaceInfo *workspace) {
-    TRACE("Entering create_workspace_info_object");
-    if (!workspace) return NULL;
+    // Set framework info
+    (*env)->SetObjectField(env, obj, jni.project_type.frameworkInfo,
+                           create_framework_info_object(env, &project->framework_info));
 
-    jclass cls = (*env)->FindClass(env,
-                                   "com/gdme/webpulseforecast/WebPulseForecastNative$WorkspaceInfo");
-    if (!cls) return NULL;
+    // Set basic framework field (legacy)
+    (*env)->SetObjectField(env, obj, jni.project_type.framework, (*env)->NewStringUTF(env, project->framework));
 
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
-    if (!obj) return NULL;
+    // Set file counts
+    (*env)->SetIntField(env, obj, jni.project_type.htmlFileCount, project->html_file_count);
+    (*env)->SetIntField(env, obj, jni.project_type.cssFileCount, project->css_file_count);
+    (*env)->SetIntField(env, obj, jni.project_type.jsFileCount, project->js_file_count);
+    (*env)->SetIntField(env, obj, jni.project_type.jsonFileCount, project->json_file_count);
+    (*env)->SetIntField(env, obj, jni.project_type.tsFileCount, project->ts_file_count);
+    (*env)->SetIntField(env, obj, jni.project_type.jsxFileCount, project->jsx_file_count);
+    (*env)->SetIntField(env, obj, jni.project_type.vueFileCount, project->vue_file_count);
+    (*env)->SetIntField(env, obj, jni.project_type.xmlFileCount, project->xml_file_count);
+    (*env)->SetIntField(env, obj, jni.project_type.imageFileCount, project->image_file_count);
 
-    // Set root path
-    jfieldID field = (*env)->GetFieldID(env, cls, "rootPath", "Ljava/lang/String;");
-    jstring rootPath = (*env)->NewStringUTF(env, workspace->root_path);
-    (*env)->SetObjectField(env, obj, field, rootPath);
-    (*env)->DeleteLocalRef(env, rootPath);
+    // Set component tracking
+    (*env)->SetIntField(env, obj, jni.project_type.reactComponentCount, project->react_component_count);
+    (*env)->SetIntField(env, obj, jni.project_type.customElementCount, project->custom_element_count);
 
-    // Set name
-    field = (*env)->GetFieldID(env, cls, "name", "Ljava/lang/String;");
-    jstring name = (*env)->NewStringUTF(env, workspace->name);
-    (*env)->SetObjectField(env, obj, field, name);
-    (*env)->DeleteLocalRef(env, name);
+    // Set parser results
+    (*env)->SetObjectField(env, obj, jni.project_type.totalHtmlInfo,
+                           create_html_info_object(env, &project->total_html_info, sections));
+    (*env)->SetObjectField(env, obj, jni.project_type.totalCssInfo,
+                           create_css_info_object(env, &project->total_css_info));
+    (*env)->SetObjectField(env, obj, jni.project_type.totalJsInfo,
+                           create_js_info_object(env, &project->total_js_info));
+    (*env)->SetObjectField(env, obj, jni.project_type.totalJsonInfo,
+                           create_json_info_object(env, &project->total_json_info));
 
-    // Create and set packages array
-    jclass packageCls = (*env)->FindClass(env,
-                                          "com/gdme/webpulseforecast/WebPulseForecastNative$Package");
-    jobjectArray packages = (*env)->NewObjectArray(env, workspace->package_count, packageCls, NULL);
-
-    for (int i = 0; i < workspace->package_count; i++) {
-        jobject pkg = create_package_object(env, &workspace->packages[i]);
-        if (pkg) {
-            (*env)->SetObjectArrayElement(env, packages, i, pkg);
-            (*env)->DeleteLocalRef(env, pkg);
-        }
+    // Create and set external resources array
+    (*env)->SetIntField(env, obj, jni.project_type.externalResourceCount, project->external_resource_count);
+    if (sections) {
+        (*env)->SetObjectField(env, obj, jni.project_type.externalResources,
+                               create_object_array(env, jni.external_resource.cls, project->external_resource_count,
+                                                   project->external_resources, sizeof(ExternalResource),
+                                                   create_external_resource_object));
     }
 
-    field = (*env)->GetFieldID(env, cls, "packages",
-                               "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$Package;");
-    (*env)->SetObjectField(env, obj, field, packages);
-    (*env)->DeleteLocalRef(env, packages);
-
-    // Set shared dependencies
-    jobject sharedDeps = create_dependency_list_object(env, &workspace->shared_dependencies);
-    if (sharedDeps) {
-        field = (*env)->GetFieldID(env, cls, "sharedDependencies",
-                                   "Lcom/gdme/webpulseforecast/WebPulseForecastNative$DependencyList;");
-        (*env)->SetObjectField(env, obj, field, sharedDeps);
-        (*env)->DeleteLocalRef(env, sharedDeps);
+    // Set workspace info
+    if (project->is_monorepo) {
+        (*env)->SetObjectField(env, obj, jni.project_type.workspaceInfo,
+                               create_workspace_info_object(env, &project->workspace, sections));
     }
 
-    // Create and set workspace globs array
-    jclass stringCls = (*env)->FindClass(env, "java/lang/String");
-    jobjectArray globs = (*env)->NewObjectArray(env, workspace->workspace_count, stringCls, NULL);
-
-    for (int i = 0; i < workspace->workspace_count; i++) {
-        jstring glob = (*env)->NewStringUTF(env, workspace->workspace_globs[i]);
-        (*env)->SetObjectArrayElement(env, globs, i, glob);
-        (*env)->DeleteLocalRef(env, glob);
+    // Set dependencies and module paths
+    (*env)->SetIntField(env, obj, jni.project_type.modulePathCount, project->module_path_count);
+    if (sections) {
+        (*env)->SetObjectField(env, obj, jni.project_type.dependencies,
+                               create_dependency_list_object(env, project->dependencies.items,
+                                                             project->dependencies.count));
+        (*env)->SetObjectField(env, obj, jni.project_type.modulePaths,
+                               create_object_array(env, jni.string_cls, project->module_path_count,
+                                                   project->module_paths, sizeof(StringId),
+                                                   create_pooled_string));
     }
 
-    field = (*env)->GetFieldID(env, cls, "workspaceGlobs", "[Ljava/lang/String;");
-    (*env)->SetObjectField(env, obj, field, globs);
-    (*env)->DeleteLocalRef(env, globs);
-
-    // Set all boolean flags
-    field = (*env)->GetFieldID(env, cls, "isLerna", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->is_lerna);
-
-    field = (*env)->GetFieldID(env, cls, "isYarnWorkspace", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->is_yarn_workspace);
-
-    field = (*env)->GetFieldID(env, cls, "isPnpmWorkspace", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->is_pnpm_workspace);
-
-    field = (*env)->GetFieldID(env, cls, "isNxWorkspace", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->is_nx_workspace);
-
-    field = (*env)->GetFieldID(env, cls, "isRush", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->is_rush);
-
-    field = (*env)->GetFieldID(env, cls, "hasHoisting", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->has_hoisting);
+    // Set flags
+    (*env)->SetBooleanField(env, obj, jni.project_type.usesCommonjs, project->uses_commonjs);
+    (*env)->SetBooleanField(env, obj, jni.project_type.usesEsmodules, project->uses_esmodules);
+    (*env)->SetBooleanField(env, obj, jni.project_type.hasWebpack, project->has_webpack);
+    (*env)->SetBooleanField(env, obj, jni.project_type.hasVite, project->has_vite);
+    (*env)->SetBooleanField(env, obj, jni.project_type.hasBabel, project->has_babel);
+    (*env)->SetBooleanField(env, obj, jni.project_type.hasCi, project->has_ci);
+    (*env)->SetBooleanField(env, obj, jni.project_type.hasEnvConfig, project->has_env_config);
+    (*env)->SetBooleanField(env, obj, jni.project_type.hasTypescript, project->has_typescript);
+    (*env)->SetBooleanField(env, obj, jni.project_type.isMonorepo, project->is_monorepo);
+
+    // Partial results from a cancelled or expired analysis
+    (*env)->SetBooleanField(env, obj, jni.project_type.isIncomplete, project->is_incomplete);
+    (*env)->SetDoubleField(env, obj, jni.project_type.coverage, project->coverage);
+
+    PROFILE_END(PROFILE_PHASE_JNI_CONVERSION, conversion_mark, 0, 1);
+    LOG_TRACE(LOG_CAT_JNI, "Exiting build_project_type_object");
+    return (*env)->PopLocalFrame(env, obj);
+}
 
-    field = (*env)->GetFieldID(env, cls, "hasWorkspacesPrefix", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->has_workspaces_prefix);
+// Helper function to create a complete ProjectType Java object
+jobject create_project_type_object(JNIEnv *env, const ProjectType *project) {
+    return build_project_type_object(env, project, 1);
+}
 
-    field = (*env)->GetFieldID(env, cls, "usesNpmWorkspaces", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->uses_npm_workspaces);
+// Helper function to create a ResourceEstimation Java object
+jobject create_resource_estimation_object(JNIEnv *env, const ResourceEstimation *estimation) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering jobject create_resource_estimation_object");
+    jobject obj = (*env)->NewObject(env, jni.resource_estimation.cls, jni.resource_estimation.init);
 
-    field = (*env)->GetFieldID(env, cls, "usesChangesets", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->uses_changesets);
+    // Set fields
+    (*env)->SetLongField(env, obj, jni.resource_estimation.jsHeapSize, estimation->js_heap_size);
+    (*env)->SetLongField(env, obj, jni.resource_estimation.transferredData, estimation->transferred_data);
+    (*env)->SetLongField(env, obj, jni.resource_estimation.resourceSize, estimation->resource_size);
+    (*env)->SetIntField(env, obj, jni.resource_estimation.domContentLoaded, estimation->dom_content_loaded);
+    (*env)->SetIntField(env, obj, jni.resource_estimation.largestContentfulPaint, estimation->largest_contentful_paint);
 
-    field = (*env)->GetFieldID(env, cls, "usesTurborepo", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->uses_turborepo);
+    LOG_TRACE(LOG_CAT_JNI, "Exiting jobject create_resource_estimation_object");
+    return obj;
+}
 
-    field = (*env)->GetFieldID(env, cls, "hasSharedConfigs", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->has_shared_configs);
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectType
+        (JNIEnv *env, jobject obj, jstring projectPath) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectType");
+    const char *path = (*env)->GetStringUTFChars(env, projectPath, 0);
 
-    field = (*env)->GetFieldID(env, cls, "usesConventionalCommits", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->uses_conventional_commits);
+    // Call analyze_project_type, which now returns a pointer
+    ProjectType *project = analyze_project_type(path);
 
-    field = (*env)->GetFieldID(env, cls, "usesGitTags", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->uses_git_tags);
+    (*env)->ReleaseStringUTFChars(env, projectPath, path);
 
-    // Create and set task groups array
-    jclass taskGroupCls = (*env)->FindClass(env,
-                                            "com/gdme/webpulseforecast/WebPulseForecastNative$TaskGroup");
-    jobjectArray taskGroups = (*env)->NewObjectArray(env, workspace->task_group_count, taskGroupCls, NULL);
-
-    for (int i = 0; i < workspace->task_group_count; i++) {
-        jobject group = create_task_group_object(env, &workspace->task_groups[i]);
-        if (group) {
-            (*env)->SetObjectArrayElement(env, taskGroups, i, group);
-            (*env)->DeleteLocalRef(env, group);
-        }
+    if (!project) {
+        // Handle the case where analyze_project_type failed
+        return NULL;
     }
 
-    field = (*env)->GetFieldID(env, cls, "taskGroups",
-                               "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$TaskGroup;");
-    (*env)->SetObjectField(env, obj, field, taskGroups);
-    (*env)->DeleteLocalRef(env, taskGroups);
-
-    // Set configuration paths
-    field = (*env)->GetFieldID(env, cls, "buildCachePath", "Ljava/lang/String;");
-    jstring buildCache = (*env)->NewStringUTF(env, workspace->build_cache_path);
-    (*env)->SetObjectField(env, obj, field, buildCache);
-    (*env)->DeleteLocalRef(env, buildCache);
-
-    field = (*env)->GetFieldID(env, cls, "tsconfigPath", "Ljava/lang/String;");
-    jstring tsconfig = (*env)->NewStringUTF(env, workspace->tsconfig_path);
-    (*env)->SetObjectField(env, obj, field, tsconfig);
-    (*env)->DeleteLocalRef(env, tsconfig);
-
-    field = (*env)->GetFieldID(env, cls, "eslintConfigPath", "Ljava/lang/String;");
-    jstring eslint = (*env)->NewStringUTF(env, workspace->eslint_config_path);
-    (*env)->SetObjectField(env, obj, field, eslint);
-    (*env)->DeleteLocalRef(env, eslint);
-
-    field = (*env)->GetFieldID(env, cls, "prettierConfigPath", "Ljava/lang/String;");
-    jstring prettier = (*env)->NewStringUTF(env, workspace->prettier_config_path);
-    (*env)->SetObjectField(env, obj, field, prettier);
-    (*env)->DeleteLocalRef(env, prettier);
-
-    field = (*env)->GetFieldID(env, cls, "jestConfigPath", "Ljava/lang/String;");
-    jstring jest = (*env)->NewStringUTF(env, workspace->jest_config_path);
-    (*env)->SetObjectField(env, obj, field, jest);
-    (*env)->DeleteLocalRef(env, jest);
-
-    field = (*env)->GetFieldID(env, cls, "babelConfigPath", "Ljava/lang/String;");
-    jstring babel = (*env)->NewStringUTF(env, workspace->babel_config_path);
-    (*env)->SetObjectField(env, obj, field, babel);
-    (*env)->DeleteLocalRef(env, babel);
-
-    // Set version management info
-    field = (*env)->GetFieldID(env, cls, "versionStrategy", "Ljava/lang/String;");
-    jstring strategy = (*env)->NewStringUTF(env, workspace->version_strategy);
-    (*env)->SetObjectField(env, obj, field, strategy);
-    (*env)->DeleteLocalRef(env, strategy);
+    jobject result = create_project_type_object(env, project);
 
-    field = (*env)->GetFieldID(env, cls, "usesSemanticRelease", "Z");
-    (*env)->SetBooleanField(env, obj, field, workspace->uses_semantic_release);
+    // Free the memory allocated for ProjectType
+    free_project_type(project);
 
-    TRACE("Exiting create_workspace_info_object");
-    return obj;
+    LOG_TRACE(LOG_CAT_JNI, "Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectType");
+    return result;
 }
 
-// Helper function to create a ProjectType Java object
-jobject create_project_type_object(JNIEnv *env, const ProjectType *project) {
-    TRACE("Entering create_project_type_object");
-    static jclass cls = NULL;
-    static jmethodID constructor = NULL;
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectTypeWithTimeout
+        (JNIEnv *env, jobject obj, jstring projectPath, jdouble timeoutSeconds) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectTypeWithTimeout");
+    const char *path = (*env)->GetStringUTFChars(env, projectPath, 0);
 
-    if (!project) {
-        TRACE("NULL project pointer provided");
-        return NULL;
-    }
+    AnalysisOptions options = {0};
+    options.timeout_seconds = timeoutSeconds;
+    ProjectType *project = analyze_project_type_ex(path, &options);
 
-    if (cls == NULL) {
-        cls = (*env)->FindClass(env, "com/gdme/webpulseforecast/WebPulseForecastNative$ProjectType");
-        if (cls == NULL) {
-            TRACE("Failed to find ProjectType class");
-            return NULL;
-        }
-        cls = (*env)->NewGlobalRef(env, cls);
-        constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-        if (constructor == NULL) {
-            TRACE("Failed to get constructor");
-            return NULL;
-        }
-    }
+    (*env)->ReleaseStringUTFChars(env, projectPath, path);
 
-    jobject obj = (*env)->NewObject(env, cls, constructor);
-    if (obj == NULL) {
-        TRACE("Failed to create new ProjectType object");
+    if (!project) {
         return NULL;
     }
 
-    // Set framework info
-    jobject frameworkInfo = create_framework_info_object(env, &project->framework_info);
-    if (frameworkInfo) {
-        jfieldID field = (*env)->GetFieldID(env, cls, "frameworkInfo",
-                                            "Lcom/gdme/webpulseforecast/WebPulseForecastNative$FrameworkInfo;");
-        (*env)->SetObjectField(env, obj, field, frameworkInfo);
-        (*env)->DeleteLocalRef(env, frameworkInfo);
-    }
-
-    // Set basic framework field (legacy)
-    jfieldID field = (*env)->GetFieldID(env, cls, "framework", "Ljava/lang/String;");
-    jstring frameworkString = (*env)->NewStringUTF(env, project->framework);
-    (*env)->SetObjectField(env, obj, field, frameworkString);
-    (*env)->DeleteLocalRef(env, frameworkString);
-
-    // Set file counts
-    field = (*env)->GetFieldID(env, cls, "htmlFileCount", "I");
-    (*env)->SetIntField(env, obj, field, project->html_file_count);
-
-    field = (*env)->GetFieldID(env, cls, "cssFileCount", "I");
-    (*env)->SetIntField(env, obj, field, project->css_file_count);
-
-    field = (*env)->GetFieldID(env, cls, "jsFileCount", "I");
-    (*env)->SetIntField(env, obj, field, project->js_file_count);
-
-    field = (*env)->GetFieldID(env, cls, "jsonFileCount", "I");
-    (*env)->SetIntField(env, obj, field, project->json_file_count);
+    // Past the deadline this is a partial result with isIncomplete set
+    jobject result = create_project_type_object(env, project);
+    free_project_type(project);
 
-    field = (*env)->GetFieldID(env, cls, "tsFileCount", "I");
-    (*env)->SetIntField(env, obj, field, project->ts_file_count);
+    LOG_TRACE(LOG_CAT_JNI, "Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectTypeWithTimeout");
+    return result;
+}
 
-    field = (*env)->GetFieldID(env, cls, "jsxFileCount", "I");
-    (*env)->SetIntField(env, obj, field, project->jsx_file_count);
+// Native threads that call into Java, such as pool workers and the analysis
+// thread, are attached once as daemons and stay attached until they exit. A
+// thread-local key marks them, and its destructor does the detaching.
+#ifdef _WIN32
+static DWORD env_key = FLS_OUT_OF_INDEXES;
+static INIT_ONCE env_key_once = INIT_ONCE_STATIC_INIT;
 
-    field = (*env)->GetFieldID(env, cls, "vueFileCount", "I");
-    (*env)->SetIntField(env, obj, field, project->vue_file_count);
+static void WINAPI detach_thread(void *value) {
+    if (value) (*jni.vm)->DetachCurrentThread(jni.vm);
+}
 
-    field = (*env)->GetFieldID(env, cls, "xmlFileCount", "I");
-    (*env)->SetIntField(env, obj, field, project->xml_file_count);
+static BOOL CALLBACK create_env_key(PINIT_ONCE once, void *param, void **context) {
+    env_key = FlsAlloc(detach_thread);
+    return TRUE;
+}
 
-    field = (*env)->GetFieldID(env, cls, "imageFileCount", "I");
-    (*env)->SetIntField(env, obj, field, project->image_file_count);
+static int env_key_init(void) {
+    InitOnceExecuteOnce(&env_key_once, create_env_key, NULL, NULL);
+    return env_key != FLS_OUT_OF_INDEXES;
+}
 
-    // Set component tracking
-    field = (*env)->GetFieldID(env, cls, "reactComponentCount", "I");
-    (*env)->SetIntField(env, obj, field, project->react_component_count);
+#define ENV_KEY_GET() FlsGetValue(env_key)
+#define ENV_KEY_SET(value) FlsSetValue(env_key, value)
+#else
+static pthread_key_t env_key;
+static pthread_once_t env_key_once = PTHREAD_ONCE_INIT;
+static int env_key_ready;
 
-    field = (*env)->GetFieldID(env, cls, "customElementCount", "I");
-    (*env)->SetIntField(env, obj, field, project->custom_element_count);
+static void detach_thread(void *value) {
+    (*jni.vm)->DetachCurrentThread(jni.vm);
+}
 
-    // Set parser results
-    // HTML Info
-    jobject htmlInfo = create_html_info_object(env, &project->total_html_info);
-    if (htmlInfo) {
-        field = (*env)->GetFieldID(env, cls, "totalHtmlInfo",
-                                   "Lcom/gdme/webpulseforecast/WebPulseForecastNative$HTMLInfo;");
-        (*env)->SetObjectField(env, obj, field, htmlInfo);
-        (*env)->DeleteLocalRef(env, htmlInfo);
-    }
-
-    // CSS Info
-    jobject cssInfo = create_css_info_object(env, &project->total_css_info);
-    if (cssInfo) {
-        field = (*env)->GetFieldID(env, cls, "totalCssInfo",
-                                   "Lcom/gdme/webpulseforecast/WebPulseForecastNative$CSSInfo;");
-        (*env)->SetObjectField(env, obj, field, cssInfo);
-        (*env)->DeleteLocalRef(env, cssInfo);
-    }
-
-    // JS Info
-    jobject jsInfo = create_js_info_object(env, &project->total_js_info);
-    if (jsInfo) {
-        field = (*env)->GetFieldID(env, cls, "totalJsInfo",
-                                   "Lcom/gdme/webpulseforecast/WebPulseForecastNative$JSInfo;");
-        (*env)->SetObjectField(env, obj, field, jsInfo);
-        (*env)->DeleteLocalRef(env, jsInfo);
-    }
-
-    // JSON Info
-    jobject jsonInfo = create_json_info_object(env, &project->total_json_info);
-    if (jsonInfo) {
-        field = (*env)->GetFieldID(env, cls, "totalJsonInfo",
-                                   "Lcom/gdme/webpulseforecast/WebPulseForecastNative$JSONInfo;");
-        (*env)->SetObjectField(env, obj, field, jsonInfo);
-        (*env)->DeleteLocalRef(env, jsonInfo);
-    }
+static void create_env_key(void) {
+    env_key_ready = pthread_key_create(&env_key, detach_thread) == 0;
+}
 
-    // Create and set external resources array
-    jclass externalResourceCls = (*env)->FindClass(env,
-                                                   "com/gdme/webpulseforecast/WebPulseForecastNative$ExternalResource");
-    jobjectArray externalResources = (*env)->NewObjectArray(env,
-                                                            project->external_resource_count, externalResourceCls, NULL);
+static int env_key_init(void) {
+    pthread_once(&env_key_once, create_env_key);
+    return env_key_ready;
+}
 
-    for (int i = 0; i < project->external_resource_count; i++) {
-        jobject resource = create_external_resource_object(env, &project->external_resources[i]);
-        (*env)->SetObjectArrayElement(env, externalResources, i, resource);
-        (*env)->DeleteLocalRef(env, resource);
+#define ENV_KEY_GET() pthread_getspecific(env_key)
+#define ENV_KEY_SET(value) pthread_setspecific(env_key, value)
+#endif
+
+// Returns the calling thread's JNIEnv, attaching a native thread the first
+// time it calls in. *native is set for the threads attached this way; no Java
+// frame on them will ever see a pending exception.
+static JNIEnv *java_env(int *native) {
+    JNIEnv *env = NULL;
+    *native = 0;
+    jint status = (*jni.vm)->GetEnv(jni.vm, (void **)&env, JNI_VERSION_1_6);
+    if (status == JNI_OK) {
+        *native = env_key_init() && ENV_KEY_GET() != NULL;
+        return env;
     }
+    if (status != JNI_EDETACHED || !env_key_init()) return NULL;
 
-    field = (*env)->GetFieldID(env, cls, "externalResources",
-                               "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$ExternalResource;");
-    (*env)->SetObjectField(env, obj, field, externalResources);
-    (*env)->DeleteLocalRef(env, externalResources);
-
-    // Set workspace info
-    if (project->is_monorepo) {
-        jobject workspaceInfo = create_workspace_info_object(env, &project->workspace);
-        if (workspaceInfo) {
-            field = (*env)->GetFieldID(env, cls, "workspaceInfo",
-                                       "Lcom/gdme/webpulseforecast/WebPulseForecastNative$WorkspaceInfo;");
-            (*env)->SetObjectField(env, obj, field, workspaceInfo);
-            (*env)->DeleteLocalRef(env, workspaceInfo);
-        }
-    }
+    if ((*jni.vm)->AttachCurrentThreadAsDaemon(jni.vm, (void **)&env, NULL) != JNI_OK) return NULL;
+    ENV_KEY_SET((void *)1);
+    *native = 1;
+    return env;
+}
 
-    // Set dependencies
-    jobject dependencies = create_dependency_list_object(env, &project->dependencies);
-    if (dependencies) {
-        field = (*env)->GetFieldID(env, cls, "dependencies",
-                                   "Lcom/gdme/webpulseforecast/WebPulseForecastNative$DependencyList;");
-        (*env)->SetObjectField(env, obj, field, dependencies);
-        (*env)->DeleteLocalRef(env, dependencies);
+static void java_report_exception(JNIEnv *env, int native) {
+    if (native && (*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionDescribe(env);
+        (*env)->ExceptionClear(env);
     }
+}
 
-    // Set module paths
-    jclass stringCls = (*env)->FindClass(env, "java/lang/String");
-    jobjectArray modulePaths = (*env)->NewObjectArray(env, project->module_path_count, stringCls, NULL);
-
-    for (int i = 0; i < project->module_path_count; i++) {
-        jstring path = (*env)->NewStringUTF(env, project->module_paths[i]);
-        (*env)->SetObjectArrayElement(env, modulePaths, i, path);
-        (*env)->DeleteLocalRef(env, path);
+// Forwards analysis callbacks to a Java AnalysisListener on whichever thread
+// they run, through java_env.
+typedef struct {
+    jobject listener;
+    jmethodID on_progress;
+    jmethodID on_file;
+    CancelToken cancel;
+} JavaAnalysisListener;
+
+// A listener that throws stops the analysis. On a Java thread the exception
+// stays pending for the caller; on a native one it is reported and cleared.
+static void check_listener_exception(JNIEnv *env, JavaAnalysisListener *java) {
+    if ((*env)->ExceptionCheck(env)) {
+        cancel_token_cancel(&java->cancel);
     }
+}
 
-    field = (*env)->GetFieldID(env, cls, "modulePaths", "[Ljava/lang/String;");
-    (*env)->SetObjectField(env, obj, field, modulePaths);
-    (*env)->DeleteLocalRef(env, modulePaths);
-
-    // Set flags
-    field = (*env)->GetFieldID(env, cls, "usesCommonjs", "Z");
-    (*env)->SetBooleanField(env, obj, field, project->uses_commonjs);
-
-    field = (*env)->GetFieldID(env, cls, "usesEsmodules", "Z");
-    (*env)->SetBooleanField(env, obj, field, project->uses_esmodules);
-
-    field = (*env)->GetFieldID(env, cls, "hasWebpack", "Z");
-    (*env)->SetBooleanField(env, obj, field, project->has_webpack);
-
-    field = (*env)->GetFieldID(env, cls, "hasVite", "Z");
-    (*env)->SetBooleanField(env, obj, field, project->has_vite);
-
-    field = (*env)->GetFieldID(env, cls, "hasBabel", "Z");
-    (*env)->SetBooleanField(env, obj, field, project->has_babel);
-
-    field = (*env)->GetFieldID(env, cls, "hasCi", "Z");
-    (*env)->SetBooleanField(env, obj, field, project->has_ci);
-
-    field = (*env)->GetFieldID(env, cls, "hasEnvConfig", "Z");
-    (*env)->SetBooleanField(env, obj, field, project->has_env_config);
+static void forward_progress(const AnalysisProgress *progress, void *user_data) {
+    JavaAnalysisListener *java = (JavaAnalysisListener *)user_data;
+    if (cancel_token_is_cancelled(&java->cancel)) return;
+
+    int native;
+    JNIEnv *env = java_env(&native);
+    if (!env) return;
+
+    jstring framework = (*env)->NewStringUTF(env, progress->framework);
+    (*env)->CallVoidMethod(env, java->listener, java->on_progress,
+                           (jlong)progress->files_done, (jlong)progress->files_found,
+                           (jlong)progress->bytes_done, (jlong)progress->dirs_done,
+                           (jdouble)progress->elapsed_seconds, framework,
+                           (jboolean)(progress->is_final != 0));
+    (*env)->DeleteLocalRef(env, framework);
+    check_listener_exception(env, java);
+    java_report_exception(env, native);
+}
 
-    field = (*env)->GetFieldID(env, cls, "hasTypescript", "Z");
-    (*env)->SetBooleanField(env, obj, field, project->has_typescript);
+static void forward_file(const char *path, ParsedKind kind, size_t bytes, void *user_data) {
+    JavaAnalysisListener *java = (JavaAnalysisListener *)user_data;
+    if (cancel_token_is_cancelled(&java->cancel)) return;
 
-    field = (*env)->GetFieldID(env, cls, "isMonorepo", "Z");
-    (*env)->SetBooleanField(env, obj, field, project->is_monorepo);
+    int native;
+    JNIEnv *env = java_env(&native);
+    if (!env) return;
 
-    TRACE("Exiting create_project_type_object");
-    return obj;
+    jstring jpath = (*env)->NewStringUTF(env, path);
+    (*env)->CallVoidMethod(env, java->listener, java->on_file, jpath, (jint)kind, (jlong)bytes);
+    (*env)->DeleteLocalRef(env, jpath);
+    check_listener_exception(env, java);
+    java_report_exception(env, native);
 }
 
-// Helper function to create a ResourceEstimation Java object
-jobject create_resource_estimation_object(JNIEnv *env, const ResourceEstimation *estimation) {
-    TRACE("Entering jobject create_resource_estimation_object");
-    jclass cls = (*env)->FindClass(env, "com/gdme/webpulseforecast/WebPulseForecastNative$ResourceEstimation");
-    jmethodID constructor = (*env)->GetMethodID(env, cls, "<init>", "()V");
-    jobject obj = (*env)->NewObject(env, cls, constructor);
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectTypeWithListener
+        (JNIEnv *env, jobject obj, jstring projectPath, jobject listener) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectTypeWithListener");
+    if (!jni_available(env, jni.analysis_listener.cls, "AnalysisListener is not available")) return NULL;
+    JavaAnalysisListener java = {0};
+    java.listener = listener;
 
-    // Set fields
-    (*env)->SetLongField(env, obj, (*env)->GetFieldID(env, cls, "jsHeapSize", "J"), estimation->js_heap_size);
-    (*env)->SetLongField(env, obj, (*env)->GetFieldID(env, cls, "transferredData", "J"), estimation->transferred_data);
-    (*env)->SetLongField(env, obj, (*env)->GetFieldID(env, cls, "resourceSize", "J"), estimation->resource_size);
-    (*env)->SetIntField(env, obj, (*env)->GetFieldID(env, cls, "domContentLoaded", "I"), estimation->dom_content_loaded);
-    (*env)->SetIntField(env, obj, (*env)->GetFieldID(env, cls, "largestContentfulPaint", "I"), estimation->largest_contentful_paint);
+    java.on_progress = jni.analysis_listener.onProgress;
+    java.on_file = jni.analysis_listener.onFileAnalyzed;
 
-    TRACE("Exiting jobject create_resource_estimation_object");
-    return obj;
-}
+    AnalysisOptions options = {0};
+    options.cancel = &java.cancel;
+    options.on_progress = forward_progress;
+    options.on_file = forward_file;
+    options.callback_data = &java;
+    options.progress_interval = 0.25;
 
-JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectType
-        (JNIEnv *env, jobject obj, jstring projectPath) {
-    TRACE("Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectType");
     const char *path = (*env)->GetStringUTFChars(env, projectPath, 0);
-
-    // Call analyze_project_type, which now returns a pointer
-    ProjectType *project = analyze_project_type(path);
-
+    ProjectType *project = analyze_project_type_ex(path, &options);
     (*env)->ReleaseStringUTFChars(env, projectPath, path);
 
     if (!project) {
-        // Handle the case where analyze_project_type failed
         return NULL;
     }
 
-    jobject result = create_project_type_object(env, project);
-
-    // Free the memory allocated for ProjectType
-    free(project);
+    jobject result = NULL;
+    if (!(*env)->ExceptionCheck(env)) {
+        result = create_project_type_object(env, project);
+    }
+    free_project_type(project);
 
-    TRACE("Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectType");
+    LOG_TRACE(LOG_CAT_JNI, "Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectTypeWithListener");
     return result;
 }
 
 JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_estimateResources
         (JNIEnv *env, jobject obj, jobject projectType) {
 
-    TRACE("Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_estimateResources");
+    LOG_TRACE(LOG_CAT_JNI, "Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_estimateResources");
 
     // Extract fields from the ProjectType Java object
-    jclass projectTypeCls = (*env)->GetObjectClass(env, projectType);
 
-    jfieldID frameworkField = (*env)->GetFieldID(env, projectTypeCls, "framework", "Ljava/lang/String;");
-    jfieldID htmlFileCountField = (*env)->GetFieldID(env, projectTypeCls, "htmlFileCount", "I");
-    jfieldID cssFileCountField = (*env)->GetFieldID(env, projectTypeCls, "cssFileCount", "I");
-    jfieldID jsFileCountField = (*env)->GetFieldID(env, projectTypeCls, "jsFileCount", "I");
-    jfieldID jsonFileCountField = (*env)->GetFieldID(env, projectTypeCls, "jsonFileCount", "I");
-    jfieldID imageFileCountField = (*env)->GetFieldID(env, projectTypeCls, "imageFileCount", "I");
+    jfieldID frameworkField = jni.project_type.framework;
+    jfieldID htmlFileCountField = jni.project_type.htmlFileCount;
+    jfieldID cssFileCountField = jni.project_type.cssFileCount;
+    jfieldID jsFileCountField = jni.project_type.jsFileCount;
+    jfieldID jsonFileCountField = jni.project_type.jsonFileCount;
+    jfieldID imageFileCountField = jni.project_type.imageFileCount;
 
     // Get the actual values from the Java object
     jstring framework = (jstring) (*env)->GetObjectField(env, projectType, frameworkField);
@@ -1759,7 +1690,7 @@ JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_
     jint imageFileCount = (*env)->GetIntField(env, projectType, imageFileCountField);
 
     // Allocate ProjectType structure dynamically to reduce stack usage
-    ProjectType *project = (ProjectType *) malloc(sizeof(ProjectType));
+    ProjectType *project = (ProjectType *) mem_alloc(PROFILE_PHASE_JNI_CONVERSION, sizeof(ProjectType));
     if (project == NULL) {
         // Handle memory allocation failure
         (*env)->ReleaseStringUTFChars(env, framework, cFramework);
@@ -1781,7 +1712,7 @@ JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_
     project->image_file_count = imageFileCount;
 
     // Log or trace extracted values for debugging
-    TRACE("Extracted values: framework=%s, htmlFileCount=%d, cssFileCount=%d, jsFileCount=%d, jsonFileCount=%d, imageFileCount=%d",
+    LOG_DEBUG(LOG_CAT_JNI, "Extracted values: framework=%s, htmlFileCount=%d, cssFileCount=%d, jsFileCount=%d, jsonFileCount=%d, imageFileCount=%d",
           project->framework, project->html_file_count, project->css_file_count, project->js_file_count,
           project->json_file_count, project->image_file_count);
 
@@ -1792,94 +1723,88 @@ JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_
     ResourceEstimation estimation = estimate_resources(project);
 
     // Log resource estimation results
-    TRACE("Estimated resources: js_heap_size=%lld, transferred_data=%lld, resource_size=%lld, dom_content_loaded=%d, lcp=%d",
+    LOG_DEBUG(LOG_CAT_JNI, "Estimated resources: js_heap_size=%zu, transferred_data=%zu, resource_size=%zu, dom_content_loaded=%d, lcp=%d",
           estimation.js_heap_size, estimation.transferred_data, estimation.resource_size,
           estimation.dom_content_loaded, estimation.largest_contentful_paint);
 
     // Convert ResourceEstimation back into a Java object
-    jclass estimationCls = (*env)->FindClass(env, "com/gdme/webpulseforecast/WebPulseForecastNative$ResourceEstimation");
-    jmethodID constructor = (*env)->GetMethodID(env, estimationCls, "<init>", "()V");
-    jobject estimationObj = (*env)->NewObject(env, estimationCls, constructor);
-
-    // Set the fields back in Java object
-    (*env)->SetLongField(env, estimationObj, (*env)->GetFieldID(env, estimationCls, "jsHeapSize", "J"), estimation.js_heap_size);
-    (*env)->SetLongField(env, estimationObj, (*env)->GetFieldID(env, estimationCls, "transferredData", "J"), estimation.transferred_data);
-    (*env)->SetLongField(env, estimationObj, (*env)->GetFieldID(env, estimationCls, "resourceSize", "J"), estimation.resource_size);
-    (*env)->SetIntField(env, estimationObj, (*env)->GetFieldID(env, estimationCls, "domContentLoaded", "I"), estimation.dom_content_loaded);
-    (*env)->SetIntField(env, estimationObj, (*env)->GetFieldID(env, estimationCls, "largestContentfulPaint", "I"), estimation.largest_contentful_paint);
+    jobject estimationObj = create_resource_estimation_object(env, &estimation);
 
     // Free dynamically allocated memory for ProjectType
-    free(project);
+    mem_free(PROFILE_PHASE_JNI_CONVERSION, project, sizeof(ProjectType));
 
-    TRACE("Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_estimateResources");
+    LOG_TRACE(LOG_CAT_JNI, "Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_estimateResources");
     return estimationObj;
 }
 
 JNIEXPORT jdouble JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_calculatePerformanceImpact
         (JNIEnv *env, jobject obj, jobject projectType) {
-    TRACE("Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_calculatePerformanceImpact");
+    LOG_TRACE(LOG_CAT_JNI, "Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_calculatePerformanceImpact");
 
     if (!projectType) {
-        TRACE("NULL projectType provided");
+        LOG_TRACE(LOG_CAT_JNI, "NULL projectType provided");
         return 0.0;
     }
 
     // Allocate memory for ProjectType
-    ProjectType *project = (ProjectType *) malloc(sizeof(ProjectType));
+    ProjectType *project = (ProjectType *) mem_alloc(PROFILE_PHASE_JNI_CONVERSION, sizeof(ProjectType));
     if (!project) {
-        TRACE("Memory allocation for ProjectType failed");
+        LOG_ERROR(LOG_CAT_JNI, "Memory allocation for ProjectType failed");
         return 0.0;
     }
 
     // Initialize the structure to avoid any garbage values
     memset(project, 0, sizeof(ProjectType));
 
-    // Extract all project information using our helper function
+    // Extract all project information using our helper function. The strings
+    // it interns are not part of any result, so hold the pool for the call.
+    string_pool_retain();
     extract_project_type(env, projectType, project);
 
     // Log key metrics for debugging
-    TRACE("Framework: %s", project->framework);
-    TRACE("Total HTML tags: %d", project->total_html_info.tag_count);
-    TRACE("Total JS functions: %d", project->total_js_info.function_count);
-    TRACE("Total CSS rules: %d", project->total_css_info.rule_count);
-    TRACE("Total JSON objects: %d", project->total_json_info.object_count);
-    TRACE("Image files: %d", project->image_file_count);
-    TRACE("React hooks count: %d", project->framework_info.react_hooks_count);
-    TRACE("Custom elements: %d", project->custom_element_count);
-    TRACE("External resources: %d", project->external_resource_count);
-    TRACE("Is monorepo: %d", project->is_monorepo);
+    LOG_DEBUG(LOG_CAT_JNI, "Framework: %s", project->framework);
+    LOG_DEBUG(LOG_CAT_JNI, "Total HTML tags: %d", project->total_html_info.tag_count);
+    LOG_DEBUG(LOG_CAT_JNI, "Total JS functions: %d", project->total_js_info.function_count);
+    LOG_DEBUG(LOG_CAT_JNI, "Total CSS rules: %d", project->total_css_info.rule_count);
+    LOG_DEBUG(LOG_CAT_JNI, "Total JSON objects: %d", project->total_json_info.object_count);
+    LOG_DEBUG(LOG_CAT_JNI, "Image files: %d", project->image_file_count);
+    LOG_DEBUG(LOG_CAT_JNI, "React hooks count: %d", project->framework_info.react_hooks_count);
+    LOG_DEBUG(LOG_CAT_JNI, "Custom elements: %d", project->custom_element_count);
+    LOG_DEBUG(LOG_CAT_JNI, "External resources: %d", project->external_resource_count);
+    LOG_DEBUG(LOG_CAT_JNI, "Is monorepo: %d", project->is_monorepo);
 
     // Framework info logging
-    TRACE("Has React: %d", project->framework_info.has_react);
-    TRACE("Has Vue: %d", project->framework_info.has_vue);
-    TRACE("Has Angular: %d", project->framework_info.has_angular);
-    TRACE("Has Svelte: %d", project->framework_info.has_svelte);
-    TRACE("Has Next.js: %d", project->framework_info.has_nextjs);
-    TRACE("Has Nuxt.js: %d", project->framework_info.has_nuxtjs);
-    TRACE("Uses TypeScript: %d", project->framework_info.uses_typescript);
+    LOG_DEBUG(LOG_CAT_JNI, "Has React: %d", project->framework_info.has_react);
+    LOG_DEBUG(LOG_CAT_JNI, "Has Vue: %d", project->framework_info.has_vue);
+    LOG_DEBUG(LOG_CAT_JNI, "Has Angular: %d", project->framework_info.has_angular);
+    LOG_DEBUG(LOG_CAT_JNI, "Has Svelte: %d", project->framework_info.has_svelte);
+    LOG_DEBUG(LOG_CAT_JNI, "Has Next.js: %d", project->framework_info.has_nextjs);
+    LOG_DEBUG(LOG_CAT_JNI, "Has Nuxt.js: %d", project->framework_info.has_nuxtjs);
+    LOG_DEBUG(LOG_CAT_JNI, "Uses TypeScript: %d", project->framework_info.uses_typescript);
 
     // Calculate performance impact
     jdouble impact = calculate_performance_impact(project);
-    TRACE("Calculated performance impact: %f", impact);
+    LOG_DEBUG(LOG_CAT_JNI, "Calculated performance impact: %f", impact);
 
-    // Clean up
-    free(project);
+    // Clean up, workspace tables included
+    arena_destroy(project->workspace.arena);
+    mem_free(PROFILE_PHASE_JNI_CONVERSION, project, sizeof(ProjectType));
+    string_pool_release();
 
-    TRACE("Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_calculatePerformanceImpact");
+    LOG_TRACE(LOG_CAT_JNI, "Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_calculatePerformanceImpact");
     return impact;
 }
 
 JNIEXPORT jstring JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getResourceUsageDisplay
         (JNIEnv *env, jobject obj, jobject resourceEstimation) {
-    TRACE("Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_getResourceUsageDisplay");
+    LOG_TRACE(LOG_CAT_JNI, "Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_getResourceUsageDisplay");
 
     // Extract fields from ResourceEstimation Java object
-    jclass estimationCls = (*env)->GetObjectClass(env, resourceEstimation);
-    jfieldID jsHeapSizeField = (*env)->GetFieldID(env, estimationCls, "jsHeapSize", "J");
-    jfieldID transferredDataField = (*env)->GetFieldID(env, estimationCls, "transferredData", "J");
-    jfieldID resourceSizeField = (*env)->GetFieldID(env, estimationCls, "resourceSize", "J");
-    jfieldID domContentLoadedField = (*env)->GetFieldID(env, estimationCls, "domContentLoaded", "I");
-    jfieldID lcpField = (*env)->GetFieldID(env, estimationCls, "largestContentfulPaint", "I");
+    jfieldID jsHeapSizeField = jni.resource_estimation.jsHeapSize;
+    jfieldID transferredDataField = jni.resource_estimation.transferredData;
+    jfieldID resourceSizeField = jni.resource_estimation.resourceSize;
+    jfieldID domContentLoadedField = jni.resource_estimation.domContentLoaded;
+    jfieldID lcpField = jni.resource_estimation.largestContentfulPaint;
 
     // Extract the actual values from the Java object
     ResourceEstimation estimation = {0};
@@ -1902,27 +1827,26 @@ JNIEXPORT jstring JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_
     // Create a Java string from the formatted buffer
     jstring result = create_jstring(env, buffer);
 
-    TRACE("Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_getResourceUsageDisplay");
+    LOG_TRACE(LOG_CAT_JNI, "Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_getResourceUsageDisplay");
     return result;
 }
 
 JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getPotentialIssues
         (JNIEnv *env, jobject obj, jobject projectType) {
-    TRACE("Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_getPotentialIssues");
+    LOG_TRACE(LOG_CAT_JNI, "Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_getPotentialIssues");
 
     // Extract fields from the ProjectType Java object
-    jclass projectTypeCls = (*env)->GetObjectClass(env, projectType);
 
     // Get the potentialIssueCount field from the ProjectType Java object
-    jfieldID issueCountField = (*env)->GetFieldID(env, projectTypeCls, "potentialIssueCount", "I");
+    jfieldID issueCountField = jni.project_type.potentialIssueCount;
     jint potentialIssueCount = (*env)->GetIntField(env, projectType, issueCountField);
 
     // Get the potentialIssues array from the ProjectType Java object
-    jfieldID potentialIssuesField = (*env)->GetFieldID(env, projectTypeCls, "potentialIssues", "[Lcom/gdme/webpulseforecast/WebPulseForecastNative$PotentialIssue;");
+    jfieldID potentialIssuesField = jni.project_type.potentialIssues;
     jobjectArray potentialIssuesArray = (jobjectArray)(*env)->GetObjectField(env, projectType, potentialIssuesField);
 
     // Create a Java String array to hold the issues
-    jclass stringClass = (*env)->FindClass(env, "java/lang/String");
+    jclass stringClass = jni.string_cls;
     jobjectArray issuesArray = (*env)->NewObjectArray(env, potentialIssueCount, stringClass, NULL);
 
     // Iterate through potential issues in the Java array and add them to the string array
@@ -1931,8 +1855,7 @@ JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNa
         jobject potentialIssueObj = (*env)->GetObjectArrayElement(env, potentialIssuesArray, i);
 
         // Get the description field from the PotentialIssue object
-        jclass potentialIssueCls = (*env)->GetObjectClass(env, potentialIssueObj);
-        jfieldID descriptionField = (*env)->GetFieldID(env, potentialIssueCls, "description", "Ljava/lang/String;");
+        jfieldID descriptionField = jni.potential_issue.description;
         jstring description = (jstring)(*env)->GetObjectField(env, potentialIssueObj, descriptionField);
 
         // Add the description string to the issuesArray
@@ -1943,6 +1866,722 @@ JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNa
         (*env)->DeleteLocalRef(env, description);
     }
 
-    TRACE("Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_getPotentialIssues");
+    LOG_TRACE(LOG_CAT_JNI, "Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_getPotentialIssues");
     return issuesArray;
-}
\ No newline at end of file
+}
+
+// Native analysis results handed to Java as opaque jlong handles, so the
+// estimation, impact and issue calls work on the C struct directly instead of
+// rebuilding it from a Java ProjectType.
+//
+// A handle is never a pointer. It names a slot in the registry below as
+// (generation << 32) | (slot + 1), and every lookup checks the slot's kind and
+// generation first, so a released, repeated or made-up handle is rejected
+// without touching freed memory. Freeing a slot moves its generation on.
+// Java must still not release a handle while another call is using it.
+#define HANDLE_PROJECT 1
+#define HANDLE_ANALYSIS 2
+
+typedef struct {
+    void *object;             // NULL while the slot is free
+    int kind;
+    unsigned int generation;
+    int next_free;
+} HandleSlot;
+
+static struct {
+    HandleSlot *slots;
+    int capacity;
+    int free_head;            // -1 when every slot is in use
+} handles = {NULL, 0, -1};
+
+#ifdef _WIN32
+static SRWLOCK handle_lock = SRWLOCK_INIT;
+#define HANDLE_LOCK() AcquireSRWLockExclusive(&handle_lock)
+#define HANDLE_UNLOCK() ReleaseSRWLockExclusive(&handle_lock)
+#else
+static pthread_mutex_t handle_lock = PTHREAD_MUTEX_INITIALIZER;
+#define HANDLE_LOCK() pthread_mutex_lock(&handle_lock)
+#define HANDLE_UNLOCK() pthread_mutex_unlock(&handle_lock)
+#endif
+
+// Returns 0 if the table cannot grow
+static jlong handle_register(int kind, void *object) {
+    HANDLE_LOCK();
+    if (handles.free_head < 0) {
+        int capacity = handles.capacity ? handles.capacity * 2 : 64;
+        HandleSlot *slots = handles.capacity < (1 << 30)
+            ? (HandleSlot *)realloc(handles.slots, capacity * sizeof(HandleSlot)) : NULL;
+        if (!slots) {
+            HANDLE_UNLOCK();
+            return 0;
+        }
+        for (int i = handles.capacity; i < capacity; i++) {
+            slots[i].object = NULL;
+            slots[i].kind = 0;
+            slots[i].generation = 1;
+            slots[i].next_free = i + 1 < capacity ? i + 1 : -1;
+        }
+        handles.free_head = handles.capacity;
+        handles.slots = slots;
+        handles.capacity = capacity;
+    }
+
+    int slot = handles.free_head;
+    HandleSlot *entry = &handles.slots[slot];
+    handles.free_head = entry->next_free;
+    entry->object = object;
+    entry->kind = kind;
+    jlong handle = (jlong)(((uint64_t)entry->generation << 32) | (uint64_t)(slot + 1));
+    HANDLE_UNLOCK();
+    return handle;
+}
+
+// Lock held. Returns the live slot handle names, or NULL.
+static HandleSlot *handle_slot_locked(jlong handle, int kind) {
+    uint64_t bits = (uint64_t)handle;
+    uint64_t slot = (bits & 0xFFFFFFFFu) - 1;
+    if (slot >= (uint64_t)handles.capacity) return NULL;
+
+    HandleSlot *entry = &handles.slots[slot];
+    if (!entry->object || entry->kind != kind ||
+        entry->generation != (unsigned int)(bits >> 32)) {
+        return NULL;
+    }
+    return entry;
+}
+
+static void *handle_lookup(jlong handle, int kind) {
+    HANDLE_LOCK();
+    HandleSlot *entry = handle_slot_locked(handle, kind);
+    void *object = entry ? entry->object : NULL;
+    HANDLE_UNLOCK();
+    return object;
+}
+
+// Retires the handle and returns what it named; NULL if it was not live
+static void *handle_remove(jlong handle, int kind) {
+    HANDLE_LOCK();
+    HandleSlot *entry = handle_slot_locked(handle, kind);
+    void *object = NULL;
+    if (entry) {
+        object = entry->object;
+        entry->object = NULL;
+        entry->kind = 0;
+        if (++entry->generation == 0) entry->generation = 1;
+        entry->next_free = handles.free_head;
+        handles.free_head = (int)(entry - handles.slots);
+    }
+    HANDLE_UNLOCK();
+    return object;
+}
+
+static ProjectType *project_from_handle(JNIEnv *env, jlong handle) {
+    ProjectType *project = (ProjectType *)handle_lookup(handle, HANDLE_PROJECT);
+    if (!project) {
+        (*env)->ThrowNew(env, jni.illegal_argument_cls, "Invalid or released project handle");
+    }
+    return project;
+}
+
+static jobjectArray create_issue_array(JNIEnv *env, const ProjectType *project) {
+    return create_object_array(env, jni.string_cls, project->potential_issue_count,
+                               project->potential_issues[0].description, sizeof(PotentialIssue),
+                               create_fixed_string);
+}
+
+// Takes ownership of project; frees it and returns 0 if no handle can be made
+static jlong wrap_project_handle(ProjectType *project) {
+    if (!project) return 0;
+
+    jlong handle = handle_register(HANDLE_PROJECT, project);
+    if (!handle) free_project_type(project);
+    return handle;
+}
+
+JNIEXPORT jlong JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectHandle
+        (JNIEnv *env, jobject obj, jstring projectPath) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectHandle");
+    const char *path = (*env)->GetStringUTFChars(env, projectPath, 0);
+    ProjectType *project = analyze_project_type(path);
+    (*env)->ReleaseStringUTFChars(env, projectPath, path);
+
+    LOG_TRACE(LOG_CAT_JNI, "Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectHandle");
+    return wrap_project_handle(project);
+}
+
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_releaseProjectHandle
+        (JNIEnv *env, jobject obj, jlong handle) {
+    if (handle == 0) return;
+    ProjectType *project = (ProjectType *)handle_remove(handle, HANDLE_PROJECT);
+    if (!project) {
+        (*env)->ThrowNew(env, jni.illegal_argument_cls, "Invalid or released project handle");
+        return;
+    }
+    free_project_type(project);
+}
+
+// Builds the full Java ProjectType only when the caller asks for it
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getProjectType
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    return project ? create_project_type_object(env, project) : NULL;
+}
+
+JNIEXPORT jstring JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getFramework
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    return project ? (*env)->NewStringUTF(env, project->framework) : NULL;
+}
+
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_estimateResourcesForHandle
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    if (!project) return NULL;
+
+    ResourceEstimation estimation = estimate_resources(project);
+    return create_resource_estimation_object(env, &estimation);
+}
+
+JNIEXPORT jdouble JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_calculatePerformanceImpactForHandle
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    return project ? calculate_performance_impact(project) : 0.0;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getPotentialIssuesForHandle
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    return project ? create_issue_array(env, project) : NULL;
+}
+
+// File counts in ProjectType order (html, css, js, json, ts, jsx, vue, xml,
+// image), copied in one SetIntArrayRegion call instead of nine field reads
+JNIEXPORT jintArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getFileCounts
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    if (!project) return NULL;
+
+    jint counts[] = {
+        project->html_file_count, project->css_file_count, project->js_file_count,
+        project->json_file_count, project->ts_file_count, project->jsx_file_count,
+        project->vue_file_count, project->xml_file_count, project->image_file_count
+    };
+    jsize length = (jsize)(sizeof(counts) / sizeof(counts[0]));
+
+    jintArray array = (*env)->NewIntArray(env, length);
+    if (!array) return NULL;
+    (*env)->SetIntArrayRegion(env, array, 0, length, counts);
+    return array;
+}
+
+// Headline fields only; the heavy sections below are fetched when needed
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getProjectSummary
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    return project ? build_project_type_object(env, project, 0) : NULL;
+}
+
+// Null for projects that are not monorepos
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getWorkspaceInfo
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    if (!project || !project->is_monorepo) return NULL;
+    return create_workspace_info_object(env, &project->workspace, 1);
+}
+
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getWorkspacePackage
+        (JNIEnv *env, jobject obj, jlong handle, jint index) {
+    ProjectType *project = project_from_handle(env, handle);
+    if (!project) return NULL;
+
+    if (index < 0 || index >= project->workspace.package_count) {
+        (*env)->ThrowNew(env, jni.illegal_argument_cls, "Package index out of range");
+        return NULL;
+    }
+    return create_package_object(env, &project->workspace.packages[index]);
+}
+
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getDependencies
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    return project ? create_dependency_list_object(env, project->dependencies.items,
+                                                   project->dependencies.count) : NULL;
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getCustomElements
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    if (!project) return NULL;
+
+    const HTMLInfo *html = &project->total_html_info;
+    return create_object_array(env, jni.custom_element.cls, html->custom_element_count,
+                               html->custom_elements, sizeof(CustomElement),
+                               create_custom_element_object);
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getExternalResources
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    if (!project) return NULL;
+
+    return create_object_array(env, jni.external_resource.cls, project->external_resource_count,
+                               project->external_resources, sizeof(ExternalResource),
+                               create_external_resource_object);
+}
+
+JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getModulePaths
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    if (!project) return NULL;
+
+    return create_object_array(env, jni.string_cls, project->module_path_count,
+                               project->module_paths, sizeof(StringId), create_pooled_string);
+}
+
+// The bytes of a direct buffer between its position and limit, the part a
+// channel write would take. Returns NULL if it is not a direct buffer.
+static const char *direct_buffer_bytes(JNIEnv *env, jobject buffer, size_t *length) {
+    const char *address = (const char *)(*env)->GetDirectBufferAddress(env, buffer);
+    if (!address) return NULL;
+
+    jint position = (*env)->CallIntMethod(env, buffer, jni.buffer.position);
+    jint limit = (*env)->CallIntMethod(env, buffer, jni.buffer.limit);
+    if ((*env)->ExceptionCheck(env) || position < 0 || limit < position) return NULL;
+
+    *length = (size_t)(limit - position);
+    return address + position;
+}
+
+// Overlays in-memory documents on a project handle (0 for none) and returns a
+// new handle; the base handle stays valid. Contents are direct ByteBuffers,
+// read from position to limit without moving either. previousContents may be
+// null, or hold null for documents the base did not include.
+JNIEXPORT jlong JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeBuffers
+        (JNIEnv *env, jobject obj, jlong baseHandle, jobjectArray paths, jobjectArray contents,
+         jobjectArray previousContents) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeBuffers");
+    const ProjectType *base = NULL;
+    if (baseHandle != 0) {
+        base = project_from_handle(env, baseHandle);
+        if (!base) return 0;
+    }
+
+    jsize count = paths ? (*env)->GetArrayLength(env, paths) : 0;
+    if (!contents || (*env)->GetArrayLength(env, contents) != count ||
+        (previousContents && (*env)->GetArrayLength(env, previousContents) != count)) {
+        (*env)->ThrowNew(env, jni.illegal_argument_cls, "paths and contents must have the same length");
+        return 0;
+    }
+
+    SourceBuffer *buffers = (SourceBuffer *)calloc(count > 0 ? (size_t)count : 1, sizeof(SourceBuffer));
+    jstring *path_refs = (jstring *)calloc(count > 0 ? (size_t)count : 1, sizeof(jstring));
+    if (!buffers || !path_refs) {
+        free(buffers);
+        free(path_refs);
+        return 0;
+    }
+
+    // The direct buffers stay valid without pinning; only the path strings
+    // need their local references kept until the analysis is done.
+    jsize ready = 0;
+    int valid = 1;
+    for (; ready < count && valid; ready++) {
+        path_refs[ready] = (jstring)(*env)->GetObjectArrayElement(env, paths, ready);
+        jobject content = (*env)->GetObjectArrayElement(env, contents, ready);
+        jobject previous = previousContents ?
+            (*env)->GetObjectArrayElement(env, previousContents, ready) : NULL;
+
+        SourceBuffer *buffer = &buffers[ready];
+        buffer->path = path_refs[ready] ? (*env)->GetStringUTFChars(env, path_refs[ready], 0) : NULL;
+        buffer->data = content ? direct_buffer_bytes(env, content, &buffer->length) : NULL;
+        if (previous) {
+            buffer->previous_data = direct_buffer_bytes(env, previous, &buffer->previous_length);
+            valid = buffer->previous_data != NULL;
+        }
+        valid = valid && buffer->path && buffer->data;
+
+        if (content) (*env)->DeleteLocalRef(env, content);
+        if (previous) (*env)->DeleteLocalRef(env, previous);
+    }
+
+    jlong handle = 0;
+    if (valid) {
+        handle = wrap_project_handle(analyze_buffers(base, buffers, (int)count, NULL));
+    } else {
+        (*env)->ThrowNew(env, jni.illegal_argument_cls, "Paths must be non-null and contents direct ByteBuffers");
+    }
+
+    for (jsize i = 0; i < ready; i++) {
+        if (!path_refs[i]) continue;
+        if (buffers[i].path) (*env)->ReleaseStringUTFChars(env, path_refs[i], buffers[i].path);
+        (*env)->DeleteLocalRef(env, path_refs[i]);
+    }
+    free(path_refs);
+    free(buffers);
+
+    LOG_TRACE(LOG_CAT_JNI, "Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeBuffers");
+    return handle;
+}
+
+// Binary result transfer: the whole result is encoded into a direct
+// ByteBuffer owned by Java in one call (layout in web_result_format.h), so
+// the Java side can decode lazily instead of crossing JNI per field.
+//
+// Sizes travel as jint, negated for "too small", so an encoding past INT_MAX
+// bytes cannot be expressed and throws IllegalStateException instead.
+static int serialized_size(JNIEnv *env, const ProjectType *project, size_t *out) {
+    size_t size = result_format_size(project);
+    if (size > INT_MAX) {
+        (*env)->ThrowNew(env, jni.illegal_state_cls, "Serialized result exceeds 2 GB");
+        return 0;
+    }
+    *out = size;
+    return 1;
+}
+
+JNIEXPORT jint JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getSerializedSize
+        (JNIEnv *env, jobject obj, jlong handle) {
+    ProjectType *project = project_from_handle(env, handle);
+    size_t size;
+    if (!project || !serialized_size(env, project, &size)) return 0;
+    return (jint)size;
+}
+
+// Returns the number of bytes written, or the negated required size when the
+// buffer is too small. The buffer position and limit are left untouched.
+JNIEXPORT jint JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_serializeProjectInto
+        (JNIEnv *env, jobject obj, jlong handle, jobject buffer) {
+    ProjectType *project = project_from_handle(env, handle);
+    if (!project) return 0;
+
+    void *address = buffer ? (*env)->GetDirectBufferAddress(env, buffer) : NULL;
+    jlong capacity = buffer ? (*env)->GetDirectBufferCapacity(env, buffer) : -1;
+    if (!address || capacity < 0) {
+        (*env)->ThrowNew(env, jni.illegal_argument_cls, "A direct ByteBuffer is required");
+        return 0;
+    }
+
+    size_t needed;
+    if (!serialized_size(env, project, &needed)) return 0;
+    if ((size_t)capacity < needed) {
+        return -(jint)needed;
+    }
+    return (jint)result_format_write(project, address, (size_t)capacity);
+}
+
+// Asynchronous analysis. startAnalysis runs the whole analysis on a native
+// thread of its own and returns at once. It is not queued on the shared pool:
+// a thread waiting there helps only with its own tasks, but a queued analysis
+// would still hold a worker for its whole run. The thread attaches to the JVM
+// as it starts and detaches as it exits; startAnalysis waits for the attach,
+// so a thread that cannot attach fails the call instead of running an analysis
+// nobody will hear about. Progress and per-file callbacks arrive on that
+// thread or on pool workers, and onComplete always fires last with a project handle (0 if
+// the analysis failed) that Java then owns.
+//
+// The task is shared by Java and the analysis thread, so it is reference
+// counted and freed by whichever side lets go last: the thread after
+// onComplete, Java through releaseAnalysis. Java's reference is its registry
+// handle, so cancelAnalysis works on the task only under the registry lock.
+// Analyses recurse through the project tree, like the pool workers
+#define ASYNC_ANALYSIS_STACK_SIZE (8 * 1024 * 1024)
+
+typedef struct {
+    volatile long refs;
+    JavaAnalysisListener java;  // java.cancel doubles as the Java cancel flag
+    char path[MAX_PATH];
+} AsyncAnalysis;
+
+static long async_release_ref(AsyncAnalysis *task) {
+#ifdef _WIN32
+    return InterlockedDecrement(&task->refs);
+#else
+    return __atomic_sub_fetch(&task->refs, 1, __ATOMIC_ACQ_REL);
+#endif
+}
+
+static void async_analysis_unref(JNIEnv *env, AsyncAnalysis *task) {
+    if (async_release_ref(task) > 0) return;
+
+    (*env)->DeleteGlobalRef(env, task->java.listener);
+    free(task);
+}
+
+// Handed to the analysis thread, which reports through status whether it
+// attached: 1 if so, -1 if not. Lives on startAnalysis's stack.
+typedef struct {
+    AsyncAnalysis *task;
+    int status;
+} AsyncStart;
+
+#ifdef _WIN32
+static CONDITION_VARIABLE async_started = CONDITION_VARIABLE_INIT;
+#define ASYNC_STARTED_WAIT() SleepConditionVariableSRW(&async_started, &handle_lock, INFINITE, 0)
+#define ASYNC_STARTED_SIGNAL() WakeAllConditionVariable(&async_started)
+#else
+static pthread_cond_t async_started = PTHREAD_COND_INITIALIZER;
+#define ASYNC_STARTED_WAIT() pthread_cond_wait(&async_started, &handle_lock)
+#define ASYNC_STARTED_SIGNAL() pthread_cond_broadcast(&async_started)
+#endif
+
+static void run_async_analysis(JNIEnv *env, AsyncAnalysis *task) {
+    AnalysisOptions options = {0};
+    options.cancel = &task->java.cancel;
+    options.on_progress = forward_progress;
+    options.on_file = forward_file;
+    options.callback_data = &task->java;
+    options.progress_interval = 0.25;
+
+    ProjectType *project = analyze_project_type_ex(task->path, &options);
+    int incomplete = !project || project->is_incomplete;
+    jlong handle = wrap_project_handle(project);
+
+    (*env)->CallVoidMethod(env, task->java.listener, jni.analysis_listener.onComplete,
+                           handle, (jboolean)(incomplete != 0));
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionDescribe(env);
+        (*env)->ExceptionClear(env);
+    }
+
+    async_analysis_unref(env, task);
+}
+
+// The env key detaches the thread once this returns
+static void async_analysis_thread(AsyncStart *start) {
+    AsyncAnalysis *task = start->task;
+    int native;
+    JNIEnv *env = java_env(&native);
+
+    HANDLE_LOCK();
+    start->status = env ? 1 : -1;
+    ASYNC_STARTED_SIGNAL();
+    HANDLE_UNLOCK();
+
+    if (env) run_async_analysis(env, task);
+}
+
+#ifdef _WIN32
+static unsigned __stdcall async_analysis_main(void *arg) {
+    async_analysis_thread((AsyncStart *)arg);
+    return 0;
+}
+#else
+static void *async_analysis_main(void *arg) {
+    async_analysis_thread((AsyncStart *)arg);
+    return NULL;
+}
+#endif
+
+// Starts a detached thread for the task and waits until it has attached.
+// Returns 0 if it could not be created or could not attach.
+static int start_async_analysis(AsyncStart *start) {
+#ifdef _WIN32
+    uintptr_t thread = _beginthreadex(NULL, ASYNC_ANALYSIS_STACK_SIZE, async_analysis_main, start, 0, NULL);
+    if (!thread) return 0;
+    CloseHandle((HANDLE)thread);
+#else
+    pthread_t thread;
+    pthread_attr_t attr;
+    pthread_attr_init(&attr);
+    pthread_attr_setstacksize(&attr, ASYNC_ANALYSIS_STACK_SIZE);
+    pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_DETACHED);
+    int started = pthread_create(&thread, &attr, async_analysis_main, start) == 0;
+    pthread_attr_destroy(&attr);
+    if (!started) return 0;
+#endif
+
+    HANDLE_LOCK();
+    while (start->status == 0) ASYNC_STARTED_WAIT();
+    int attached = start->status > 0;
+    HANDLE_UNLOCK();
+    return attached;
+}
+
+JNIEXPORT jlong JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_startAnalysis
+        (JNIEnv *env, jobject obj, jstring projectPath, jobject listener) {
+    LOG_TRACE(LOG_CAT_JNI, "Entering Java_com_gdme_webpulseforecast_WebPulseForecastNative_startAnalysis");
+    if (!jni_available(env, jni.analysis_listener.cls, "AnalysisListener is not available")) return 0;
+    if (!listener) {
+        (*env)->ThrowNew(env, jni.illegal_argument_cls, "An AnalysisListener is required");
+        return 0;
+    }
+
+    AsyncAnalysis *task = (AsyncAnalysis *)calloc(1, sizeof(AsyncAnalysis));
+    if (!task) return 0;
+
+    const char *path = (*env)->GetStringUTFChars(env, projectPath, 0);
+    strncpy(task->path, path, MAX_PATH - 1);
+    (*env)->ReleaseStringUTFChars(env, projectPath, path);
+
+    task->refs = 2;  // One for Java, one for the analysis thread
+    task->java.listener = (*env)->NewGlobalRef(env, listener);
+    task->java.on_progress = jni.analysis_listener.onProgress;
+    task->java.on_file = jni.analysis_listener.onFileAnalyzed;
+
+    // Registered before starting: the thread may finish and drop its
+    // reference before this returns, but Java's reference keeps the task alive.
+    AsyncStart start = {task, 0};
+    jlong handle = handle_register(HANDLE_ANALYSIS, task);
+    if (!handle || !start_async_analysis(&start)) {
+        // A thread that failed to attach returned without touching the task
+        fprintf(stderr, "WebPulseForecast JNI: cannot start analysis thread\n");
+        if (handle) handle_remove(handle, HANDLE_ANALYSIS);
+        (*env)->DeleteGlobalRef(env, task->java.listener);
+        free(task);
+        return 0;
+    }
+
+    LOG_TRACE(LOG_CAT_JNI, "Exiting Java_com_gdme_webpulseforecast_WebPulseForecastNative_startAnalysis");
+    return handle;
+}
+
+// Requests a stop; the analysis still ends with onComplete, flagged incomplete
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_cancelAnalysis
+        (JNIEnv *env, jobject obj, jlong handle) {
+    // Under the lock so a concurrent releaseAnalysis cannot free the task
+    HANDLE_LOCK();
+    HandleSlot *entry = handle_slot_locked(handle, HANDLE_ANALYSIS);
+    if (entry) cancel_token_cancel(&((AsyncAnalysis *)entry->object)->java.cancel);
+    HANDLE_UNLOCK();
+
+    if (!entry) {
+        (*env)->ThrowNew(env, jni.illegal_argument_cls, "Invalid or released analysis handle");
+    }
+}
+
+// Drops Java's reference. Does not cancel; a running analysis still completes.
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_releaseAnalysis
+        (JNIEnv *env, jobject obj, jlong handle) {
+    if (handle == 0) return;
+    AsyncAnalysis *task = (AsyncAnalysis *)handle_remove(handle, HANDLE_ANALYSIS);
+    if (!task) {
+        (*env)->ThrowNew(env, jni.illegal_argument_cls, "Invalid or released analysis handle");
+        return;
+    }
+    async_analysis_unref(env, task);
+}
+
+// The log writer is attached for as long as a Java log listener is installed;
+// web_log runs these hooks on the writer thread as the sink comes and goes.
+static void attach_log_writer(void) {
+    JNIEnv *env;
+    if ((*jni.vm)->AttachCurrentThreadAsDaemon(jni.vm, (void **)&env, NULL) != JNI_OK) {
+        fprintf(stderr, "WebPulseForecast JNI: cannot attach log writer thread\n");
+    }
+}
+
+static void detach_log_writer(void) {
+    (*jni.vm)->DetachCurrentThread(jni.vm);
+}
+
+// Log sink for setLogListener. Usually runs on the attached log writer, but a
+// flush or sink swap drains on the calling thread, so look the env up.
+static void forward_log(void *user, int level, unsigned int category,
+                        long long timestamp_ms, const char *message) {
+    int native;
+    JNIEnv *env = java_env(&native);
+    if (!env) return;
+
+    jstring jcategory = (*env)->NewStringUTF(env, web_log_category_name(category));
+    jstring jmessage = (*env)->NewStringUTF(env, message);
+    (*env)->CallVoidMethod(env, (jobject)user, jni.log_listener.onLog,
+                           (jint)level, jcategory, (jlong)timestamp_ms, jmessage);
+    if ((*env)->ExceptionCheck(env)) {
+        (*env)->ExceptionDescribe(env);
+        (*env)->ExceptionClear(env);
+    }
+    (*env)->DeleteLocalRef(env, jcategory);
+    (*env)->DeleteLocalRef(env, jmessage);
+}
+
+// Routes log records at or above level to listener.onLog instead of stderr;
+// a null listener restores stderr. onLog runs on the log writer thread and
+// must not call setLogListener itself.
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_setLogListener
+        (JNIEnv *env, jobject obj, jobject listener, jint level) {
+    if (listener && !jni_available(env, jni.log_listener.cls, "LogListener is not available")) return;
+    jobject previous = log_listener;
+    jobject current = listener ? (*env)->NewGlobalRef(env, listener) : NULL;
+
+    // Pending records drain to the previous sink before it is swapped out
+    if (current) {
+        web_log_set_sink_hooks(forward_log, current, attach_log_writer, detach_log_writer);
+    } else {
+        web_log_set_sink(NULL, NULL);
+    }
+    log_listener = current;
+    if (previous) (*env)->DeleteGlobalRef(env, previous);
+
+    web_log_set_level(level);
+}
+
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_setProfilingEnabled
+        (JNIEnv *env, jobject obj, jboolean enabled) {
+    profile_set_enabled(enabled);
+}
+
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_resetProfile
+        (JNIEnv *env, jobject obj) {
+    profile_reset();
+}
+
+// Formats a report with an snprintf-style writer. Analyses running
+// concurrently can grow the report between measuring and writing, so the
+// measurement is only a first guess: a report that did not fit is rewritten
+// into a larger buffer.
+static jstring format_report(JNIEnv *env, size_t (*format)(char *, size_t)) {
+    size_t size = format(NULL, 0) + 64;
+    for (;;) {
+        char *report = (char *)malloc(size);
+        if (!report) return NULL;
+
+        size_t length = format(report, size);
+        if (length < size) {
+            jstring result = (*env)->NewStringUTF(env, report);
+            free(report);
+            return result;
+        }
+        free(report);
+        size = length + length / 2 + 64;
+    }
+}
+
+// Phase timings accumulated since the last reset, as the JSON array written
+// by profile_format_json
+JNIEXPORT jstring JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getProfileReport
+        (JNIEnv *env, jobject obj) {
+    return format_report(env, profile_format_json);
+}
+
+// Writes a Chrome trace-event file of the analyses run until stopTrace.
+// Returns 0, or -1 if a trace is already running.
+JNIEXPORT jint JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_startTrace
+        (JNIEnv *env, jobject obj, jstring outputPath) {
+    if (!outputPath) return -1;
+    const char *path = (*env)->GetStringUTFChars(env, outputPath, 0);
+    int result = trace_start(path);
+    (*env)->ReleaseStringUTFChars(env, outputPath, path);
+    return result;
+}
+
+// Returns the number of events written, or -1 on failure
+JNIEXPORT jint JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_stopTrace
+        (JNIEnv *env, jobject obj) {
+    return trace_stop();
+}
+
+// Hardware counters join the profile report under "hw". Returns whether
+// counting is active, which it is not where perf events are unavailable.
+JNIEXPORT jboolean JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_setHardwareCountersEnabled
+        (JNIEnv *env, jobject obj, jboolean enabled) {
+    return hw_counters_set_enabled(enabled) ? JNI_TRUE : JNI_FALSE;
+}
+
+// Tracked allocations per phase plus process RSS, as JSON (see web_memory.h).
+// The allocation counts are also in the profile report under "mem".
+JNIEXPORT jstring JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getMemoryReport
+        (JNIEnv *env, jobject obj) {
+    // RSS is re-read on every call, so this can grow between calls too
+    return format_report(env, mem_format_json);
+}
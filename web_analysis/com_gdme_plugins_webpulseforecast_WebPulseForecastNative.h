@@ -15,6 +15,22 @@ extern "C" {
 JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectType
   (JNIEnv *, jobject, jstring);
 
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    analyzeProjectTypeWithTimeout
+ * Signature: (Ljava/lang/String;D)Lcom/gdme/webpulseforecast/WebPulseForecastNative/ProjectType;
+ */
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectTypeWithTimeout
+  (JNIEnv *, jobject, jstring, jdouble);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    analyzeProjectTypeWithListener
+ * Signature: (Ljava/lang/String;Lcom/gdme/webpulseforecast/WebPulseForecastNative/AnalysisListener;)Lcom/gdme/webpulseforecast/WebPulseForecastNative/ProjectType;
+ */
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectTypeWithListener
+  (JNIEnv *, jobject, jstring, jobject);
+
 /*
  * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
  * Method:    estimateResources
@@ -47,6 +63,238 @@ JNIEXPORT jstring JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_
 JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getPotentialIssues
   (JNIEnv *, jobject, jobject);
 
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    analyzeProjectHandle
+ * Signature: (Ljava/lang/String;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeProjectHandle
+  (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    releaseProjectHandle
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_releaseProjectHandle
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getProjectType
+ * Signature: (J)Lcom/gdme/webpulseforecast/WebPulseForecastNative/ProjectType;
+ */
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getProjectType
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getFramework
+ * Signature: (J)Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getFramework
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    estimateResourcesForHandle
+ * Signature: (J)Lcom/gdme/webpulseforecast/WebPulseForecastNative/ResourceEstimation;
+ */
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_estimateResourcesForHandle
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    calculatePerformanceImpactForHandle
+ * Signature: (J)D
+ */
+JNIEXPORT jdouble JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_calculatePerformanceImpactForHandle
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getPotentialIssuesForHandle
+ * Signature: (J)[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getPotentialIssuesForHandle
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getFileCounts
+ * Signature: (J)[I
+ */
+JNIEXPORT jintArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getFileCounts
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getProjectSummary
+ * Signature: (J)Lcom/gdme/webpulseforecast/WebPulseForecastNative/ProjectType;
+ */
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getProjectSummary
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getWorkspaceInfo
+ * Signature: (J)Lcom/gdme/webpulseforecast/WebPulseForecastNative/WorkspaceInfo;
+ */
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getWorkspaceInfo
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getWorkspacePackage
+ * Signature: (JI)Lcom/gdme/webpulseforecast/WebPulseForecastNative/Package;
+ */
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getWorkspacePackage
+  (JNIEnv *, jobject, jlong, jint);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getDependencies
+ * Signature: (J)Lcom/gdme/webpulseforecast/WebPulseForecastNative/DependencyList;
+ */
+JNIEXPORT jobject JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getDependencies
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getCustomElements
+ * Signature: (J)[Lcom/gdme/webpulseforecast/WebPulseForecastNative/CustomElement;
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getCustomElements
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getExternalResources
+ * Signature: (J)[Lcom/gdme/webpulseforecast/WebPulseForecastNative/ExternalResource;
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getExternalResources
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getModulePaths
+ * Signature: (J)[Ljava/lang/String;
+ */
+JNIEXPORT jobjectArray JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getModulePaths
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    analyzeBuffers
+ * Signature: (J[Ljava/lang/String;[Ljava/nio/ByteBuffer;[Ljava/nio/ByteBuffer;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_analyzeBuffers
+  (JNIEnv *, jobject, jlong, jobjectArray, jobjectArray, jobjectArray);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getSerializedSize
+ * Signature: (J)I
+ */
+JNIEXPORT jint JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getSerializedSize
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    serializeProjectInto
+ * Signature: (JLjava/nio/ByteBuffer;)I
+ */
+JNIEXPORT jint JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_serializeProjectInto
+  (JNIEnv *, jobject, jlong, jobject);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    startAnalysis
+ * Signature: (Ljava/lang/String;Lcom/gdme/webpulseforecast/WebPulseForecastNative/AnalysisListener;)J
+ */
+JNIEXPORT jlong JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_startAnalysis
+  (JNIEnv *, jobject, jstring, jobject);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    cancelAnalysis
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_cancelAnalysis
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    releaseAnalysis
+ * Signature: (J)V
+ */
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_releaseAnalysis
+  (JNIEnv *, jobject, jlong);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    setLogListener
+ * Signature: (Lcom/gdme/webpulseforecast/WebPulseForecastNative/LogListener;I)V
+ */
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_setLogListener
+  (JNIEnv *, jobject, jobject, jint);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    setProfilingEnabled
+ * Signature: (Z)V
+ */
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_setProfilingEnabled
+  (JNIEnv *, jobject, jboolean);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    resetProfile
+ * Signature: ()V
+ */
+JNIEXPORT void JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_resetProfile
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getProfileReport
+ * Signature: ()Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getProfileReport
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    startTrace
+ * Signature: (Ljava/lang/String;)I
+ */
+JNIEXPORT jint JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_startTrace
+  (JNIEnv *, jobject, jstring);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    stopTrace
+ * Signature: ()I
+ */
+JNIEXPORT jint JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_stopTrace
+  (JNIEnv *, jobject);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    setHardwareCountersEnabled
+ * Signature: (Z)Z
+ */
+JNIEXPORT jboolean JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_setHardwareCountersEnabled
+  (JNIEnv *, jobject, jboolean);
+
+/*
+ * Class:     com_gdme_plugins_webpulseforecast_WebPulseForecastNative
+ * Method:    getMemoryReport
+ * Signature: ()Ljava/lang/String;
+ */
+JNIEXPORT jstring JNICALL Java_com_gdme_webpulseforecast_WebPulseForecastNative_getMemoryReport
+  (JNIEnv *, jobject);
+
 #ifdef __cplusplus
 }
 #endif
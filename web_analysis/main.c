@@ -176,24 +176,40 @@ static void print_node_analysis(const ProjectType* project) {
         printf("\nNotable Dependencies:\n");
         for (int i = 0; i < project->dependencies.count; i++) {
             const Dependency* dep = &project->dependencies.items[i];
+            const char* name = string_pool_get(dep->name);
             // Only show significant dependencies
             if (!dep->is_dev_dependency &&
-                (strstr(dep->name, "react") == dep->name ||    // Starts with "react"
-                 strstr(dep->name, "vue") == dep->name ||      // Starts with "vue"
-                 strstr(dep->name, "@angular") == dep->name || // Angular packages
-                 strstr(dep->name, "express") == dep->name ||  // Express.js
-                 strstr(dep->name, "next") == dep->name ||     // Next.js
-                 strstr(dep->name, "nuxt") == dep->name)) {    // Nuxt.js
-                printf("- %s@%s\n", dep->name, dep->version);
+                (strstr(name, "react") == name ||    // Starts with "react"
+                 strstr(name, "vue") == name ||      // Starts with "vue"
+                 strstr(name, "@angular") == name || // Angular packages
+                 strstr(name, "express") == name ||  // Express.js
+                 strstr(name, "next") == name ||     // Next.js
+                 strstr(name, "nuxt") == name)) {    // Nuxt.js
+                printf("- %s@%s\n", name, string_pool_get(dep->version));
             }
         }
     }
 
+    // Lockfile
+    const LockfileSummary* lockfile = &project->lockfile;
+    if (lockfile->kind[0]) {
+        printf("\nLockfile (%s, version %d, %.1f KB):\n", lockfile->kind, lockfile->lockfile_version,
+               lockfile->bytes / 1024.0);
+        printf("Installed Packages: %d (%d distinct, %d development)\n",
+               lockfile->package_count, lockfile->unique_package_count, lockfile->dev_package_count);
+        printf("Dependency Edges: %d (%d resolved)\n", lockfile->edge_count, lockfile->resolved_edge_count);
+        printf("Packages at Several Versions: %d\n", lockfile->duplicate_package_count);
+        for (int i = 0; i < lockfile->duplicate_count; i++) {
+            printf("- %s: %d versions, %d installs\n", string_pool_get(lockfile->duplicates[i].name),
+                   lockfile->duplicates[i].version_count, lockfile->duplicates[i].install_count);
+        }
+    }
+
     // Module Paths
     if (project->module_path_count > 0) {
         printf("\nLocal Modules:\n");
         for (int i = 0; i < project->module_path_count; i++) {
-            printf("- %s\n", project->module_paths[i]);
+            printf("- %s\n", string_pool_get(project->module_paths[i]));
         }
     }
 
@@ -428,13 +444,14 @@ static void print_workspace_analysis(const ProjectType* project) {
         printf("\nKey Shared Dependencies:\n");
         for (int i = 0; i < project->workspace.shared_dependencies.count; i++) {
             const Dependency* dep = &project->workspace.shared_dependencies.items[i];
+            const char* name = string_pool_get(dep->name);
             // Only show significant dependencies
-            if (strstr(dep->name, "react") == dep->name ||
-                strstr(dep->name, "vue") == dep->name ||
-                strstr(dep->name, "@angular") == dep->name ||
-                strstr(dep->name, "typescript") == dep->name ||
-                strstr(dep->name, "webpack") == dep->name) {
-                printf("- %s@%s\n", dep->name, dep->version);
+            if (strstr(name, "react") == name ||
+                strstr(name, "vue") == name ||
+                strstr(name, "@angular") == name ||
+                strstr(name, "typescript") == name ||
+                strstr(name, "webpack") == name) {
+                printf("- %s@%s\n", name, string_pool_get(dep->version));
             }
         }
     }
@@ -447,7 +464,7 @@ static void print_workspace_analysis(const ProjectType* project) {
             const TaskGroup* group = &project->workspace.task_groups[i];
             printf("\n%s (%s):\n", group->name, group->type);
             for (int j = 0; j < group->package_count; j++) {
-                printf("  - %s\n", group->packages[j]);
+                printf("  - %s\n", string_pool_get(group->packages[j]));
             }
         }
     }
@@ -493,9 +510,9 @@ static void print_workspace_analysis_detailed(const ProjectType* project) {
     printf("----------------\n");
     for (int i = 0; i < project->workspace.package_count; i++) {
         const Package* pkg = &project->workspace.packages[i];
-        printf("\nPackage #%d: %s\n", i + 1, pkg->name);
-        printf("  Path: %s\n", pkg->path);
-        printf("  Dependencies: %d\n", pkg->dependencies.count);
+        printf("\nPackage #%d: %s\n", i + 1, string_pool_get(pkg->name));
+        printf("  Path: %s\n", string_pool_get(pkg->path));
+        printf("  Dependencies: %d\n", pkg->dependency_count);
 
         // Framework information
         printf("  Technologies: ");
@@ -505,6 +522,17 @@ static void print_workspace_analysis_detailed(const ProjectType* project) {
         if (pkg->framework_info.has_nodejs) printf("Node.js ");
         printf("\n");
 
+        // Sources, from the package's own walk
+        const PackageSummary* summary = &pkg->summary;
+        printf("  Sources: %d files in %d directories (%.1f KB)%s\n",
+               summary->file_count, summary->directory_count, summary->bytes / 1024.0,
+               summary->is_incomplete ? ", incomplete" : "");
+        printf("  Files: %d JS, %d TS, %d JSX, %d Vue, %d CSS, %d HTML, %d JSON, %d images\n",
+               summary->js_file_count, summary->ts_file_count, summary->jsx_file_count,
+               summary->vue_file_count, summary->css_file_count, summary->html_file_count,
+               summary->json_file_count, summary->image_file_count);
+        if (summary->framework[0]) printf("  Framework: %s\n", summary->framework);
+
         // Package configuration
         if (pkg->config.uses_typescript) printf("  - Uses TypeScript\n");
         if (pkg->config.uses_eslint) printf("  - Uses ESLint\n");
@@ -514,13 +542,13 @@ static void print_workspace_analysis_detailed(const ProjectType* project) {
         if (pkg->config.ref_count > 0) {
             printf("  Internal Dependencies:\n");
             for (int j = 0; j < pkg->config.ref_count; j++) {
-                printf("    - %s\n", pkg->config.refs[j].target);
+                printf("    - %s\n", string_pool_get(pkg->config.refs[j].target));
             }
         }
 
         // Build information
-        if (pkg->config.build_output_path[0]) {
-            printf("  Build Output: %s\n", pkg->config.build_output_path);
+        if (pkg->config.build_output_path != STRING_ID_EMPTY) {
+            printf("  Build Output: %s\n", string_pool_get(pkg->config.build_output_path));
         }
 
         // Scripts
@@ -528,8 +556,8 @@ static void print_workspace_analysis_detailed(const ProjectType* project) {
             printf("  Scripts:\n");
             for (int j = 0; j < pkg->config.script_count; j++) {
                 printf("    - %s: %s\n",
-                       pkg->config.scripts[j].script_name,
-                       pkg->config.scripts[j].command);
+                       string_pool_get(pkg->config.scripts[j].script_name),
+                       string_pool_get(pkg->config.scripts[j].command));
             }
         }
     }
@@ -540,8 +568,8 @@ static void print_workspace_analysis_detailed(const ProjectType* project) {
     printf("Shared Dependencies: %d\n", project->workspace.shared_dependencies.count);
     for (int i = 0; i < project->workspace.shared_dependencies.count; i++) {
         printf("  - %s@%s\n",
-               project->workspace.shared_dependencies.items[i].name,
-               project->workspace.shared_dependencies.items[i].version);
+               string_pool_get(project->workspace.shared_dependencies.items[i].name),
+               string_pool_get(project->workspace.shared_dependencies.items[i].version));
     }
 
     // 4. Build Configuration
@@ -553,7 +581,29 @@ static void print_workspace_analysis_detailed(const ProjectType* project) {
             printf("\nTask Group: %s (%s)\n", group->name, group->type);
             printf("Packages:\n");
             for (int j = 0; j < group->package_count; j++) {
-                printf("  - %s\n", group->packages[j]);
+                printf("  - %s\n", string_pool_get(group->packages[j]));
+            }
+        }
+    }
+
+    const BuildGraphInfo* graph = &project->workspace.build_graph;
+    if (graph->level_count > 0 || graph->cycle_count > 0) {
+        printf("\nBuild Graph:\n");
+        printf("-----------\n");
+        printf("Levels: %d\n", graph->level_count);
+        printf("Max Parallelism: %d packages\n", graph->max_parallelism);
+        printf("Critical Path: %d packages, %lld bytes\n", graph->critical_path_length, graph->critical_path_bytes);
+        for (int i = 0; i < graph->critical_path_length; i++) {
+            printf("  %d. %s\n", i + 1, string_pool_get(graph->critical_path[i]));
+        }
+        if (graph->cycle_count > 0) {
+            printf("Reference Cycles: %d (%d packages not scheduled)\n", graph->cycle_count, graph->blocked_count);
+            for (int c = 0; c < graph->cycle_count; c++) {
+                printf("  -");
+                for (int i = graph->cycle_start[c]; i < graph->cycle_start[c + 1]; i++) {
+                    printf(" %s ->", string_pool_get(graph->cycle_packages[i]));
+                }
+                printf(" %s\n", string_pool_get(graph->cycle_packages[graph->cycle_start[c]]));
             }
         }
     }
@@ -722,18 +772,7 @@ static void print_vue_info(const VueInfo* info) {
     }
 }
 
-int main(int argc, char* argv[]) {
-    const char* project_path = argc > 1 ? argv[1] : "E:\\Software Dev\\Others CodeBases\\codeclimberscli";
-
-    printf("Analyzing project: %s\n\n", project_path);
-
-    // Analyze the project type
-    ProjectType* project = analyze_project_type(project_path);
-    if (project == NULL) {
-        fprintf(stderr, "Failed to analyze project type.\n");
-        return EXIT_FAILURE;
-    }
-
+static void print_project_report(const ProjectType* project) {
     // Project Overview
     printf("Project Analysis Summary\n");
     printf("=======================\n");
@@ -787,7 +826,7 @@ int main(int argc, char* argv[]) {
     if (project->framework_component_count > 0) {
         printf("Framework Components:\n");
         for (int i = 0; i < project->framework_component_count; i++) {
-            printf("  - %s\n", project->framework_components[i]);
+            printf("  - %s\n", string_pool_get(project->framework_components[i]));
         }
     }
 
@@ -795,7 +834,7 @@ int main(int argc, char* argv[]) {
         printf("\nCustom Elements:\n");
         for (int i = 0; i < project->custom_element_count; i++) {
             printf("  - %s (used %d times)\n",
-                   project->custom_elements[i].name,
+                   string_pool_get(project->custom_elements[i].name),
                    project->custom_elements[i].count);
         }
     }
@@ -839,9 +878,63 @@ int main(int argc, char* argv[]) {
     printf("\nPotential Issues\n");
     printf("===============\n");
     display_potential_issues(project);
+}
+
+// Several roots on the command line are analyzed together on one worker pool
+static int analyze_batch(int count, char* paths[]) {
+    BatchResult* results = calloc((size_t)count, sizeof(BatchResult));
+    if (!results) {
+        fprintf(stderr, "Memory allocation failed for batch results\n");
+        return EXIT_FAILURE;
+    }
+
+    printf("Analyzing %d projects\n\n", count);
+    int succeeded = analyze_projects_batch((const char* const*)paths, count, NULL, results);
+
+    for (int i = 0; i < count; i++) {
+        printf("\n\nProject: %s\n", results[i].project_path);
+        printf("Queued: %.2f seconds, Analysis: %.2f seconds\n",
+               results[i].queued_seconds, results[i].elapsed_seconds);
+        if (!results[i].project) {
+            fprintf(stderr, "Failed to analyze project type.\n");
+            continue;
+        }
+        print_project_report(results[i].project);
+        free_project_type(results[i].project);
+    }
+
+    printf("\n%d of %d projects analyzed\n", succeeded, count);
+    free(results);
+    return succeeded == count ? 0 : EXIT_FAILURE;
+}
+
+int main(int argc, char* argv[]) {
+    if (argc > 2) {
+        return analyze_batch(argc - 1, argv + 1);
+    }
+
+    const char* project_path = argc > 1 ? argv[1] : "E:\\Software Dev\\Others CodeBases\\codeclimberscli";
+
+    printf("Analyzing project: %s\n\n", project_path);
+
+    // Analyze the project type
+    ProjectType* project = analyze_project_type(project_path);
+    if (project == NULL) {
+        fprintf(stderr, "Failed to analyze project type.\n");
+        return EXIT_FAILURE;
+    }
+
+    print_project_report(project);
+
+    // Enabled with WEB_ANALYSIS_PROFILE=1 and/or WEB_ANALYSIS_HW_COUNTERS=1
+    if (profile_enabled > 0 || hw_counters_enabled > 0) {
+        char report[8192];
+        profile_format_report(report, sizeof(report));
+        printf("\nPhase Timings:\n%s", report);
+    }
 
     // Cleanup
-    free(project);
+    free_project_type(project);
 
     printf("\nPress Enter to exit...");
     getchar();
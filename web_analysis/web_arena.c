@@ -0,0 +1,129 @@
+#include "web_arena.h"
+#include "web_memory.h"
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#define ARENA_LOCK_TYPE SRWLOCK
+#define ARENA_LOCK_INIT(l) InitializeSRWLock(l)
+#define ARENA_LOCK(l) AcquireSRWLockExclusive(l)
+#define ARENA_UNLOCK(l) ReleaseSRWLockExclusive(l)
+#define ARENA_LOCK_DESTROY(l) ((void)(l))
+#else
+#include <pthread.h>
+#define ARENA_LOCK_TYPE pthread_mutex_t
+#define ARENA_LOCK_INIT(l) pthread_mutex_init(l, NULL)
+#define ARENA_LOCK(l) pthread_mutex_lock(l)
+#define ARENA_UNLOCK(l) pthread_mutex_unlock(l)
+#define ARENA_LOCK_DESTROY(l) pthread_mutex_destroy(l)
+#endif
+
+#define ARENA_DEFAULT_BLOCK_SIZE (64 * 1024)
+#define ARENA_ALIGNMENT 8
+
+typedef struct ArenaBlock {
+    struct ArenaBlock* next;
+    size_t used;
+    size_t capacity;
+    char data[];             // 8-aligned: the header is three words
+} ArenaBlock;
+
+struct Arena {
+    ArenaBlock* blocks;      // Newest first; only the head is bumped
+    size_t block_size;
+    size_t used;
+    size_t reserved;
+    ProfilePhase phase;
+    ARENA_LOCK_TYPE lock;
+};
+
+static ArenaBlock* new_block(Arena* arena, size_t capacity) {
+    ArenaBlock* block = mem_alloc(arena->phase, sizeof(ArenaBlock) + capacity);
+    if (!block) return NULL;
+    block->used = 0;
+    block->capacity = capacity;
+    arena->reserved += sizeof(ArenaBlock) + capacity;
+    return block;
+}
+
+Arena* arena_create(ProfilePhase phase, size_t block_size) {
+    Arena* arena = mem_alloc(phase, sizeof(Arena));
+    if (!arena) return NULL;
+    memset(arena, 0, sizeof(Arena));
+    arena->phase = phase;
+    arena->block_size = block_size ? block_size : ARENA_DEFAULT_BLOCK_SIZE;
+    ARENA_LOCK_INIT(&arena->lock);
+    return arena;
+}
+
+void* arena_alloc(Arena* arena, size_t size) {
+    if (!arena) return NULL;
+    size = (size + ARENA_ALIGNMENT - 1) & ~(size_t)(ARENA_ALIGNMENT - 1);
+    if (size == 0) size = ARENA_ALIGNMENT;
+
+    ARENA_LOCK(&arena->lock);
+    ArenaBlock* block = arena->blocks;
+    if (!block || block->capacity - block->used < size) {
+        if (size > arena->block_size / 4) {
+            // Large tables get a block of their own behind the current one,
+            // so the current block keeps taking small allocations
+            ArenaBlock* own = new_block(arena, size);
+            if (!own) {
+                ARENA_UNLOCK(&arena->lock);
+                return NULL;
+            }
+            own->used = size;
+            if (block) {
+                own->next = block->next;
+                block->next = own;
+            } else {
+                own->next = NULL;
+                arena->blocks = own;
+            }
+            arena->used += size;
+            ARENA_UNLOCK(&arena->lock);
+            memset(own->data, 0, size);
+            return own->data;
+        }
+        block = new_block(arena, arena->block_size);
+        if (!block) {
+            ARENA_UNLOCK(&arena->lock);
+            return NULL;
+        }
+        block->next = arena->blocks;
+        arena->blocks = block;
+    }
+
+    void* ptr = block->data + block->used;
+    block->used += size;
+    arena->used += size;
+    ARENA_UNLOCK(&arena->lock);
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+void* arena_copy(Arena* arena, const void* data, size_t size) {
+    void* ptr = arena_alloc(arena, size);
+    if (ptr && size) memcpy(ptr, data, size);
+    return ptr;
+}
+
+void arena_destroy(Arena* arena) {
+    if (!arena) return;
+    ArenaBlock* block = arena->blocks;
+    while (block) {
+        ArenaBlock* next = block->next;
+        mem_free(arena->phase, block, sizeof(ArenaBlock) + block->capacity);
+        block = next;
+    }
+    ARENA_LOCK_DESTROY(&arena->lock);
+    mem_free(arena->phase, arena, sizeof(Arena));
+}
+
+size_t arena_bytes_used(const Arena* arena) {
+    return arena ? arena->used : 0;
+}
+
+size_t arena_bytes_reserved(const Arena* arena) {
+    return arena ? arena->reserved : 0;
+}
@@ -0,0 +1,39 @@
+#ifndef WEB_ARENA_H
+#define WEB_ARENA_H
+
+#include <stddef.h>
+#include "web_profile.h"
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Bump allocator for tables that live and die together, such as a monorepo's
+// packages and their dependency arrays. Allocations are never freed one by
+// one; arena_destroy releases every block at once. Blocks come from mem_alloc
+// under the arena's phase, so the memory report counts them.
+//
+// Allocation is thread-safe, so packages analyzed on different workers can
+// fill their tables from the same arena.
+typedef struct Arena Arena;
+
+// block_size 0 uses the default (64 KB). Returns NULL if out of memory.
+EXPORT Arena* arena_create(ProfilePhase phase, size_t block_size);
+
+// Zeroed and aligned to 8 bytes. Requests larger than a block get a block of
+// their own. Returns NULL if out of memory.
+EXPORT void* arena_alloc(Arena* arena, size_t size);
+
+// arena_alloc followed by a copy of size bytes from data
+EXPORT void* arena_copy(Arena* arena, const void* data, size_t size);
+
+// Frees every block and the arena itself. NULL is a no-op.
+EXPORT void arena_destroy(Arena* arena);
+
+// Bytes handed out, and bytes held in blocks
+EXPORT size_t arena_bytes_used(const Arena* arena);
+EXPORT size_t arena_bytes_reserved(const Arena* arena);
+
+#endif // WEB_ARENA_H
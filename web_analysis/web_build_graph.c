@@ -0,0 +1,249 @@
+#include "web_build_graph.h"
+#include "web_memory.h"
+#include <string.h>
+
+typedef struct {
+    int node;
+    int dependency;
+} BuildEdge;
+
+struct BuildGraph {
+    int node_count;
+    ProfilePhase phase;
+    long long* weights;
+
+    // Edges as added, turned into adjacency lists when scheduling
+    BuildEdge* edges;
+    int edge_count;
+    int edge_capacity;
+
+    // Adjacency lists, results and scratch of the last schedule, one block
+    void* schedule_block;
+    size_t schedule_size;
+};
+
+BuildGraph* build_graph_create(int node_count, ProfilePhase phase) {
+    if (node_count < 0) return NULL;
+    BuildGraph* graph = mem_alloc(phase, sizeof(BuildGraph));
+    if (!graph) return NULL;
+    memset(graph, 0, sizeof(BuildGraph));
+    graph->node_count = node_count;
+    graph->phase = phase;
+    if (node_count > 0) {
+        graph->weights = mem_calloc(phase, (size_t)node_count, sizeof(long long));
+        if (!graph->weights) {
+            mem_free(phase, graph, sizeof(BuildGraph));
+            return NULL;
+        }
+    }
+    return graph;
+}
+
+int build_graph_add_edge(BuildGraph* graph, int node, int dependency) {
+    if (!graph || node < 0 || node >= graph->node_count ||
+        dependency < 0 || dependency >= graph->node_count) {
+        return 0;
+    }
+
+    if (graph->edge_count == graph->edge_capacity) {
+        int capacity = graph->edge_capacity ? graph->edge_capacity * 2 : 64;
+        BuildEdge* edges = mem_realloc(graph->phase, graph->edges,
+                                       (size_t)graph->edge_capacity * sizeof(BuildEdge),
+                                       (size_t)capacity * sizeof(BuildEdge));
+        if (!edges) return 0;
+        graph->edges = edges;
+        graph->edge_capacity = capacity;
+    }
+
+    graph->edges[graph->edge_count].node = node;
+    graph->edges[graph->edge_count].dependency = dependency;
+    graph->edge_count++;
+    return 1;
+}
+
+void build_graph_set_weight(BuildGraph* graph, int node, long long weight) {
+    if (!graph || node < 0 || node >= graph->node_count) return;
+    graph->weights[node] = weight;
+}
+
+static void release_schedule(BuildGraph* graph) {
+    mem_free(graph->phase, graph->schedule_block, graph->schedule_size);
+    graph->schedule_block = NULL;
+    graph->schedule_size = 0;
+}
+
+// Walks from an unscheduled node along unscheduled dependencies, which every
+// unscheduled node has, until the walk meets itself (a new cycle) or an
+// earlier walk. The walk is pushed at nodes + *total; only the cycle is kept.
+static int find_cycle(int start, const int* level, const int* dep_start, const int* deps,
+                      int* mark, int walk, int* position, int* nodes, int* total) {
+    int base = *total;
+    int current = start;
+    while (current >= 0 && !mark[current]) {
+        mark[current] = walk;
+        position[current] = *total;
+        nodes[(*total)++] = current;
+
+        int next = -1;
+        for (int i = dep_start[current]; i < dep_start[current + 1]; i++) {
+            if (level[deps[i]] < 0) {
+                next = deps[i];
+                break;
+            }
+        }
+        current = next;
+    }
+
+    if (current < 0 || mark[current] != walk) {
+        *total = base;
+        return 0;
+    }
+    int from = position[current];
+    int length = *total - from;
+    memmove(nodes + base, nodes + from, (size_t)length * sizeof(int));
+    *total = base + length;
+    return 1;
+}
+
+int build_graph_schedule(BuildGraph* graph, BuildSchedule* schedule) {
+    memset(schedule, 0, sizeof(BuildSchedule));
+    if (!graph) return 0;
+    release_schedule(graph);
+
+    int n = graph->node_count;
+    int e = graph->edge_count;
+    size_t int_count = (size_t)12 * n + 4 + (size_t)2 * e;
+    size_t size = (size_t)n * sizeof(long long) + int_count * sizeof(int);
+    char* block = mem_alloc(graph->phase, size);
+    if (!block) return 0;
+    memset(block, 0, size);
+    graph->schedule_block = block;
+    graph->schedule_size = size;
+
+    long long* dist = (long long*)block;      // Heaviest chain ending at a node
+    int* ints = (int*)(block + (size_t)n * sizeof(long long));
+    int* dep_start = ints;                    // n + 1
+    int* deps = dep_start + n + 1;            // e
+    int* dependent_start = deps + e;          // n + 1
+    int* dependents = dependent_start + n + 1; // e
+    int* pending = dependents + e;            // Unbuilt dependencies, then walk positions
+    int* level = pending + n;
+    int* order = level + n;
+    int* level_start = order + n;             // n + 1
+    int* pred = level_start + n + 1;          // Previous node on the heaviest chain
+    int* chain = pred + n;                    // Nodes on that chain
+    int* path = chain + n;
+    int* cycle_nodes = path + n;
+    int* cycle_start = cycle_nodes + n;       // n + 1
+    int* mark = cycle_start + n + 1;
+
+    // Adjacency lists both ways, by counting sort on the edges. level and
+    // order serve as fill cursors before they are set.
+    for (int i = 0; i < e; i++) {
+        dep_start[graph->edges[i].node + 1]++;
+        dependent_start[graph->edges[i].dependency + 1]++;
+    }
+    for (int i = 0; i < n; i++) {
+        dep_start[i + 1] += dep_start[i];
+        dependent_start[i + 1] += dependent_start[i];
+        level[i] = dep_start[i];
+        order[i] = dependent_start[i];
+    }
+    for (int i = 0; i < e; i++) {
+        int node = graph->edges[i].node;
+        int dependency = graph->edges[i].dependency;
+        deps[level[node]++] = dependency;
+        dependents[order[dependency]++] = node;
+    }
+
+    int tail = 0;
+    for (int i = 0; i < n; i++) {
+        pending[i] = dep_start[i + 1] - dep_start[i];
+        level[i] = -1;
+        pred[i] = -1;
+    }
+    for (int i = 0; i < n; i++) {
+        if (pending[i] == 0) {
+            level[i] = 0;
+            order[tail++] = i;
+        }
+    }
+
+    // Kahn's algorithm, one level at a time. A node's dependencies are all
+    // done before it is queued, so its heaviest chain is final by then.
+    int head = 0;
+    int levels = 0;
+    while (head < tail) {
+        int end = tail;
+        level_start[levels] = head;
+        if (end - head > schedule->max_parallelism) schedule->max_parallelism = end - head;
+        for (; head < end; head++) {
+            int node = order[head];
+            dist[node] += graph->weights[node];
+            chain[node]++;
+            for (int i = dependent_start[node]; i < dependent_start[node + 1]; i++) {
+                int dependent = dependents[i];
+                if (pred[dependent] < 0 || dist[node] > dist[dependent] ||
+                    (dist[node] == dist[dependent] && chain[node] > chain[dependent])) {
+                    dist[dependent] = dist[node];
+                    chain[dependent] = chain[node];
+                    pred[dependent] = node;
+                }
+                if (--pending[dependent] == 0) {
+                    level[dependent] = levels + 1;
+                    order[tail++] = dependent;
+                }
+            }
+        }
+        levels++;
+    }
+    level_start[levels] = tail;
+
+    int last = -1;
+    for (int i = 0; i < tail; i++) {
+        int node = order[i];
+        if (last < 0 || dist[node] > dist[last] || (dist[node] == dist[last] && chain[node] > chain[last])) {
+            last = node;
+        }
+    }
+    if (last >= 0) {
+        schedule->critical_path_length = chain[last];
+        schedule->critical_path_weight = dist[last];
+        int k = chain[last];
+        for (int node = last; node >= 0 && k > 0; node = pred[node]) {
+            path[--k] = node;
+        }
+    }
+
+    int cycles = 0;
+    int total = 0;
+    if (tail < n) {
+        for (int i = 0; i < n; i++) {
+            if (level[i] >= 0 || mark[i]) continue;
+            int base = total;
+            if (find_cycle(i, level, dep_start, deps, mark, i + 1, pending, cycle_nodes, &total)) {
+                cycle_start[cycles++] = base;
+            }
+        }
+    }
+    cycle_start[cycles] = total;
+
+    schedule->level = level;
+    schedule->order = order;
+    schedule->level_start = level_start;
+    schedule->level_count = levels;
+    schedule->scheduled_count = tail;
+    schedule->critical_path = path;
+    schedule->cycle_nodes = cycle_nodes;
+    schedule->cycle_start = cycle_start;
+    schedule->cycle_count = cycles;
+    return 1;
+}
+
+void build_graph_destroy(BuildGraph* graph) {
+    if (!graph) return;
+    release_schedule(graph);
+    mem_free(graph->phase, graph->edges, (size_t)graph->edge_capacity * sizeof(BuildEdge));
+    mem_free(graph->phase, graph->weights, (size_t)graph->node_count * sizeof(long long));
+    mem_free(graph->phase, graph, sizeof(BuildGraph));
+}
@@ -0,0 +1,63 @@
+#ifndef WEB_BUILD_GRAPH_H
+#define WEB_BUILD_GRAPH_H
+
+#include "web_profile.h"
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Dependency graph over nodes 0 .. node_count-1, such as the packages of a
+// workspace. An edge says a node has to be built after one of its
+// dependencies. Scheduling sorts the nodes into levels with Kahn's algorithm:
+// level 0 holds nodes without dependencies, and every other node sits one
+// level past its deepest dependency, so each level can be built in parallel.
+// Nodes on a dependency cycle, or depending on one, cannot be scheduled; the
+// cycles are reported instead.
+//
+// Scheduling is O(nodes + edges). Arrays are allocated with mem_alloc under
+// the phase given at creation.
+typedef struct BuildGraph BuildGraph;
+
+// Everything points into the graph and stays valid until build_graph_destroy
+typedef struct {
+    const int* level;            // Per node; -1 if on or behind a cycle
+    const int* order;            // Scheduled nodes, level by level
+    const int* level_start;      // level_count + 1 offsets into order
+    int level_count;
+    int scheduled_count;
+    int max_parallelism;         // Nodes in the largest level
+
+    // Heaviest chain of dependencies, first built first. Ties go to the
+    // chain with more nodes.
+    const int* critical_path;
+    int critical_path_length;
+    long long critical_path_weight;
+
+    // Each cycle as the nodes along it, each depending on the next and the
+    // last on the first. Cycles are disjoint.
+    const int* cycle_nodes;
+    const int* cycle_start;      // cycle_count + 1 offsets into cycle_nodes
+    int cycle_count;
+} BuildSchedule;
+
+// Returns NULL if out of memory
+EXPORT BuildGraph* build_graph_create(int node_count, ProfilePhase phase);
+
+// node builds after dependency. Duplicate edges are allowed. Returns 0 for an
+// out-of-range node or if out of memory.
+EXPORT int build_graph_add_edge(BuildGraph* graph, int node, int dependency);
+
+// Weight counted toward the critical path (default 0)
+EXPORT void build_graph_set_weight(BuildGraph* graph, int node, long long weight);
+
+// Sorts the graph into levels. Edges added afterwards need another call.
+// Returns 0 if out of memory.
+EXPORT int build_graph_schedule(BuildGraph* graph, BuildSchedule* schedule);
+
+// NULL is a no-op
+EXPORT void build_graph_destroy(BuildGraph* graph);
+
+#endif // WEB_BUILD_GRAPH_H
@@ -0,0 +1,246 @@
+#include "web_content_cache.h"
+#include "web_memory.h"
+#include "web_string_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+typedef SRWLOCK cache_mutex_t;
+#define mutex_init(m) InitializeSRWLock(m)
+#define mutex_destroy(m) ((void)(m))
+#define mutex_lock(m) AcquireSRWLockExclusive(m)
+#define mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#else
+#include <pthread.h>
+typedef pthread_mutex_t cache_mutex_t;
+#define mutex_init(m) pthread_mutex_init(m, NULL)
+#define mutex_destroy(m) pthread_mutex_destroy(m)
+#define mutex_lock(m) pthread_mutex_lock(m)
+#define mutex_unlock(m) pthread_mutex_unlock(m)
+#endif
+
+// Independent shards keep workers from queueing on one lock
+#define CACHE_SHARD_COUNT 16
+#define CACHE_INITIAL_SLOTS 256
+
+typedef struct {
+    uint64_t hash;
+    size_t length;
+    int kind;
+    size_t value_size;
+    void* value;        // NULL marks a free slot
+} CacheEntry;
+
+typedef struct {
+    cache_mutex_t lock;
+    CacheEntry* slots;
+    size_t capacity;
+    size_t count;
+} CacheShard;
+
+struct ContentCache {
+    CacheShard shards[CACHE_SHARD_COUNT];
+    size_t max_bytes;
+
+    // Statistics, guarded by stats_lock
+    cache_mutex_t stats_lock;
+    size_t bytes;
+    size_t hits;
+    size_t misses;
+    size_t rejected;
+};
+
+EXPORT uint64_t content_cache_hash(const void* data, size_t length) {
+    const unsigned char* bytes = (const unsigned char*)data;
+    uint64_t hash = 14695981039346656037ULL;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+static size_t slot_for(uint64_t hash, size_t length, int kind, size_t capacity) {
+    uint64_t mixed = hash ^ ((uint64_t)length * 0x9E3779B97F4A7C15ULL) ^ (uint64_t)kind;
+    return (size_t)(mixed >> 7) & (capacity - 1);
+}
+
+static CacheShard* shard_for(ContentCache* cache, uint64_t hash) {
+    return &cache->shards[hash & (CACHE_SHARD_COUNT - 1)];
+}
+
+// Must be called with the shard lock held
+static CacheEntry* find_slot(CacheShard* shard, uint64_t hash, size_t length, int kind) {
+    size_t slot = slot_for(hash, length, kind, shard->capacity);
+    for (;;) {
+        CacheEntry* entry = &shard->slots[slot];
+        if (!entry->value ||
+            (entry->hash == hash && entry->length == length && entry->kind == kind)) {
+            return entry;
+        }
+        slot = (slot + 1) & (shard->capacity - 1);
+    }
+}
+
+static int grow_shard(CacheShard* shard) {
+    size_t new_capacity = shard->capacity * 2;
+    CacheEntry* new_slots = (CacheEntry*)mem_calloc(PROFILE_PHASE_PARSE, new_capacity, sizeof(CacheEntry));
+    if (!new_slots) return 0;
+
+    for (size_t i = 0; i < shard->capacity; i++) {
+        CacheEntry* entry = &shard->slots[i];
+        if (!entry->value) continue;
+        size_t slot = slot_for(entry->hash, entry->length, entry->kind, new_capacity);
+        while (new_slots[slot].value) {
+            slot = (slot + 1) & (new_capacity - 1);
+        }
+        new_slots[slot] = *entry;
+    }
+
+    mem_free(PROFILE_PHASE_PARSE, shard->slots, shard->capacity * sizeof(CacheEntry));
+    shard->slots = new_slots;
+    shard->capacity = new_capacity;
+    return 1;
+}
+
+EXPORT ContentCache* content_cache_create(size_t max_bytes) {
+    ContentCache* cache = (ContentCache*)mem_calloc(PROFILE_PHASE_PARSE, 1, sizeof(ContentCache));
+    if (!cache) {
+        fprintf(stderr, "Memory allocation failed for ContentCache\n");
+        return NULL;
+    }
+    // Cached parse results carry string IDs, which must outlive any analysis
+    string_pool_retain();
+
+    cache->max_bytes = max_bytes ? max_bytes : CONTENT_CACHE_DEFAULT_BYTES;
+    mutex_init(&cache->stats_lock);
+
+    for (int i = 0; i < CACHE_SHARD_COUNT; i++) {
+        CacheShard* shard = &cache->shards[i];
+        mutex_init(&shard->lock);
+        shard->capacity = CACHE_INITIAL_SLOTS;
+        shard->slots = (CacheEntry*)mem_calloc(PROFILE_PHASE_PARSE, shard->capacity, sizeof(CacheEntry));
+        if (!shard->slots) {
+            fprintf(stderr, "Memory allocation failed for cache shard\n");
+            content_cache_destroy(cache);
+            return NULL;
+        }
+    }
+    return cache;
+}
+
+EXPORT void content_cache_destroy(ContentCache* cache) {
+    if (!cache) return;
+
+    for (int i = 0; i < CACHE_SHARD_COUNT; i++) {
+        CacheShard* shard = &cache->shards[i];
+        if (shard->slots) {
+            for (size_t j = 0; j < shard->capacity; j++) {
+                mem_free(PROFILE_PHASE_PARSE, shard->slots[j].value, shard->slots[j].value_size);
+            }
+            mem_free(PROFILE_PHASE_PARSE, shard->slots, shard->capacity * sizeof(CacheEntry));
+        }
+        mutex_destroy(&shard->lock);
+    }
+    mutex_destroy(&cache->stats_lock);
+    mem_free(PROFILE_PHASE_PARSE, cache, sizeof(ContentCache));
+    string_pool_release();
+}
+
+EXPORT size_t content_cache_lookup(ContentCache* cache, uint64_t hash, size_t length, int kind,
+                                   void* out, size_t out_size) {
+    if (!cache || !out) return 0;
+
+    CacheShard* shard = shard_for(cache, hash);
+    size_t copied = 0;
+
+    mutex_lock(&shard->lock);
+    CacheEntry* entry = find_slot(shard, hash, length, kind);
+    if (entry->value && entry->value_size <= out_size) {
+        memcpy(out, entry->value, entry->value_size);
+        copied = entry->value_size;
+    }
+    mutex_unlock(&shard->lock);
+
+    mutex_lock(&cache->stats_lock);
+    if (copied) {
+        cache->hits++;
+    } else {
+        cache->misses++;
+    }
+    mutex_unlock(&cache->stats_lock);
+
+    return copied;
+}
+
+EXPORT int content_cache_store(ContentCache* cache, uint64_t hash, size_t length, int kind,
+                               const void* value, size_t value_size) {
+    if (!cache || !value || value_size == 0) return 0;
+
+    // Reserve budget up front so concurrent stores cannot overshoot it
+    mutex_lock(&cache->stats_lock);
+    int fits = cache->bytes + value_size <= cache->max_bytes;
+    if (fits) {
+        cache->bytes += value_size;
+    } else {
+        cache->rejected++;
+    }
+    mutex_unlock(&cache->stats_lock);
+    if (!fits) return 0;
+
+    void* copy = mem_alloc(PROFILE_PHASE_PARSE, value_size);
+    int stored = 0;
+    if (copy) {
+        memcpy(copy, value, value_size);
+
+        CacheShard* shard = shard_for(cache, hash);
+        mutex_lock(&shard->lock);
+        // Keep the table at most half full
+        if ((shard->count + 1) * 2 <= shard->capacity || grow_shard(shard)) {
+            CacheEntry* entry = find_slot(shard, hash, length, kind);
+            if (!entry->value) {
+                entry->hash = hash;
+                entry->length = length;
+                entry->kind = kind;
+                entry->value_size = value_size;
+                entry->value = copy;
+                shard->count++;
+                copy = NULL;
+                stored = 1;
+            } else {
+                // Another worker parsed the same content first
+                stored = -1;
+            }
+        }
+        mutex_unlock(&shard->lock);
+        mem_free(PROFILE_PHASE_PARSE, copy, value_size);
+    }
+
+    if (stored != 1) {
+        mutex_lock(&cache->stats_lock);
+        cache->bytes -= value_size;
+        mutex_unlock(&cache->stats_lock);
+    }
+    return stored != 0;
+}
+
+EXPORT ContentCacheStats content_cache_stats(ContentCache* cache) {
+    ContentCacheStats stats = {0};
+    if (!cache) return stats;
+
+    for (int i = 0; i < CACHE_SHARD_COUNT; i++) {
+        mutex_lock(&cache->shards[i].lock);
+        stats.entries += cache->shards[i].count;
+        mutex_unlock(&cache->shards[i].lock);
+    }
+
+    mutex_lock(&cache->stats_lock);
+    stats.bytes = cache->bytes;
+    stats.hits = cache->hits;
+    stats.misses = cache->misses;
+    stats.rejected = cache->rejected;
+    mutex_unlock(&cache->stats_lock);
+    return stats;
+}
@@ -0,0 +1,48 @@
+#ifndef WEB_CONTENT_CACHE_H
+#define WEB_CONTENT_CACHE_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Default budget for cached parse results
+#define CONTENT_CACHE_DEFAULT_BYTES (64 * 1024 * 1024)
+
+// Thread-safe cache of parse results keyed by a hash of the file content, its
+// length and the kind of parse. Identical files seen again, in the same
+// project or in another root of a batch, reuse the earlier result.
+typedef struct ContentCache ContentCache;
+
+typedef struct {
+    size_t entries;
+    size_t bytes;
+    size_t hits;
+    size_t misses;
+    size_t rejected;   // Stores skipped because the budget was exhausted
+} ContentCacheStats;
+
+// max_bytes of 0 uses CONTENT_CACHE_DEFAULT_BYTES
+EXPORT ContentCache* content_cache_create(size_t max_bytes);
+EXPORT void content_cache_destroy(ContentCache* cache);
+
+// 64-bit FNV-1a over the content
+EXPORT uint64_t content_cache_hash(const void* data, size_t length);
+
+// Copies a cached value into out and returns its size, or returns 0 on a
+// miss. Values larger than out_size are treated as a miss.
+EXPORT size_t content_cache_lookup(ContentCache* cache, uint64_t hash, size_t length, int kind,
+                                   void* out, size_t out_size);
+
+// Stores a copy of value. Returns 1 if stored (or already present), 0 if the
+// budget is exhausted or allocation failed.
+EXPORT int content_cache_store(ContentCache* cache, uint64_t hash, size_t length, int kind,
+                               const void* value, size_t value_size);
+
+EXPORT ContentCacheStats content_cache_stats(ContentCache* cache);
+
+#endif // WEB_CONTENT_CACHE_H
@@ -0,0 +1,224 @@
+#include "web_hw_counters.h"
+#include "web_log.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <linux/perf_event.h>
+#include <pthread.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#ifdef _MSC_VER
+static __forceinline long long load_i64(volatile long long* p) { return InterlockedCompareExchange64(p, 0, 0); }
+static __forceinline void store_i64(volatile long long* p, long long v) { InterlockedExchange64(p, v); }
+static __forceinline void add_i64(volatile long long* p, long long v) { InterlockedExchangeAdd64(p, v); }
+static __forceinline long load_long(volatile long* p) { return InterlockedCompareExchange(p, 0, 0); }
+static __forceinline void or_long(volatile long* p, long v) { InterlockedOr(p, v); }
+static __forceinline long exchange_long(volatile long* p, long v) { return InterlockedExchange(p, v); }
+#else
+static inline long long load_i64(volatile long long* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline void store_i64(volatile long long* p, long long v) { __atomic_store_n(p, v, __ATOMIC_RELAXED); }
+static inline void add_i64(volatile long long* p, long long v) { __atomic_add_fetch(p, v, __ATOMIC_RELAXED); }
+static inline long load_long(volatile long* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline void or_long(volatile long* p, long v) { __atomic_or_fetch(p, v, __ATOMIC_RELAXED); }
+static inline long exchange_long(volatile long* p, long v) { return __atomic_exchange_n(p, v, __ATOMIC_RELAXED); }
+#endif
+
+static const char* counter_names[HW_COUNTER_COUNT] = {
+    "cycles", "instructions", "branch_misses", "l1d_misses", "llc_misses"
+};
+
+// Per phase: samples, then one total per counter. Relaxed like the profile.
+static volatile long long totals[PROFILE_PHASE_COUNT][HW_COUNTER_COUNT + 1];
+static volatile long available;
+
+static int initial_enabled(void) {
+    const char* value = getenv(HW_COUNTERS_ENV_VAR);
+    return value && *value && strcmp(value, "0") != 0;
+}
+
+volatile int hw_counters_enabled = -1;
+
+#ifdef __linux__
+
+typedef struct {
+    int state;                       // 0 until opened, 1 open, -1 unavailable
+    int leader;                      // Group leader fd, read for the whole group
+    int opened;                      // Group members, in read order
+    int fds[HW_COUNTER_COUNT];
+    int slot[HW_COUNTER_COUNT];      // Position in the group read, -1 if not open
+} ThreadCounters;
+
+static __thread ThreadCounters* local_counters;
+static pthread_key_t counters_key;
+static pthread_once_t counters_once = PTHREAD_ONCE_INIT;
+static volatile long unavailable_logged;
+
+// Closes a worker's counters when it exits
+static void close_counters(void* value) {
+    ThreadCounters* counters = (ThreadCounters*)value;
+    for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+        if (counters->fds[i] >= 0) close(counters->fds[i]);
+    }
+    free(counters);
+}
+
+static void create_key(void) {
+    pthread_key_create(&counters_key, close_counters);
+}
+
+static void event_config(HwCounter counter, struct perf_event_attr* attr) {
+    attr->type = PERF_TYPE_HARDWARE;
+    switch (counter) {
+        case HW_COUNTER_CYCLES: attr->config = PERF_COUNT_HW_CPU_CYCLES; break;
+        case HW_COUNTER_INSTRUCTIONS: attr->config = PERF_COUNT_HW_INSTRUCTIONS; break;
+        case HW_COUNTER_BRANCH_MISSES: attr->config = PERF_COUNT_HW_BRANCH_MISSES; break;
+        case HW_COUNTER_L1D_MISSES:
+            attr->type = PERF_TYPE_HW_CACHE;
+            attr->config = PERF_COUNT_HW_CACHE_L1D |
+                           (PERF_COUNT_HW_CACHE_OP_READ << 8) |
+                           (PERF_COUNT_HW_CACHE_RESULT_MISS << 16);
+            break;
+        case HW_COUNTER_LLC_MISSES: attr->config = PERF_COUNT_HW_CACHE_MISSES; break;
+        default: break;
+    }
+}
+
+static ThreadCounters* open_counters(void) {
+    pthread_once(&counters_once, create_key);
+
+    ThreadCounters* counters = calloc(1, sizeof(ThreadCounters));
+    if (!counters) return NULL;
+    counters->leader = -1;
+
+    int first_error = 0;
+    for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+        counters->fds[i] = -1;
+        counters->slot[i] = -1;
+
+        struct perf_event_attr attr;
+        memset(&attr, 0, sizeof(attr));
+        attr.size = sizeof(attr);
+        event_config((HwCounter)i, &attr);
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        attr.read_format = PERF_FORMAT_GROUP | PERF_FORMAT_TOTAL_TIME_ENABLED |
+                           PERF_FORMAT_TOTAL_TIME_RUNNING;
+
+        // This thread only, on whichever CPU it runs
+        int fd = (int)syscall(SYS_perf_event_open, &attr, 0, -1, counters->leader, PERF_FLAG_FD_CLOEXEC);
+        if (fd < 0) {
+            if (!first_error) first_error = errno;
+            continue;
+        }
+        if (counters->leader < 0) counters->leader = fd;
+        counters->fds[i] = fd;
+        counters->slot[i] = counters->opened++;
+        or_long(&available, 1L << i);
+    }
+
+    counters->state = counters->leader >= 0 ? 1 : -1;
+    if (first_error && exchange_long(&unavailable_logged, 1) == 0) {
+        LOG_INFO(LOG_CAT_CORE, "Some hardware counters are unavailable (%s)%s", strerror(first_error),
+                 counters->state < 0 ? "; counting disabled" : "");
+    }
+
+    pthread_setspecific(counters_key, counters);
+    local_counters = counters;
+    return counters;
+}
+
+static int read_counters(HwCounts* out) {
+    ThreadCounters* counters = local_counters ? local_counters : open_counters();
+    if (!counters || counters->state < 0) return 0;
+
+    unsigned long long buffer[3 + HW_COUNTER_COUNT];
+    ssize_t expected = (ssize_t)((3 + counters->opened) * sizeof(unsigned long long));
+    if (read(counters->leader, buffer, sizeof(buffer)) < expected) return 0;
+
+    out->time_enabled = (long long)buffer[1];
+    out->time_running = (long long)buffer[2];
+    for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+        out->values[i] = counters->slot[i] >= 0 ? (long long)buffer[3 + counters->slot[i]] : 0;
+    }
+    return 1;
+}
+
+#else
+
+static int read_counters(HwCounts* out) {
+    (void)out;
+    return 0;
+}
+
+#endif
+
+int hw_counters_set_enabled(int enabled) {
+    hw_counters_enabled = enabled ? 1 : 0;
+    HwCounts probe;
+    return enabled && read_counters(&probe);
+}
+
+void hw_counters_reset(void) {
+    for (int phase = 0; phase < PROFILE_PHASE_COUNT; phase++) {
+        for (int i = 0; i <= HW_COUNTER_COUNT; i++) store_i64(&totals[phase][i], 0);
+    }
+}
+
+unsigned int hw_counters_available(void) {
+    return (unsigned int)load_long(&available);
+}
+
+const char* hw_counter_name(HwCounter counter) {
+    return (counter >= 0 && counter < HW_COUNTER_COUNT) ? counter_names[counter] : "unknown";
+}
+
+int hw_counters_read(HwCounts* out) {
+    if (hw_counters_enabled < 0) hw_counters_enabled = initial_enabled();
+    if (!hw_counters_enabled) return 0;
+    return read_counters(out);
+}
+
+int hw_counters_delta(const HwCounts* start, HwCounts* delta) {
+    HwCounts now;
+    if (!read_counters(&now)) return 0;
+
+    delta->time_enabled = now.time_enabled - start->time_enabled;
+    delta->time_running = now.time_running - start->time_running;
+
+    // While the PMU is oversubscribed the group only runs part of the time
+    double scale = 1.0;
+    if (delta->time_running <= 0) scale = 0.0;
+    else if (delta->time_running < delta->time_enabled) scale = (double)delta->time_enabled / delta->time_running;
+
+    for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+        delta->values[i] = (long long)((now.values[i] - start->values[i]) * scale);
+    }
+    return 1;
+}
+
+void hw_counters_add(ProfilePhase phase, const HwCounts* delta) {
+    if (phase < 0 || phase >= PROFILE_PHASE_COUNT) return;
+    add_i64(&totals[phase][0], 1);
+    for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+        if (delta->values[i]) add_i64(&totals[phase][i + 1], delta->values[i]);
+    }
+}
+
+int hw_counters_snapshot(HwPhaseCounts* out, int capacity) {
+    int count = capacity < PROFILE_PHASE_COUNT ? capacity : PROFILE_PHASE_COUNT;
+    for (int phase = 0; phase < count; phase++) {
+        out[phase].samples = load_i64(&totals[phase][0]);
+        for (int i = 0; i < HW_COUNTER_COUNT; i++) {
+            out[phase].values[i] = load_i64(&totals[phase][i + 1]);
+        }
+    }
+    return count;
+}
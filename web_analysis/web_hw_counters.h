@@ -0,0 +1,79 @@
+#ifndef WEB_HW_COUNTERS_H
+#define WEB_HW_COUNTERS_H
+
+#include "web_profile.h"
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Hardware performance counters per profile phase, read through Linux
+// perf_event_open. Each thread opens its own counter group on first use and
+// counts user-space events for itself only, so a phase's totals cover the
+// threads that ran it. Counters the kernel, PMU or container refuses are left
+// out; when none open, sampling turns into a no-op and the report omits them.
+// Other platforms never have counters. Off until enabled through
+// hw_counters_set_enabled or HW_COUNTERS_ENV_VAR=1.
+#define HW_COUNTERS_ENV_VAR "WEB_ANALYSIS_HW_COUNTERS"
+
+typedef enum {
+    HW_COUNTER_CYCLES,
+    HW_COUNTER_INSTRUCTIONS,
+    HW_COUNTER_BRANCH_MISSES,
+    HW_COUNTER_L1D_MISSES,       // L1 data cache read misses
+    HW_COUNTER_LLC_MISSES,       // Last-level cache misses
+    HW_COUNTER_COUNT
+} HwCounter;
+
+// One reading of the calling thread's counters, or the events between two
+// readings as computed by hw_counters_delta (then scaled for multiplexing).
+// Counters this thread could not open stay 0.
+typedef struct {
+    long long values[HW_COUNTER_COUNT];
+    long long time_enabled;
+    long long time_running;
+} HwCounts;
+
+typedef struct {
+    long long samples;
+    long long values[HW_COUNTER_COUNT];
+} HwPhaseCounts;
+
+// Checked inline by HW_COUNTERS_START; -1 until resolved from the environment
+extern EXPORT volatile int hw_counters_enabled;
+
+// Returns the resulting state: 1 if enabled and the calling thread has at
+// least one counter, else 0.
+EXPORT int hw_counters_set_enabled(int enabled);
+EXPORT void hw_counters_reset(void);
+
+// Bit (1 << HwCounter) for every counter some thread managed to open
+EXPORT unsigned int hw_counters_available(void);
+
+EXPORT const char* hw_counter_name(HwCounter counter);
+
+// Reads the calling thread's counters into out. Returns 0 if counting is
+// disabled or unavailable on this thread.
+EXPORT int hw_counters_read(HwCounts* out);
+
+// Stores the events since start in delta. Returns 0 if counting stopped.
+EXPORT int hw_counters_delta(const HwCounts* start, HwCounts* delta);
+
+// Adds one sample of events to a phase
+EXPORT void hw_counters_add(ProfilePhase phase, const HwCounts* delta);
+
+// Copies the totals in ProfilePhase order. Returns the number copied.
+EXPORT int hw_counters_snapshot(HwPhaseCounts* out, int capacity);
+
+#define HW_COUNTERS_START(mark) \
+    HwCounts mark; \
+    int mark##_on = hw_counters_enabled && hw_counters_read(&mark)
+
+#define HW_COUNTERS_END(phase, mark) do { \
+    HwCounts mark##_delta; \
+    if (mark##_on && hw_counters_delta(&mark, &mark##_delta)) hw_counters_add(phase, &mark##_delta); \
+} while (0)
+
+#endif // WEB_HW_COUNTERS_H
@@ -0,0 +1,943 @@
+#include "web_lockfile.h"
+#include "web_memory.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define LOCKFILE_PATH_SIZE 1024
+#define LOCKFILE_MAX_DEPTH 64    // npm v1 nesting followed before skipping
+
+// Read-only view of a whole file
+typedef struct {
+    const char* data;
+    size_t size;
+#ifdef _WIN32
+    HANDLE mapping;
+#endif
+} MappedFile;
+
+static int map_file(const char* path, MappedFile* map) {
+    memset(map, 0, sizeof(MappedFile));
+#ifdef _WIN32
+    HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+                              FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+    if (file == INVALID_HANDLE_VALUE) return 0;
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+        CloseHandle(file);
+        return 0;
+    }
+    map->size = (size_t)size.QuadPart;
+    if (map->size == 0) {
+        CloseHandle(file);
+        map->data = "";
+        return 1;
+    }
+    map->mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+    CloseHandle(file);
+    if (!map->mapping) return 0;
+    map->data = MapViewOfFile(map->mapping, FILE_MAP_READ, 0, 0, 0);
+    if (!map->data) {
+        CloseHandle(map->mapping);
+        return 0;
+    }
+    return 1;
+#else
+    int fd = open(path, O_RDONLY);
+    if (fd < 0) return 0;
+    struct stat st;
+    if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode)) {
+        close(fd);
+        return 0;
+    }
+    map->size = (size_t)st.st_size;
+    if (map->size == 0) {
+        close(fd);
+        map->data = "";
+        return 1;
+    }
+    void* data = mmap(NULL, map->size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (data == MAP_FAILED) return 0;
+#ifdef MADV_SEQUENTIAL
+    madvise(data, map->size, MADV_SEQUENTIAL);
+#endif
+    map->data = data;
+    return 1;
+#endif
+}
+
+static void unmap_file(MappedFile* map) {
+    if (map->size == 0) return;
+#ifdef _WIN32
+    UnmapViewOfFile(map->data);
+    CloseHandle(map->mapping);
+#else
+    munmap((void*)map->data, map->size);
+#endif
+}
+
+// Open-addressed map from a 64-bit key to a non-negative int
+typedef struct {
+    uint64_t* keys;
+    int* values;             // Value + 1, 0 for a free slot
+    int capacity;            // Power of two
+    int count;
+} KeyMap;
+
+static uint64_t mix64(uint64_t x) {
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return x;
+}
+
+static void keymap_free(KeyMap* map) {
+    mem_free(PROFILE_PHASE_LOCKFILE, map->keys, (size_t)map->capacity * sizeof(uint64_t));
+    mem_free(PROFILE_PHASE_LOCKFILE, map->values, (size_t)map->capacity * sizeof(int));
+    memset(map, 0, sizeof(KeyMap));
+}
+
+static int keymap_get(const KeyMap* map, uint64_t key) {
+    if (map->capacity == 0) return -1;
+    uint32_t mask = (uint32_t)(map->capacity - 1);
+    for (uint32_t slot = (uint32_t)mix64(key) & mask; map->values[slot]; slot = (slot + 1) & mask) {
+        if (map->keys[slot] == key) return map->values[slot] - 1;
+    }
+    return -1;
+}
+
+// Keeps the first value stored for a key. Returns 0 if out of memory.
+static int keymap_put(KeyMap* map, uint64_t key, int value) {
+    if ((map->count + 1) * 2 > map->capacity) {
+        int capacity = map->capacity ? map->capacity * 2 : 1024;
+        uint64_t* keys = mem_alloc(PROFILE_PHASE_LOCKFILE, (size_t)capacity * sizeof(uint64_t));
+        int* values = mem_calloc(PROFILE_PHASE_LOCKFILE, (size_t)capacity, sizeof(int));
+        if (!keys || !values) {
+            mem_free(PROFILE_PHASE_LOCKFILE, keys, (size_t)capacity * sizeof(uint64_t));
+            mem_free(PROFILE_PHASE_LOCKFILE, values, (size_t)capacity * sizeof(int));
+            return 0;
+        }
+        for (int i = 0; i < map->capacity; i++) {
+            if (!map->values[i]) continue;
+            uint32_t slot = (uint32_t)mix64(map->keys[i]) & (uint32_t)(capacity - 1);
+            while (values[slot]) slot = (slot + 1) & (uint32_t)(capacity - 1);
+            keys[slot] = map->keys[i];
+            values[slot] = map->values[i];
+        }
+        int count = map->count;
+        keymap_free(map);
+        map->keys = keys;
+        map->values = values;
+        map->capacity = capacity;
+        map->count = count;
+    }
+
+    uint32_t mask = (uint32_t)(map->capacity - 1);
+    uint32_t slot = (uint32_t)mix64(key) & mask;
+    while (map->values[slot]) {
+        if (map->keys[slot] == key) return 1;
+        slot = (slot + 1) & mask;
+    }
+    map->keys[slot] = key;
+    map->values[slot] = value + 1;
+    map->count++;
+    return 1;
+}
+
+static uint64_t pair_key(uint32_t high, uint32_t low) {
+    return ((uint64_t)high << 32) | low;
+}
+
+// FNV-1a, 64-bit, so spans can be keyed without interning them
+#define FNV64_OFFSET 14695981039346656037ULL
+
+static uint64_t hash_bytes(uint64_t hash, const char* data, size_t length) {
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)data[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+typedef struct {
+    const char* s;
+    size_t n;
+} Span;
+
+static int span_is(Span span, const char* literal) {
+    size_t length = strlen(literal);
+    return span.n == length && memcmp(span.s, literal, length) == 0;
+}
+
+static int span_starts(Span span, const char* literal) {
+    size_t length = strlen(literal);
+    return span.n >= length && memcmp(span.s, literal, length) == 0;
+}
+
+static Span span_trim(Span span) {
+    while (span.n && (span.s[0] == ' ' || span.s[0] == '\t')) {
+        span.s++;
+        span.n--;
+    }
+    while (span.n && (span.s[span.n - 1] == ' ' || span.s[span.n - 1] == '\t' || span.s[span.n - 1] == '\r')) {
+        span.n--;
+    }
+    return span;
+}
+
+static Span span_unquote(Span span) {
+    span = span_trim(span);
+    if (span.n >= 2 && (span.s[0] == '"' || span.s[0] == '\'') && span.s[span.n - 1] == span.s[0]) {
+        span.s++;
+        span.n -= 2;
+    }
+    return span;
+}
+
+// Leading digits of a span, so version numbers never read past a mapping
+static int span_int(Span span) {
+    int value = 0;
+    for (size_t i = 0; i < span.n && span.s[i] >= '0' && span.s[i] <= '9'; i++) {
+        value = value * 10 + (span.s[i] - '0');
+    }
+    return value;
+}
+
+// Removes a quote at either end, which need not pair up when a list of
+// quoted items was split on commas
+static Span strip_quotes(Span span) {
+    span = span_trim(span);
+    if (span.n && (span.s[0] == '"' || span.s[0] == '\'')) {
+        span.s++;
+        span.n--;
+    }
+    if (span.n && (span.s[span.n - 1] == '"' || span.s[span.n - 1] == '\'')) span.n--;
+    return span;
+}
+
+static StringId intern_span(Span span) {
+    return span.n ? string_pool_intern_n(span.s, span.n) : STRING_ID_EMPTY;
+}
+
+// Scan state shared by the three formats
+typedef struct {
+    LockfileGraph* graph;
+    const char* p;
+    const char* end;
+    int failed;              // Out of memory; the graph is discarded
+
+    int* parents;            // npm: package whose node_modules holds each one
+    int parent_capacity;
+    KeyMap paths;            // npm: hash of the install path -> package
+    KeyMap children;         // npm: (parent + 1, name) -> package
+    KeyMap descriptors;      // yarn: hash of "name@range" -> package
+    KeyMap versions;         // pnpm: (name, version) -> package
+    KeyMap snapshots;        // pnpm 9: packages whose edges are recorded
+} LockReader;
+
+static int add_package(LockReader* r, StringId name, StringId version, int parent) {
+    LockfileGraph* graph = r->graph;
+    if (graph->package_count == graph->package_capacity) {
+        int capacity = graph->package_capacity ? graph->package_capacity * 2 : 256;
+        LockfilePackage* packages = mem_realloc(PROFILE_PHASE_LOCKFILE, graph->packages,
+                                                (size_t)graph->package_capacity * sizeof(LockfilePackage),
+                                                (size_t)capacity * sizeof(LockfilePackage));
+        if (!packages) {
+            r->failed = 1;
+            return -1;
+        }
+        graph->packages = packages;
+        graph->package_capacity = capacity;
+    }
+    if (parent != -1 || r->parents) {
+        if (r->parent_capacity < graph->package_capacity) {
+            int* parents = mem_realloc(PROFILE_PHASE_LOCKFILE, r->parents,
+                                       (size_t)r->parent_capacity * sizeof(int),
+                                       (size_t)graph->package_capacity * sizeof(int));
+            if (!parents) {
+                r->failed = 1;
+                return -1;
+            }
+            for (int i = r->parent_capacity; i < graph->package_capacity; i++) parents[i] = -1;
+            r->parents = parents;
+            r->parent_capacity = graph->package_capacity;
+        }
+        r->parents[graph->package_count] = parent;
+    }
+
+    int index = graph->package_count++;
+    LockfilePackage* pkg = &graph->packages[index];
+    pkg->name = name;
+    pkg->version = version;
+    pkg->is_dev = 0;
+    return index;
+}
+
+static void add_edge(LockReader* r, int source, StringId name, StringId range) {
+    LockfileGraph* graph = r->graph;
+    if (source < 0 || name == STRING_ID_EMPTY) return;
+    if (graph->edge_count == graph->edge_capacity) {
+        int capacity = graph->edge_capacity ? graph->edge_capacity * 2 : 1024;
+        LockfileEdge* edges = mem_realloc(PROFILE_PHASE_LOCKFILE, graph->edges,
+                                          (size_t)graph->edge_capacity * sizeof(LockfileEdge),
+                                          (size_t)capacity * sizeof(LockfileEdge));
+        if (!edges) {
+            r->failed = 1;
+            return;
+        }
+        graph->edges = edges;
+        graph->edge_capacity = capacity;
+    }
+    LockfileEdge* edge = &graph->edges[graph->edge_count++];
+    edge->source = source;
+    edge->target = -1;
+    edge->name = name;
+    edge->range = range;
+}
+
+static void put_key(LockReader* r, KeyMap* map, uint64_t key, int value) {
+    if (!keymap_put(map, key, value)) r->failed = 1;
+}
+
+// JSON, for package-lock.json. Values the reader does not need are skipped
+// without being decoded.
+
+static void skip_space(LockReader* r) {
+    while (r->p < r->end && (*r->p == ' ' || *r->p == '\n' || *r->p == '\r' || *r->p == '\t')) r->p++;
+}
+
+// At an opening quote: the string's raw contents, escapes left as they are
+static Span read_string(LockReader* r) {
+    Span span = { r->p + 1, 0 };
+    const char* p = r->p + 1;
+    while (p < r->end && *p != '"') {
+        p += (*p == '\\') ? 2 : 1;
+    }
+    if (p > r->end) p = r->end;
+    span.n = (size_t)(p - span.s);
+    r->p = (p < r->end) ? p + 1 : r->end;
+    return span;
+}
+
+static void skip_value(LockReader* r) {
+    skip_space(r);
+    if (r->p >= r->end) return;
+    if (*r->p == '"') {
+        read_string(r);
+        return;
+    }
+    if (*r->p == '{' || *r->p == '[') {
+        int depth = 0;
+        while (r->p < r->end) {
+            char c = *r->p;
+            if (c == '"') {
+                read_string(r);
+                continue;
+            }
+            r->p++;
+            if (c == '{' || c == '[') {
+                depth++;
+            } else if (c == '}' || c == ']') {
+                if (--depth == 0) return;
+            }
+        }
+        return;
+    }
+    while (r->p < r->end && *r->p != ',' && *r->p != '}' && *r->p != ']') r->p++;
+}
+
+// Steps into an object value. Anything else is skipped and returns 0.
+static int enter_object(LockReader* r) {
+    skip_space(r);
+    if (r->p < r->end && *r->p == '{') {
+        r->p++;
+        return 1;
+    }
+    skip_value(r);
+    return 0;
+}
+
+// Moves to the value of the next member of the current object. Returns 0
+// after the closing brace.
+static int next_member(LockReader* r, Span* key) {
+    skip_space(r);
+    if (r->p < r->end && *r->p == ',') {
+        r->p++;
+        skip_space(r);
+    }
+    if (r->p >= r->end || *r->p != '"') {
+        // Closing brace, or a malformed file that ends the scan
+        r->p = (r->p < r->end && *r->p == '}') ? r->p + 1 : r->end;
+        return 0;
+    }
+    *key = read_string(r);
+    skip_space(r);
+    if (r->p < r->end && *r->p == ':') r->p++;
+    skip_space(r);
+    return 1;
+}
+
+static int read_true(LockReader* r) {
+    int is_true = (r->end - r->p >= 4 && memcmp(r->p, "true", 4) == 0);
+    skip_value(r);
+    return is_true;
+}
+
+static StringId read_string_value(LockReader* r) {
+    skip_space(r);
+    if (r->p < r->end && *r->p == '"') return intern_span(read_string(r));
+    skip_value(r);
+    return STRING_ID_EMPTY;
+}
+
+// A { "name": "range" } object as edges from source
+static void read_npm_requirements(LockReader* r, int source) {
+    if (!enter_object(r)) return;
+    Span key;
+    while (next_member(r, &key)) {
+        StringId range = read_string_value(r);
+        add_edge(r, source, intern_span(key), range);
+    }
+}
+
+// Members of a package entry, shared by both npm layouts. Returns 1 for a
+// link to a folder in the project, which is not an install.
+static int read_npm_entry(LockReader* r, int index, int depth);
+
+static void read_npm_dependencies_v1(LockReader* r, int parent, int depth) {
+    if (!enter_object(r)) return;
+    Span key;
+    while (next_member(r, &key)) {
+        if (depth >= LOCKFILE_MAX_DEPTH || r->failed) {
+            skip_value(r);
+            continue;
+        }
+        StringId name = intern_span(key);
+        int index = add_package(r, name, STRING_ID_EMPTY, parent);
+        if (index < 0) {
+            skip_value(r);
+            continue;
+        }
+        put_key(r, &r->children, pair_key((uint32_t)(parent + 1), name), index);
+        read_npm_entry(r, index, depth + 1);
+    }
+}
+
+static int read_npm_entry(LockReader* r, int index, int depth) {
+    int is_link = 0;
+    if (!enter_object(r)) return 0;
+    Span key;
+    while (next_member(r, &key)) {
+        if (span_is(key, "version")) {
+            r->graph->packages[index].version = read_string_value(r);
+        } else if (span_is(key, "dev")) {
+            r->graph->packages[index].is_dev = read_true(r);
+        } else if (span_is(key, "link")) {
+            is_link = read_true(r);
+        } else if (span_is(key, "requires") || span_is(key, "optionalDependencies")) {
+            read_npm_requirements(r, index);
+        } else if (span_is(key, "dependencies")) {
+            // Lockfile v1 nests installs here; later versions list requirements
+            if (r->graph->lockfile_version == 1) {
+                read_npm_dependencies_v1(r, index, depth);
+            } else {
+                read_npm_requirements(r, index);
+            }
+        } else {
+            skip_value(r);
+        }
+    }
+    return is_link;
+}
+
+static const char* find_last(Span span, const char* needle) {
+    size_t length = strlen(needle);
+    if (span.n < length) return NULL;
+    for (size_t i = span.n - length + 1; i-- > 0;) {
+        if (memcmp(span.s + i, needle, length) == 0) return span.s + i;
+    }
+    return NULL;
+}
+
+// "packages" of lockfile v2 and v3: install path -> entry. Parents sort
+// before their nested installs, so each parent is known by the time a child
+// is read.
+static void read_npm_packages(LockReader* r) {
+    if (!enter_object(r)) return;
+    Span key;
+    while (next_member(r, &key)) {
+        // The root project ("") and workspace folders are not installs
+        const char* installed = find_last(key, "node_modules/");
+        if (!installed || r->failed) {
+            skip_value(r);
+            continue;
+        }
+        Span name = { installed + 13, (size_t)(key.s + key.n - installed - 13) };
+        int parent = -1;
+        if (installed > key.s + 1) {
+            parent = keymap_get(&r->paths, hash_bytes(FNV64_OFFSET, key.s, (size_t)(installed - 1 - key.s)));
+        }
+
+        int index = add_package(r, intern_span(name), STRING_ID_EMPTY, parent);
+        if (index < 0) {
+            skip_value(r);
+            continue;
+        }
+        int edges_before = r->graph->edge_count;
+        if (read_npm_entry(r, index, 0)) {
+            r->graph->package_count--;
+            r->graph->edge_count = edges_before;
+            continue;
+        }
+        put_key(r, &r->paths, hash_bytes(FNV64_OFFSET, key.s, key.n), index);
+        put_key(r, &r->children, pair_key((uint32_t)(parent + 1), r->graph->packages[index].name), index);
+    }
+}
+
+static void read_npm(LockReader* r) {
+    int has_packages = 0;
+    if (!enter_object(r)) return;
+    Span key;
+    while (next_member(r, &key) && !r->failed) {
+        if (span_is(key, "lockfileVersion")) {
+            r->graph->lockfile_version = span_int((Span){ r->p, (size_t)(r->end - r->p) });
+            skip_value(r);
+        } else if (span_is(key, "packages")) {
+            read_npm_packages(r);
+            has_packages = 1;
+        } else if (span_is(key, "dependencies") && !has_packages) {
+            // Lockfile v1, or a v2 file whose "packages" comes later
+            if (r->graph->lockfile_version == 0) r->graph->lockfile_version = 1;
+            if (r->graph->lockfile_version == 1) {
+                read_npm_dependencies_v1(r, -1, 0);
+            } else {
+                skip_value(r);
+            }
+        } else {
+            skip_value(r);
+        }
+    }
+}
+
+// Node resolution: a requirement is met by the nearest install of that name
+// in the requiring package's node_modules or any enclosing one
+static void resolve_npm(LockReader* r) {
+    LockfileGraph* graph = r->graph;
+    for (int i = 0; i < graph->edge_count; i++) {
+        LockfileEdge* edge = &graph->edges[i];
+        int scope = edge->source;
+        for (int depth = 0; depth <= LOCKFILE_MAX_DEPTH * 4; depth++) {
+            int target = keymap_get(&r->children, pair_key((uint32_t)(scope + 1), edge->name));
+            if (target >= 0) {
+                edge->target = target;
+                break;
+            }
+            if (scope < 0) break;
+            scope = r->parents ? r->parents[scope] : -1;
+        }
+    }
+}
+
+// Line scanning, for yarn.lock and pnpm-lock.yaml
+
+typedef struct {
+    int indent;
+    Span text;               // After the indent, without the line break
+} Line;
+
+static int next_line(LockReader* r, Line* line) {
+    while (r->p < r->end) {
+        const char* start = r->p;
+        const char* eol = memchr(start, '\n', (size_t)(r->end - start));
+        if (!eol) eol = r->end;
+        r->p = (eol < r->end) ? eol + 1 : r->end;
+
+        const char* text = start;
+        while (text < eol && *text == ' ') text++;
+        Span span = span_trim((Span){ text, (size_t)(eol - text) });
+        if (span.n == 0 || span.s[0] == '#') continue;
+        line->indent = (int)(text - start);
+        line->text = span;
+        return 1;
+    }
+    return 0;
+}
+
+// Splits "key: value" or "key value" where the key may be quoted
+static void split_entry(Span text, Span* key, Span* value) {
+    size_t i = 0;
+    if (text.n && (text.s[0] == '"' || text.s[0] == '\'')) {
+        char quote = text.s[0];
+        i = 1;
+        while (i < text.n && text.s[i] != quote) i++;
+        *key = (Span){ text.s + 1, i - 1 };
+        if (i < text.n) i++;
+    } else {
+        while (i < text.n && text.s[i] != ' ' && text.s[i] != ':') i++;
+        *key = (Span){ text.s, i };
+    }
+    if (i < text.n && text.s[i] == ':') i++;
+    *value = span_unquote((Span){ text.s + i, text.n - i });
+}
+
+// "@scope/name@range" at the '@' that ends the name, or NULL
+static const char* name_end(Span descriptor) {
+    if (descriptor.n < 2) return NULL;
+    const char* at = memchr(descriptor.s + 1, '@', descriptor.n - 1);
+    return at;
+}
+
+static uint64_t descriptor_key(Span name, const char* prefix, Span range) {
+    uint64_t hash = hash_bytes(FNV64_OFFSET, name.s, name.n);
+    hash = hash_bytes(hash, "@", 1);
+    hash = hash_bytes(hash, prefix, strlen(prefix));
+    return hash_bytes(hash, range.s, range.n);
+}
+
+// An entry header lists every descriptor it resolves, comma separated and
+// quoted one by one (classic) or as a whole (berry)
+static int read_yarn_header(LockReader* r, Span header) {
+    int index = -1;
+    const char* p = header.s;
+    const char* end = header.s + header.n;
+    while (p < end && !r->failed) {
+        const char* comma = memchr(p, ',', (size_t)(end - p));
+        if (!comma) comma = end;
+        Span descriptor = strip_quotes((Span){ p, (size_t)(comma - p) });
+        p = comma + 1;
+
+        const char* at = name_end(descriptor);
+        if (!at) continue;
+        Span name = { descriptor.s, (size_t)(at - descriptor.s) };
+        Span range = { at + 1, (size_t)(descriptor.s + descriptor.n - at - 1) };
+        // Workspace packages are the project's own sources
+        if (span_starts(range, "workspace:")) return -1;
+        if (index < 0) {
+            index = add_package(r, intern_span(name), STRING_ID_EMPTY, -1);
+            if (index < 0) return -1;
+        }
+        put_key(r, &r->descriptors, descriptor_key(name, "", range), index);
+    }
+    return index;
+}
+
+static void read_yarn(LockReader* r) {
+    Line line;
+    int current = -1;
+    int in_metadata = 0;
+    int in_dependencies = 0;
+    r->graph->lockfile_version = 1;
+    while (next_line(r, &line) && !r->failed) {
+        Span key, value;
+        if (line.indent == 0) {
+            current = -1;
+            in_dependencies = 0;
+            Span header = line.text;
+            if (header.n && header.s[header.n - 1] == ':') header.n--;
+            in_metadata = span_is(header, "__metadata");
+            if (!in_metadata) current = read_yarn_header(r, header);
+        } else if (line.indent <= 2) {
+            in_dependencies = 0;
+            split_entry(line.text, &key, &value);
+            if (span_is(key, "version")) {
+                if (in_metadata) {
+                    r->graph->lockfile_version = span_int(value);
+                } else if (current >= 0) {
+                    r->graph->packages[current].version = intern_span(value);
+                }
+            } else {
+                in_dependencies = value.n == 0 &&
+                                  (span_is(key, "dependencies") || span_is(key, "optionalDependencies"));
+            }
+        } else if (in_dependencies && current >= 0) {
+            split_entry(line.text, &key, &value);
+            add_edge(r, current, intern_span(key), intern_span(value));
+        }
+    }
+}
+
+// Requirements match the descriptors in entry headers. Berry writes npm
+// ranges without the "npm:" protocol inside entries but with it in headers.
+static void resolve_yarn(LockReader* r) {
+    LockfileGraph* graph = r->graph;
+    for (int i = 0; i < graph->edge_count; i++) {
+        LockfileEdge* edge = &graph->edges[i];
+        const char* name = string_pool_get(edge->name);
+        const char* range = string_pool_get(edge->range);
+        Span name_span = { name, strlen(name) };
+        Span range_span = { range, strlen(range) };
+        edge->target = keymap_get(&r->descriptors, descriptor_key(name_span, "", range_span));
+        if (edge->target < 0) {
+            edge->target = keymap_get(&r->descriptors, descriptor_key(name_span, "npm:", range_span));
+        }
+    }
+}
+
+// pnpm versions carry the peers they were resolved with, "1.0.0(react@18.2.0)"
+// from version 6 on and "1.0.0_react@18.2.0" before
+static Span strip_peers(LockReader* r, Span version) {
+    for (size_t i = 0; i < version.n; i++) {
+        if (version.s[i] == '(' || (version.s[i] == '_' && r->graph->lockfile_version < 6)) {
+            version.n = i;
+            break;
+        }
+    }
+    return version;
+}
+
+// Package keys: "/name/1.0.0" (5), "/name@1.0.0" (6) or "name@1.0.0" (9)
+static int split_pnpm_key(LockReader* r, Span key, Span* name, Span* version) {
+    key = span_unquote(key);
+    if (key.n && key.s[0] == '/') {
+        key.s++;
+        key.n--;
+    }
+    const char* separator = NULL;
+    if (r->graph->lockfile_version >= 6 || r->graph->lockfile_version == 0) {
+        separator = name_end(key);
+    } else {
+        for (size_t i = key.n; i-- > 1;) {
+            if (key.s[i] == '/') {
+                separator = key.s + i;
+                break;
+            }
+        }
+    }
+    if (!separator) return 0;
+    *name = (Span){ key.s, (size_t)(separator - key.s) };
+    *version = strip_peers(r, (Span){ separator + 1, (size_t)(key.s + key.n - separator - 1) });
+    return 1;
+}
+
+static int pnpm_package(LockReader* r, Span key) {
+    Span name, version;
+    if (!split_pnpm_key(r, key, &name, &version)) return -1;
+    StringId name_id = intern_span(name);
+    StringId version_id = intern_span(version);
+    uint64_t pair = pair_key(name_id, version_id);
+    int index = keymap_get(&r->versions, pair);
+    if (index < 0) {
+        index = add_package(r, name_id, version_id, -1);
+        if (index >= 0) put_key(r, &r->versions, pair, index);
+    }
+    return index;
+}
+
+static void read_pnpm(LockReader* r) {
+    enum { SECTION_OTHER, SECTION_PACKAGES, SECTION_SNAPSHOTS } section = SECTION_OTHER;
+    Line line;
+    int current = -1;
+    int in_dependencies = 0;
+    while (next_line(r, &line) && !r->failed) {
+        Span key, value;
+        split_entry(line.text, &key, &value);
+        if (line.indent == 0) {
+            current = -1;
+            in_dependencies = 0;
+            if (span_is(key, "lockfileVersion")) {
+                r->graph->lockfile_version = span_int(value);
+            }
+            section = span_is(key, "packages") ? SECTION_PACKAGES
+                    : span_is(key, "snapshots") ? SECTION_SNAPSHOTS : SECTION_OTHER;
+        } else if (section == SECTION_OTHER) {
+            continue;
+        } else if (line.indent <= 2) {
+            in_dependencies = 0;
+            current = pnpm_package(r, key);
+            // Version 9 lists each package once under packages and once per
+            // peer variant under snapshots; the first snapshot gives the edges
+            if (section == SECTION_SNAPSHOTS && current >= 0) {
+                if (keymap_get(&r->snapshots, (uint64_t)current) >= 0) {
+                    current = -1;
+                } else {
+                    put_key(r, &r->snapshots, (uint64_t)current, current);
+                }
+            }
+        } else if (current < 0) {
+            continue;
+        } else if (line.indent <= 4) {
+            in_dependencies = value.n == 0 &&
+                              (span_is(key, "dependencies") || span_is(key, "optionalDependencies"));
+            if (span_is(key, "dev") && span_is(value, "true")) {
+                r->graph->packages[current].is_dev = 1;
+            }
+        } else if (in_dependencies) {
+            add_edge(r, current, intern_span(key), intern_span(strip_peers(r, value)));
+        }
+    }
+}
+
+static void resolve_pnpm(LockReader* r) {
+    LockfileGraph* graph = r->graph;
+    for (int i = 0; i < graph->edge_count; i++) {
+        LockfileEdge* edge = &graph->edges[i];
+        edge->target = keymap_get(&r->versions, pair_key(edge->name, edge->range));
+    }
+}
+
+static int compare_clusters(const void* a, const void* b) {
+    const LockfileCluster* x = (const LockfileCluster*)a;
+    const LockfileCluster* y = (const LockfileCluster*)b;
+    if (x->version_count != y->version_count) return y->version_count - x->version_count;
+    if (x->install_count != y->install_count) return y->install_count - x->install_count;
+    return strcmp(string_pool_get(x->name), string_pool_get(y->name));
+}
+
+// Distinct names, and the names resolved at more than one version
+static void find_clusters(LockReader* r) {
+    LockfileGraph* graph = r->graph;
+    KeyMap names = {0};
+    KeyMap pairs = {0};
+    size_t table_size = (size_t)(graph->package_count ? graph->package_count : 1) * sizeof(LockfileCluster);
+    LockfileCluster* table = mem_alloc(PROFILE_PHASE_LOCKFILE, table_size);
+    if (!table) {
+        r->failed = 1;
+        return;
+    }
+
+    int count = 0;
+    for (int i = 0; i < graph->package_count && !r->failed; i++) {
+        const LockfilePackage* pkg = &graph->packages[i];
+        int slot = keymap_get(&names, pkg->name);
+        if (slot < 0) {
+            slot = count++;
+            table[slot].name = pkg->name;
+            table[slot].version_count = 0;
+            table[slot].install_count = 0;
+            put_key(r, &names, pkg->name, slot);
+        }
+        table[slot].install_count++;
+        uint64_t pair = pair_key(pkg->name, pkg->version);
+        if (keymap_get(&pairs, pair) < 0) {
+            table[slot].version_count++;
+            put_key(r, &pairs, pair, i);
+        }
+    }
+    graph->unique_package_count = count;
+
+    int clusters = 0;
+    for (int i = 0; i < count; i++) {
+        if (table[i].version_count > 1) table[clusters++] = table[i];
+    }
+    if (clusters > 0 && !r->failed) {
+        graph->clusters = mem_alloc(PROFILE_PHASE_LOCKFILE, (size_t)clusters * sizeof(LockfileCluster));
+        if (graph->clusters) {
+            memcpy(graph->clusters, table, (size_t)clusters * sizeof(LockfileCluster));
+            qsort(graph->clusters, (size_t)clusters, sizeof(LockfileCluster), compare_clusters);
+            graph->cluster_count = clusters;
+        } else {
+            r->failed = 1;
+        }
+    }
+
+    mem_free(PROFILE_PHASE_LOCKFILE, table, table_size);
+    keymap_free(&names);
+    keymap_free(&pairs);
+}
+
+const char* lockfile_kind_name(LockfileKind kind) {
+    switch (kind) {
+        case LOCKFILE_NPM: return "npm";
+        case LOCKFILE_YARN: return "yarn";
+        case LOCKFILE_PNPM: return "pnpm";
+        default: return "";
+    }
+}
+
+LockfileGraph* lockfile_read(const char* path, LockfileKind kind) {
+    if (!path || kind == LOCKFILE_NONE) return NULL;
+    MappedFile map;
+    if (!map_file(path, &map)) return NULL;
+
+    LockfileGraph* graph = mem_calloc(PROFILE_PHASE_LOCKFILE, 1, sizeof(LockfileGraph));
+    if (!graph) {
+        unmap_file(&map);
+        return NULL;
+    }
+    graph->kind = kind;
+    graph->bytes = (long long)map.size;
+
+    LockReader reader;
+    memset(&reader, 0, sizeof(LockReader));
+    reader.graph = graph;
+    reader.p = map.data;
+    reader.end = map.data + map.size;
+
+    switch (kind) {
+        case LOCKFILE_NPM:
+            read_npm(&reader);
+            resolve_npm(&reader);
+            break;
+        case LOCKFILE_YARN:
+            read_yarn(&reader);
+            resolve_yarn(&reader);
+            break;
+        case LOCKFILE_PNPM:
+            read_pnpm(&reader);
+            resolve_pnpm(&reader);
+            break;
+        default:
+            break;
+    }
+    unmap_file(&map);
+
+    for (int i = 0; i < graph->edge_count; i++) {
+        if (graph->edges[i].target >= 0) graph->resolved_edge_count++;
+    }
+    if (!reader.failed) find_clusters(&reader);
+
+    mem_free(PROFILE_PHASE_LOCKFILE, reader.parents, (size_t)reader.parent_capacity * sizeof(int));
+    keymap_free(&reader.paths);
+    keymap_free(&reader.children);
+    keymap_free(&reader.descriptors);
+    keymap_free(&reader.versions);
+    keymap_free(&reader.snapshots);
+
+    if (reader.failed) {
+        fprintf(stderr, "Memory allocation failed reading lockfile %s\n", path);
+        lockfile_free(graph);
+        return NULL;
+    }
+    return graph;
+}
+
+LockfileGraph* lockfile_read_project(const char* root_path) {
+    static const struct {
+        const char* name;
+        LockfileKind kind;
+    } lockfiles[] = {
+        { "package-lock.json", LOCKFILE_NPM },
+        { "npm-shrinkwrap.json", LOCKFILE_NPM },
+        { "yarn.lock", LOCKFILE_YARN },
+        { "pnpm-lock.yaml", LOCKFILE_PNPM },
+    };
+    if (!root_path) return NULL;
+
+    for (size_t i = 0; i < sizeof(lockfiles) / sizeof(lockfiles[0]); i++) {
+        char path[LOCKFILE_PATH_SIZE];
+        snprintf(path, sizeof(path), "%s/%s", root_path, lockfiles[i].name);
+        LockfileGraph* graph = lockfile_read(path, lockfiles[i].kind);
+        if (graph) return graph;
+    }
+    return NULL;
+}
+
+void lockfile_free(LockfileGraph* graph) {
+    if (!graph) return;
+    mem_free(PROFILE_PHASE_LOCKFILE, graph->packages, (size_t)graph->package_capacity * sizeof(LockfilePackage));
+    mem_free(PROFILE_PHASE_LOCKFILE, graph->edges, (size_t)graph->edge_capacity * sizeof(LockfileEdge));
+    mem_free(PROFILE_PHASE_LOCKFILE, graph->clusters, (size_t)graph->cluster_count * sizeof(LockfileCluster));
+    mem_free(PROFILE_PHASE_LOCKFILE, graph, sizeof(LockfileGraph));
+}
@@ -0,0 +1,77 @@
+#ifndef WEB_LOCKFILE_H
+#define WEB_LOCKFILE_H
+
+#include "web_string_pool.h"
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Readers for package-lock.json and npm-shrinkwrap.json (lockfile versions 1
+// to 3), yarn.lock (classic and berry) and pnpm-lock.yaml (versions 5 to 9).
+// Each maps the file and scans it once, recording packages and dependency
+// edges as it goes. No document tree is built, so memory follows the number
+// of packages rather than the size of the file.
+
+typedef enum {
+    LOCKFILE_NONE,
+    LOCKFILE_NPM,
+    LOCKFILE_YARN,
+    LOCKFILE_PNPM
+} LockfileKind;
+
+// One resolved install. npm lists a package once per node_modules folder it
+// is installed in, so a name and version can appear more than once.
+typedef struct {
+    StringId name;
+    StringId version;        // Without pnpm's peer dependency suffix
+    int is_dev;              // Development only, where the lockfile records it
+} LockfilePackage;
+
+typedef struct {
+    int source;              // Package index
+    int target;              // Package the edge resolves to, -1 if not locked
+    StringId name;
+    StringId range;          // As requested (npm, yarn) or resolved (pnpm)
+} LockfileEdge;
+
+// A package name resolved at more than one version
+typedef struct {
+    StringId name;
+    int version_count;
+    int install_count;
+} LockfileCluster;
+
+typedef struct {
+    LockfileKind kind;
+    int lockfile_version;    // npm lockfileVersion, yarn 1 (classic) or the
+                             // berry metadata version, pnpm major version
+    long long bytes;
+    LockfilePackage* packages;
+    int package_count;
+    LockfileEdge* edges;
+    int edge_count;
+    int resolved_edge_count;
+    int unique_package_count; // Distinct names
+    LockfileCluster* clusters; // Most versions first, then most installs
+    int cluster_count;
+    int package_capacity;
+    int edge_capacity;
+} LockfileGraph;
+
+EXPORT const char* lockfile_kind_name(LockfileKind kind);
+
+// Reads the lockfile at path as the given kind. Returns NULL if the file
+// cannot be mapped or memory runs out.
+EXPORT LockfileGraph* lockfile_read(const char* path, LockfileKind kind);
+
+// Reads the first lockfile found in a project root, trying npm, yarn and
+// pnpm in that order. Returns NULL without one.
+EXPORT LockfileGraph* lockfile_read_project(const char* root_path);
+
+// NULL is a no-op
+EXPORT void lockfile_free(LockfileGraph* graph);
+
+#endif // WEB_LOCKFILE_H
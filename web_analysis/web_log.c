@@ -0,0 +1,391 @@
+#include "web_log.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+typedef HANDLE log_thread_t;
+typedef SRWLOCK log_mutex_t;
+typedef CONDITION_VARIABLE log_cond_t;
+#define LOG_MUTEX_INIT SRWLOCK_INIT
+#define LOG_COND_INIT CONDITION_VARIABLE_INIT
+#define mutex_lock(m) AcquireSRWLockExclusive(m)
+#define mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#define cond_wait(c, m) SleepConditionVariableSRW(c, m, INFINITE, 0)
+#define cond_signal(c) WakeConditionVariable(c)
+#else
+#include <pthread.h>
+typedef pthread_t log_thread_t;
+typedef pthread_mutex_t log_mutex_t;
+typedef pthread_cond_t log_cond_t;
+#define LOG_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define LOG_COND_INIT PTHREAD_COND_INITIALIZER
+#define mutex_lock(m) pthread_mutex_lock(m)
+#define mutex_unlock(m) pthread_mutex_unlock(m)
+#define cond_wait(c, m) pthread_cond_wait(c, m)
+#define cond_signal(c) pthread_cond_signal(c)
+#endif
+
+#ifdef _MSC_VER
+static __forceinline long long load_i64(volatile long long* p) { return InterlockedCompareExchange64(p, 0, 0); }
+static __forceinline void store_i64(volatile long long* p, long long v) { InterlockedExchange64(p, v); }
+static __forceinline int cas_i64(volatile long long* p, long long expected, long long desired) {
+    return InterlockedCompareExchange64(p, desired, expected) == expected;
+}
+static __forceinline long long add_i64(volatile long long* p, long long v) { return InterlockedExchangeAdd64(p, v) + v; }
+static __forceinline long load_long(volatile long* p) { return InterlockedCompareExchange(p, 0, 0); }
+static __forceinline void store_long(volatile long* p, long v) { InterlockedExchange(p, v); }
+static __forceinline int cas_long(volatile long* p, long expected, long desired) {
+    return InterlockedCompareExchange(p, desired, expected) == expected;
+}
+#else
+static inline long long load_i64(volatile long long* p) { return __atomic_load_n(p, __ATOMIC_SEQ_CST); }
+static inline void store_i64(volatile long long* p, long long v) { __atomic_store_n(p, v, __ATOMIC_SEQ_CST); }
+static inline int cas_i64(volatile long long* p, long long expected, long long desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+static inline long long add_i64(volatile long long* p, long long v) { return __atomic_add_fetch(p, v, __ATOMIC_SEQ_CST); }
+static inline long load_long(volatile long* p) { return __atomic_load_n(p, __ATOMIC_SEQ_CST); }
+static inline void store_long(volatile long* p, long v) { __atomic_store_n(p, v, __ATOMIC_SEQ_CST); }
+static inline int cas_long(volatile long* p, long expected, long desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+#endif
+
+#define LOG_RING_MASK (LOG_RING_CAPACITY - 1)
+
+typedef struct {
+    int level;
+    unsigned int category;
+    long long timestamp_ms;
+    char message[LOG_MESSAGE_SIZE];
+} LogRecord;
+
+// Bounded multi-producer ring (Vyukov). A slot is free for position pos when
+// its sequence equals pos and holds a record for pos when it equals pos + 1.
+// Sequences are stored relative to the slot index so the zeroed static array
+// starts out with every slot free for its first lap.
+typedef struct {
+    volatile long long sequence;
+    LogRecord record;
+} LogSlot;
+
+// Starts at trace so the first call reaches web_log_write, which reads the
+// environment and then applies the real threshold
+volatile int web_log_level = LOG_LEVEL_TRACE;
+volatile unsigned int web_log_categories = LOG_CAT_ALL;
+
+static LogSlot ring[LOG_RING_CAPACITY];
+static volatile long long enqueue_pos;
+static volatile long long dequeue_pos;    // Advanced only under drain_lock
+static volatile long long dropped;
+static volatile long configured;
+
+static LogSink current_sink;              // Guarded by drain_lock
+static void* current_user;
+static LogThreadHook current_attach;
+static LogThreadHook current_detach;
+static volatile long sink_generation;     // Bumped under drain_lock on every swap
+
+// The writer's hold on the sink it last attached to. Touched only by the
+// writer thread; -1 makes a fresh writer pick up whatever is installed.
+static LogThreadHook bound_detach;
+static long bound_generation = -1;
+
+// Consumers (the writer thread and web_log_flush) take drain_lock; producers
+// never lock unless the writer is asleep and needs waking.
+static log_mutex_t drain_lock = LOG_MUTEX_INIT;
+static log_mutex_t wake_lock = LOG_MUTEX_INIT;
+static log_cond_t wake = LOG_COND_INIT;
+static log_mutex_t control_lock = LOG_MUTEX_INIT;
+static volatile long writer_running;
+static volatile long writer_idle;
+static volatile long writer_stop;
+static volatile long exit_hook_registered;
+static volatile long exiting;
+static log_thread_t writer_thread;
+
+static long long slot_sequence(long long index) {
+    return load_i64(&ring[index].sequence) + index;
+}
+
+static void set_slot_sequence(long long index, long long sequence) {
+    store_i64(&ring[index].sequence, sequence - index);
+}
+
+static long long now_ms(void) {
+#ifdef _WIN32
+    FILETIME ft;
+    GetSystemTimeAsFileTime(&ft);
+    unsigned long long ticks = ((unsigned long long)ft.dwHighDateTime << 32) | ft.dwLowDateTime;
+    return (long long)((ticks - 116444736000000000ULL) / 10000);  // 100ns since 1601 to ms since 1970
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_REALTIME, &ts);
+    return (long long)ts.tv_sec * 1000 + ts.tv_nsec / 1000000;
+#endif
+}
+
+const char* web_log_level_name(int level) {
+    static const char* names[] = { "TRACE", "DEBUG", "INFO", "WARN", "ERROR", "OFF" };
+    return (level >= LOG_LEVEL_TRACE && level <= LOG_LEVEL_OFF) ? names[level] : "?";
+}
+
+const char* web_log_category_name(unsigned int category) {
+    switch (category) {
+        case LOG_CAT_CORE: return "core";
+        case LOG_CAT_PARSER: return "parser";
+        case LOG_CAT_DEPS: return "deps";
+        case LOG_CAT_JNI: return "jni";
+        default: return "misc";
+    }
+}
+
+static int parse_level(const char* value) {
+    static const char* names[] = { "trace", "debug", "info", "warn", "error", "off" };
+    if (value[0] >= '0' && value[0] <= '9') {
+        int level = atoi(value);
+        return level > LOG_LEVEL_OFF ? LOG_LEVEL_OFF : level;
+    }
+    for (int i = LOG_LEVEL_TRACE; i <= LOG_LEVEL_OFF; i++) {
+        if (strcmp(value, names[i]) == 0) return i;
+    }
+    return LOG_LEVEL_WARN;
+}
+
+// Applies LOG_LEVEL_ENV_VAR once, unless web_log_set_level got there first
+static void configure_from_env(void) {
+    if (load_long(&configured) || !cas_long(&configured, 0, 1)) return;
+
+    const char* value = getenv(LOG_LEVEL_ENV_VAR);
+    web_log_level = (value && *value) ? parse_level(value) : LOG_LEVEL_WARN;
+}
+
+void web_log_set_level(int level) {
+    store_long(&configured, 1);
+    web_log_level = level;
+}
+
+void web_log_set_categories(unsigned int categories) {
+    web_log_categories = categories;
+}
+
+long long web_log_dropped(void) {
+    return load_i64(&dropped);
+}
+
+static void stderr_sink(void* user, int level, unsigned int category,
+                        long long timestamp_ms, const char* message) {
+    (void)user;
+    time_t seconds = (time_t)(timestamp_ms / 1000);
+    struct tm tm;
+#ifdef _WIN32
+    localtime_s(&tm, &seconds);
+#else
+    localtime_r(&seconds, &tm);
+#endif
+    char timestr[20];
+    strftime(timestr, sizeof(timestr), "%Y-%m-%d %H:%M:%S", &tm);
+    fprintf(stderr, "[%s.%03d] %-5s %s: %s\n", timestr, (int)(timestamp_ms % 1000),
+            web_log_level_name(level), web_log_category_name(category), message);
+}
+
+static int ring_has_record(void) {
+    long long pos = load_i64(&dequeue_pos);
+    return slot_sequence(pos & LOG_RING_MASK) == pos + 1;
+}
+
+// Hands every published record to the sink. Caller holds drain_lock.
+static void drain_locked(void) {
+    LogSink sink = current_sink ? current_sink : stderr_sink;
+    int wrote_stderr = 0;
+
+    for (;;) {
+        long long pos = load_i64(&dequeue_pos);
+        long long index = pos & LOG_RING_MASK;
+        if (slot_sequence(index) != pos + 1) break;
+
+        LogRecord* record = &ring[index].record;
+        sink(current_user, record->level, record->category, record->timestamp_ms, record->message);
+        wrote_stderr = (sink == stderr_sink);
+
+        store_i64(&dequeue_pos, pos + 1);
+        set_slot_sequence(index, pos + LOG_RING_CAPACITY);
+    }
+    if (wrote_stderr) fflush(stderr);
+}
+
+// Writer thread, drain_lock held. Leaves the sink it was attached to once it
+// has been swapped out and attaches to the new one before its first record.
+// Hooks are skipped during process exit, when whatever they attach to (the
+// JVM, say) may already be shutting down.
+static void bind_writer_locked(void) {
+    long generation = load_long(&sink_generation);
+    if (generation == bound_generation) return;
+
+    int hooks = !load_long(&exiting);
+    if (bound_detach && hooks) bound_detach();
+    if (current_attach && hooks) current_attach();
+    bound_detach = current_detach;
+    bound_generation = generation;
+}
+
+static void unbind_writer_locked(void) {
+    if (bound_detach && !load_long(&exiting)) bound_detach();
+    bound_detach = NULL;
+    bound_generation = -1;
+}
+
+#ifdef _WIN32
+static unsigned __stdcall writer_main(void* arg)
+#else
+static void* writer_main(void* arg)
+#endif
+{
+    (void)arg;
+    for (;;) {
+        mutex_lock(&drain_lock);
+        bind_writer_locked();
+        drain_locked();
+        mutex_unlock(&drain_lock);
+
+        // Producers and sink swaps only signal while writer_idle is set, and
+        // check it after publishing, so re-checking here cannot miss either
+        mutex_lock(&wake_lock);
+        store_long(&writer_idle, 1);
+        if (!load_long(&writer_stop) && !ring_has_record() &&
+            load_long(&sink_generation) == bound_generation) {
+            cond_wait(&wake, &wake_lock);
+        }
+        store_long(&writer_idle, 0);
+        int stop = load_long(&writer_stop) != 0;
+        mutex_unlock(&wake_lock);
+
+        if (stop) break;
+    }
+
+    mutex_lock(&drain_lock);
+    bind_writer_locked();
+    drain_locked();
+    unbind_writer_locked();
+    mutex_unlock(&drain_lock);
+    return 0;
+}
+
+static void shutdown_at_exit(void) {
+    store_long(&exiting, 1);
+    web_log_shutdown();
+}
+
+static void start_writer(void) {
+    mutex_lock(&control_lock);
+    if (!load_long(&writer_running)) {
+#ifdef _WIN32
+        writer_thread = (HANDLE)_beginthreadex(NULL, 0, writer_main, NULL, 0, NULL);
+        int failed = writer_thread == 0;
+#else
+        int failed = pthread_create(&writer_thread, NULL, writer_main, NULL) != 0;
+#endif
+        if (failed) {
+            fprintf(stderr, "web_log: failed to start writer thread\n");
+        } else {
+            store_long(&writer_running, 1);
+            if (cas_long(&exit_hook_registered, 0, 1)) atexit(shutdown_at_exit);
+        }
+    }
+    mutex_unlock(&control_lock);
+}
+
+void web_log_write(int level, unsigned int category, const char* fmt, ...) {
+    configure_from_env();
+    if (level < web_log_level || !(web_log_categories & category)) return;
+
+    // Claim a slot, or drop the record if the writer has fallen a lap behind
+    long long pos = load_i64(&enqueue_pos);
+    long long index;
+    for (;;) {
+        index = pos & LOG_RING_MASK;
+        long long diff = slot_sequence(index) - pos;
+        if (diff == 0) {
+            if (cas_i64(&enqueue_pos, pos, pos + 1)) break;
+        } else if (diff < 0) {
+            add_i64(&dropped, 1);
+            return;
+        }
+        pos = load_i64(&enqueue_pos);
+    }
+
+    LogRecord* record = &ring[index].record;
+    record->level = level;
+    record->category = category;
+    record->timestamp_ms = now_ms();
+
+    va_list args;
+    va_start(args, fmt);
+    vsnprintf(record->message, sizeof(record->message), fmt, args);
+    va_end(args);
+
+    set_slot_sequence(index, pos + 1);
+
+    if (!load_long(&writer_running)) {
+        start_writer();
+    } else if (load_long(&writer_idle)) {
+        mutex_lock(&wake_lock);
+        cond_signal(&wake);
+        mutex_unlock(&wake_lock);
+    }
+}
+
+void web_log_flush(void) {
+    mutex_lock(&drain_lock);
+    drain_locked();
+    mutex_unlock(&drain_lock);
+}
+
+void web_log_set_sink(LogSink sink, void* user) {
+    web_log_set_sink_hooks(sink, user, NULL, NULL);
+}
+
+void web_log_set_sink_hooks(LogSink sink, void* user, LogThreadHook attach, LogThreadHook detach) {
+    mutex_lock(&drain_lock);
+    drain_locked();
+    current_sink = sink;
+    current_user = user;
+    current_attach = attach;
+    current_detach = detach;
+    store_long(&sink_generation, load_long(&sink_generation) + 1);
+    mutex_unlock(&drain_lock);
+
+    // Wake an idle writer so it leaves the old sink now, not at the next record
+    if (load_long(&writer_running) && load_long(&writer_idle)) {
+        mutex_lock(&wake_lock);
+        cond_signal(&wake);
+        mutex_unlock(&wake_lock);
+    }
+}
+
+void web_log_shutdown(void) {
+    mutex_lock(&control_lock);
+    if (load_long(&writer_running)) {
+        mutex_lock(&wake_lock);
+        store_long(&writer_stop, 1);
+        cond_signal(&wake);
+        mutex_unlock(&wake_lock);
+
+#ifdef _WIN32
+        WaitForSingleObject(writer_thread, INFINITE);
+        CloseHandle(writer_thread);
+#else
+        pthread_join(writer_thread, NULL);
+#endif
+        store_long(&writer_stop, 0);
+        store_long(&writer_running, 0);
+    }
+    mutex_unlock(&control_lock);
+
+    web_log_flush();
+}
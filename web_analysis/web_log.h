@@ -0,0 +1,126 @@
+#ifndef WEB_LOG_H
+#define WEB_LOG_H
+
+#include <stddef.h>
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Levels, lowest first. These are plain defines so WEB_LOG_COMPILE_LEVEL can
+// be compared in #if.
+#define LOG_LEVEL_TRACE 0
+#define LOG_LEVEL_DEBUG 1
+#define LOG_LEVEL_INFO  2
+#define LOG_LEVEL_WARN  3
+#define LOG_LEVEL_ERROR 4
+#define LOG_LEVEL_OFF   5
+
+// Calls below this level are removed by the preprocessor. Override with
+// -DWEB_LOG_COMPILE_LEVEL=<n> (the WEB_LOG_COMPILE_LEVEL CMake cache entry).
+#ifndef WEB_LOG_COMPILE_LEVEL
+#define WEB_LOG_COMPILE_LEVEL LOG_LEVEL_DEBUG
+#endif
+
+// Categories are bits so the runtime filter can enable any combination
+#define LOG_CAT_CORE   (1u << 0)   // Analysis driver and estimation
+#define LOG_CAT_PARSER (1u << 1)   // File parsers
+#define LOG_CAT_DEPS   (1u << 2)   // package.json dependency extraction
+#define LOG_CAT_JNI    (1u << 3)   // Java bridge
+#define LOG_CAT_ALL    0xffffffffu
+
+// Runtime level, read once on first use: "trace", "debug", "info", "warn",
+// "error" or "off". Defaults to warn.
+#define LOG_LEVEL_ENV_VAR "WEB_ANALYSIS_LOG_LEVEL"
+
+// Maximum formatted message length; longer messages are truncated
+#define LOG_MESSAGE_SIZE 240
+
+// Records that fit in the ring before new ones are dropped. Power of two.
+#define LOG_RING_CAPACITY 1024
+
+// Receives each record on the background writer thread, in enqueue order.
+// timestamp_ms is milliseconds since the Unix epoch.
+typedef void (*LogSink)(void* user, int level, unsigned int category,
+                        long long timestamp_ms, const char* message);
+
+// Runtime filter. Enabled calls are formatted at the call site and queued;
+// disabled calls cost these two loads.
+extern EXPORT volatile int web_log_level;
+extern EXPORT volatile unsigned int web_log_categories;
+
+EXPORT void web_log_set_level(int level);
+EXPORT void web_log_set_categories(unsigned int categories);
+
+// Replaces the destination for drained records. NULL restores the default,
+// which writes one line per record to stderr. Pending records are flushed to
+// the previous sink first.
+EXPORT void web_log_set_sink(LogSink sink, void* user);
+
+// Runs on the writer thread: attach before it hands a newly installed sink
+// any record, detach once that sink is replaced or the writer stops. Lets a
+// sink hold per-thread state, such as a JVM attachment, only while installed.
+// Records drained by web_log_flush or a sink swap still reach the sink on the
+// calling thread, outside these hooks.
+typedef void (*LogThreadHook)(void);
+
+// web_log_set_sink with writer thread hooks; either may be NULL
+EXPORT void web_log_set_sink_hooks(LogSink sink, void* user, LogThreadHook attach, LogThreadHook detach);
+
+// Formats and queues a record without blocking. Drops it if the ring is full.
+EXPORT void web_log_write(int level, unsigned int category, const char* fmt, ...)
+#if defined(__GNUC__)
+    __attribute__((format(printf, 3, 4)))
+#endif
+    ;
+
+// Blocks until every record queued before the call has reached the sink
+EXPORT void web_log_flush(void);
+
+// Flushes and stops the writer thread. Later writes restart it.
+EXPORT void web_log_shutdown(void);
+
+// Records dropped because the ring was full
+EXPORT long long web_log_dropped(void);
+
+EXPORT const char* web_log_level_name(int level);
+EXPORT const char* web_log_category_name(unsigned int category);
+
+#define WEB_LOG_AT(level, category, fmt, ...) do { \
+    if ((level) >= web_log_level && (web_log_categories & (category))) \
+        web_log_write(level, category, fmt, ##__VA_ARGS__); \
+} while (0)
+
+#if WEB_LOG_COMPILE_LEVEL <= LOG_LEVEL_TRACE
+#define LOG_TRACE(category, fmt, ...) WEB_LOG_AT(LOG_LEVEL_TRACE, category, fmt, ##__VA_ARGS__)
+#else
+#define LOG_TRACE(category, fmt, ...) ((void)0)
+#endif
+
+#if WEB_LOG_COMPILE_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(category, fmt, ...) WEB_LOG_AT(LOG_LEVEL_DEBUG, category, fmt, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(category, fmt, ...) ((void)0)
+#endif
+
+#if WEB_LOG_COMPILE_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(category, fmt, ...) WEB_LOG_AT(LOG_LEVEL_INFO, category, fmt, ##__VA_ARGS__)
+#else
+#define LOG_INFO(category, fmt, ...) ((void)0)
+#endif
+
+#if WEB_LOG_COMPILE_LEVEL <= LOG_LEVEL_WARN
+#define LOG_WARN(category, fmt, ...) WEB_LOG_AT(LOG_LEVEL_WARN, category, fmt, ##__VA_ARGS__)
+#else
+#define LOG_WARN(category, fmt, ...) ((void)0)
+#endif
+
+#if WEB_LOG_COMPILE_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(category, fmt, ...) WEB_LOG_AT(LOG_LEVEL_ERROR, category, fmt, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(category, fmt, ...) ((void)0)
+#endif
+
+#endif // WEB_LOG_H
@@ -0,0 +1,213 @@
+#include "web_memory.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#define PSAPI_VERSION 2   // GetProcessMemoryInfo from kernel32, no psapi import
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#include <unistd.h>
+#ifdef __APPLE__
+#include <mach/mach.h>
+#endif
+#endif
+
+#ifdef _MSC_VER
+static __forceinline long long load_i64(volatile long long* p) { return InterlockedCompareExchange64(p, 0, 0); }
+static __forceinline void store_i64(volatile long long* p, long long v) { InterlockedExchange64(p, v); }
+static __forceinline int cas_i64(volatile long long* p, long long expected, long long desired) {
+    return InterlockedCompareExchange64(p, desired, expected) == expected;
+}
+static __forceinline long long add_i64(volatile long long* p, long long v) { return InterlockedExchangeAdd64(p, v) + v; }
+#else
+static inline long long load_i64(volatile long long* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline void store_i64(volatile long long* p, long long v) { __atomic_store_n(p, v, __ATOMIC_RELAXED); }
+static inline int cas_i64(volatile long long* p, long long expected, long long desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+static inline long long add_i64(volatile long long* p, long long v) { return __atomic_add_fetch(p, v, __ATOMIC_RELAXED); }
+#endif
+
+typedef struct {
+    volatile long long allocations;
+    volatile long long frees;
+    volatile long long bytes;
+    volatile long long live_bytes;
+    volatile long long peak_live_bytes;
+} MemoryCounters;
+
+static MemoryCounters counters[PROFILE_PHASE_COUNT];
+static volatile long long live_total;
+static volatile long long peak_total;
+static volatile long long peak_sampled_rss;
+
+static void raise_peak(volatile long long* peak, long long value) {
+    long long current = load_i64(peak);
+    while (value > current && !cas_i64(peak, current, value)) {
+        current = load_i64(peak);
+    }
+}
+
+static void count_alloc(ProfilePhase phase, size_t size) {
+    if (phase < 0 || phase >= PROFILE_PHASE_COUNT) return;
+    MemoryCounters* c = &counters[phase];
+    add_i64(&c->allocations, 1);
+    add_i64(&c->bytes, (long long)size);
+    raise_peak(&c->peak_live_bytes, add_i64(&c->live_bytes, (long long)size));
+    raise_peak(&peak_total, add_i64(&live_total, (long long)size));
+}
+
+static void count_free(ProfilePhase phase, size_t size) {
+    if (phase < 0 || phase >= PROFILE_PHASE_COUNT) return;
+    MemoryCounters* c = &counters[phase];
+    add_i64(&c->frees, 1);
+    add_i64(&c->live_bytes, -(long long)size);
+    add_i64(&live_total, -(long long)size);
+}
+
+void* mem_alloc(ProfilePhase phase, size_t size) {
+    void* ptr = malloc(size);
+    if (ptr) count_alloc(phase, size);
+    return ptr;
+}
+
+void* mem_calloc(ProfilePhase phase, size_t count, size_t size) {
+    void* ptr = calloc(count, size);
+    if (ptr) count_alloc(phase, count * size);
+    return ptr;
+}
+
+void* mem_realloc(ProfilePhase phase, void* ptr, size_t old_size, size_t new_size) {
+    void* moved = realloc(ptr, new_size);
+    if (!moved) return NULL;
+    if (ptr) count_free(phase, old_size);
+    count_alloc(phase, new_size);
+    return moved;
+}
+
+void mem_free(ProfilePhase phase, void* ptr, size_t size) {
+    if (!ptr) return;
+    count_free(phase, size);
+    free(ptr);
+}
+
+static long long current_rss(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS info;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info))) return (long long)info.WorkingSetSize;
+    return 0;
+#elif defined(__APPLE__)
+    mach_task_basic_info_data_t info;
+    mach_msg_type_number_t count = MACH_TASK_BASIC_INFO_COUNT;
+    if (task_info(mach_task_self(), MACH_TASK_BASIC_INFO, (task_info_t)&info, &count) == KERN_SUCCESS) {
+        return (long long)info.resident_size;
+    }
+    return 0;
+#else
+    FILE* f = fopen("/proc/self/statm", "r");
+    if (!f) return 0;
+    long long size = 0, resident = 0;
+    int parsed = fscanf(f, "%lld %lld", &size, &resident);
+    fclose(f);
+    return parsed == 2 ? resident * (long long)sysconf(_SC_PAGESIZE) : 0;
+#endif
+}
+
+static long long process_peak_rss(void) {
+#ifdef _WIN32
+    PROCESS_MEMORY_COUNTERS info;
+    if (GetProcessMemoryInfo(GetCurrentProcess(), &info, sizeof(info))) return (long long)info.PeakWorkingSetSize;
+    return 0;
+#else
+    struct rusage usage;
+    if (getrusage(RUSAGE_SELF, &usage) != 0) return 0;
+#ifdef __APPLE__
+    return (long long)usage.ru_maxrss;            // Bytes on macOS
+#else
+    return (long long)usage.ru_maxrss * 1024;     // Kilobytes elsewhere
+#endif
+#endif
+}
+
+long long mem_sample_rss(void) {
+    long long rss = current_rss();
+    raise_peak(&peak_sampled_rss, rss);
+    return rss;
+}
+
+void mem_reset(void) {
+    for (int i = 0; i < PROFILE_PHASE_COUNT; i++) {
+        store_i64(&counters[i].allocations, 0);
+        store_i64(&counters[i].frees, 0);
+        store_i64(&counters[i].bytes, 0);
+        store_i64(&counters[i].peak_live_bytes, load_i64(&counters[i].live_bytes));
+    }
+    store_i64(&peak_total, load_i64(&live_total));
+    store_i64(&peak_sampled_rss, current_rss());
+}
+
+int mem_snapshot(MemoryStats* out, int capacity) {
+    int count = capacity < PROFILE_PHASE_COUNT ? capacity : PROFILE_PHASE_COUNT;
+    for (int i = 0; i < count; i++) {
+        out[i].phase = i;
+        out[i].name = profile_phase_name((ProfilePhase)i);
+        out[i].allocations = load_i64(&counters[i].allocations);
+        out[i].frees = load_i64(&counters[i].frees);
+        out[i].bytes = load_i64(&counters[i].bytes);
+        out[i].live_bytes = load_i64(&counters[i].live_bytes);
+        out[i].peak_live_bytes = load_i64(&counters[i].peak_live_bytes);
+    }
+    return count;
+}
+
+void mem_totals(MemoryTotals* out) {
+    out->live_bytes = load_i64(&live_total);
+    out->peak_live_bytes = load_i64(&peak_total);
+    out->rss_bytes = mem_sample_rss();
+    out->peak_sampled_rss_bytes = load_i64(&peak_sampled_rss);
+    out->peak_rss_bytes = process_peak_rss();
+}
+
+// snprintf into a running position that keeps counting past the end
+typedef struct {
+    char* out;
+    size_t size;
+    size_t length;
+} ReportWriter;
+
+static void report_append(ReportWriter* w, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    size_t remaining = w->length < w->size ? w->size - w->length : 0;
+    int n = vsnprintf(remaining ? w->out + w->length : NULL, remaining, fmt, args);
+    va_end(args);
+    if (n > 0) w->length += (size_t)n;
+}
+
+size_t mem_format_json(char* out, size_t size) {
+    MemoryTotals totals;
+    MemoryStats stats[PROFILE_PHASE_COUNT];
+    mem_totals(&totals);
+    int count = mem_snapshot(stats, PROFILE_PHASE_COUNT);
+    ReportWriter w = { out, size, 0 };
+    if (size > 0) out[0] = '\0';
+
+    report_append(&w, "{\"live_bytes\":%lld,\"peak_live_bytes\":%lld,\"rss_bytes\":%lld,"
+                      "\"peak_sampled_rss_bytes\":%lld,\"peak_rss_bytes\":%lld,\"phases\":[",
+                  totals.live_bytes, totals.peak_live_bytes, totals.rss_bytes,
+                  totals.peak_sampled_rss_bytes, totals.peak_rss_bytes);
+    int written = 0;
+    for (int i = 0; i < count; i++) {
+        if (stats[i].allocations == 0 && stats[i].live_bytes == 0) continue;
+        report_append(&w, "%s{\"phase\":\"%s\",\"allocations\":%lld,\"frees\":%lld,\"bytes\":%lld,"
+                          "\"live_bytes\":%lld,\"peak_live_bytes\":%lld}",
+                      written++ ? "," : "", stats[i].name, stats[i].allocations, stats[i].frees,
+                      stats[i].bytes, stats[i].live_bytes, stats[i].peak_live_bytes);
+    }
+    report_append(&w, "]}");
+    return w.length;
+}
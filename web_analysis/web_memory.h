@@ -0,0 +1,61 @@
+#ifndef WEB_MEMORY_H
+#define WEB_MEMORY_H
+
+#include <stddef.h>
+#include "web_profile.h"
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Allocation accounting by profile phase. The wrappers are sized: frees pass
+// back the size they allocated, so no header is added and every block stays
+// an ordinary malloc block. A block freed with plain free() is still valid;
+// it just stays counted as live. Counting is always on, since the
+// wrapped allocations are per batch, table or result rather than per item.
+//
+// Process RSS is sampled at batch and analysis boundaries so the report can
+// show the peak seen during analysis next to the OS high-water mark.
+
+typedef struct {
+    int phase;
+    const char* name;
+    long long allocations;
+    long long frees;
+    long long bytes;             // Total allocated since the last reset
+    long long live_bytes;
+    long long peak_live_bytes;
+} MemoryStats;
+
+typedef struct {
+    long long live_bytes;        // Across all phases
+    long long peak_live_bytes;
+    long long rss_bytes;         // Current resident set, 0 if unknown
+    long long peak_sampled_rss_bytes;
+    long long peak_rss_bytes;    // OS high-water mark for the process
+} MemoryTotals;
+
+EXPORT void* mem_alloc(ProfilePhase phase, size_t size);
+EXPORT void* mem_calloc(ProfilePhase phase, size_t count, size_t size);
+EXPORT void* mem_realloc(ProfilePhase phase, void* ptr, size_t old_size, size_t new_size);
+EXPORT void mem_free(ProfilePhase phase, void* ptr, size_t size);
+
+// Reads the process RSS and folds it into the sampled peak. Returns it in
+// bytes, or 0 where it cannot be read.
+EXPORT long long mem_sample_rss(void);
+
+// Clears allocation totals and restarts every peak from the current live
+// bytes and RSS. Live bytes are kept so later frees still balance.
+EXPORT void mem_reset(void);
+
+// Copies up to capacity phases in ProfilePhase order. Returns the number copied.
+EXPORT int mem_snapshot(MemoryStats* out, int capacity);
+EXPORT void mem_totals(MemoryTotals* out);
+
+// JSON object with the MemoryTotals fields and a "phases" array of the phases
+// that allocated. Returns the length needed, like snprintf.
+EXPORT size_t mem_format_json(char* out, size_t size);
+
+#endif // WEB_MEMORY_H
@@ -1,7 +1,39 @@
 #include "web_parsers.h"
+#include "web_log.h"
 #include <string.h>
 #include <ctype.h>
 
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+static THREAD_LOCAL ParserStopCheck stop_check = NULL;
+static THREAD_LOCAL void* stop_context = NULL;
+static THREAD_LOCAL int stopped = 0;
+
+EXPORT void parser_set_stop_check(ParserStopCheck check, void* context) {
+    stop_check = check;
+    stop_context = context;
+    stopped = 0;
+}
+
+EXPORT int parser_was_stopped(void) {
+    return stopped;
+}
+
+static int poll_stop(void) {
+    if (!stopped && stop_check && stop_check(stop_context)) {
+        stopped = 1;
+    }
+    return stopped;
+}
+
+// Polls the stop check once every PARSER_STOP_INTERVAL loop iterations
+#define PARSER_SHOULD_STOP(polls) \
+    ((++(polls) & (PARSER_STOP_INTERVAL - 1)) == 0 && poll_stop())
+
 static void init_framework_info(FrameworkInfo* info) {
     if (!info) return;
 
@@ -25,11 +57,13 @@ HTMLInfo parse_html(const char* html_content) {
     const char* ptr = html_content;
     int tag_count = 0;
 
+    unsigned int polls = 0;
     while (*ptr) {
+        if (PARSER_SHOULD_STOP(polls)) break;
         if (*ptr == '<') {
             tag_count++;
             if (tag_count % 1000 == 0) {
-                printf("Processed %d HTML tags\n", tag_count);
+                LOG_DEBUG(LOG_CAT_PARSER, "Processed %d HTML tags", tag_count);
             }
             if (strncmp(ptr, "script", 6) == 0) {
                 info.script_count++;
@@ -83,16 +117,17 @@ HTMLInfo parse_html(const char* html_content) {
                 tag_name[i] = '\0';
 
                 if (strchr(tag_name, '-') && tag_name[0] != '/') {
+                    StringId tag_id = string_pool_intern(tag_name);
                     int found = 0;
                     for (i = 0; i < info.custom_element_count; i++) {
-                        if (strcmp(info.custom_elements[i].name, tag_name) == 0) {
+                        if (info.custom_elements[i].name == tag_id) {
                             info.custom_elements[i].count++;
                             found = 1;
                             break;
                         }
                     }
                     if (!found && info.custom_element_count < MAX_CUSTOM_ELEMENTS) {
-                        strncpy(info.custom_elements[info.custom_element_count].name, tag_name, 49);
+                        info.custom_elements[info.custom_element_count].name = tag_id;
                         info.custom_elements[info.custom_element_count].count = 1;
                         info.custom_element_count++;
                     }
@@ -101,10 +136,10 @@ HTMLInfo parse_html(const char* html_content) {
                     if (info.framework_component_count < MAX_FRAMEWORK_COMPONENTS) {
                         if (strncmp(tag_name, "zephyr-", 7) == 0) {
                             info.is_zephyr = 1;
-                            strncpy(info.framework_components[info.framework_component_count++], tag_name, 49);
+                            info.framework_components[info.framework_component_count++] = tag_id;
                         } else if (strncmp(tag_name, "app-", 4) == 0 || strncmp(tag_name, "ng-", 3) == 0) {
                             info.is_angular = 1;
-                            strncpy(info.framework_components[info.framework_component_count++], tag_name, 49);
+                            info.framework_components[info.framework_component_count++] = tag_id;
                         }
                     }
                 }
@@ -112,10 +147,6 @@ HTMLInfo parse_html(const char* html_content) {
             info.tag_count++;
         }
         ptr++;
-
-        if (info.tag_count % 1000 == 0) {
-            printf("Processed %d HTML tags\n", info.tag_count);
-        }
     }
 
     // Check for potential issues
@@ -130,7 +161,7 @@ HTMLInfo parse_html(const char* html_content) {
         info.potential_issue_count++;
     }
 
-    printf("Finished parsing HTML. Total tags: %d\n", info.tag_count);
+    LOG_DEBUG(LOG_CAT_PARSER, "Finished parsing HTML. Total tags: %d", info.tag_count);
     return info;
 }
 
@@ -138,7 +169,9 @@ CSSInfo parse_css(const char* css_content) {
     CSSInfo info = {0};
     const char* ptr = css_content;
 
+    unsigned int polls = 0;
     while (*ptr) {
+        if (PARSER_SHOULD_STOP(polls)) break;
         if (*ptr == '{') {
             info.rule_count++;
         } else if (*ptr == ':') {
@@ -174,7 +207,9 @@ JSInfo parse_javascript(const char* js_content) {
 
     init_framework_info(&info.framework);
 
+    unsigned int polls = 0;
     while (*ptr) {
+        if (PARSER_SHOULD_STOP(polls)) break;
         if (strstr(ptr, "function") == ptr || strstr(ptr, "=>") == ptr) {
             info.function_count++;
         } else if (strstr(ptr, "var ") == ptr || strstr(ptr, "let ") == ptr || strstr(ptr, "const ") == ptr) {
@@ -204,6 +239,7 @@ JSInfo parse_javascript(const char* js_content) {
     ptr = js_content;
     int nested_functions = 0;
     while (*ptr) {
+        if (PARSER_SHOULD_STOP(polls)) break;
         if (strstr(ptr, "function") == ptr) {
             nested_functions++;
             if (nested_functions > 1) {
@@ -243,7 +279,9 @@ JSONInfo parse_json(const char* json_content) {
     int in_string = 0;
     char prev_char = '\0';
 
+    unsigned int polls = 0;
     for (const char* c = json_content; *c != '\0'; c++) {
+        if (PARSER_SHOULD_STOP(polls)) break;
         if (*c == '"' && prev_char != '\\') {
             in_string = !in_string;
         }
@@ -373,7 +411,9 @@ TSInfo parse_typescript(const char* ts_content) {
     TSInfo info = {0};
     const char* ptr = ts_content;
 
+    unsigned int polls = 0;
     while (*ptr) {
+        if (PARSER_SHOULD_STOP(polls)) break;
         // Interface detection
         if (strstr(ptr, "interface ") == ptr) {
             info.interface_count++;
@@ -432,7 +472,9 @@ JSXInfo parse_jsx(const char* jsx_content) {
     char component_stack[100][50] = {0};
     int stack_depth = 0;
 
+    unsigned int polls = 0;
     while (*ptr) {
+        if (PARSER_SHOULD_STOP(polls)) break;
         // Component detection
         if (*ptr == '<' && isalpha(*(ptr + 1))) {
             char component_name[50] = {0};
@@ -447,7 +489,9 @@ JSXInfo parse_jsx(const char* jsx_content) {
                 // Check if it's a custom component (starts with capital letter)
                 if (isupper(component_name[0])) {
                     info.custom_component_count++;
-                    strncpy(component_stack[stack_depth++], component_name, 49);
+                    if (stack_depth < 100) {
+                        strncpy(component_stack[stack_depth++], component_name, 49);
+                    }
                 }
 
                 // Track component nesting
@@ -498,7 +542,9 @@ VueInfo parse_vue(const char* vue_content) {
     int in_script = 0;
     int in_style = 0;
 
+    unsigned int polls = 0;
     while (*ptr) {
+        if (PARSER_SHOULD_STOP(polls)) break;
         // Section detection
         if (strstr(ptr, "<template>") == ptr) {
             in_template = 1;
@@ -562,12 +608,15 @@ VueInfo parse_vue(const char* vue_content) {
 XMLInfo parse_xml(const char* xml_content) {
     XMLInfo info = {0};
     const char* ptr = xml_content;
+    const char* end = xml_content + strlen(xml_content);
     int depth = 0;
     char namespace_stack[100][50] = {0};
     int namespace_depth = 0;
 
-    while (*ptr) {
-        if (*ptr == '<' && *(ptr + 1) != '/') {
+    unsigned int polls = 0;
+    while (ptr < end) {
+        if (PARSER_SHOULD_STOP(polls)) break;
+        if (*ptr == '<' && (ptr + 1 >= end || *(ptr + 1) != '/')) {
             depth++;
             if (depth > info.max_nesting_level) {
                 info.max_nesting_level = depth;
@@ -601,8 +650,9 @@ XMLInfo parse_xml(const char* xml_content) {
             info.has_xml_declaration = 1;
         }
 
-        // Attribute counting
-        if (*ptr == '=' && *(ptr - 1) != '>' && *(ptr + 1) == '"') {
+        // Attribute counting. The neighbours may lie outside the content.
+        if (*ptr == '=' && ptr > xml_content && *(ptr - 1) != '>' &&
+            ptr + 1 < end && *(ptr + 1) == '"') {
             info.attribute_count++;
         }
 
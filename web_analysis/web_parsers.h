@@ -5,6 +5,7 @@
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
+#include "web_string_pool.h"
 
 #ifdef _WIN32
 #define EXPORT __declspec(dllexport)
@@ -27,7 +28,7 @@ typedef struct {
 } PotentialIssue;
 
 typedef struct {
-    char name[50];
+    StringId name;
     int count;
 } CustomElement;
 
@@ -120,7 +121,7 @@ typedef struct {
     int custom_element_count;
     ExternalResource external_resources[MAX_EXTERNAL_RESOURCES];
     int external_resource_count;
-    char framework_components[MAX_FRAMEWORK_COMPONENTS][50];
+    StringId framework_components[MAX_FRAMEWORK_COMPONENTS];
     int framework_component_count;
     PotentialIssue potential_issues[MAX_POTENTIAL_ISSUES];
     int potential_issue_count;
@@ -227,6 +228,20 @@ EXPORT JSXInfo parse_jsx(const char* jsx_content);
 EXPORT VueInfo parse_vue(const char* vue_content);
 EXPORT XMLInfo parse_xml(const char* xml_content);
 
+// Cooperative stop check for long parser loops. The check is installed per
+// thread; parsers poll it every PARSER_STOP_INTERVAL iterations and return
+// what they have gathered so far once it returns non-zero.
+#define PARSER_STOP_INTERVAL 4096
+typedef int (*ParserStopCheck)(void* context);
+
+// Installs a check for the calling thread (NULL removes it) and clears the
+// stopped flag.
+EXPORT void parser_set_stop_check(ParserStopCheck check, void* context);
+
+// Non-zero if a parser on this thread stopped early since the last
+// parser_set_stop_check call, meaning its result is partial.
+EXPORT int parser_was_stopped(void);
+
 #pragma pack(pop)
 
 #endif // WEB_PARSERS_H
\ No newline at end of file
@@ -0,0 +1,284 @@
+#include "web_profile.h"
+#include "web_hw_counters.h"
+#include "web_memory.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#endif
+
+#ifdef _MSC_VER
+static __forceinline long long load_i64(volatile long long* p) { return InterlockedCompareExchange64(p, 0, 0); }
+static __forceinline void store_i64(volatile long long* p, long long v) { InterlockedExchange64(p, v); }
+static __forceinline int cas_i64(volatile long long* p, long long expected, long long desired) {
+    return InterlockedCompareExchange64(p, desired, expected) == expected;
+}
+static __forceinline void add_i64(volatile long long* p, long long v) { InterlockedExchangeAdd64(p, v); }
+#else
+static inline long long load_i64(volatile long long* p) { return __atomic_load_n(p, __ATOMIC_RELAXED); }
+static inline void store_i64(volatile long long* p, long long v) { __atomic_store_n(p, v, __ATOMIC_RELAXED); }
+static inline int cas_i64(volatile long long* p, long long expected, long long desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_RELAXED, __ATOMIC_RELAXED);
+}
+static inline void add_i64(volatile long long* p, long long v) { __atomic_add_fetch(p, v, __ATOMIC_RELAXED); }
+#endif
+
+// Counters only ever grow between resets, so relaxed ordering is enough; a
+// snapshot taken mid-analysis may see one phase slightly ahead of another.
+typedef struct {
+    volatile long long calls;
+    volatile long long total_ns;
+    volatile long long max_ns;
+    volatile long long bytes;
+    volatile long long items;
+} PhaseCounters;
+
+typedef struct {
+    const char* name;
+    int parent;
+} PhaseInfo;
+
+static const PhaseInfo phase_info[PROFILE_PHASE_COUNT] = {
+    [PROFILE_PHASE_ANALYSIS] = { "analysis", -1 },
+    [PROFILE_PHASE_ENUMERATION] = { "enumeration", PROFILE_PHASE_ANALYSIS },
+    [PROFILE_PHASE_IO] = { "io", PROFILE_PHASE_ANALYSIS },
+    [PROFILE_PHASE_PARSE] = { "parse", PROFILE_PHASE_ANALYSIS },
+    [PROFILE_PHASE_PARSE_HTML] = { "parse_html", PROFILE_PHASE_PARSE },
+    [PROFILE_PHASE_PARSE_CSS] = { "parse_css", PROFILE_PHASE_PARSE },
+    [PROFILE_PHASE_PARSE_JS] = { "parse_javascript", PROFILE_PHASE_PARSE },
+    [PROFILE_PHASE_PARSE_JSON] = { "parse_json", PROFILE_PHASE_PARSE },
+    [PROFILE_PHASE_PARSE_TS] = { "parse_typescript", PROFILE_PHASE_PARSE },
+    [PROFILE_PHASE_PARSE_JSX] = { "parse_jsx", PROFILE_PHASE_PARSE },
+    [PROFILE_PHASE_PARSE_VUE] = { "parse_vue", PROFILE_PHASE_PARSE },
+    [PROFILE_PHASE_PARSE_XML] = { "parse_xml", PROFILE_PHASE_PARSE },
+    [PROFILE_PHASE_PACKAGE_JSON] = { "package_json", PROFILE_PHASE_PARSE },
+    [PROFILE_PHASE_MERGE] = { "merge", PROFILE_PHASE_ANALYSIS },
+    [PROFILE_PHASE_WORKSPACE] = { "workspace", PROFILE_PHASE_ANALYSIS },
+    [PROFILE_PHASE_LOCKFILE] = { "lockfile", PROFILE_PHASE_ANALYSIS },
+    [PROFILE_PHASE_DEPENDENCY_STATS] = { "dependency_stats", PROFILE_PHASE_ANALYSIS },
+    [PROFILE_PHASE_ESTIMATION] = { "estimation", -1 },
+    [PROFILE_PHASE_JNI_CONVERSION] = { "jni_conversion", -1 },
+};
+
+static PhaseCounters counters[PROFILE_PHASE_COUNT];
+
+static int initial_enabled(void) {
+    const char* value = getenv(PROFILE_ENV_VAR);
+    return value && *value && strcmp(value, "0") != 0;
+}
+
+// -1 until first read; profile_now_ns resolves it from the environment
+volatile int profile_enabled = -1;
+
+void profile_set_enabled(int enabled) {
+    profile_enabled = enabled ? 1 : 0;
+}
+
+void profile_reset(void) {
+    for (int i = 0; i < PROFILE_PHASE_COUNT; i++) {
+        store_i64(&counters[i].calls, 0);
+        store_i64(&counters[i].total_ns, 0);
+        store_i64(&counters[i].max_ns, 0);
+        store_i64(&counters[i].bytes, 0);
+        store_i64(&counters[i].items, 0);
+    }
+    hw_counters_reset();
+    mem_reset();
+}
+
+long long profile_now_ns(void) {
+    if (profile_enabled < 0) {
+        profile_enabled = initial_enabled();
+        if (!profile_enabled) return 0;
+    }
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER counter;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+    return (long long)((double)counter.QuadPart * 1.0e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+void profile_record(ProfilePhase phase, long long elapsed_ns, long long bytes, long long items) {
+    if (phase < 0 || phase >= PROFILE_PHASE_COUNT) return;
+    PhaseCounters* c = &counters[phase];
+
+    add_i64(&c->calls, 1);
+    add_i64(&c->total_ns, elapsed_ns);
+    if (bytes) add_i64(&c->bytes, bytes);
+    if (items) add_i64(&c->items, items);
+
+    long long max = load_i64(&c->max_ns);
+    while (elapsed_ns > max && !cas_i64(&c->max_ns, max, elapsed_ns)) {
+        max = load_i64(&c->max_ns);
+    }
+}
+
+const char* profile_phase_name(ProfilePhase phase) {
+    return (phase >= 0 && phase < PROFILE_PHASE_COUNT) ? phase_info[phase].name : "unknown";
+}
+
+int profile_phase_parent(ProfilePhase phase) {
+    return (phase >= 0 && phase < PROFILE_PHASE_COUNT) ? phase_info[phase].parent : -1;
+}
+
+int profile_snapshot(PhaseStats* out, int capacity) {
+    int count = capacity < PROFILE_PHASE_COUNT ? capacity : PROFILE_PHASE_COUNT;
+    for (int i = 0; i < count; i++) {
+        out[i].phase = i;
+        out[i].parent = phase_info[i].parent;
+        out[i].name = phase_info[i].name;
+        out[i].calls = load_i64(&counters[i].calls);
+        out[i].total_ns = load_i64(&counters[i].total_ns);
+        out[i].max_ns = load_i64(&counters[i].max_ns);
+        out[i].bytes = load_i64(&counters[i].bytes);
+        out[i].items = load_i64(&counters[i].items);
+    }
+    return count;
+}
+
+// snprintf into a running position that keeps counting past the end
+typedef struct {
+    char* out;
+    size_t size;
+    size_t length;
+} ReportWriter;
+
+static void report_append(ReportWriter* w, const char* fmt, ...) {
+    va_list args;
+    va_start(args, fmt);
+    size_t remaining = w->length < w->size ? w->size - w->length : 0;
+    int n = vsnprintf(remaining ? w->out + w->length : NULL, remaining, fmt, args);
+    va_end(args);
+    if (n > 0) w->length += (size_t)n;
+}
+
+static int phase_depth(int phase) {
+    int depth = 0;
+    for (int p = phase_info[phase].parent; p >= 0; p = phase_info[p].parent) depth++;
+    return depth;
+}
+
+size_t profile_format_report(char* out, size_t size) {
+    PhaseStats stats[PROFILE_PHASE_COUNT];
+    int count = profile_snapshot(stats, PROFILE_PHASE_COUNT);
+    ReportWriter w = { out, size, 0 };
+    if (size > 0) out[0] = '\0';
+
+    report_append(&w, "%-24s %8s %12s %10s %12s %10s\n",
+                  "phase", "calls", "total ms", "max ms", "bytes", "items");
+    for (int i = 0; i < count; i++) {
+        if (stats[i].calls == 0) continue;
+        int indent = phase_depth(i) * 2;
+        report_append(&w, "%*s%-*s %8lld %12.3f %10.3f %12lld %10lld\n",
+                      indent, "", 24 - indent, stats[i].name, stats[i].calls,
+                      stats[i].total_ns / 1.0e6, stats[i].max_ns / 1.0e6,
+                      stats[i].bytes, stats[i].items);
+    }
+
+    // Hardware counters, for the phases that sampled them; "-" where the
+    // counter could not be opened
+    HwPhaseCounts hw[PROFILE_PHASE_COUNT];
+    hw_counters_snapshot(hw, PROFILE_PHASE_COUNT);
+    unsigned int available = hw_counters_available();
+    int header = 0;
+    for (int i = 0; i < count; i++) {
+        if (hw[i].samples == 0) continue;
+        if (!header) {
+            report_append(&w, "\n%-24s %8s", "phase", "samples");
+            for (int c = 0; c < HW_COUNTER_COUNT; c++) report_append(&w, " %14s", hw_counter_name(c));
+            report_append(&w, " %6s\n", "ipc");
+            header = 1;
+        }
+        int indent = phase_depth(i) * 2;
+        report_append(&w, "%*s%-*s %8lld", indent, "", 24 - indent, stats[i].name, hw[i].samples);
+        for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+            if (available & (1u << c)) report_append(&w, " %14lld", hw[i].values[c]);
+            else report_append(&w, " %14s", "-");
+        }
+        long long cycles = hw[i].values[HW_COUNTER_CYCLES];
+        if (cycles > 0 && (available & (1u << HW_COUNTER_INSTRUCTIONS))) {
+            report_append(&w, " %6.2f\n", (double)hw[i].values[HW_COUNTER_INSTRUCTIONS] / cycles);
+        } else {
+            report_append(&w, " %6s\n", "-");
+        }
+    }
+
+    // Tracked allocations per phase, then the process as a whole
+    MemoryStats mem[PROFILE_PHASE_COUNT];
+    MemoryTotals totals;
+    mem_snapshot(mem, PROFILE_PHASE_COUNT);
+    mem_totals(&totals);
+    header = 0;
+    for (int i = 0; i < count; i++) {
+        if (mem[i].allocations == 0 && mem[i].live_bytes == 0) continue;
+        if (!header) {
+            report_append(&w, "\n%-24s %8s %8s %12s %10s %10s\n",
+                          "phase", "allocs", "frees", "alloc KB", "live KB", "peak KB");
+            header = 1;
+        }
+        int indent = phase_depth(i) * 2;
+        report_append(&w, "%*s%-*s %8lld %8lld %12.1f %10.1f %10.1f\n",
+                      indent, "", 24 - indent, mem[i].name, mem[i].allocations, mem[i].frees,
+                      mem[i].bytes / 1024.0, mem[i].live_bytes / 1024.0, mem[i].peak_live_bytes / 1024.0);
+    }
+    report_append(&w, "\nrss %.1f MB, sampled peak %.1f MB, process peak %.1f MB; "
+                      "tracked live %.1f KB, peak %.1f KB\n",
+                  totals.rss_bytes / 1048576.0, totals.peak_sampled_rss_bytes / 1048576.0,
+                  totals.peak_rss_bytes / 1048576.0,
+                  totals.live_bytes / 1024.0, totals.peak_live_bytes / 1024.0);
+    return w.length;
+}
+
+size_t profile_format_json(char* out, size_t size) {
+    PhaseStats stats[PROFILE_PHASE_COUNT];
+    int count = profile_snapshot(stats, PROFILE_PHASE_COUNT);
+    HwPhaseCounts hw[PROFILE_PHASE_COUNT];
+    hw_counters_snapshot(hw, PROFILE_PHASE_COUNT);
+    unsigned int available = hw_counters_available();
+    MemoryStats mem[PROFILE_PHASE_COUNT];
+    mem_snapshot(mem, PROFILE_PHASE_COUNT);
+    ReportWriter w = { out, size, 0 };
+    if (size > 0) out[0] = '\0';
+
+    report_append(&w, "[");
+    for (int i = 0; i < count; i++) {
+        const char* parent = stats[i].parent >= 0 ? phase_info[stats[i].parent].name : NULL;
+        report_append(&w, "%s{\"phase\":\"%s\",\"parent\":%s%s%s,\"calls\":%lld,\"total_ns\":%lld,"
+                          "\"max_ns\":%lld,\"bytes\":%lld,\"items\":%lld",
+                      i ? "," : "", stats[i].name,
+                      parent ? "\"" : "", parent ? parent : "null", parent ? "\"" : "",
+                      stats[i].calls, stats[i].total_ns, stats[i].max_ns,
+                      stats[i].bytes, stats[i].items);
+
+        // Present once a phase has counter samples; unavailable counters are null
+        if (hw[i].samples > 0) {
+            report_append(&w, ",\"hw\":{\"samples\":%lld", hw[i].samples);
+            for (int c = 0; c < HW_COUNTER_COUNT; c++) {
+                if (available & (1u << c)) report_append(&w, ",\"%s\":%lld", hw_counter_name(c), hw[i].values[c]);
+                else report_append(&w, ",\"%s\":null", hw_counter_name(c));
+            }
+            report_append(&w, "}");
+        }
+
+        // Present once a phase has tracked allocations
+        if (mem[i].allocations > 0 || mem[i].live_bytes != 0) {
+            report_append(&w, ",\"mem\":{\"allocations\":%lld,\"frees\":%lld,\"bytes\":%lld,"
+                              "\"live_bytes\":%lld,\"peak_live_bytes\":%lld}",
+                          mem[i].allocations, mem[i].frees, mem[i].bytes,
+                          mem[i].live_bytes, mem[i].peak_live_bytes);
+        }
+        report_append(&w, "}");
+    }
+    report_append(&w, "]");
+    return w.length;
+}
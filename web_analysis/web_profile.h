@@ -0,0 +1,84 @@
+#ifndef WEB_PROFILE_H
+#define WEB_PROFILE_H
+
+#include <stddef.h>
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Process-wide phase timings. Each phase accumulates monotonic wall time,
+// bytes and items from every thread that records it, so phases run on the
+// worker pool (io, parse_*) report summed worker time, which can exceed the
+// elapsed time of their parent. Recording is off until enabled through
+// profile_set_enabled or PROFILE_ENV_VAR=1.
+#define PROFILE_ENV_VAR "WEB_ANALYSIS_PROFILE"
+
+typedef enum {
+    PROFILE_PHASE_ANALYSIS,          // analyze_project_type_ex end to end
+    PROFILE_PHASE_ENUMERATION,       // Directory walk, excluding batch work
+    PROFILE_PHASE_IO,                // File reads
+    PROFILE_PHASE_PARSE,             // parse_file_content, cache lookups included
+    PROFILE_PHASE_PARSE_HTML,
+    PROFILE_PHASE_PARSE_CSS,
+    PROFILE_PHASE_PARSE_JS,
+    PROFILE_PHASE_PARSE_JSON,
+    PROFILE_PHASE_PARSE_TS,
+    PROFILE_PHASE_PARSE_JSX,
+    PROFILE_PHASE_PARSE_VUE,
+    PROFILE_PHASE_PARSE_XML,
+    PROFILE_PHASE_PACKAGE_JSON,      // Dependency sections of package.json
+    PROFILE_PHASE_MERGE,             // Folding parsed files into the project
+    PROFILE_PHASE_WORKSPACE,         // Monorepo workspace analysis
+    PROFILE_PHASE_LOCKFILE,          // Lockfile read and dependency graph
+    PROFILE_PHASE_DEPENDENCY_STATS,
+    PROFILE_PHASE_ESTIMATION,        // estimate_resources
+    PROFILE_PHASE_JNI_CONVERSION,    // Java <-> C result conversion
+    PROFILE_PHASE_COUNT
+} ProfilePhase;
+
+typedef struct {
+    int phase;
+    int parent;                      // Enclosing phase, -1 for top level
+    const char* name;
+    long long calls;
+    long long total_ns;
+    long long max_ns;
+    long long bytes;
+    long long items;
+} PhaseStats;
+
+// Checked inline by PROFILE_START so disabled builds pay one load per phase
+extern EXPORT volatile int profile_enabled;
+
+EXPORT void profile_set_enabled(int enabled);
+// Also clears the hardware counter and memory totals
+EXPORT void profile_reset(void);
+
+EXPORT long long profile_now_ns(void);
+EXPORT void profile_record(ProfilePhase phase, long long elapsed_ns, long long bytes, long long items);
+
+EXPORT const char* profile_phase_name(ProfilePhase phase);
+EXPORT int profile_phase_parent(ProfilePhase phase);
+
+// Copies up to capacity phases in ProfilePhase order. Returns the number copied.
+EXPORT int profile_snapshot(PhaseStats* out, int capacity);
+
+// Writes the phases as an indented text tree, or as a JSON array of objects
+// with the PhaseStats field names. Phases with hardware counter samples get a
+// second table, or an "hw" object in JSON (see web_hw_counters.h), and
+// phases with tracked allocations a "mem" table or object (web_memory.h). Both
+// return the length the full report needs, excluding the terminator, like
+// snprintf.
+EXPORT size_t profile_format_report(char* out, size_t size);
+EXPORT size_t profile_format_json(char* out, size_t size);
+
+#define PROFILE_START(mark) long long mark = profile_enabled ? profile_now_ns() : 0
+
+#define PROFILE_END(phase, mark, bytes, items) do { \
+    if (mark) profile_record(phase, profile_now_ns() - (mark), bytes, items); \
+} while (0)
+
+#endif // WEB_PROFILE_H
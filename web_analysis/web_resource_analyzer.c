@@ -1,23 +1,36 @@
 #include "web_resource_analyzer.h"
-
-static void cache_dependency(const char* name, const char* version) {
-    for (int i = 0; i < dep_cache.count; i++) {
-        if (strcmp(dep_cache.items[i].name, name) == 0) {
-            dep_cache.items[i].count++;
+#ifndef _WIN32
+#include <pthread.h>
+#endif
+
+static void cache_dependency(DependencyCache* dep_cache, StringId name, StringId version) {
+    for (int i = 0; i < dep_cache->count; i++) {
+        if (dep_cache->items[i].name == name) {
+            dep_cache->items[i].count++;
             return;
         }
     }
 
-    if (dep_cache.count < MAX_CACHED_DEPS) {
-        strncpy(dep_cache.items[dep_cache.count].name, name, 99);
-        strncpy(dep_cache.items[dep_cache.count].version, version, 19);
-        dep_cache.items[dep_cache.count].count = 1;
-        dep_cache.count++;
+    if (dep_cache->count < MAX_CACHED_DEPS) {
+        dep_cache->items[dep_cache->count].name = name;
+        dep_cache->items[dep_cache->count].version = version;
+        dep_cache->items[dep_cache->count].count = 1;
+        dep_cache->count++;
     }
 }
 
-void generate_dependency_statistics(ProjectType* project) {
-    if (!project) return;
+// Recomputes the dependency counters from the project's dependency list
+static void count_dependencies(ProjectType* project) {
+    // Collapse the project's dependency list to unique names
+    DependencyCache* dep_cache = mem_calloc(PROFILE_PHASE_DEPENDENCY_STATS, 1, sizeof(DependencyCache));
+    if (!dep_cache) {
+        fprintf(stderr, "Memory allocation failed for DependencyCache\n");
+        return;
+    }
+    for (int i = 0; i < project->dependencies.count; i++) {
+        cache_dependency(dep_cache, project->dependencies.items[i].name,
+                         project->dependencies.items[i].version);
+    }
 
     // Reset any existing dependency counts
     project->total_dependencies = 0;
@@ -26,20 +39,28 @@ void generate_dependency_statistics(ProjectType* project) {
     project->framework_dependencies = 0;
 
     // Use the cache to compute statistics
-    for (int i = 0; i < dep_cache.count; i++) {
+    for (int i = 0; i < dep_cache->count; i++) {
         project->total_dependencies++;
 
         // Check for framework-related dependencies
-        if (strstr(dep_cache.items[i].name, "react") ||
-            strstr(dep_cache.items[i].name, "vue") ||
-            strstr(dep_cache.items[i].name, "angular") ||
-            strstr(dep_cache.items[i].name, "svelte")) {
+        const char* name = string_pool_get(dep_cache->items[i].name);
+        if (strstr(name, "react") ||
+            strstr(name, "vue") ||
+            strstr(name, "angular") ||
+            strstr(name, "svelte")) {
             project->framework_dependencies++;
         }
 
         // Additional statistics could be added here
         // For example, counting dependencies by type, checking versions, etc.
     }
+    mem_free(PROFILE_PHASE_DEPENDENCY_STATS, dep_cache, sizeof(DependencyCache));
+}
+
+void generate_dependency_statistics(ProjectType* project) {
+    if (!project) return;
+
+    count_dependencies(project);
 
     // Add dependency-related issues if needed
     if (project->total_dependencies > 100) {
@@ -55,6 +76,308 @@ void generate_dependency_statistics(ProjectType* project) {
                  project->framework_dependencies);
         project->potential_issue_count++;
     }
+
+    // Transitive installs, from the lockfile when there is one
+    const LockfileSummary* lockfile = &project->lockfile;
+    if (lockfile->package_count > 1000 && project->potential_issue_count < MAX_POTENTIAL_ISSUES) {
+        snprintf(project->potential_issues[project->potential_issue_count].description, 255,
+                 "High number of installed packages (%d from %d direct dependencies) increases install and bundle size",
+                 lockfile->package_count, project->total_dependencies);
+        project->potential_issue_count++;
+    }
+
+    if (lockfile->duplicate_count > 0 && project->potential_issue_count < MAX_POTENTIAL_ISSUES) {
+        snprintf(project->potential_issues[project->potential_issue_count].description, 255,
+                 "%d packages are installed at more than one version (%s at %d) - deduplicating may shrink the bundle",
+                 lockfile->duplicate_package_count, string_pool_get(lockfile->duplicates[0].name),
+                 lockfile->duplicates[0].version_count);
+        project->potential_issue_count++;
+    }
+}
+
+// Summarizes the lockfile in the project root, if any, for the dependency
+// statistics. The graph itself is not kept.
+static void read_project_lockfile(const char* project_path, ProjectType* project) {
+    LockfileSummary* summary = &project->lockfile;
+    memset(summary, 0, sizeof(LockfileSummary));
+
+    PROFILE_START(lockfile_mark);
+    LockfileGraph* graph = lockfile_read_project(project_path);
+    if (!graph) return;
+
+    strncpy(summary->kind, lockfile_kind_name(graph->kind), sizeof(summary->kind) - 1);
+    summary->lockfile_version = graph->lockfile_version;
+    summary->bytes = graph->bytes;
+    summary->package_count = graph->package_count;
+    summary->unique_package_count = graph->unique_package_count;
+    for (int i = 0; i < graph->package_count; i++) {
+        if (graph->packages[i].is_dev) summary->dev_package_count++;
+    }
+    summary->edge_count = graph->edge_count;
+    summary->resolved_edge_count = graph->resolved_edge_count;
+    summary->duplicate_package_count = graph->cluster_count;
+    summary->duplicate_count = graph->cluster_count < MAX_LOCKFILE_DUPLICATES
+                               ? graph->cluster_count : MAX_LOCKFILE_DUPLICATES;
+    if (summary->duplicate_count > 0) {
+        memcpy(summary->duplicates, graph->clusters, (size_t)summary->duplicate_count * sizeof(LockfileCluster));
+    }
+
+    PROFILE_END(PROFILE_PHASE_LOCKFILE, lockfile_mark, graph->bytes, graph->package_count);
+    LOG_DEBUG(LOG_CAT_DEPS, "%s lockfile: %d packages, %d edges, %d duplicated names",
+              summary->kind, graph->package_count, graph->edge_count, graph->cluster_count);
+    lockfile_free(graph);
+}
+
+// Workspace tables. Everything they point to lives in the workspace arena,
+// created on first use, so freeing the project releases it in one call.
+static Arena* workspace_arena(WorkspaceInfo* workspace) {
+    if (!workspace->arena) {
+        workspace->arena = arena_create(PROFILE_PHASE_WORKSPACE, 0);
+        if (!workspace->arena) {
+            fprintf(stderr, "Memory allocation failed for workspace arena\n");
+        }
+    }
+    return workspace->arena;
+}
+
+// Copies the first count items of a table into a new arena array of
+// capacity items. The old array stays in the arena until it is destroyed,
+// which doubling keeps to less than the table's final size.
+static void* grow_table(Arena* arena, const void* items, int count, int capacity, size_t stride) {
+    void* grown = arena_alloc(arena, (size_t)capacity * stride);
+    if (grown && count > 0) memcpy(grown, items, (size_t)count * stride);
+    return grown;
+}
+
+static void add_workspace_glob(WorkspaceInfo* workspace, const char* glob, size_t length) {
+    if (length == 0) return;
+    Arena* arena = workspace_arena(workspace);
+    if (!arena) return;
+    if (workspace->workspace_count == workspace->workspace_capacity) {
+        int capacity = workspace->workspace_capacity ? workspace->workspace_capacity * 2 : 8;
+        StringId* globs = grow_table(arena, workspace->workspace_globs, workspace->workspace_count,
+                                     capacity, sizeof(StringId));
+        if (!globs) return;
+        workspace->workspace_globs = globs;
+        workspace->workspace_capacity = capacity;
+    }
+    workspace->workspace_globs[workspace->workspace_count++] = string_pool_intern_n(glob, length);
+}
+
+static TaskGroup* add_task_group(WorkspaceInfo* workspace, const char* name, const char* type) {
+    Arena* arena = workspace_arena(workspace);
+    if (!arena) return NULL;
+    if (workspace->task_group_count == workspace->task_group_capacity) {
+        int capacity = workspace->task_group_capacity ? workspace->task_group_capacity * 2 : 8;
+        TaskGroup* groups = grow_table(arena, workspace->task_groups, workspace->task_group_count,
+                                       capacity, sizeof(TaskGroup));
+        if (!groups) return NULL;
+        workspace->task_groups = groups;
+        workspace->task_group_capacity = capacity;
+    }
+    TaskGroup* group = &workspace->task_groups[workspace->task_group_count++];
+    strncpy(group->name, name, sizeof(group->name) - 1);
+    strncpy(group->type, type, sizeof(group->type) - 1);
+    return group;
+}
+
+static void add_task_group_member(WorkspaceInfo* workspace, TaskGroup* group, StringId name) {
+    if (group->package_count == group->package_capacity) {
+        int capacity = group->package_capacity ? group->package_capacity * 2 : 8;
+        StringId* members = grow_table(workspace_arena(workspace), group->packages, group->package_count,
+                                       capacity, sizeof(StringId));
+        if (!members) return;
+        group->packages = members;
+        group->package_capacity = capacity;
+    }
+    group->packages[group->package_count++] = name;
+}
+
+// Compares paths ignoring separator style, repeated separators and a
+// trailing separator, since globs and config files spell them differently
+static int same_path(const char* a, const char* b) {
+    for (;;) {
+        int a_sep = (*a == '/' || *a == '\\');
+        int b_sep = (*b == '/' || *b == '\\');
+        if (a_sep && b_sep) {
+            while (*a == '/' || *a == '\\') a++;
+            while (*b == '/' || *b == '\\') b++;
+            continue;
+        }
+        if (a_sep && !*b) {
+            while (*a == '/' || *a == '\\') a++;
+            return *a == '\0';
+        }
+        if (b_sep && !*a) {
+            while (*b == '/' || *b == '\\') b++;
+            return *b == '\0';
+        }
+        if (*a != *b) return 0;
+        if (!*a) return 1;
+        a++;
+        b++;
+    }
+}
+
+// FNV-1a over a path as same_path sees it, so equal paths hash alike
+static uint32_t hash_path(const char* path) {
+    uint32_t hash = 2166136261u;
+    while (*path) {
+        unsigned char c = (unsigned char)*path++;
+        if (c == '/' || c == '\\') {
+            while (*path == '/' || *path == '\\') path++;
+            if (!*path) break;
+            c = '/';
+        }
+        hash ^= c;
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static uint32_t hash_package_path(const Package* pkg) {
+    return hash_path(string_pool_get(pkg->path));
+}
+
+static uint32_t hash_package_name(const Package* pkg) {
+    return pkg->name * 2654435761u;
+}
+
+// Adds package index to an index keyed by hash, at most half full. Growing
+// rehashes the entries already there.
+static void index_package(WorkspaceInfo* workspace, PackageIndex* index, int package,
+                          uint32_t (*hash)(const Package* pkg)) {
+    if ((index->count + 1) * 2 > index->capacity) {
+        int capacity = index->capacity ? index->capacity * 2 : 64;
+        int* slots = arena_alloc(workspace_arena(workspace), (size_t)capacity * sizeof(int));
+        if (!slots) return;
+        for (int i = 0; i < index->capacity; i++) {
+            int entry = index->slots[i];
+            if (!entry) continue;
+            uint32_t slot = hash(&workspace->packages[entry - 1]) & (uint32_t)(capacity - 1);
+            while (slots[slot]) slot = (slot + 1) & (uint32_t)(capacity - 1);
+            slots[slot] = entry;
+        }
+        index->slots = slots;
+        index->capacity = capacity;
+    }
+
+    uint32_t mask = (uint32_t)(index->capacity - 1);
+    uint32_t slot = hash(&workspace->packages[package]) & mask;
+    while (index->slots[slot]) slot = (slot + 1) & mask;
+    index->slots[slot] = package + 1;
+    index->count++;
+}
+
+// Index of the package whose directory is path, or -1
+static int find_package_by_path(const WorkspaceInfo* workspace, const char* path) {
+    const PackageIndex* index = &workspace->path_index;
+    if (index->capacity == 0) return -1;
+    uint32_t mask = (uint32_t)(index->capacity - 1);
+    for (uint32_t slot = hash_path(path) & mask; index->slots[slot]; slot = (slot + 1) & mask) {
+        int package = index->slots[slot] - 1;
+        if (same_path(string_pool_get(workspace->packages[package].path), path)) return package;
+    }
+    return -1;
+}
+
+// Index of the first package named name, or -1. Valid once
+// index_package_names has run.
+static int find_package_by_name(const WorkspaceInfo* workspace, StringId name) {
+    const PackageIndex* index = &workspace->name_index;
+    if (index->capacity == 0 || name == STRING_ID_EMPTY) return -1;
+    uint32_t mask = (uint32_t)(index->capacity - 1);
+    for (uint32_t slot = (name * 2654435761u) & mask; index->slots[slot]; slot = (slot + 1) & mask) {
+        int package = index->slots[slot] - 1;
+        if (workspace->packages[package].name == name) return package;
+    }
+    return -1;
+}
+
+static void index_package_names(WorkspaceInfo* workspace) {
+    for (int i = 0; i < workspace->package_count; i++) {
+        StringId name = workspace->packages[i].name;
+        if (name != STRING_ID_EMPTY && find_package_by_name(workspace, name) < 0) {
+            index_package(workspace, &workspace->name_index, i, hash_package_name);
+        }
+    }
+}
+
+static uint32_t hash_dependency_name(StringId name) {
+    return name * 2654435761u;
+}
+
+// Records which packages use each dependency, in one pass over the packages.
+// The table is sized from the dependency counts up front so it never grows.
+static void index_package_dependencies(WorkspaceInfo* workspace) {
+    DependencyIndex* index = &workspace->dependency_index;
+    long long total = 0;
+    for (int i = 0; i < workspace->package_count; i++) {
+        total += workspace->packages[i].dependency_count;
+    }
+    if (total == 0) return;
+
+    int capacity = 64;
+    while ((long long)capacity < total * 2) capacity *= 2;
+    Arena* arena = workspace_arena(workspace);
+    DependencyUsage* entries = arena_alloc(arena, (size_t)capacity * sizeof(DependencyUsage));
+    if (!entries) return;
+    index->entries = entries;
+    index->capacity = capacity;
+    index->count = 0;
+    index->package_words = (workspace->package_count + 63) / 64;
+
+    uint32_t mask = (uint32_t)(capacity - 1);
+    for (int i = 0; i < workspace->package_count; i++) {
+        const Package* pkg = &workspace->packages[i];
+        for (int j = 0; j < pkg->dependency_count; j++) {
+            const Dependency* dep = &pkg->dependencies[j];
+            if (dep->name == STRING_ID_EMPTY) continue;
+
+            uint32_t slot = hash_dependency_name(dep->name) & mask;
+            while (entries[slot].name != STRING_ID_EMPTY && entries[slot].name != dep->name) {
+                slot = (slot + 1) & mask;
+            }
+            DependencyUsage* usage = &entries[slot];
+            if (usage->name == STRING_ID_EMPTY) {
+                usage->packages = arena_alloc(arena, (size_t)index->package_words * sizeof(uint64_t));
+                if (!usage->packages) continue;
+                usage->name = dep->name;
+                usage->version = dep->version;
+                usage->package_limit = workspace->package_count;
+                index->count++;
+            }
+
+            // Listed in both dependencies and devDependencies counts once
+            uint64_t bit = (uint64_t)1 << (i % 64);
+            if (usage->packages[i / 64] & bit) continue;
+            usage->packages[i / 64] |= bit;
+            usage->package_count++;
+            if (dep->version != usage->version && dep->version != STRING_ID_EMPTY) {
+                if (usage->version == STRING_ID_EMPTY) {
+                    usage->version = dep->version;
+                } else {
+                    usage->has_version_skew = 1;
+                }
+            }
+        }
+    }
+}
+
+EXPORT const DependencyUsage* find_dependency_usage(const WorkspaceInfo* workspace, StringId name) {
+    const DependencyIndex* index = &workspace->dependency_index;
+    if (index->capacity == 0 || name == STRING_ID_EMPTY) return NULL;
+    uint32_t mask = (uint32_t)(index->capacity - 1);
+    for (uint32_t slot = hash_dependency_name(name) & mask; index->entries[slot].name != STRING_ID_EMPTY;
+         slot = (slot + 1) & mask) {
+        if (index->entries[slot].name == name) return &index->entries[slot];
+    }
+    return NULL;
+}
+
+EXPORT int dependency_used_by(const DependencyUsage* usage, int package_index) {
+    if (!usage || package_index < 0 || package_index >= usage->package_limit) return 0;
+    return (usage->packages[package_index / 64] >> (package_index % 64)) & 1;
 }
 
 static void parse_workspace_globs(const char* content, ProjectType* project) {
@@ -66,23 +389,19 @@ static void parse_workspace_globs(const char* content, ProjectType* project) {
     if (!ptr) return;
     ptr++;
 
-    while (*ptr && project->workspace.workspace_count < MAX_WORKSPACES) {
+    while (*ptr) {
         // Skip whitespace
         while (*ptr && isspace(*ptr)) ptr++;
 
         if (*ptr == '"') {
             ptr++; // Skip opening quote
-            char* glob = project->workspace.workspace_globs[project->workspace.workspace_count];
-            int i = 0;
+            const char* glob = ptr;
 
-            // Copy until closing quote or max length
-            while (*ptr && *ptr != '"' && i < 99) {
-                glob[i++] = *ptr++;
-            }
-            glob[i] = '\0';
+            // Copy until closing quote
+            while (*ptr && *ptr != '"') ptr++;
 
             if (*ptr == '"') {
-                project->workspace.workspace_count++;
+                add_workspace_glob(&project->workspace, glob, (size_t)(ptr - glob));
                 ptr++; // Skip closing quote
             }
         }
@@ -94,22 +413,19 @@ static void parse_workspace_globs(const char* content, ProjectType* project) {
     }
 }
 
-static void parse_json_array(const char* json, char globs[][100], int* count, int max_count) {
+static void parse_json_array(const char* json, WorkspaceInfo* workspace) {
     const char* ptr = strchr(json, '[');
     if (!ptr) return;
 
     ptr++;
-    while (*ptr && *count < max_count) {
+    while (*ptr) {
         while (*ptr && isspace(*ptr)) ptr++;
         if (*ptr != '"') break;
 
         ptr++;
-        int i = 0;
-        while (*ptr && *ptr != '"' && i < 99) {
-            globs[*count][i++] = *ptr++;
-        }
-        globs[*count][i] = '\0';
-        (*count)++;
+        const char* glob = ptr;
+        while (*ptr && *ptr != '"') ptr++;
+        add_workspace_glob(workspace, glob, (size_t)(ptr - glob));
 
         while (*ptr && *ptr != ',' && *ptr != ']') ptr++;
         if (*ptr == ',') ptr++;
@@ -156,8 +472,8 @@ static void extract_import_path(const char* ptr, char* module_name, size_t size)
     module_name[i] = '\0';
 }
 
-static char* parse_version(const char* content, const char* package_name) {
-    static char version[20];
+// Writes into the caller's buffer so concurrent analyses don't share state
+static char* parse_version(const char* content, const char* package_name, char* version, size_t size) {
     version[0] = '\0';
 
     char search_pattern[256];
@@ -167,7 +483,7 @@ static char* parse_version(const char* content, const char* package_name) {
     if (ptr) {
         ptr += strlen(search_pattern);
         int i = 0;
-        while (*ptr && *ptr != '"' && i < sizeof(version) - 1) {
+        while (*ptr && *ptr != '"' && i < size - 1) {
             version[i++] = *ptr++;
         }
         version[i] = '\0';
@@ -176,35 +492,6 @@ static char* parse_version(const char* content, const char* package_name) {
     return version;
 }
 
-static void update_shared_dependency_count(const char* name, ProjectType* project) {
-    int count = 0;
-    for (int i = 0; i < project->workspace.package_count; i++) {
-        Package* pkg = &project->workspace.packages[i];
-        for (int j = 0; j < pkg->dependencies.count; j++) {
-            if (strcmp(pkg->dependencies.items[j].name, name) == 0) {
-                count++;
-                break;
-            }
-        }
-    }
-
-    // If dependency is used in multiple packages, add to shared dependencies
-    if (count > 1) {
-        for (int i = 0; i < project->workspace.shared_dependencies.count; i++) {
-            if (strcmp(project->workspace.shared_dependencies.items[i].name, name) == 0) {
-                return;
-            }
-        }
-
-        if (project->workspace.shared_dependencies.count < MAX_DEPENDENCIES) {
-            Dependency* dep = &project->workspace.shared_dependencies.items[
-                    project->workspace.shared_dependencies.count++];
-            strncpy(dep->name, name, sizeof(dep->name) - 1);
-            // Version will be added when processing package.json
-        }
-    }
-}
-
 static void analyze_workspace_package_json(const char* content, ProjectType* project) {
     // Check for Yarn workspaces
     if (strstr(content, "\"workspaces\"")) {
@@ -220,7 +507,8 @@ static void analyze_workspace_package_json(const char* content, ProjectType* pro
 
 // Helper function for sorting dependencies
 static int compare_dependencies(const void* a, const void* b) {
-    return strcmp(((const Dependency*)a)->name, ((const Dependency*)b)->name);
+    return strcmp(string_pool_get(((const Dependency*)a)->name),
+                  string_pool_get(((const Dependency*)b)->name));
 }
 
 static void parse_global_deps(const char* deps_json, ProjectType* project) {
@@ -275,8 +563,9 @@ static void parse_global_deps(const char* deps_json, ProjectType* project) {
                         if (strlen(dep_name) > 0) {
                             // Add to shared dependencies if not already present
                             int found = 0;
+                            StringId dep_id = string_pool_intern(dep_name);
                             for (i = 0; i < project->workspace.shared_dependencies.count; i++) {
-                                if (strcmp(project->workspace.shared_dependencies.items[i].name, dep_name) == 0) {
+                                if (project->workspace.shared_dependencies.items[i].name == dep_id) {
                                     found = 1;
                                     break;
                                 }
@@ -286,8 +575,8 @@ static void parse_global_deps(const char* deps_json, ProjectType* project) {
                                 Dependency* dep = &project->workspace.shared_dependencies.items[
                                     project->workspace.shared_dependencies.count++];
 
-                                strncpy(dep->name, dep_name, sizeof(dep->name) - 1);
-                                strncpy(dep->version, dep_value, sizeof(dep->version) - 1);
+                                dep->name = dep_id;
+                                dep->version = string_pool_intern(dep_value);
                                 dep->is_dev_dependency = 0; // Global deps are typically not dev deps
                             }
 
@@ -325,13 +614,13 @@ static void parse_global_deps(const char* deps_json, ProjectType* project) {
                                     fseek(f, 0, SEEK_SET);
 
                                     if (fsize > 0 && fsize < 1024 * 1024) { // 1MB limit
-                                        char* content = (char*)malloc(fsize + 1);
+                                        char* content = (char*)mem_alloc(PROFILE_PHASE_WORKSPACE, (size_t)fsize + 1);
                                         if (content) {
                                             if (fread(content, 1, fsize, f) == fsize) {
                                                 content[fsize] = '\0';
                                                 analyze_workspace_package_json(content, project);
                                             }
-                                            free(content);
+                                            mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)fsize + 1);
                                         }
                                     }
                                     fclose(f);
@@ -388,7 +677,7 @@ static void parse_lerna_config(const char* root_path, ProjectType* project) {
     long fsize = ftell(f);
     fseek(f, 0, SEEK_SET);
 
-    char* content = malloc(fsize + 1);
+    char* content = (char*)mem_alloc(PROFILE_PHASE_WORKSPACE, (size_t)fsize + 1);
     if (!content) {
         fclose(f);
         return;
@@ -407,8 +696,7 @@ static void parse_lerna_config(const char* root_path, ProjectType* project) {
         // Parse package locations
         const char* packages = strstr(content, "\"packages\"");
         if (packages) {
-            parse_json_array(packages, project->workspace.workspace_globs,
-                             &project->workspace.workspace_count, MAX_WORKSPACES);
+            parse_json_array(packages, &project->workspace);
         }
 
         // Parse npm client preference
@@ -424,7 +712,7 @@ static void parse_lerna_config(const char* root_path, ProjectType* project) {
         }
     }
 
-    free(content);
+    mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)fsize + 1);
     fclose(f);
 }
 
@@ -440,15 +728,17 @@ static void parse_pnpm_workspace(const char* root_path, ProjectType* project) {
         // Parse package patterns
         if (strstr(line, "packages:")) {
             while (fgets(line, sizeof(line), f) && strstr(line, "- ")) {
-                char* pattern = line + 2;
-                // Trim whitespace and newlines
+                char* pattern = strstr(line, "- ") + 2;
+                while (isspace(*pattern)) pattern++;
+                // Trim whitespace and newlines, then any quotes
                 char* end = pattern + strlen(pattern) - 1;
                 while (end > pattern && isspace(*end)) *end-- = '\0';
-
-                if (project->workspace.workspace_count < MAX_WORKSPACES) {
-                    strncpy(project->workspace.workspace_globs[project->workspace.workspace_count++],
-                            pattern, 99);
+                if ((*pattern == '\'' || *pattern == '"') && end > pattern && *end == *pattern) {
+                    *end = '\0';
+                    pattern++;
                 }
+
+                add_workspace_glob(&project->workspace, pattern, strlen(pattern));
             }
         }
     }
@@ -470,7 +760,7 @@ static void analyze_turbo_config(const char* root_path, ProjectType* project) {
     long fsize = ftell(f);
     fseek(f, 0, SEEK_SET);
 
-    char* content = malloc(fsize + 1);
+    char* content = (char*)mem_alloc(PROFILE_PHASE_WORKSPACE, (size_t)fsize + 1);
     if (!content) {
         fclose(f);
         return;
@@ -492,122 +782,130 @@ static void analyze_turbo_config(const char* root_path, ProjectType* project) {
         }
     }
 
-    free(content);
+    mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)fsize + 1);
     fclose(f);
 }
 
 static void analyze_package_interdependencies(ProjectType* project) {
-    for (int i = 0; i < project->workspace.package_count; i++) {
-        Package* pkg = &project->workspace.packages[i];
-
-        // Check each dependency to see if it's another workspace package
-        for (int j = 0; j < pkg->dependencies.count; j++) {
-            Dependency* dep = &pkg->dependencies.items[j];
-
-            // Look for internal dependencies
-            for (int k = 0; k < project->workspace.package_count; k++) {
-                if (strcmp(dep->name, project->workspace.packages[k].name) == 0) {
-                    // Add package reference
-                    PackageReference* ref = &pkg->config.refs[pkg->config.ref_count++];
-                    strncpy(ref->source, pkg->name, sizeof(ref->source) - 1);
-                    strncpy(ref->target, dep->name, sizeof(ref->target) - 1);
-                    break;
-                }
+    WorkspaceInfo* workspace = &project->workspace;
+    for (int i = 0; i < workspace->package_count; i++) {
+        Package* pkg = &workspace->packages[i];
+
+        // Count the dependencies that are other workspace packages, then
+        // record them in an array of that size
+        int internal = 0;
+        for (int j = 0; j < pkg->dependency_count; j++) {
+            if (find_package_by_name(workspace, pkg->dependencies[j].name) >= 0) internal++;
+        }
+        if (internal == 0) continue;
+
+        PackageReference* refs = arena_alloc(workspace_arena(workspace), (size_t)internal * sizeof(PackageReference));
+        if (!refs) continue;
+        pkg->config.refs = refs;
+        pkg->config.ref_count = 0;
+        for (int j = 0; j < pkg->dependency_count; j++) {
+            const Dependency* dep = &pkg->dependencies[j];
+            if (find_package_by_name(workspace, dep->name) >= 0) {
+                PackageReference* ref = &refs[pkg->config.ref_count++];
+                ref->source = pkg->name;
+                ref->target = dep->name;
             }
         }
     }
 }
 
+// Appends the packages at the given graph nodes to a pooled-name list in the
+// workspace arena
+static StringId* package_names(WorkspaceInfo* workspace, const int* nodes, int count) {
+    if (count <= 0) return NULL;
+    StringId* names = arena_alloc(workspace_arena(workspace), (size_t)count * sizeof(StringId));
+    if (!names) return NULL;
+    for (int i = 0; i < count; i++) {
+        names[i] = workspace->packages[nodes[i]].name;
+    }
+    return names;
+}
+
+static void report_build_cycle(ProjectType* project, const StringId* names, int count) {
+    if (project->potential_issue_count >= MAX_POTENTIAL_ISSUES) return;
+    PotentialIssue* issue = &project->potential_issues[project->potential_issue_count++];
+
+    size_t length = (size_t)snprintf(issue->description, sizeof(issue->description),
+                                     "Circular dependency between workspace packages:");
+    for (int i = 0; i <= count && length < sizeof(issue->description); i++) {
+        const char* name = string_pool_get(names[i % count]);
+        length += (size_t)snprintf(issue->description + length, sizeof(issue->description) - length,
+                                   "%s%s", i ? " -> " : " ", name);
+    }
+    snprintf(issue->location, sizeof(issue->location), "%s", project->workspace.root_path);
+}
+
+// Orders the packages by their internal references: each build level holds
+// the packages whose references are all built in earlier levels, so a level
+// builds in parallel. Packages caught in a reference cycle are reported and
+// left out of the levels.
 static void detect_build_order(ProjectType* project) {
-    // Create task groups based on dependencies
-    char (*build_order)[MAX_PACKAGES][100] = NULL;
-    build_order = malloc(sizeof(*build_order));
-    if (!build_order) {
-        fprintf(stderr, "Failed to allocate memory for build order\n");
+    WorkspaceInfo* workspace = &project->workspace;
+    BuildGraphInfo* info = &workspace->build_graph;
+    memset(info, 0, sizeof(BuildGraphInfo));
+
+    BuildGraph* graph = build_graph_create(workspace->package_count, PROFILE_PHASE_WORKSPACE);
+    if (!graph) {
+        fprintf(stderr, "Memory allocation failed for build order\n");
         return;
     }
-    memset(build_order, 0, sizeof(*build_order));
-    int order_count = 0;
-
-    // Initialize build order with independent packages
-    for (int i = 0; i < project->workspace.package_count; i++) {
-        Package* pkg = &project->workspace.packages[i];
-        if (pkg->config.ref_count == 0 && order_count < MAX_PACKAGES) {
-            strncpy(&(*build_order)[0][order_count * 100], pkg->name, 99);
-            (*build_order)[0][order_count * 100 + 99] = '\0';
-            order_count++;
-        }
-    }
-
-    // Add dependent packages in correct order
-    int level = 1;
-    while (order_count < project->workspace.package_count && level < MAX_PACKAGES) {
-        for (int i = 0; i < project->workspace.package_count; i++) {
-            Package* pkg = &project->workspace.packages[i];
-
-            // Check if package is already in build order
-            int already_added = 0;
-            for (int k = 0; k < level; k++) {
-                for (int l = 0; l < MAX_PACKAGES; l++) {
-                    const char* current_pkg = &(*build_order)[k][l * 100];
-                    if (current_pkg[0] && strcmp(pkg->name, current_pkg) == 0) {
-                        already_added = 1;
-                        break;
-                    }
-                }
-                if (already_added) break;
-            }
-            if (already_added) continue;
-
-            // Check if all dependencies are in previous levels
-            int can_build = 1;
-            for (int j = 0; j < pkg->config.ref_count; j++) {
-                int dep_found = 0;
-                for (int k = 0; k < level; k++) {
-                    for (int l = 0; l < MAX_PACKAGES; l++) {
-                        const char* current_pkg = &(*build_order)[k][l * 100];
-                        if (current_pkg[0] && strcmp(pkg->config.refs[j].target, current_pkg) == 0) {
-                            dep_found = 1;
-                            break;
-                        }
-                    }
-                    if (dep_found) break;
-                }
-                if (!dep_found) {
-                    can_build = 0;
-                    break;
-                }
-            }
-
-            if (can_build && (order_count % MAX_PACKAGES) < MAX_PACKAGES) {
-                strncpy(&(*build_order)[level][(order_count % MAX_PACKAGES) * 100],
-                        pkg->name, 99);
-                (*build_order)[level][(order_count % MAX_PACKAGES) * 100 + 99] = '\0';
-                order_count++;
-            }
+    for (int i = 0; i < workspace->package_count; i++) {
+        const Package* pkg = &workspace->packages[i];
+        build_graph_set_weight(graph, i, pkg->summary.bytes);
+        for (int j = 0; j < pkg->config.ref_count; j++) {
+            int k = find_package_by_name(workspace, pkg->config.refs[j].target);
+            if (k >= 0) build_graph_add_edge(graph, i, k);
         }
-        level++;
+    }
+
+    BuildSchedule schedule;
+    if (!build_graph_schedule(graph, &schedule)) {
+        fprintf(stderr, "Memory allocation failed for build order\n");
+        build_graph_destroy(graph);
+        return;
     }
 
     // Create task groups from build order
-    for (int i = 0; i < level && i < MAX_PACKAGES; i++) {
-        if (project->workspace.task_group_count >= sizeof(project->workspace.task_groups) / sizeof(TaskGroup)) {
-            break;
+    for (int l = 0; l < schedule.level_count; l++) {
+        char name[100];
+        snprintf(name, sizeof(name), "build-level-%d", l + 1);
+        TaskGroup* group = add_task_group(workspace, name, "build");
+        if (!group) break;
+
+        for (int i = schedule.level_start[l]; i < schedule.level_start[l + 1]; i++) {
+            add_task_group_member(workspace, group, workspace->packages[schedule.order[i]].name);
         }
+    }
 
-        TaskGroup* group = &project->workspace.task_groups[project->workspace.task_group_count++];
-        snprintf(group->name, sizeof(group->name), "build-level-%d", i + 1);
-        strncpy(group->type, "build", sizeof(group->type) - 1);
-        group->type[sizeof(group->type) - 1] = '\0';
+    info->level_count = schedule.level_count;
+    info->max_parallelism = schedule.max_parallelism;
+    info->blocked_count = workspace->package_count - schedule.scheduled_count;
+    info->critical_path_bytes = schedule.critical_path_weight;
+    info->critical_path = package_names(workspace, schedule.critical_path, schedule.critical_path_length);
+    if (info->critical_path) info->critical_path_length = schedule.critical_path_length;
 
-        for (int j = 0; j < MAX_PACKAGES; j++) {
-            const char* current_pkg = &(*build_order)[i][j * 100];
-            if (!current_pkg[0] || group->package_count >= MAX_PACKAGES) break;
-            strncpy(group->packages[group->package_count++], current_pkg, 99);
-        }
+    int cycle_total = schedule.cycle_start[schedule.cycle_count];
+    if (schedule.cycle_count > 0) {
+        info->cycle_packages = package_names(workspace, schedule.cycle_nodes, cycle_total);
+        info->cycle_start = arena_copy(workspace_arena(workspace), schedule.cycle_start,
+                                       (size_t)(schedule.cycle_count + 1) * sizeof(int));
+        if (info->cycle_packages && info->cycle_start) info->cycle_count = schedule.cycle_count;
+    }
+    for (int c = 0; c < info->cycle_count; c++) {
+        int start = info->cycle_start[c];
+        report_build_cycle(project, info->cycle_packages + start, info->cycle_start[c + 1] - start);
+    }
+    if (info->blocked_count > 0) {
+        LOG_WARN(LOG_CAT_CORE, "%d workspace packages are on or behind %d reference cycles",
+                 info->blocked_count, info->cycle_count);
     }
 
-    free(build_order);
+    build_graph_destroy(graph);
 }
 
 static void clean_version_string(char* version) {
@@ -1005,28 +1303,18 @@ static void parse_turbo_pipeline(const char* pipeline_json, ProjectType* project
                     deps = strchr(deps, '[');
                     if (deps) {
                         // Create a new task group
-                        if (project->workspace.task_group_count < 20) {
-                            TaskGroup* group = &project->workspace.task_groups[
-                                    project->workspace.task_group_count++];
-                            strncpy(group->name, task_name, sizeof(group->name) - 1);
-                            strncpy(group->type, "build", sizeof(group->type) - 1);
-
+                        TaskGroup* group = add_task_group(&project->workspace, task_name, "build");
+                        if (group) {
                             // Parse dependencies
                             deps++; // Skip the opening bracket
                             while (*deps && *deps != ']') {
                                 if (*deps == '"') {
                                     deps++; // Skip opening quote
-                                    char dep_name[100] = {0};
-                                    i = 0;
-
-                                    while (*deps && *deps != '"' && i < 99) {
-                                        dep_name[i++] = *deps++;
-                                    }
-
-                                    if (group->package_count < MAX_PACKAGES) {
-                                        strncpy(group->packages[group->package_count++],
-                                                dep_name, 99);
-                                    }
+                                    const char* dep_name = deps;
+                                    while (*deps && *deps != '"') deps++;
+                                    add_task_group_member(&project->workspace, group,
+                                                          string_pool_intern_n(dep_name, (size_t)(deps - dep_name)));
+                                    if (!*deps) break;
                                 }
                                 deps++;
                             }
@@ -1044,7 +1332,16 @@ static void parse_turbo_pipeline(const char* pipeline_json, ProjectType* project
     }
 }
 
-static void parse_package_info(const char* content, Package* pkg) {
+// Interns the characters from start up to the next quote
+static StringId intern_quoted(const char* start, const char** end) {
+    const char* ptr = start;
+    while (*ptr && *ptr != '"') ptr++;
+    if (end) *end = ptr;
+    return string_pool_intern_n(start, (size_t)(ptr - start));
+}
+
+// Arrays parsed here go into the workspace arena
+static void parse_package_info(const char* content, Package* pkg, Arena* arena) {
     if (!content || !pkg) return;
 
     // Parse package name
@@ -1054,12 +1351,7 @@ static void parse_package_info(const char* content, Package* pkg) {
         if (name_start) {
             name_start = strchr(name_start, '"');
             if (name_start) {
-                name_start++; // Skip the quote
-                int i = 0;
-                while (*name_start && *name_start != '"' && i < sizeof(pkg->name) - 1) {
-                    pkg->name[i++] = *name_start++;
-                }
-                pkg->name[i] = '\0';
+                pkg->name = intern_quoted(name_start + 1, NULL);
             }
         }
     }
@@ -1071,12 +1363,7 @@ static void parse_package_info(const char* content, Package* pkg) {
         if (version_start) {
             version_start = strchr(version_start, '"');
             if (version_start) {
-                version_start++; // Skip the quote
-                int i = 0;
-                while (*version_start && *version_start != '"' && i < sizeof(pkg->version) - 1) {
-                    pkg->version[i++] = *version_start++;
-                }
-                pkg->version[i] = '\0';
+                pkg->version = intern_quoted(version_start + 1, NULL);
             }
         }
     }
@@ -1089,13 +1376,7 @@ static void parse_package_info(const char* content, Package* pkg) {
             if (build_start) {
                 build_start = strchr(build_start, '"');
                 if (build_start) {
-                    build_start++; // Skip the quote
-                    int i = 0;
-                    while (*build_start && *build_start != '"' &&
-                           i < sizeof(pkg->config.build_output_path) - 1) {
-                        pkg->config.build_output_path[i++] = *build_start++;
-                    }
-                    pkg->config.build_output_path[i] = '\0';
+                    pkg->config.build_output_path = intern_quoted(build_start + 1, NULL);
                 }
             }
         }
@@ -1116,36 +1397,34 @@ static void parse_package_info(const char* content, Package* pkg) {
     if (scripts) {
         scripts = strchr(scripts, '{');
         if (scripts) {
+            int capacity = 0;
             scripts++; // Skip the opening brace
-            while (*scripts && *scripts != '}' &&
-                   pkg->config.script_count < sizeof(pkg->config.scripts)/sizeof(PackageScript)) {
+            while (*scripts && *scripts != '}') {
 
                 if (*scripts == '"') {
-                    scripts++; // Skip the quote
-                    PackageScript* script = &pkg->config.scripts[pkg->config.script_count];
-
                     // Parse script name
-                    int i = 0;
-                    while (*scripts && *scripts != '"' && i < sizeof(script->script_name) - 1) {
-                        script->script_name[i++] = *scripts++;
-                    }
-                    script->script_name[i] = '\0';
+                    StringId script_name = intern_quoted(scripts + 1, &scripts);
 
                     // Skip to command
                     scripts = strchr(scripts, ':');
                     if (!scripts) break;
                     scripts = strchr(scripts, '"');
                     if (!scripts) break;
-                    scripts++; // Skip the quote
 
                     // Parse command
-                    i = 0;
-                    while (*scripts && *scripts != '"' && i < sizeof(script->command) - 1) {
-                        script->command[i++] = *scripts++;
+                    StringId command = intern_quoted(scripts + 1, &scripts);
+
+                    if (pkg->config.script_count == capacity) {
+                        capacity = capacity ? capacity * 2 : 8;
+                        PackageScript* grown = grow_table(arena, pkg->config.scripts, pkg->config.script_count,
+                                                          capacity, sizeof(PackageScript));
+                        if (!grown) break;
+                        pkg->config.scripts = grown;
                     }
-                    script->command[i] = '\0';
-
-                    pkg->config.script_count++;
+                    PackageScript* script = &pkg->config.scripts[pkg->config.script_count++];
+                    script->script_name = script_name;
+                    script->command = command;
+                    if (!*scripts) break;
                 }
                 scripts++;
             }
@@ -1155,7 +1434,7 @@ static void parse_package_info(const char* content, Package* pkg) {
 
 static void parse_dependencies_section(const char* content, const char* section_name, DependencyList* deps, int is_dev) {
     if (!content || !section_name || !deps) {
-        TRACE("Null pointer passed to parse_dependencies_section");
+        LOG_WARN(LOG_CAT_DEPS, "Null pointer passed to parse_dependencies_section");
         return;
     }
 
@@ -1163,14 +1442,14 @@ static void parse_dependencies_section(const char* content, const char* section_
     char section_key[256];
     int key_len = snprintf(section_key, sizeof(section_key), "\"%s\"", section_name);
     if (key_len < 0 || key_len >= sizeof(section_key)) {
-        TRACE("Section key too long: %s", section_name);
+        LOG_WARN(LOG_CAT_DEPS, "Section key too long: %s", section_name);
         return;
     }
 
     // Find the section
     const char* section = strstr(content, section_key);
     if (!section) {
-        TRACE("Section not found: %s", section_name);
+        LOG_TRACE(LOG_CAT_DEPS, "Section not found: %s", section_name);
         return;
     }
 
@@ -1178,7 +1457,7 @@ static void parse_dependencies_section(const char* content, const char* section_
     const char* content_end = content + strlen(content);
     section = strchr(section, '{');
     if (!section || section >= content_end) {
-        TRACE("Opening brace not found for section: %s", section_name);
+        LOG_DEBUG(LOG_CAT_DEPS, "Opening brace not found for section: %s", section_name);
         return;
     }
 
@@ -1228,24 +1507,22 @@ static void parse_dependencies_section(const char* content, const char* section_
 
                         // Validate dependency name and version
                         if (strlen(name) > 0 && strlen(version) > 0) {
-                            // Cache the dependency before adding to the list
-                            cache_dependency(name, version);
+                            StringId name_id = string_pool_intern(name);
+                            StringId version_id = string_pool_intern(version);
 
                             // Add to dependency list
                             if (deps->count < MAX_DEPENDENCIES) {
                                 Dependency* dep = &deps->items[deps->count];
-                                strncpy(dep->name, name, sizeof(dep->name) - 1);
-                                dep->name[sizeof(dep->name) - 1] = '\0';
-                                strncpy(dep->version, version, sizeof(dep->version) - 1);
-                                dep->version[sizeof(dep->version) - 1] = '\0';
+                                dep->name = name_id;
+                                dep->version = version_id;
                                 dep->is_dev_dependency = is_dev;
                                 deps->count++;
 
-                                TRACE("Added dependency: %s@%s (%s)",
-                                      dep->name, dep->version,
-                                      is_dev ? "dev" : "prod");
+                                LOG_TRACE(LOG_CAT_DEPS, "Added dependency: %s@%s (%s)",
+                                          name, version,
+                                          is_dev ? "dev" : "prod");
                             } else {
-                                TRACE("Max dependencies reached (%d)", MAX_DEPENDENCIES);
+                                LOG_WARN(LOG_CAT_DEPS, "Max dependencies reached (%d)", MAX_DEPENDENCIES);
                                 return;
                             }
                         }
@@ -1290,25 +1567,27 @@ static char* get_json_string_value(const char* content, const char* key, char* b
     return (*value_start == '"') ? buffer : NULL;
 }
 
-static void analyze_package_dependencies(const char* content, Package* pkg) {
+static void analyze_package_dependencies(const char* content, Package* pkg, Arena* arena) {
     if (!content || !pkg) return;
 
-    // Parse regular dependencies
-    parse_dependencies_section(content, "dependencies", &pkg->dependencies, 0);
-
-    // Parse dev dependencies
-    DependencyList dev_deps = {0};
-    parse_dependencies_section(content, "devDependencies", &dev_deps, 1);
-
-    // Merge dev dependencies into main dependencies list
-    for (int i = 0; i < dev_deps.count && pkg->dependencies.count < MAX_DEPENDENCIES; i++) {
-        pkg->dependencies.items[pkg->dependencies.count] = dev_deps.items[i];
-        pkg->dependencies.count++;
+    // Parse regular then dev dependencies into a scratch list, and keep an
+    // array of just the entries found
+    DependencyList* deps = mem_calloc(PROFILE_PHASE_WORKSPACE, 1, sizeof(DependencyList));
+    if (!deps) {
+        fprintf(stderr, "Memory allocation failed for package dependencies\n");
+        return;
     }
+    parse_dependencies_section(content, "dependencies", deps, 0);
+    parse_dependencies_section(content, "devDependencies", deps, 1);
+    if (deps->count > 0) {
+        pkg->dependencies = arena_copy(arena, deps->items, (size_t)deps->count * sizeof(Dependency));
+        pkg->dependency_count = pkg->dependencies ? deps->count : 0;
+    }
+    mem_free(PROFILE_PHASE_WORKSPACE, deps, sizeof(DependencyList));
 
     // Analyze for framework dependencies
-    for (int i = 0; i < pkg->dependencies.count; i++) {
-        const char* dep_name = pkg->dependencies.items[i].name;
+    for (int i = 0; i < pkg->dependency_count; i++) {
+        const char* dep_name = string_pool_get(pkg->dependencies[i].name);
 
         // React detection
         if (strcmp(dep_name, "react") == 0 ||
@@ -1344,8 +1623,8 @@ static void analyze_package_dependencies(const char* content, Package* pkg) {
     const char* test_frameworks[] = {"jest", "mocha", "jasmine", "karma"};
     const char* build_tools[] = {"webpack", "rollup", "parcel", "esbuild"};
 
-    for (int i = 0; i < pkg->dependencies.count; i++) {
-        const char* dep_name = pkg->dependencies.items[i].name;
+    for (int i = 0; i < pkg->dependency_count; i++) {
+        const char* dep_name = string_pool_get(pkg->dependencies[i].name);
 
         // Check for testing frameworks
         for (size_t j = 0; j < sizeof(test_frameworks)/sizeof(test_frameworks[0]); j++) {
@@ -1365,15 +1644,49 @@ static void analyze_package_dependencies(const char* content, Package* pkg) {
     }
 }
 
-static void analyze_package_workspace(const char* path, ProjectType* project) {
-    if (project->workspace.package_count >= MAX_PACKAGES) return;
+// Helper function to check file existence
+static int file_exists_in_root(const char* root_path, const char* filename) {
+    char full_path[MAX_PATH];
+    snprintf(full_path, sizeof(full_path), "%s/%s", root_path, filename);
 
-    Package* pkg = &project->workspace.packages[project->workspace.package_count];
-    strncpy(pkg->path, path, MAX_PATH - 1);
+    FILE* f = fopen(full_path, "r");
+    if (f) {
+        fclose(f);
+        return 1;
+    }
+    return 0;
+}
 
-    // Read package.json for this package
+// Records a package directory. Its manifest and sources are read later, by
+// analyze_workspace. Returns NULL for the workspace root, a directory already
+// recorded or without a package.json, or when out of memory.
+static Package* add_workspace_package(const char* path, ProjectType* project) {
+    WorkspaceInfo* workspace = &project->workspace;
+    if (same_path(path, workspace->root_path)) return NULL;
+    if (find_package_by_path(workspace, path) >= 0) return NULL;
+    if (!file_exists_in_root(path, "package.json")) return NULL;
+
+    Arena* arena = workspace_arena(workspace);
+    if (!arena) return NULL;
+    if (workspace->package_count == workspace->package_capacity) {
+        int capacity = workspace->package_capacity ? workspace->package_capacity * 2 : 16;
+        Package* packages = grow_table(arena, workspace->packages, workspace->package_count,
+                                       capacity, sizeof(Package));
+        if (!packages) return NULL;
+        workspace->packages = packages;
+        workspace->package_capacity = capacity;
+    }
+
+    int index = workspace->package_count++;
+    Package* pkg = &workspace->packages[index];
+    pkg->path = string_pool_intern(path);
+    index_package(workspace, &workspace->path_index, index, hash_package_path);
+    return pkg;
+}
+
+static void read_package_manifest(Package* pkg, Arena* arena) {
     char package_json_path[MAX_PATH];
-    snprintf(package_json_path, MAX_PATH, "%s/package.json", path);
+    snprintf(package_json_path, MAX_PATH, "%s/package.json", string_pool_get(pkg->path));
 
     FILE* f = fopen(package_json_path, "r");
     if (!f) return;
@@ -1384,20 +1697,18 @@ static void analyze_package_workspace(const char* path, ProjectType* project) {
     fseek(f, 0, SEEK_SET);
 
     if (fsize > 0 && fsize < 1024 * 1024) { // 1MB limit for package.json
-        char* content = malloc(fsize + 1);
+        char* content = (char*)mem_alloc(PROFILE_PHASE_WORKSPACE, (size_t)fsize + 1);
         if (content) {
             if (fread(content, 1, fsize, f) == fsize) {
                 content[fsize] = 0;
-                parse_package_info(content, pkg);
-                analyze_package_dependencies(content, pkg);
+                parse_package_info(content, pkg, arena);
+                analyze_package_dependencies(content, pkg, arena);
                 detect_framework_usage(content, &pkg->framework_info);
             }
-            free(content);
+            mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)fsize + 1);
         }
     }
     fclose(f);
-
-    project->workspace.package_count++;
 }
 
 static void scan_workspace_glob(const char* root_path, const char* glob_pattern, ProjectType* project) {
@@ -1415,7 +1726,10 @@ static void scan_workspace_glob(const char* root_path, const char* glob_pattern,
         strncpy(base_dir, glob_pattern, prefix_len);
         base_dir[prefix_len] = '\0';
     } else {
-        strncpy(base_dir, glob_pattern, sizeof(base_dir) - 1);
+        // A plain path names the package directory itself
+        snprintf(full_path, sizeof(full_path), "%s/%s", root_path, glob_pattern);
+        add_workspace_package(full_path, project);
+        return;
     }
 
     // Construct full path
@@ -1435,8 +1749,9 @@ static void scan_workspace_glob(const char* root_path, const char* glob_pattern,
 
         if (file.is_dir && strcmp(file.name, ".") != 0 && strcmp(file.name, "..") != 0) {
             // If there's a wildcard, check if this directory matches the pattern
+            // ("packages/**" is taken as "packages/*")
             int should_process = 1;
-            if (wildcard && *(wildcard + 1) != '\0') {
+            if (wildcard && *(wildcard + 1) != '\0' && strcmp(wildcard, "**") != 0) {
                 const char* pattern = wildcard + 1;
                 const char* name_end = file.name + strlen(file.name);
                 should_process = 0;
@@ -1451,28 +1766,8 @@ static void scan_workspace_glob(const char* root_path, const char* glob_pattern,
             }
 
             if (should_process) {
-                // Check for package.json
-                char package_path[MAX_PATH];
-                snprintf(package_path, sizeof(package_path), "%s/package.json", file.path);
-
-                FILE* f = fopen(package_path, "r");
-                if (f) {
-                    fseek(f, 0, SEEK_END);
-                    long fsize = ftell(f);
-                    fseek(f, 0, SEEK_SET);
-
-                    if (fsize > 0 && fsize < 1024 * 1024) { // 1MB limit
-                        char* content = (char*)malloc(fsize + 1);
-                        if (content) {
-                            if (fread(content, 1, fsize, f) == fsize) {
-                                content[fsize] = 0;
-                                analyze_package_workspace(file.path, project);
-                            }
-                            free(content);
-                        }
-                    }
-                    fclose(f);
-                }
+                // Only directories with a package.json are recorded
+                add_workspace_package(file.path, project);
             }
         }
 
@@ -1497,7 +1792,7 @@ static void parse_nx_workspace(const char* root_path, ProjectType* project) {
     fseek(f, 0, SEEK_SET);
 
     if (fsize > 0 && fsize < 1024 * 1024) { // 1MB limit
-        char* content = (char*)malloc(fsize + 1);
+        char* content = (char*)mem_alloc(PROFILE_PHASE_WORKSPACE, (size_t)fsize + 1);
         if (content) {
             if (fread(content, 1, fsize, f) == fsize) {
                 content[fsize] = 0;
@@ -1524,7 +1819,7 @@ static void parse_nx_workspace(const char* root_path, ProjectType* project) {
                                     // Found a valid project path
                                     snprintf(workspace_path, sizeof(workspace_path),
                                              "%s/%s", root_path, project_path);
-                                    analyze_package_workspace(workspace_path, project);
+                                    add_workspace_package(workspace_path, project);
                                 }
                             }
                             projects++;
@@ -1555,12 +1850,8 @@ static void parse_nx_workspace(const char* root_path, ProjectType* project) {
                                     target_name[i++] = *targets++;
                                 }
 
-                                if (*targets == '"' &&
-                                    project->workspace.task_group_count < sizeof(project->workspace.task_groups)/sizeof(TaskGroup)) {
-                                    // Create new task group
-                                    TaskGroup* group = &project->workspace.task_groups[project->workspace.task_group_count++];
-                                    strncpy(group->name, target_name, sizeof(group->name) - 1);
-                                    strncpy(group->type, "nx-target", sizeof(group->type) - 1);
+                                if (*targets == '"') {
+                                    add_task_group(&project->workspace, target_name, "nx-target");
                                 }
                             }
                             targets++;
@@ -1568,7 +1859,7 @@ static void parse_nx_workspace(const char* root_path, ProjectType* project) {
                     }
                 }
             }
-            free(content);
+            mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)fsize + 1);
         }
     }
     fclose(f);
@@ -1583,7 +1874,7 @@ static void parse_nx_workspace(const char* root_path, ProjectType* project) {
         fseek(f, 0, SEEK_SET);
 
         if (wsize > 0 && wsize < 1024 * 1024) {
-            char* content = (char*)malloc(wsize + 1);
+            char* content = (char*)mem_alloc(PROFILE_PHASE_WORKSPACE, (size_t)wsize + 1);
             if (content) {
                 if (fread(content, 1, wsize, f) == wsize) {
                     content[wsize] = 0;
@@ -1610,7 +1901,7 @@ static void parse_nx_workspace(const char* root_path, ProjectType* project) {
                         }
                     }
                 }
-                free(content);
+                mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)wsize + 1);
             }
         }
         fclose(f);
@@ -1636,7 +1927,7 @@ static void parse_rush_config(const char* root_path, ProjectType* project) {
         return;
     }
 
-    char* content = (char*)malloc(fsize + 1);
+    char* content = (char*)mem_alloc(PROFILE_PHASE_WORKSPACE, (size_t)fsize + 1);
     if (!content) {
         fclose(f);
         return;
@@ -1646,7 +1937,7 @@ static void parse_rush_config(const char* root_path, ProjectType* project) {
     fclose(f);
 
     if (read_size != fsize) {
-        free(content);
+        mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)fsize + 1);
         return;
     }
     content[fsize] = '\0';
@@ -1689,17 +1980,13 @@ static void parse_rush_config(const char* root_path, ProjectType* project) {
                                             folder[i++] = *projectFolder++;
                                         }
 
-                                        // Construct full path and analyze package
+                                        // Construct full path and record the package; its
+                                        // package.json name replaces this one if it has one
                                         char full_path[MAX_PATH];
                                         snprintf(full_path, sizeof(full_path), "%s/%s", root_path, folder);
-                                        analyze_package_workspace(full_path, project);
-
-                                        // Store in workspace projects if space available
-                                        if (project->workspace.package_count < MAX_PACKAGES) {
-                                            Package* pkg = &project->workspace.packages[project->workspace.package_count];
-                                            strncpy(pkg->name, name, sizeof(pkg->name) - 1);
-                                            strncpy(pkg->path, full_path, sizeof(pkg->path) - 1);
-                                            project->workspace.package_count++;
+                                        Package* pkg = add_workspace_package(full_path, project);
+                                        if (pkg) {
+                                            pkg->name = string_pool_intern(name);
                                         }
                                     }
                                 }
@@ -1793,20 +2080,7 @@ static void parse_rush_config(const char* root_path, ProjectType* project) {
         }
     }
 
-    free(content);
-}
-
-// Helper function to check file existence
-static int file_exists_in_root(const char* root_path, const char* filename) {
-    char full_path[MAX_PATH];
-    snprintf(full_path, sizeof(full_path), "%s/%s", root_path, filename);
-
-    FILE* f = fopen(full_path, "r");
-    if (f) {
-        fclose(f);
-        return 1;
-    }
-    return 0;
+    mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)fsize + 1);
 }
 
 static void parse_lerna_packages(const char* root_path, ProjectType* project) {
@@ -1828,7 +2102,7 @@ static void parse_lerna_packages(const char* root_path, ProjectType* project) {
         return;
     }
 
-    char* content = (char*)malloc(fsize + 1);
+    char* content = (char*)mem_alloc(PROFILE_PHASE_WORKSPACE, (size_t)fsize + 1);
     if (!content) {
         fclose(f);
         return;
@@ -1838,7 +2112,7 @@ static void parse_lerna_packages(const char* root_path, ProjectType* project) {
     fclose(f);
 
     if (read_size != fsize) {
-        free(content);
+        mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)fsize + 1);
         return;
     }
     content[fsize] = '\0';
@@ -1885,21 +2159,12 @@ static void parse_lerna_packages(const char* root_path, ProjectType* project) {
                 if (*packages == '"') {
                     packages++; // Skip opening quote
 
-                    if (project->workspace.workspace_count < MAX_WORKSPACES) {
-                        char* glob = project->workspace.workspace_globs[project->workspace.workspace_count];
-                        int i = 0;
-
-                        while (*packages && *packages != '"' && i < 99) {
-                            glob[i++] = *packages++;
-                        }
-                        glob[i] = '\0';
+                    const char* glob = packages;
+                    while (*packages && *packages != '"') packages++;
 
-                        // Process the glob pattern
-                        if (strlen(glob) > 0) {
-                            scan_workspace_glob(root_path, glob, project);
-                            project->workspace.workspace_count++;
-                        }
-                    }
+                    // Scanned with the other workspace globs
+                    add_workspace_glob(&project->workspace, glob, (size_t)(packages - glob));
+                    if (!*packages) break;
                 }
                 packages++;
             }
@@ -1965,10 +2230,7 @@ static void parse_lerna_packages(const char* root_path, ProjectType* project) {
         project->workspace.uses_changesets = 1;
     }
 
-    free(content);
-
-    // After parsing all packages, analyze interdependencies
-    analyze_package_interdependencies(project);
+    mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)fsize + 1);
 }
 
 // Helper functions for monorepo detection and analysis
@@ -2005,57 +2267,137 @@ static void detect_workspace_type(const char* root_path, ProjectType* project) {
         project->is_monorepo = 1;
         fclose(f);
     }
+
+    // Yarn and npm workspaces are declared in the root package.json
+    char package_path[MAX_PATH];
+    snprintf(package_path, MAX_PATH, "%s/package.json", root_path);
+    if ((f = fopen(package_path, "r"))) {
+        fseek(f, 0, SEEK_END);
+        long fsize = ftell(f);
+        fseek(f, 0, SEEK_SET);
+
+        if (fsize > 0 && fsize < 1024 * 1024) { // 1MB limit
+            char* content = (char*)mem_alloc(PROFILE_PHASE_WORKSPACE, (size_t)fsize + 1);
+            if (content) {
+                if (fread(content, 1, fsize, f) == fsize) {
+                    content[fsize] = '\0';
+                    if (strstr(content, "\"workspaces\"")) {
+                        analyze_workspace_package_json(content, project);
+                        if (file_exists_in_root(root_path, "package-lock.json")) {
+                            project->workspace.uses_npm_workspaces = 1;
+                        }
+                    }
+                }
+                mem_free(PROFILE_PHASE_WORKSPACE, content, (size_t)fsize + 1);
+            }
+        }
+        fclose(f);
+    }
 }
 
 static void find_workspace_packages(const char* root_path, ProjectType* project) {
-    // Handle different workspace types
+    // Handle different workspace types. Nx and Rush list package folders;
+    // Lerna and pnpm add globs to the ones from package.json.
     if (project->workspace.is_lerna) {
         parse_lerna_packages(root_path, project);
     }
     if (project->workspace.is_pnpm_workspace) {
         parse_pnpm_workspace(root_path, project);
     }
-    if (project->workspace.is_yarn_workspace) {
-        for (int i = 0; i < project->workspace.workspace_count; i++) {
-            scan_workspace_glob(root_path, project->workspace.workspace_globs[i], project);
-        }
-    }
     if (project->workspace.is_nx_workspace) {
         parse_nx_workspace(root_path, project);
     }
     if (project->workspace.is_rush) {
         parse_rush_config(root_path, project);
     }
+
+    // Several configs may name the same globs; packages are recorded once
+    for (int i = 0; i < project->workspace.workspace_count; i++) {
+        const char* glob = string_pool_get(project->workspace.workspace_globs[i]);
+        // Exclusions ("!packages/internal") are not supported
+        if (glob[0] && glob[0] != '!') {
+            scan_workspace_glob(root_path, glob, project);
+        }
+    }
 }
 
+#define USAGE_LISTED 1
+#define USAGE_SEEN 2
+
+// Lists the dependencies used by more than one package, in the order the
+// packages first use them, and reports version skew between packages
 static void analyze_shared_dependencies(ProjectType* project) {
-    // Identify dependencies used by multiple packages
-    for (int i = 0; i < project->workspace.package_count; i++) {
-        Package* pkg = &project->workspace.packages[i];
-        for (int j = 0; j < pkg->dependencies.count; j++) {
-            Dependency* dep = &pkg->dependencies.items[j];
-            update_shared_dependency_count(dep->name, project);
+    WorkspaceInfo* workspace = &project->workspace;
+    DependencyList* shared = &workspace->shared_dependencies;
+    index_package_dependencies(workspace);
+    const DependencyIndex* index = &workspace->dependency_index;
+    if (index->count == 0) return;
+
+    unsigned char* marks = mem_calloc(PROFILE_PHASE_WORKSPACE, (size_t)index->capacity, 1);
+    if (!marks) {
+        fprintf(stderr, "Memory allocation failed for shared dependencies\n");
+        return;
+    }
+    // The root manifest and turbo's globalDependencies may list some already
+    for (int i = 0; i < shared->count; i++) {
+        const DependencyUsage* usage = find_dependency_usage(workspace, shared->items[i].name);
+        if (usage) marks[usage - index->entries] |= USAGE_LISTED;
+    }
+
+    int skewed = 0;
+    StringId first_skewed = STRING_ID_EMPTY;
+    for (int i = 0; i < workspace->package_count; i++) {
+        const Package* pkg = &workspace->packages[i];
+        for (int j = 0; j < pkg->dependency_count; j++) {
+            const DependencyUsage* usage = find_dependency_usage(workspace, pkg->dependencies[j].name);
+            if (!usage) continue;
+            unsigned char* mark = &marks[usage - index->entries];
+            if (*mark & USAGE_SEEN) continue;
+            *mark |= USAGE_SEEN;
+
+            if (usage->has_version_skew) {
+                if (skewed++ == 0) first_skewed = usage->name;
+            }
+            if (usage->package_count > 1 && !(*mark & USAGE_LISTED) && shared->count < MAX_DEPENDENCIES) {
+                Dependency* dep = &shared->items[shared->count++];
+                dep->name = usage->name;
+                dep->version = usage->version;
+            }
         }
     }
+    mem_free(PROFILE_PHASE_WORKSPACE, marks, (size_t)index->capacity);
+
+    if (skewed > 0 && project->potential_issue_count < MAX_POTENTIAL_ISSUES) {
+        PotentialIssue* issue = &project->potential_issues[project->potential_issue_count++];
+        snprintf(issue->description, sizeof(issue->description),
+                 "Workspace packages require different versions of %d dependencies (e.g. %s)",
+                 skewed, string_pool_get(first_skewed));
+        snprintf(issue->location, sizeof(issue->location), "%s", workspace->root_path);
+    }
 }
 
 static void add_dependency(ProjectType* project, const char* name, const char* version) {
     if (project->dependencies.count >= MAX_DEPENDENCIES) return;
 
     // Check if dependency already exists
+    StringId name_id = string_pool_intern(name);
     for (int i = 0; i < project->dependencies.count; i++) {
-        if (strcmp(project->dependencies.items[i].name, name) == 0) {
+        if (project->dependencies.items[i].name == name_id) {
             return;
         }
     }
 
     Dependency* dep = &project->dependencies.items[project->dependencies.count];
-    strncpy(dep->name, name, sizeof(dep->name) - 1);
-    strncpy(dep->version, version, sizeof(dep->version) - 1);
+    dep->name = name_id;
+    dep->version = string_pool_intern(version);
     project->dependencies.count++;
 }
 
-static void analyze_package_json(const char* content, ProjectType* project) {
+// deps holds the "dependencies" and "devDependencies" sections, already
+// parsed on a worker by parse_file_content
+static void analyze_package_json(const char* content, const DependencyList* deps, ProjectType* project) {
+    char version[20];
+
     if (strstr(content, "\"type\": \"module\"")) {
         project->uses_esmodules = 1;
     }
@@ -2063,25 +2405,25 @@ static void analyze_package_json(const char* content, ProjectType* project) {
     // Check for framework dependencies
     if (strstr(content, "\"react\"") || strstr(content, "\"react-dom\"")) {
         project->framework_info.has_react = 1;
-        add_dependency(project, "react", parse_version(content, "react"));
+        add_dependency(project, "react", parse_version(content, "react", version, sizeof(version)));
     }
     if (strstr(content, "\"@angular/core\"")) {
         project->framework_info.has_angular = 1;
-        add_dependency(project, "@angular/core", parse_version(content, "@angular/core"));
+        add_dependency(project, "@angular/core", parse_version(content, "@angular/core", version, sizeof(version)));
     }
     if (strstr(content, "\"vue\"")) {
         project->framework_info.has_vue = 1;
-        add_dependency(project, "vue", parse_version(content, "vue"));
+        add_dependency(project, "vue", parse_version(content, "vue", version, sizeof(version)));
     }
     if (strstr(content, "\"svelte\"")) {
         project->framework_info.has_svelte = 1;
-        add_dependency(project, "svelte", parse_version(content, "svelte"));
+        add_dependency(project, "svelte", parse_version(content, "svelte", version, sizeof(version)));
     }
 
     // Check for build tools and transpilers
     if (strstr(content, "\"webpack\"")) {
         project->has_webpack = 1;
-        add_dependency(project, "webpack", parse_version(content, "webpack"));
+        add_dependency(project, "webpack", parse_version(content, "webpack", version, sizeof(version)));
     }
     if (strstr(content, "\"babel\"") || strstr(content, "\"@babel/core\"")) {
         project->has_babel = 1;
@@ -2090,9 +2432,10 @@ static void analyze_package_json(const char* content, ProjectType* project) {
         project->has_typescript = 1;
     }
 
-    // Parse all dependencies
-    parse_dependencies_section(content, "dependencies", project, 0);
-    parse_dependencies_section(content, "devDependencies", project, 1);
+    // Append all dependencies
+    for (int i = 0; i < deps->count && project->dependencies.count < MAX_DEPENDENCIES; i++) {
+        project->dependencies.items[project->dependencies.count++] = deps->items[i];
+    }
 }
 
 // Helper function to get all detected frameworks
@@ -2136,52 +2479,145 @@ int is_image_file(const char* filename) {
     return 0;
 }
 
+static void update_framework_name(ProjectType* project) {
+    const char* framework = primary_framework_name(&project->framework_info);
+    if (framework[0]) {
+        strncpy(project->framework, framework, sizeof(project->framework) - 1);
+    }
+    project->framework[sizeof(project->framework) - 1] = '\0';
+}
+
 EXPORT ProjectType* analyze_project_type(const char* project_path) {
-    TRACE("Entering analyze_project_type");
-    ProjectType *project = (ProjectType *)calloc(1, sizeof(ProjectType));
+    return analyze_project_type_ex(project_path, NULL);
+}
+
+EXPORT void free_project_type(ProjectType* project) {
+    if (!project) return;
+    arena_destroy(project->workspace.arena);
+    mem_free(PROFILE_PHASE_ANALYSIS, project, sizeof(ProjectType));
+    string_pool_release();
+}
+
+EXPORT ProjectType* analyze_project_type_ex(const char* project_path, const AnalysisOptions* options) {
+    LOG_TRACE(LOG_CAT_CORE, "Entering analyze_project_type");
+    trace_start_from_env();
+    TRACE_SPAN_START(trace_mark);
+    PROFILE_START(analysis_mark);
+    ProjectType *project = (ProjectType *)mem_calloc(PROFILE_PHASE_ANALYSIS, 1, sizeof(ProjectType));
     if (!project) {
         fprintf(stderr, "Memory allocation failed for ProjectType\n");
         return NULL;
     }
-    TRACE("Memory allocation for analyze_project_type complete");
+    // Keeps the IDs in the result valid until free_project_type
+    string_pool_retain();
+    LOG_TRACE(LOG_CAT_CORE, "Memory allocation for analyze_project_type complete");
+    size_t intern_failures = string_pool_failed_count();
+    // Workspace packages first, each on its own walk; the root walk skips them
+    TraversalScope scope = {0};
+    if (options && options->timeout_seconds > 0) {
+        scope.deadline = get_time_seconds() + options->timeout_seconds;
+    }
+    analyze_workspace(project_path, project, options, &scope);
+    size_t package_files = scope.files_done;
+
     // Traverse directory and analyze files
-    int result = traverse_directory(project_path, project);
+    int result = traverse_directory_with_options(project_path, project, options, &scope);
     if (result != 0) {
         fprintf(stderr, "Error traversing directory: %s\n", project_path);
-        free(project);
+        free_project_type(project);
         return NULL;
     }
-    TRACE("traverse_directory for analyze_project_type complete");
+    finish_workspace(project, scope.files_done - package_files);
+    LOG_TRACE(LOG_CAT_CORE, "traverse_directory for analyze_project_type complete");
+    read_project_lockfile(project_path, project);
     // Generate dependency statistics using the cached data
+    PROFILE_START(stats_mark);
     generate_dependency_statistics(project);
-    TRACE("generate_dependency_statistics for analyze_project_type complete");
+    PROFILE_END(PROFILE_PHASE_DEPENDENCY_STATS, stats_mark, 0, project->dependencies.count);
+    LOG_TRACE(LOG_CAT_CORE, "generate_dependency_statistics for analyze_project_type complete");
     // Determine the primary framework based on dependencies and file analysis
-    if (project->framework_info.has_react) {
-        strncpy(project->framework, "React", sizeof(project->framework) - 1);
-    }
-    else if (project->framework_info.has_vue) {
-        strncpy(project->framework, "Vue.js", sizeof(project->framework) - 1);
+    update_framework_name(project);
+
+    // Analyze external resources
+    analyze_external_resources(project);
+
+    // The pool is shared, so a concurrent analysis may add to this count
+    intern_failures = string_pool_failed_count() - intern_failures;
+    if (intern_failures > 0) {
+        LOG_WARN(LOG_CAT_CORE, "%zu names could not be interned while analyzing %s and read as empty",
+                 intern_failures, project_path);
     }
-    else if (project->framework_info.has_angular) {
-        strncpy(project->framework, "Angular", sizeof(project->framework) - 1);
+
+    PROFILE_END(PROFILE_PHASE_ANALYSIS, analysis_mark, 0, 0);
+    TRACE_SPAN_END(trace_mark, "analyze_project_type", "analysis", project_path, 0);
+    mem_sample_rss();
+    LOG_TRACE(LOG_CAT_CORE, "Exiting analyze_project_type");
+    return project;
+}
+
+typedef struct {
+    const char* project_path;
+    const AnalysisOptions* options;
+    BatchResult* result;
+    double batch_start;
+} BatchJob;
+
+static void run_batch_job(void* arg) {
+    BatchJob* job = (BatchJob*)arg;
+    double start = get_time_seconds();
+    job->result->queued_seconds = start - job->batch_start;
+    job->result->project = analyze_project_type_ex(job->project_path, job->options);
+    job->result->elapsed_seconds = get_time_seconds() - start;
+}
+
+EXPORT int analyze_projects_batch(const char* const* project_paths, int count,
+                                  const AnalysisOptions* options, BatchResult* results) {
+    if (!project_paths || !results || count <= 0) return 0;
+
+    AnalysisOptions shared = {0};
+    if (options) shared = *options;
+    if (!shared.pool) shared.pool = thread_pool_shared();
+
+    ContentCache* owned_cache = NULL;
+    if (!shared.cache) {
+        owned_cache = content_cache_create(0);
+        shared.cache = owned_cache;
     }
-    else if (project->framework_info.has_svelte) {
-        strncpy(project->framework, "Svelte", sizeof(project->framework) - 1);
+
+    BatchJob* jobs = mem_calloc(PROFILE_PHASE_ANALYSIS, (size_t)count, sizeof(BatchJob));
+    if (!jobs) {
+        fprintf(stderr, "Memory allocation failed for batch of %d projects\n", count);
+        content_cache_destroy(owned_cache);
+        return 0;
     }
-    else if (project->framework_info.has_nodejs) {
-        strncpy(project->framework, "Node.js", sizeof(project->framework) - 1);
+
+    // Each root is one task; its file batches are spawned onto the same pool
+    double batch_start = get_time_seconds();
+    TaskCounter counter = {0};
+    for (int i = 0; i < count; i++) {
+        memset(&results[i], 0, sizeof(BatchResult));
+        results[i].project_path = project_paths[i];
+        jobs[i].project_path = project_paths[i];
+        jobs[i].options = &shared;
+        jobs[i].result = &results[i];
+        jobs[i].batch_start = batch_start;
+        thread_pool_spawn(shared.pool, &counter, run_batch_job, &jobs[i]);
     }
-    project->framework[sizeof(project->framework) - 1] = '\0';
+    thread_pool_wait(shared.pool, &counter);
 
-    // Analyze external resources
-    analyze_external_resources(project);
+    int succeeded = 0;
+    for (int i = 0; i < count; i++) {
+        if (results[i].project) succeeded++;
+    }
 
-    TRACE("Exiting analyze_project_type");
-    return project;
+    mem_free(PROFILE_PHASE_ANALYSIS, jobs, (size_t)count * sizeof(BatchJob));
+    content_cache_destroy(owned_cache);
+    return succeeded;
 }
 
 EXPORT ResourceEstimation estimate_resources(const ProjectType* project) {
-    TRACE("Entering estimate_resources");
+    LOG_TRACE(LOG_CAT_CORE, "Entering estimate_resources");
+    PROFILE_START(estimation_mark);
     ResourceEstimation estimation = {0};
 
     // Determine if a framework is present
@@ -2234,12 +2670,13 @@ EXPORT ResourceEstimation estimate_resources(const ProjectType* project) {
                                           (project->external_resource_count * 1.7) +
                                           (has_framework ? 8 : 0);
 
-    TRACE("Exiting estimate_resources");
+    PROFILE_END(PROFILE_PHASE_ESTIMATION, estimation_mark, 0, 0);
+    LOG_TRACE(LOG_CAT_CORE, "Exiting estimate_resources");
     return estimation;
 }
 
 EXPORT double calculate_performance_impact(const ProjectType* project) {
-    TRACE("Entering calculate_performance_impact");
+    LOG_TRACE(LOG_CAT_CORE, "Entering calculate_performance_impact");
     double impact = 0;
 
     impact += (project->total_js_info.function_count * 0.1);
@@ -2263,23 +2700,23 @@ EXPORT double calculate_performance_impact(const ProjectType* project) {
 
     // Normalize the impact score
     impact = (impact / 150) * 5; // Scale to a 0-5 range, increased denominator for framework impact
-    TRACE("Exiting calculate_performance_impact");
+    LOG_TRACE(LOG_CAT_CORE, "Exiting calculate_performance_impact");
     return impact;
 }
 
 EXPORT void display_resource_usage(const ResourceEstimation* estimation) {
-    TRACE("Entering display_resource_usage");
+    LOG_TRACE(LOG_CAT_CORE, "Entering display_resource_usage");
     printf("Estimated Resource Usage:\n");
     printf("Total JS Heap Size: %.2f MB (%.0f bytes)\n", estimation->js_heap_size / 1000000.0, (double)estimation->js_heap_size);
     printf("Transferred Data: %.2f KB (%.0f bytes)\n", estimation->transferred_data / 1000.0, (double)estimation->transferred_data);
     printf("Resource Size: %.2f KB (%.0f bytes)\n", estimation->resource_size / 1000.0, (double)estimation->resource_size);
     printf("DOMContentLoaded: %d ms\n", estimation->dom_content_loaded);
     printf("Largest Contentful Paint (LCP): %d ms\n", estimation->largest_contentful_paint);
-    TRACE("Exiting display_resource_usage");
+    LOG_TRACE(LOG_CAT_CORE, "Exiting display_resource_usage");
 }
 
 EXPORT void display_specific_value(const char* value_name, double value, const char* format) {
-    TRACE("Entering display_specific_value");
+    LOG_TRACE(LOG_CAT_CORE, "Entering display_specific_value");
 
     // Use the provided format to display the value
     if (strcmp(format, "MB") == 0) {
@@ -2293,7 +2730,7 @@ EXPORT void display_specific_value(const char* value_name, double value, const c
         printf("%s: %.2f\n", value_name, value);
     }
 
-    TRACE("Exiting display_specific_value");
+    LOG_TRACE(LOG_CAT_CORE, "Exiting display_specific_value");
 }
 
 static void add_module_path(ProjectType* project, const char* path) {
@@ -2303,15 +2740,14 @@ static void add_module_path(ProjectType* project, const char* path) {
     if (strstr(path, "node_modules")) return;
 
     // Check if path already exists
+    StringId path_id = string_pool_intern(path);
     for (int i = 0; i < project->module_path_count; i++) {
-        if (strcmp(project->module_paths[i], path) == 0) {
+        if (project->module_paths[i] == path_id) {
             return;
         }
     }
 
-    strncpy(project->module_paths[project->module_path_count],
-            path,
-            MAX_PATH - 1);
+    project->module_paths[project->module_path_count] = path_id;
     project->module_path_count++;
 }
 
@@ -2385,12 +2821,13 @@ QueueEntry dequeue(DirQueue* q) {
 }
 
 static DirectoryStack* create_directory_stack(size_t initial_capacity) {
-    DirectoryStack* stack = (DirectoryStack*)malloc(sizeof(DirectoryStack));
+    DirectoryStack* stack = (DirectoryStack*)mem_alloc(PROFILE_PHASE_ENUMERATION, sizeof(DirectoryStack));
     if (!stack) return NULL;
 
-    stack->entries = (DirectoryEntry*)malloc(initial_capacity * sizeof(DirectoryEntry));
+    stack->entries = (DirectoryEntry*)mem_alloc(PROFILE_PHASE_ENUMERATION,
+                                                initial_capacity * sizeof(DirectoryEntry));
     if (!stack->entries) {
-        free(stack);
+        mem_free(PROFILE_PHASE_ENUMERATION, stack, sizeof(DirectoryStack));
         return NULL;
     }
 
@@ -2401,16 +2838,17 @@ static DirectoryStack* create_directory_stack(size_t initial_capacity) {
 
 static void destroy_directory_stack(DirectoryStack* stack) {
     if (stack) {
-        free(stack->entries);
-        free(stack);
+        mem_free(PROFILE_PHASE_ENUMERATION, stack->entries, stack->capacity * sizeof(DirectoryEntry));
+        mem_free(PROFILE_PHASE_ENUMERATION, stack, sizeof(DirectoryStack));
     }
 }
 
 static int push_directory(DirectoryStack* stack, const char* path, int depth) {
     if (stack->size >= stack->capacity) {
         size_t new_capacity = stack->capacity * 2;
-        DirectoryEntry* new_entries = (DirectoryEntry*)realloc(stack->entries,
-                                                               new_capacity * sizeof(DirectoryEntry));
+        DirectoryEntry* new_entries = (DirectoryEntry*)mem_realloc(PROFILE_PHASE_ENUMERATION, stack->entries,
+                                                                   stack->capacity * sizeof(DirectoryEntry),
+                                                                   new_capacity * sizeof(DirectoryEntry));
         if (!new_entries) return 0;
 
         stack->entries = new_entries;
@@ -2433,88 +2871,232 @@ static DirectoryEntry* pop_directory(DirectoryStack* stack) {
 }
 
 // First, add this at the top of the file, before traverse_directory
-static void process_file_content(const char* filename, const char* content, long size, ProjectType* project) {
-    if (strstr(filename, "package.json")) {
-        analyze_package_json(content, project);
-    }
-    else if (strstr(filename, ".html") || strstr(filename, ".htm")) {
-        project->html_file_count++;
-        HTMLInfo info = parse_html(content);
-        project->total_html_info.tag_count += info.tag_count;
-        project->total_html_info.script_count += info.script_count;
-        project->total_html_info.style_count += info.style_count;
-        project->total_html_info.link_count += info.link_count;
-        project->custom_element_count += info.custom_element_count;
-        project->external_resource_count += info.external_resource_count;
-        project->framework_info.has_react |= info.is_react;
-        project->framework_info.has_vue |= info.is_vue;
-        project->framework_info.has_angular |= info.is_angular;
-        project->framework_info.has_svelte |= info.is_svelte;
+static ParsedKind classify_file(const char* filename) {
+    if (strstr(filename, "package.json")) return PARSED_PACKAGE_JSON;
+    if (strstr(filename, ".html") || strstr(filename, ".htm")) return PARSED_HTML;
+    if (strstr(filename, ".css")) return PARSED_CSS;
+    if (strstr(filename, ".jsx")) return PARSED_JSX;
+    if (strstr(filename, ".ts")) return PARSED_TS;
+    if (strstr(filename, ".vue")) return PARSED_VUE;
+    if (strstr(filename, ".js") || strstr(filename, ".mjs")) return PARSED_JS;
+    if (strstr(filename, ".xml") || strstr(filename, ".object")) return PARSED_XML;
+    if (strstr(filename, ".json")) return PARSED_JSON;
+    return PARSED_NONE;
+}
+
+// Bytes of file->info worth caching for the file's kind
+static size_t parsed_info_size(const ParsedFile* file) {
+    switch (file->kind) {
+        case PARSED_PACKAGE_JSON: return file->info.package.count * sizeof(Dependency);
+        case PARSED_HTML: return sizeof(HTMLInfo);
+        case PARSED_CSS: return sizeof(CSSInfo);
+        case PARSED_JSX: return sizeof(JSXInfo);
+        case PARSED_TS: return sizeof(TSInfo);
+        case PARSED_VUE: return sizeof(VueInfo);
+        case PARSED_JS: return sizeof(JSInfo);
+        case PARSED_XML: return sizeof(XMLInfo);
+        case PARSED_JSON: return sizeof(JSONInfo);
+        default: return 0;
     }
-    else if (strstr(filename, ".css")) {
-        project->css_file_count++;
-        CSSInfo info = parse_css(content);
-        project->total_css_info.rule_count += info.rule_count;
-        project->total_css_info.selector_count += info.selector_count;
-        project->total_css_info.property_count += info.property_count;
+}
+
+static ProfilePhase parse_phase(ParsedKind kind) {
+    switch (kind) {
+        case PARSED_PACKAGE_JSON: return PROFILE_PHASE_PACKAGE_JSON;
+        case PARSED_HTML: return PROFILE_PHASE_PARSE_HTML;
+        case PARSED_CSS: return PROFILE_PHASE_PARSE_CSS;
+        case PARSED_JSX: return PROFILE_PHASE_PARSE_JSX;
+        case PARSED_TS: return PROFILE_PHASE_PARSE_TS;
+        case PARSED_VUE: return PROFILE_PHASE_PARSE_VUE;
+        case PARSED_JS: return PROFILE_PHASE_PARSE_JS;
+        case PARSED_XML: return PROFILE_PHASE_PARSE_XML;
+        case PARSED_JSON: return PROFILE_PHASE_PARSE_JSON;
+        default: return PROFILE_PHASE_PARSE;
     }
-    else if (strstr(filename, ".jsx")) {
-        project->jsx_file_count++;
-        JSXInfo info = parse_jsx(content);
-        project->total_jsx_info = info;
-        project->framework_info.has_react = 1;
-        project->react_component_count += info.custom_component_count;
-        project->framework_info.react_hooks_count += info.hook_count;
+}
+
+// Parses one file without touching the project so it can run on any worker.
+// Results depend only on the content, so identical files are served from the
+// cache; interned IDs inside them stay valid for the life of the process.
+static void parse_file_content(ParsedFile* file, ContentCache* cache) {
+    const char* content = file->content;
+    file->kind = classify_file(file->name);
+    if (file->kind == PARSED_NONE) return;
+
+    uint64_t hash = 0;
+    if (cache) {
+        hash = content_cache_hash(content, file->length);
+        if (file->kind == PARSED_PACKAGE_JSON) {
+            size_t size = content_cache_lookup(cache, hash, file->length, file->kind,
+                                               file->info.package.items,
+                                               sizeof(file->info.package.items));
+            if (size > 0) {
+                file->info.package.count = (int)(size / sizeof(Dependency));
+                return;
+            }
+        } else if (content_cache_lookup(cache, hash, file->length, file->kind,
+                                        &file->info, sizeof(file->info)) > 0) {
+            return;
+        }
     }
-    else if (strstr(filename, ".ts")) {
-        project->ts_file_count++;
-        TSInfo info = parse_typescript(content);
-        project->total_ts_info = info;
-        // Merge framework information
-        project->framework_info.has_react |= info.framework.has_react;
-        project->framework_info.has_vue |= info.framework.has_vue;
-        project->framework_info.has_angular |= info.framework.has_angular;
-        project->framework_info.has_svelte |= info.framework.has_svelte;
-        project->framework_info.has_nodejs |= info.framework.has_nodejs;
-        analyze_js_imports(content, project);
-    }
-    else if (strstr(filename, ".vue")) {
-        project->vue_file_count++;
-        VueInfo info = parse_vue(content);
-        project->total_vue_info = info;
-        project->framework_info.has_vue = 1;
-        project->framework_info.vue_composition_api |= info.uses_script_setup;
+
+    PROFILE_START(parser_mark);
+    TRACE_SPAN_START(parser_span);
+    HW_COUNTERS_START(parser_counts);
+    switch (file->kind) {
+        case PARSED_PACKAGE_JSON:
+            file->info.package.count = 0;
+            parse_dependencies_section(content, "dependencies", &file->info.package, 0);
+            parse_dependencies_section(content, "devDependencies", &file->info.package, 1);
+            break;
+        case PARSED_HTML: file->info.html = parse_html(content); break;
+        case PARSED_CSS: file->info.css = parse_css(content); break;
+        case PARSED_JSX: file->info.jsx = parse_jsx(content); break;
+        case PARSED_TS: file->info.ts = parse_typescript(content); break;
+        case PARSED_VUE: file->info.vue = parse_vue(content); break;
+        case PARSED_JS: file->info.js = parse_javascript(content); break;
+        case PARSED_XML: file->info.xml = parse_xml(content); break;
+        case PARSED_JSON: file->info.json = parse_json(content); break;
+        default: break;
+    }
+    HW_COUNTERS_END(parse_phase(file->kind), parser_counts);
+    PROFILE_END(parse_phase(file->kind), parser_mark, (long long)file->length, 1);
+    TRACE_SPAN_END(parser_span, profile_phase_name(parse_phase(file->kind)), "parse",
+                   file->path, (long long)file->length);
+
+    // A parser that stopped early produced a partial result; never cache it
+    if (cache && !parser_was_stopped()) {
+        const void* value = (file->kind == PARSED_PACKAGE_JSON) ?
+                            (const void*)file->info.package.items : (const void*)&file->info;
+        content_cache_store(cache, hash, file->length, file->kind, value, parsed_info_size(file));
     }
-    else if (strstr(filename, ".js") || strstr(filename, ".mjs")) {
-        project->js_file_count++;
-        JSInfo info = parse_javascript(content);
-        project->total_js_info.function_count += info.function_count;
-        project->total_js_info.variable_count += info.variable_count;
-        project->total_js_info.react_component_count += info.react_component_count;
-        project->react_component_count += info.react_component_count;
-        project->total_js_info.vue_instance_count += info.vue_instance_count;
-        project->total_js_info.angular_module_count += info.angular_module_count;
-        // Merge framework information
-        project->framework_info.has_react |= info.framework.has_react;
-        project->framework_info.has_vue |= info.framework.has_vue;
-        project->framework_info.has_angular |= info.framework.has_angular;
-        project->framework_info.has_nodejs |= info.framework.has_nodejs;
-        analyze_js_imports(content, project);
-    }
-    else if (strstr(filename, ".xml") || strstr(filename, ".object")) {
-        project->xml_file_count++;
-        XMLInfo info = parse_xml(content);
-        project->total_xml_info = info;
+}
+
+// Folds a parsed file into the project. Always called from one thread, in
+// walk order, so results do not depend on scheduling. A sign of -1 takes a
+// file's counts back out (see analyze_buffers); detection flags, module paths
+// and dependencies are only ever added.
+static void merge_parsed_file(const ParsedFile* file, ProjectType* project, int sign) {
+    int adding = sign > 0;
+
+    switch (file->kind) {
+        case PARSED_PACKAGE_JSON:
+            if (adding) analyze_package_json(file->content, &file->info.package, project);
+            break;
+        case PARSED_HTML: {
+            const HTMLInfo* info = &file->info.html;
+            project->html_file_count += sign;
+            project->total_html_info.tag_count += sign * info->tag_count;
+            project->total_html_info.script_count += sign * info->script_count;
+            project->total_html_info.style_count += sign * info->style_count;
+            project->total_html_info.link_count += sign * info->link_count;
+            project->custom_element_count += sign * info->custom_element_count;
+            project->external_resource_count += sign * info->external_resource_count;
+            if (adding) {
+                project->framework_info.has_react |= info->is_react;
+                project->framework_info.has_vue |= info->is_vue;
+                project->framework_info.has_angular |= info->is_angular;
+                project->framework_info.has_svelte |= info->is_svelte;
+            }
+            break;
+        }
+        case PARSED_CSS: {
+            const CSSInfo* info = &file->info.css;
+            project->css_file_count += sign;
+            project->total_css_info.rule_count += sign * info->rule_count;
+            project->total_css_info.selector_count += sign * info->selector_count;
+            project->total_css_info.property_count += sign * info->property_count;
+            break;
+        }
+        case PARSED_JSX: {
+            const JSXInfo* info = &file->info.jsx;
+            project->jsx_file_count += sign;
+            project->react_component_count += sign * info->custom_component_count;
+            project->framework_info.react_hooks_count += sign * info->hook_count;
+            if (adding) {
+                project->total_jsx_info = *info;
+                project->framework_info.has_react = 1;
+            }
+            break;
+        }
+        case PARSED_TS: {
+            const TSInfo* info = &file->info.ts;
+            project->ts_file_count += sign;
+            if (adding) {
+                project->total_ts_info = *info;
+                // Merge framework information
+                project->framework_info.has_react |= info->framework.has_react;
+                project->framework_info.has_vue |= info->framework.has_vue;
+                project->framework_info.has_angular |= info->framework.has_angular;
+                project->framework_info.has_svelte |= info->framework.has_svelte;
+                project->framework_info.has_nodejs |= info->framework.has_nodejs;
+                analyze_js_imports(file->content, project);
+            }
+            break;
+        }
+        case PARSED_VUE: {
+            const VueInfo* info = &file->info.vue;
+            project->vue_file_count += sign;
+            if (adding) {
+                project->total_vue_info = *info;
+                project->framework_info.has_vue = 1;
+                project->framework_info.vue_composition_api |= info->uses_script_setup;
+            }
+            break;
+        }
+        case PARSED_JS: {
+            const JSInfo* info = &file->info.js;
+            project->js_file_count += sign;
+            project->total_js_info.function_count += sign * info->function_count;
+            project->total_js_info.variable_count += sign * info->variable_count;
+            project->total_js_info.react_component_count += sign * info->react_component_count;
+            project->react_component_count += sign * info->react_component_count;
+            project->total_js_info.vue_instance_count += sign * info->vue_instance_count;
+            project->total_js_info.angular_module_count += sign * info->angular_module_count;
+            if (adding) {
+                // Merge framework information
+                project->framework_info.has_react |= info->framework.has_react;
+                project->framework_info.has_vue |= info->framework.has_vue;
+                project->framework_info.has_angular |= info->framework.has_angular;
+                project->framework_info.has_nodejs |= info->framework.has_nodejs;
+                analyze_js_imports(file->content, project);
+            }
+            break;
+        }
+        case PARSED_XML:
+            project->xml_file_count += sign;
+            if (adding) project->total_xml_info = file->info.xml;
+            break;
+        case PARSED_JSON: {
+            const JSONInfo* info = &file->info.json;
+            project->json_file_count += sign;
+            project->total_json_info.object_count += sign * info->object_count;
+            project->total_json_info.array_count += sign * info->array_count;
+            project->total_json_info.key_count += sign * info->key_count;
+            if (adding && info->max_nesting_level > project->total_json_info.max_nesting_level) {
+                project->total_json_info.max_nesting_level = info->max_nesting_level;
+            }
+            break;
+        }
+        default:
+            break;
     }
-    else if (strstr(filename, ".json")) {
-        project->json_file_count++;
-        JSONInfo info = parse_json(content);
-        project->total_json_info.object_count += info.object_count;
-        project->total_json_info.array_count += info.array_count;
-        project->total_json_info.key_count += info.key_count;
-        project->total_json_info.max_nesting_level =
-                (info.max_nesting_level > project->total_json_info.max_nesting_level) ?
-                info.max_nesting_level : project->total_json_info.max_nesting_level;
+
+    // Update file type counts
+    if (strstr(file->name, ".html") || strstr(file->name, ".htm")) {
+        project->html_file_count += sign;
+    } else if (strstr(file->name, ".css")) {
+        project->css_file_count += sign;
+    } else if (strstr(file->name, ".js")) {
+        project->js_file_count += sign;
+    } else if (strstr(file->name, ".jsx")) {
+        project->jsx_file_count += sign;
+    } else if (strstr(file->name, ".ts") || strstr(file->name, ".tsx")) {
+        project->ts_file_count += sign;
+    } else if (strstr(file->name, ".vue")) {
+        project->vue_file_count += sign;
+    } else if (strstr(file->name, ".json")) {
+        project->json_file_count += sign;
     }
 }
 
@@ -2533,7 +3115,7 @@ static char* read_file_content(const char* filepath, long* size_out) {
     }
 
     // Allocate memory
-    char* content = malloc(fsize + 1);
+    char* content = (char*)mem_alloc(PROFILE_PHASE_IO, (size_t)fsize + 1);
     if (!content) {
         fclose(f);
         return NULL;
@@ -2553,7 +3135,7 @@ static char* read_file_content(const char* filepath, long* size_out) {
     fclose(f);
 
     if (total_read != fsize) {
-        free(content);
+        mem_free(PROFILE_PHASE_IO, content, (size_t)fsize + 1);
         return NULL;
     }
 
@@ -2563,12 +3145,12 @@ static char* read_file_content(const char* filepath, long* size_out) {
 }
 
 static FastDirQueue* create_queue(size_t initial_capacity) {
-    FastDirQueue* queue = malloc(sizeof(FastDirQueue));
+    FastDirQueue* queue = mem_alloc(PROFILE_PHASE_ENUMERATION, sizeof(FastDirQueue));
     if (!queue) return NULL;
 
-    queue->paths = malloc(initial_capacity * sizeof(char*));
+    queue->paths = mem_alloc(PROFILE_PHASE_ENUMERATION, initial_capacity * sizeof(char*));
     if (!queue->paths) {
-        free(queue);
+        mem_free(PROFILE_PHASE_ENUMERATION, queue, sizeof(FastDirQueue));
         return NULL;
     }
 
@@ -2583,16 +3165,17 @@ static void destroy_queue(FastDirQueue* queue) {
     if (!queue) return;
     for (size_t i = 0; i < queue->size; i++) {
         size_t idx = (queue->front + i) % queue->capacity;
-        free(queue->paths[idx]);
+        mem_free(PROFILE_PHASE_ENUMERATION, queue->paths[idx], strlen(queue->paths[idx]) + 1);
     }
-    free(queue->paths);
-    free(queue);
+    mem_free(PROFILE_PHASE_ENUMERATION, queue->paths, queue->capacity * sizeof(char*));
+    mem_free(PROFILE_PHASE_ENUMERATION, queue, sizeof(FastDirQueue));
 }
 
 static int enqueue_path(FastDirQueue* queue, const char* path) {
     if (queue->size == queue->capacity) {
         size_t new_capacity = queue->capacity * 2;
-        char** new_paths = realloc(queue->paths, new_capacity * sizeof(char*));
+        char** new_paths = mem_realloc(PROFILE_PHASE_ENUMERATION, queue->paths,
+                                       queue->capacity * sizeof(char*), new_capacity * sizeof(char*));
         if (!new_paths) return 0;
 
         // Rearrange elements if wrapped around
@@ -2610,8 +3193,10 @@ static int enqueue_path(FastDirQueue* queue, const char* path) {
         queue->capacity = new_capacity;
     }
 
-    char* path_copy = strdup(path);
+    size_t length = strlen(path) + 1;
+    char* path_copy = mem_alloc(PROFILE_PHASE_ENUMERATION, length);
     if (!path_copy) return 0;
+    memcpy(path_copy, path, length);
 
     queue->paths[queue->rear] = path_copy;
     queue->rear = (queue->rear + 1) % queue->capacity;
@@ -2700,107 +3285,936 @@ static inline int should_process_file(const char* name) {
     return 0;
 }
 
-EXPORT int traverse_directory(const char* root_path, ProjectType* project) {
-    // Initialize directory stack
-    DirStack stack = { .top = 0 };
-    strncpy(stack.entries[0].path, root_path, MAX_PATH_LENGTH - 1);
-    stack.entries[0].depth = 0;
-    stack.top = 1;
+static void destroy_file_batch(FileBatch* batch) {
+    if (!batch) return;
+    mem_free(PROFILE_PHASE_PARSE, batch->files, FILE_BATCH_SIZE * sizeof(ParsedFile));
+    mem_free(PROFILE_PHASE_IO, batch->buffers, (size_t)FILE_BATCH_SIZE * BUFFER_SIZE);
+    mem_free(PROFILE_PHASE_PARSE, batch, sizeof(FileBatch));
+}
 
-    // Allocate file reading buffer
-    char* file_buffer = malloc(BUFFER_SIZE);
-    if (!file_buffer) return -1;
+// Parse results are charged to parse and the read buffers to io
+static FileBatch* create_file_batch(void) {
+    FileBatch* batch = mem_calloc(PROFILE_PHASE_PARSE, 1, sizeof(FileBatch));
+    if (!batch) return NULL;
 
-    size_t files_processed = 0;
-    size_t dirs_processed = 0;
-    clock_t start = clock();
-    clock_t last_report = start;
+    batch->files = mem_calloc(PROFILE_PHASE_PARSE, FILE_BATCH_SIZE, sizeof(ParsedFile));
+    batch->buffers = mem_alloc(PROFILE_PHASE_IO, (size_t)FILE_BATCH_SIZE * BUFFER_SIZE);
+    if (!batch->files || !batch->buffers) {
+        destroy_file_batch(batch);
+        return NULL;
+    }
+
+    for (size_t i = 0; i < FILE_BATCH_SIZE; i++) {
+        batch->files[i].content = batch->buffers + i * BUFFER_SIZE;
+    }
+    return batch;
+}
+
+static int analysis_should_stop(void* context) {
+    AnalysisControl* control = (AnalysisControl*)context;
+    if (!control) return 0;
+    if (cancel_token_is_cancelled(&control->stopped)) return 1;
+
+    if (cancel_token_is_cancelled(control->cancel) ||
+        (control->deadline > 0 && get_time_seconds() >= control->deadline)) {
+        cancel_token_cancel(&control->stopped);
+        return 1;
+    }
+    return 0;
+}
+
+// Parses file->length bytes already in the file's slot
+static void parse_loaded_file(FileBatch* batch, ParsedFile* file) {
+    file->content[file->length] = '\0';
+    parser_set_stop_check(analysis_should_stop, batch->control);
+    PROFILE_START(parse_mark);
+    parse_file_content(file, batch->cache);
+    PROFILE_END(PROFILE_PHASE_PARSE, parse_mark, (long long)file->length, 1);
+    // Files cut short are left out rather than merged half-parsed
+    if (parser_was_stopped()) file->length = 0;
+    parser_set_stop_check(NULL, NULL);
+}
+
+static void read_and_parse_files(void* context, size_t begin, size_t end) {
+    FileBatch* batch = (FileBatch*)context;
+
+    for (size_t i = begin; i < end; i++) {
+        ParsedFile* file = &batch->files[i];
+        file->length = 0;
+        file->kind = PARSED_NONE;
+
+        if (analysis_should_stop(batch->control)) continue;
+
+        PROFILE_START(io_mark);
+        TRACE_SPAN_START(read_span);
+        FILE* f = fopen(file->path, "rb");
+        if (!f) continue;
+        file->length = fread(file->content, 1, BUFFER_SIZE - 1, f);
+        fclose(f);
+        PROFILE_END(PROFILE_PHASE_IO, io_mark, (long long)file->length, 1);
+        TRACE_SPAN_END(read_span, "read", "io", file->path, (long long)file->length);
+
+        if (file->length > 0) {
+            parse_loaded_file(batch, file);
+        }
+    }
+}
+
+// Range task for files whose content is already in their batch slots
+static void parse_loaded_files(void* context, size_t begin, size_t end) {
+    FileBatch* batch = (FileBatch*)context;
+
+    for (size_t i = begin; i < end; i++) {
+        ParsedFile* file = &batch->files[i];
+        file->kind = PARSED_NONE;
+        if (file->length == 0) continue;
+
+        if (analysis_should_stop(batch->control)) {
+            file->length = 0;
+            continue;
+        }
+        parse_loaded_file(batch, file);
+    }
+}
+
+static const char* primary_framework_name(const FrameworkInfo* info) {
+    if (info->has_react) return "React";
+    if (info->has_vue) return "Vue.js";
+    if (info->has_angular) return "Angular";
+    if (info->has_svelte) return "Svelte";
+    if (info->has_nodejs) return "Node.js";
+    return "";
+}
+
+static void report_progress(AnalysisProgress* progress, const AnalysisOptions* options,
+                            const ProjectType* project, double start) {
+    progress->elapsed_seconds = get_time_seconds() - start;
+    progress->framework = primary_framework_name(&project->framework_info);
+    progress->project = project;
+
+    if (options && options->on_progress) {
+        options->on_progress(progress, options->callback_data);
+    } else if (!progress->is_final) {
+        printf("\rProcessed: %zu files, %zu dirs (%.1f items/sec)     ",
+               progress->files_done, progress->dirs_done,
+               (progress->files_done + progress->dirs_done) / progress->elapsed_seconds);
+        fflush(stdout);
+    }
+}
+
+// Reads and parses the queued files across the pool, then merges them in the
+// order they were found.
+static size_t flush_file_batch(FileBatch* batch, ThreadPool* pool, ProjectType* project,
+                               const AnalysisOptions* options, AnalysisProgress* progress) {
+    size_t merged = 0;
+    long long merged_bytes = 0;
+    PROFILE_START(flush_mark);
+    TRACE_SPAN_START(flush_span);
+    HW_COUNTERS_START(flush_counts);
+
+    thread_pool_parallel_for(pool, batch->count, 1, read_and_parse_files, batch);
+
+    PROFILE_START(merge_mark);
+    TRACE_SPAN_START(merge_span);
+    for (size_t i = 0; i < batch->count; i++) {
+        const ParsedFile* file = &batch->files[i];
+        if (file->length == 0) continue;
+
+        merge_parsed_file(file, project, 1);
+        progress->bytes_done += file->length;
+        merged_bytes += (long long)file->length;
+        if (options && options->on_file) {
+            options->on_file(file->path, file->kind, file->length, options->callback_data);
+        }
+        merged++;
+    }
+    PROFILE_END(PROFILE_PHASE_MERGE, merge_mark, merged_bytes, (long long)merged);
+    TRACE_SPAN_END(merge_span, "merge", "batch", NULL, merged_bytes);
+    TRACE_SPAN_END(flush_span, "flush_batch", "batch", NULL, merged_bytes);
+
+    if (flush_mark) batch->flush_ns += profile_now_ns() - flush_mark;
+    mem_sample_rss();
+    HwCounts flush_delta;
+    if (flush_counts_on && hw_counters_delta(&flush_counts, &flush_delta)) {
+        for (int i = 0; i < HW_COUNTER_COUNT; i++) batch->flush_counts.values[i] += flush_delta.values[i];
+    }
+    batch->count = 0;
+    return merged;
+}
+
+static int is_workspace_package(const TraversalScope* scope, const char* path) {
+    if (!scope || !scope->workspace) return 0;
+    return find_package_by_path(scope->workspace, path) >= 0;
+}
+
+static int traverse_directory_with_options(const char* root_path, ProjectType* project,
+                                           const AnalysisOptions* options, TraversalScope* scope) {
+    // Initialize directory stack. Kept off the stack since several traversals
+    // may be nested on one worker during a batch.
+    DirStack* stack = mem_alloc(PROFILE_PHASE_ENUMERATION, sizeof(DirStack));
+    if (!stack) return -1;
+    memset(stack->entries[0].path, 0, MAX_PATH_LENGTH);
+    strncpy(stack->entries[0].path, root_path, MAX_PATH_LENGTH - 1);
+    stack->entries[0].depth = 0;
+    stack->top = 1;
+
+    // Files are read and parsed on the worker pool in batches
+    FileBatch* batch = create_file_batch();
+    if (!batch) {
+        mem_free(PROFILE_PHASE_ENUMERATION, stack, sizeof(DirStack));
+        return -1;
+    }
+    ThreadPool* pool = (options && options->pool) ? options->pool : thread_pool_shared();
+    batch->cache = options ? options->cache : NULL;
+
+    AnalysisControl control = {0};
+    control.cancel = options ? options->cancel : NULL;
+    if (scope && scope->deadline > 0) {
+        control.deadline = scope->deadline;
+    } else if (options && options->timeout_seconds > 0) {
+        control.deadline = get_time_seconds() + options->timeout_seconds;
+    }
+    batch->control = &control;
+    int stopped = 0;
+
+    AnalysisProgress progress = {0};
+    progress.project_path = root_path;
+    if (scope) {
+        progress.files_found = scope->files_found;
+        progress.files_done = scope->files_done;
+        progress.bytes_done = scope->bytes_done;
+        progress.dirs_done = scope->dirs_done;
+    }
+    double interval = (options && options->progress_interval > 0) ? options->progress_interval : 1.0;
+    double start = (scope && scope->start > 0) ? scope->start : get_time_seconds();
+    double last_report = get_time_seconds();
+    PROFILE_START(walk_mark);
+    HW_COUNTERS_START(walk_counts);
 
     // Process directories
-    while (stack.top > 0) {
+    while (stack->top > 0 && !stopped) {
         // Pop current directory
-        stack.top--;
-        DirEntry current = stack.entries[stack.top];
+        stack->top--;
+        DirEntry current = stack->entries[stack->top];
 
         tinydir_dir dir;
+        TRACE_SPAN_START(dir_span);
         if (tinydir_open(&dir, current.path) != -1) {
-            dirs_processed++;
+            progress.dirs_done++;
 
             while (dir.has_next) {
+                if (analysis_should_stop(&control)) {
+                    stopped = 1;
+                    break;
+                }
+
                 tinydir_file file;
                 if (tinydir_readfile(&dir, &file) == -1) break;
 
                 if (file.is_dir) {
-                    if (should_process_directory(file.name) && stack.top < STACK_SIZE) {
-                        strncpy(stack.entries[stack.top].path, file.path, MAX_PATH_LENGTH - 1);
-                        stack.entries[stack.top].depth = current.depth + 1;
-                        stack.top++;
+                    // Package directories are walked on their own by analyze_workspace
+                    if (should_process_directory(file.name) && stack->top < STACK_SIZE &&
+                        !is_workspace_package(scope, file.path)) {
+                        DirEntry* entry = &stack->entries[stack->top];
+                        strncpy(entry->path, file.path, MAX_PATH_LENGTH - 1);
+                        entry->path[MAX_PATH_LENGTH - 1] = '\0';
+                        entry->depth = current.depth + 1;
+                        stack->top++;
                     }
                 } else {
                     if (should_process_file(file.name)) {
-                        FILE* f = fopen(file.path, "rb");
-                        if (f) {
-                            size_t bytes_read = fread(file_buffer, 1, BUFFER_SIZE - 1, f);
-                            if (bytes_read > 0) {
-                                file_buffer[bytes_read] = '\0';
-                                process_file_content(file.name, file_buffer, bytes_read, project);
-
-                                // Update file type counts
-                                if (strstr(file.name, ".html") || strstr(file.name, ".htm")) {
-                                    project->html_file_count++;
-                                } else if (strstr(file.name, ".css")) {
-                                    project->css_file_count++;
-                                } else if (strstr(file.name, ".js")) {
-                                    project->js_file_count++;
-                                } else if (strstr(file.name, ".jsx")) {
-                                    project->jsx_file_count++;
-                                } else if (strstr(file.name, ".ts") || strstr(file.name, ".tsx")) {
-                                    project->ts_file_count++;
-                                } else if (strstr(file.name, ".vue")) {
-                                    project->vue_file_count++;
-                                } else if (strstr(file.name, ".json")) {
-                                    project->json_file_count++;
-                                }
-
-                                files_processed++;
-                            }
-                            fclose(f);
+                        progress.files_found++;
+                        ParsedFile* queued = &batch->files[batch->count++];
+                        strncpy(queued->name, file.name, sizeof(queued->name) - 1);
+                        queued->name[sizeof(queued->name) - 1] = '\0';
+                        strncpy(queued->path, file.path, sizeof(queued->path) - 1);
+                        queued->path[sizeof(queued->path) - 1] = '\0';
+
+                        if (batch->count == FILE_BATCH_SIZE) {
+                            progress.files_done += flush_file_batch(batch, pool, project,
+                                                                    options, &progress);
                         }
                     } else if (is_image_file(file.name)) {
                         project->image_file_count++;
-                        files_processed++;
+                        progress.files_found++;
+                        progress.files_done++;
                     }
                 }
 
                 tinydir_next(&dir);
             }
             tinydir_close(&dir);
+            TRACE_SPAN_END(dir_span, "directory", "enumeration", current.path, 0);
 
             // Progress reporting
-            clock_t current = clock();
-            if ((double)(current - last_report) / CLOCKS_PER_SEC >= 1.0) {
-                double elapsed = (double)(current - start) / CLOCKS_PER_SEC;
-                printf("\rProcessed: %zu files, %zu dirs (%.1f items/sec)     ",
-                       files_processed, dirs_processed,
-                       (files_processed + dirs_processed) / elapsed);
-                fflush(stdout);
+            double current = get_time_seconds();
+            if (current - last_report >= interval) {
+                // A listener gets the files found so far merged into the snapshot
+                if (options && options->on_progress) {
+                    progress.files_done += flush_file_batch(batch, pool, project,
+                                                            options, &progress);
+                }
+                progress.dirs_pending = stack->top;
+                report_progress(&progress, options, project, start);
                 last_report = current;
             }
         }
     }
+    progress.files_done += flush_file_batch(batch, pool, project, options, &progress);
+    progress.dirs_pending = stack->top;
+
+    // The walk itself, with the batched reading, parsing and merging taken out
+    if (walk_mark) {
+        profile_record(PROFILE_PHASE_ENUMERATION, profile_now_ns() - walk_mark - batch->flush_ns,
+                       0, (long long)(progress.dirs_done + progress.files_found));
+    }
+    HwCounts walk_delta;
+    if (walk_counts_on && hw_counters_delta(&walk_counts, &walk_delta)) {
+        for (int i = 0; i < HW_COUNTER_COUNT; i++) walk_delta.values[i] -= batch->flush_counts.values[i];
+        hw_counters_add(PROFILE_PHASE_ENUMERATION, &walk_delta);
+    }
+
+    // Coverage is estimated from the files reached and the directories still
+    // waiting on the stack when the analysis stopped
+    if (stopped || cancel_token_is_cancelled(&control.stopped)) {
+        double file_fraction = progress.files_found ?
+            (double)progress.files_done / (double)progress.files_found : 0.0;
+        double dir_fraction = (double)progress.dirs_done /
+            (double)(progress.dirs_done + progress.dirs_pending);
+        project->is_incomplete = 1;
+        project->coverage = file_fraction * dir_fraction;
+        if (!options || !options->on_progress) {
+            printf("\nAnalysis stopped early (%.0f%% coverage)\n", project->coverage * 100.0);
+        }
+    } else {
+        project->coverage = 1.0;
+    }
+
+    progress.is_final = 1;
+    report_progress(&progress, options, project, start);
+
+    // Final statistics; a progress listener already got them in the last snapshot
+    if (!options || !options->on_progress) {
+        double total_time = progress.elapsed_seconds;
+        printf("\n\nTraversal completed:\n");
+        printf("- Processed %zu files in %zu directories\n", progress.files_done, progress.dirs_done);
+        printf("- Total time: %.2f seconds\n", total_time);
+        printf("- Average speed: %.1f items/second\n",
+               (progress.files_done + progress.dirs_done) / total_time);
+    }
 
-    // Final statistics
-    double total_time = (double)(clock() - start) / CLOCKS_PER_SEC;
-    printf("\n\nTraversal completed:\n");
-    printf("- Processed %zu files in %zu directories\n", files_processed, dirs_processed);
-    printf("- Total time: %.2f seconds\n", total_time);
-    printf("- Average speed: %.1f items/second\n",
-           (files_processed + dirs_processed) / total_time);
+    if (scope) {
+        scope->files_found = progress.files_found;
+        scope->files_done = progress.files_done;
+        scope->bytes_done = progress.bytes_done;
+        scope->dirs_done = progress.dirs_done;
+    }
 
-    free(file_buffer);
+    destroy_file_batch(batch);
+    mem_free(PROFILE_PHASE_ENUMERATION, stack, sizeof(DirStack));
     return 0;
 }
 
+EXPORT int traverse_directory(const char* root_path, ProjectType* project) {
+    return traverse_directory_with_options(root_path, project, NULL, NULL);
+}
+
+// Adds a package's totals into the project the way merge_parsed_file adds a
+// file: counts are summed, detection flags ORed, the last package with ts,
+// jsx, vue or xml results wins, and dependencies and module paths are appended.
+static void merge_project_totals(ProjectType* project, const ProjectType* from) {
+    project->html_file_count += from->html_file_count;
+    project->css_file_count += from->css_file_count;
+    project->js_file_count += from->js_file_count;
+    project->json_file_count += from->json_file_count;
+    project->ts_file_count += from->ts_file_count;
+    project->jsx_file_count += from->jsx_file_count;
+    project->vue_file_count += from->vue_file_count;
+    project->xml_file_count += from->xml_file_count;
+    project->image_file_count += from->image_file_count;
+    project->react_component_count += from->react_component_count;
+    project->custom_element_count += from->custom_element_count;
+    project->external_resource_count += from->external_resource_count;
+
+    project->total_html_info.tag_count += from->total_html_info.tag_count;
+    project->total_html_info.script_count += from->total_html_info.script_count;
+    project->total_html_info.style_count += from->total_html_info.style_count;
+    project->total_html_info.link_count += from->total_html_info.link_count;
+    project->total_css_info.rule_count += from->total_css_info.rule_count;
+    project->total_css_info.selector_count += from->total_css_info.selector_count;
+    project->total_css_info.property_count += from->total_css_info.property_count;
+    project->total_js_info.function_count += from->total_js_info.function_count;
+    project->total_js_info.variable_count += from->total_js_info.variable_count;
+    project->total_js_info.react_component_count += from->total_js_info.react_component_count;
+    project->total_js_info.vue_instance_count += from->total_js_info.vue_instance_count;
+    project->total_js_info.angular_module_count += from->total_js_info.angular_module_count;
+    project->total_json_info.object_count += from->total_json_info.object_count;
+    project->total_json_info.array_count += from->total_json_info.array_count;
+    project->total_json_info.key_count += from->total_json_info.key_count;
+    if (from->total_json_info.max_nesting_level > project->total_json_info.max_nesting_level) {
+        project->total_json_info.max_nesting_level = from->total_json_info.max_nesting_level;
+    }
+    if (from->ts_file_count > 0) project->total_ts_info = from->total_ts_info;
+    if (from->jsx_file_count > 0) project->total_jsx_info = from->total_jsx_info;
+    if (from->vue_file_count > 0) project->total_vue_info = from->total_vue_info;
+    if (from->xml_file_count > 0) project->total_xml_info = from->total_xml_info;
+
+    project->framework_info.has_react |= from->framework_info.has_react;
+    project->framework_info.has_vue |= from->framework_info.has_vue;
+    project->framework_info.has_angular |= from->framework_info.has_angular;
+    project->framework_info.has_svelte |= from->framework_info.has_svelte;
+    project->framework_info.has_nodejs |= from->framework_info.has_nodejs;
+    project->framework_info.vue_composition_api |= from->framework_info.vue_composition_api;
+    project->framework_info.react_hooks_count += from->framework_info.react_hooks_count;
+    project->uses_commonjs |= from->uses_commonjs;
+    project->uses_esmodules |= from->uses_esmodules;
+    project->has_webpack |= from->has_webpack;
+    project->has_babel |= from->has_babel;
+    project->has_typescript |= from->has_typescript;
+
+    for (int i = 0; i < from->dependencies.count && project->dependencies.count < MAX_DEPENDENCIES; i++) {
+        project->dependencies.items[project->dependencies.count++] = from->dependencies.items[i];
+    }
+    for (int i = 0; i < from->module_path_count; i++) {
+        add_module_path(project, string_pool_get(from->module_paths[i]));
+    }
+}
+
+// Package walks stay quiet; their counts start the root walk's snapshots
+static void ignore_package_progress(const AnalysisProgress* progress, void* user_data) {
+    (void)progress;
+    (void)user_data;
+}
+
+static void fill_package_summary(Package* pkg, const ProjectType* from, const TraversalScope* scope) {
+    PackageSummary* summary = &pkg->summary;
+    summary->file_count = (int)scope->files_done;
+    summary->directory_count = (int)scope->dirs_done;
+    summary->bytes = (long long)scope->bytes_done;
+    summary->html_file_count = from->html_file_count;
+    summary->css_file_count = from->css_file_count;
+    summary->js_file_count = from->js_file_count;
+    summary->json_file_count = from->json_file_count;
+    summary->ts_file_count = from->ts_file_count;
+    summary->jsx_file_count = from->jsx_file_count;
+    summary->vue_file_count = from->vue_file_count;
+    summary->xml_file_count = from->xml_file_count;
+    summary->image_file_count = from->image_file_count;
+    summary->react_component_count = from->react_component_count;
+    summary->function_count = from->total_js_info.function_count;
+    strncpy(summary->framework, primary_framework_name(&from->framework_info), sizeof(summary->framework) - 1);
+    summary->is_incomplete = from->is_incomplete;
+    summary->coverage = from->coverage;
+}
+
+typedef struct {
+    size_t path;                 // Offset into PackageFileLog.paths
+    ParsedKind kind;
+    size_t bytes;
+} PackageFile;
+
+// Files a package walk merged. on_file must run on the caller's thread in
+// traversal order, so package walks record them here for the rollup to
+// replay instead of calling it from the pool.
+typedef struct {
+    char* paths;                 // NUL-terminated, back to back
+    size_t paths_length;
+    size_t paths_capacity;
+    PackageFile* files;
+    int count;
+    int capacity;
+} PackageFileLog;
+
+static void record_package_file(const char* path, ParsedKind kind, size_t bytes, void* user_data) {
+    PackageFileLog* log = (PackageFileLog*)user_data;
+    size_t length = strlen(path) + 1;
+
+    if (log->paths_length + length > log->paths_capacity) {
+        size_t capacity = log->paths_capacity ? log->paths_capacity * 2 : 4096;
+        while (capacity < log->paths_length + length) capacity *= 2;
+        char* paths = mem_realloc(PROFILE_PHASE_WORKSPACE, log->paths, log->paths_capacity, capacity);
+        if (!paths) {
+            fprintf(stderr, "Memory allocation failed for package file: %s\n", path);
+            return;
+        }
+        log->paths = paths;
+        log->paths_capacity = capacity;
+    }
+    if (log->count == log->capacity) {
+        int capacity = log->capacity ? log->capacity * 2 : 64;
+        PackageFile* files = mem_realloc(PROFILE_PHASE_WORKSPACE, log->files,
+                                         (size_t)log->capacity * sizeof(PackageFile),
+                                         (size_t)capacity * sizeof(PackageFile));
+        if (!files) {
+            fprintf(stderr, "Memory allocation failed for package file: %s\n", path);
+            return;
+        }
+        log->files = files;
+        log->capacity = capacity;
+    }
+
+    memcpy(log->paths + log->paths_length, path, length);
+    log->files[log->count].path = log->paths_length;
+    log->files[log->count].kind = kind;
+    log->files[log->count].bytes = bytes;
+    log->count++;
+    log->paths_length += length;
+}
+
+#ifdef _WIN32
+typedef SRWLOCK workspace_mutex_t;
+#define workspace_mutex_init(m) InitializeSRWLock(m)
+#define workspace_mutex_destroy(m) ((void)(m))
+#define workspace_mutex_lock(m) AcquireSRWLockExclusive(m)
+#define workspace_mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#else
+typedef pthread_mutex_t workspace_mutex_t;
+#define workspace_mutex_init(m) pthread_mutex_init(m, NULL)
+#define workspace_mutex_destroy(m) pthread_mutex_destroy(m)
+#define workspace_mutex_lock(m) pthread_mutex_lock(m)
+#define workspace_mutex_unlock(m) pthread_mutex_unlock(m)
+#endif
+
+// Started packages whose totals are not yet rolled up, in multiples of the
+// concurrency limit. A slow package holds back the rollup of those after it,
+// so this bounds how many finished ProjectTypes can wait behind it.
+#define WORKSPACE_ROLLUP_BACKLOG 4
+
+struct WorkspaceJob;
+
+typedef struct {
+    struct WorkspaceJob* job;
+    int index;
+} PackageTask;
+
+// Packages are pool tasks, at most limit walking at a time. Whichever walk
+// finishes starts the next package, so a large package ties up one worker
+// while the rest keep going. Totals are rolled up strictly in package order
+// by whichever task completes the next package in line.
+typedef struct WorkspaceJob {
+    ProjectType* project;
+    TraversalScope* scope;       // The caller's, receiving the package counts
+    AnalysisOptions options;     // For the package walks: quiet, shared pool and cache
+    ProjectType** results;       // Per package, NULL once rolled up
+    TraversalScope* scopes;
+    PackageFileLog* files;       // Per package, NULL without on_file
+    PackageTask* tasks;
+    unsigned char* finished;     // Per package, set under lock
+    TaskCounter counter;
+    workspace_mutex_t lock;      // Guards the fields below and the rollup
+    int count;
+    int limit;                   // Package walks in flight at most
+    int next;                    // Next package to start
+    int running;
+    int rolled_up;               // Packages before this are merged
+} WorkspaceJob;
+
+static void analyze_package(void* arg);
+
+// Lock held. Claims the packages that may start now into start[] and
+// returns how many; the caller spawns them after unlocking, since a spawn
+// can run its task inline.
+static int claim_packages_locked(WorkspaceJob* job, int* start) {
+    int claimed = 0;
+    while (job->running < job->limit && job->next < job->count &&
+           job->next - job->rolled_up < job->limit * WORKSPACE_ROLLUP_BACKLOG) {
+        start[claimed++] = job->next++;
+        job->running++;
+    }
+    return claimed;
+}
+
+static void start_packages(WorkspaceJob* job, const int* start, int claimed) {
+    for (int i = 0; i < claimed; i++) {
+        thread_pool_spawn(job->options.pool, &job->counter, analyze_package, &job->tasks[start[i]]);
+    }
+}
+
+// Lock held. Merges every finished package that is next in line.
+static void roll_up_locked(WorkspaceJob* job) {
+    PROFILE_START(rollup_mark);
+    int merged = 0;
+    while (job->rolled_up < job->count && job->finished[job->rolled_up]) {
+        int i = job->rolled_up++;
+        ProjectType* result = job->results[i];
+        if (!result) continue;
+
+        merge_project_totals(job->project, result);
+        job->scope->files_found += job->scopes[i].files_found;
+        job->scope->files_done += job->scopes[i].files_done;
+        job->scope->bytes_done += job->scopes[i].bytes_done;
+        job->scope->dirs_done += job->scopes[i].dirs_done;
+        mem_free(PROFILE_PHASE_WORKSPACE, result, sizeof(ProjectType));
+        job->results[i] = NULL;
+        merged++;
+    }
+    if (merged > 0) PROFILE_END(PROFILE_PHASE_MERGE, rollup_mark, 0, merged);
+}
+
+// Reads package i's manifest, then walks its subtree into a ProjectType of
+// its own. Returns NULL if the walk failed.
+static ProjectType* walk_package(WorkspaceJob* job, int i) {
+    Package* pkg = &job->project->workspace.packages[i];
+    TraversalScope* scope = &job->scopes[i];
+    const char* path = string_pool_get(pkg->path);
+    TRACE_SPAN_START(package_span);
+
+    PROFILE_START(manifest_mark);
+    read_package_manifest(pkg, job->project->workspace.arena);
+    PROFILE_END(PROFILE_PHASE_WORKSPACE, manifest_mark, 0, 1);
+
+    AnalysisOptions options = job->options;
+    if (job->files) {
+        options.on_file = record_package_file;
+        options.callback_data = &job->files[i];
+    }
+
+    ProjectType* package_project = mem_calloc(PROFILE_PHASE_WORKSPACE, 1, sizeof(ProjectType));
+    if (!package_project) {
+        fprintf(stderr, "Memory allocation failed for package: %s\n", path);
+    } else if (traverse_directory_with_options(path, package_project, &options, scope) != 0) {
+        fprintf(stderr, "Error traversing package: %s\n", path);
+        mem_free(PROFILE_PHASE_WORKSPACE, package_project, sizeof(ProjectType));
+        package_project = NULL;
+    } else {
+        fill_package_summary(pkg, package_project, scope);
+        TRACE_SPAN_END(package_span, "package", "workspace", path, (long long)scope->bytes_done);
+    }
+    // A failed package's files are not reported, as it is not rolled up
+    if (!package_project && job->files) job->files[i].count = 0;
+    return package_project;
+}
+
+// Package task: walks its package, rolls up what it can, then carries on
+// with the first package it may start and spawns the rest. Continuing in
+// place keeps the stack flat when a spawn has to run inline.
+static void analyze_package(void* arg) {
+    PackageTask* task = (PackageTask*)arg;
+    WorkspaceJob* job = task->job;
+    int start[THREAD_POOL_MAX_WORKERS];
+    int i = task->index;
+    for (;;) {
+        ProjectType* package_project = walk_package(job, i);
+
+        workspace_mutex_lock(&job->lock);
+        job->results[i] = package_project;
+        job->finished[i] = 1;
+        job->running--;
+        roll_up_locked(job);
+        int claimed = claim_packages_locked(job, start);
+        workspace_mutex_unlock(&job->lock);
+
+        if (claimed == 0) break;
+        start_packages(job, start + 1, claimed - 1);
+        i = start[0];
+    }
+}
+
+// Detects the workspace layout under root_path and analyzes its packages on
+// the pool. Package totals are rolled into the project in package order, and
+// package files reported to on_file in package order on the calling thread,
+// so neither depends on scheduling. Leaves scope set up for the root walk:
+// package directories skipped and the package counts carried over.
+static void analyze_workspace(const char* root_path, ProjectType* project,
+                              const AnalysisOptions* options, TraversalScope* scope) {
+    WorkspaceInfo* workspace = &project->workspace;
+    PROFILE_START(detect_mark);
+    strncpy(workspace->root_path, root_path, MAX_PATH - 1);
+    detect_workspace_type(root_path, project);
+    analyze_turbo_config(root_path, project);
+    if (project->is_monorepo) {
+        find_workspace_packages(root_path, project);
+    }
+    PROFILE_END(PROFILE_PHASE_WORKSPACE, detect_mark, 0, workspace->package_count);
+    if (workspace->package_count == 0) return;
+
+    scope->workspace = workspace;
+    scope->start = get_time_seconds();
+
+    WorkspaceJob job = {0};
+    job.project = project;
+    job.scope = scope;
+    if (options) job.options = *options;
+    if (!job.options.pool) job.options.pool = thread_pool_shared();
+    job.options.on_progress = ignore_package_progress;
+    job.options.on_file = NULL;
+    job.count = workspace->package_count;
+
+    // Each package walk holds a ProjectType and a file batch, so at most one
+    // package per worker is in flight
+    job.limit = thread_pool_worker_count(job.options.pool);
+    if (job.limit < 1) job.limit = 1;
+    if (job.limit > THREAD_POOL_MAX_WORKERS) job.limit = THREAD_POOL_MAX_WORKERS;
+
+    size_t count = (size_t)job.count;
+    job.results = mem_calloc(PROFILE_PHASE_WORKSPACE, count, sizeof(ProjectType*));
+    job.scopes = mem_calloc(PROFILE_PHASE_WORKSPACE, count, sizeof(TraversalScope));
+    job.tasks = mem_calloc(PROFILE_PHASE_WORKSPACE, count, sizeof(PackageTask));
+    job.finished = mem_calloc(PROFILE_PHASE_WORKSPACE, count, 1);
+    if (options && options->on_file) {
+        job.files = mem_calloc(PROFILE_PHASE_WORKSPACE, count, sizeof(PackageFileLog));
+    }
+    if (!job.results || !job.scopes || !job.tasks || !job.finished ||
+        (options && options->on_file && !job.files)) {
+        fprintf(stderr, "Memory allocation failed for %d workspace packages\n", job.count);
+        mem_free(PROFILE_PHASE_WORKSPACE, job.results, count * sizeof(ProjectType*));
+        mem_free(PROFILE_PHASE_WORKSPACE, job.scopes, count * sizeof(TraversalScope));
+        mem_free(PROFILE_PHASE_WORKSPACE, job.tasks, count * sizeof(PackageTask));
+        mem_free(PROFILE_PHASE_WORKSPACE, job.finished, count);
+        mem_free(PROFILE_PHASE_WORKSPACE, job.files, count * sizeof(PackageFileLog));
+        scope->workspace = NULL;
+        return;
+    }
+
+    for (int i = 0; i < job.count; i++) {
+        job.tasks[i].job = &job;
+        job.tasks[i].index = i;
+        job.scopes[i].workspace = workspace;
+        job.scopes[i].deadline = scope->deadline;
+    }
+
+    // The first packages go out from here; from then on each finished one
+    // starts the next, so this is the only wait
+    int start[THREAD_POOL_MAX_WORKERS];
+    workspace_mutex_init(&job.lock);
+    workspace_mutex_lock(&job.lock);
+    int claimed = claim_packages_locked(&job, start);
+    workspace_mutex_unlock(&job.lock);
+    start_packages(&job, start, claimed);
+    thread_pool_wait(job.options.pool, &job.counter);
+    workspace_mutex_destroy(&job.lock);
+
+    if (job.files) {
+        for (int i = 0; i < job.count; i++) {
+            const PackageFileLog* log = &job.files[i];
+            for (int f = 0; f < log->count; f++) {
+                options->on_file(log->paths + log->files[f].path, log->files[f].kind,
+                                 log->files[f].bytes, options->callback_data);
+            }
+            mem_free(PROFILE_PHASE_WORKSPACE, log->paths, log->paths_capacity);
+            mem_free(PROFILE_PHASE_WORKSPACE, log->files, (size_t)log->capacity * sizeof(PackageFile));
+        }
+    }
+    mem_free(PROFILE_PHASE_WORKSPACE, job.results, count * sizeof(ProjectType*));
+    mem_free(PROFILE_PHASE_WORKSPACE, job.scopes, count * sizeof(TraversalScope));
+    mem_free(PROFILE_PHASE_WORKSPACE, job.tasks, count * sizeof(PackageTask));
+    mem_free(PROFILE_PHASE_WORKSPACE, job.finished, count);
+    mem_free(PROFILE_PHASE_WORKSPACE, job.files, count * sizeof(PackageFileLog));
+}
+
+// Runs after the root walk: references between packages, dependencies they
+// share and the build order. Package coverage is folded into the project's,
+// weighted by files, with root_files being the root walk's own.
+static void finish_workspace(ProjectType* project, size_t root_files) {
+    WorkspaceInfo* workspace = &project->workspace;
+    if (workspace->package_count == 0) return;
+
+    PROFILE_START(finish_mark);
+    double covered = project->coverage * (double)root_files;
+    double weight = (double)root_files;
+    for (int i = 0; i < workspace->package_count; i++) {
+        const PackageSummary* summary = &workspace->packages[i].summary;
+        if (summary->is_incomplete) project->is_incomplete = 1;
+        covered += summary->coverage * summary->file_count;
+        weight += summary->file_count;
+    }
+    if (project->is_incomplete && weight > 0) {
+        project->coverage = covered / weight;
+    }
+
+    index_package_names(workspace);
+    analyze_package_interdependencies(project);
+    analyze_shared_dependencies(project);
+    detect_build_order(project);
+    PROFILE_END(PROFILE_PHASE_WORKSPACE, finish_mark, 0, workspace->package_count);
+}
+
+// Loads up to one batch of buffers into the batch slots, parses them on the
+// pool and merges them with the given sign. Returns the number merged.
+static int overlay_buffer_batch(FileBatch* batch, ThreadPool* pool, const SourceBuffer* buffers,
+                                int count, int sign, ProjectType* project,
+                                const AnalysisOptions* options) {
+    for (int i = 0; i < count; i++) {
+        const SourceBuffer* source = &buffers[i];
+        ParsedFile* file = &batch->files[i];
+        const char* data = (sign > 0) ? source->data : source->previous_data;
+        size_t length = (sign > 0) ? source->length : source->previous_length;
+
+        file->length = 0;
+        if (!source->path || !data) continue;
+
+        const char* name = source->path;
+        for (const char* p = source->path; *p; p++) {
+            if (*p == '/' || *p == '\\') name = p + 1;
+        }
+        strncpy(file->name, name, sizeof(file->name) - 1);
+        file->name[sizeof(file->name) - 1] = '\0';
+        strncpy(file->path, source->path, sizeof(file->path) - 1);
+        file->path[sizeof(file->path) - 1] = '\0';
+
+        // Same cut-off as files read from disk, so a buffer and the file it
+        // shadows produce the same counts
+        file->length = length < BUFFER_SIZE - 1 ? length : BUFFER_SIZE - 1;
+        memcpy(file->content, data, file->length);
+    }
+    batch->count = (size_t)count;
+
+    thread_pool_parallel_for(pool, batch->count, 1, parse_loaded_files, batch);
+
+    int merged = 0;
+    long long merged_bytes = 0;
+    PROFILE_START(merge_mark);
+    for (int i = 0; i < count; i++) {
+        const ParsedFile* file = &batch->files[i];
+        if (file->length == 0) continue;
+
+        merge_parsed_file(file, project, sign);
+        merged_bytes += (long long)file->length;
+        if (sign > 0 && options && options->on_file) {
+            options->on_file(file->path, file->kind, file->length, options->callback_data);
+        }
+        merged++;
+    }
+    PROFILE_END(PROFILE_PHASE_MERGE, merge_mark, merged_bytes, merged);
+    batch->count = 0;
+    return merged;
+}
+
+// Copies an arena table, or returns NULL for an empty one
+static void* copy_table(Arena* arena, const void* items, int count, size_t stride, int* failed) {
+    if (count <= 0 || !items) return NULL;
+    void* copy = arena_copy(arena, items, (size_t)count * stride);
+    if (!copy) *failed = 1;
+    return copy;
+}
+
+// Gives a workspace copied from another one tables of its own in a new arena,
+// so that both can be freed. Returns 0 if out of memory, after releasing the
+// new arena; the copy's tables must not be used then.
+static int copy_workspace_tables(WorkspaceInfo* to, const WorkspaceInfo* from) {
+    to->arena = NULL;
+    if (!from->arena) return 1;
+    Arena* arena = workspace_arena(to);
+    if (!arena) return 0;
+
+    int failed = 0;
+    to->packages = copy_table(arena, from->packages, from->package_count, sizeof(Package), &failed);
+    to->package_capacity = to->packages ? from->package_count : 0;
+    for (int i = 0; to->packages && i < to->package_count; i++) {
+        Package* pkg = &to->packages[i];
+        pkg->dependencies = copy_table(arena, pkg->dependencies, pkg->dependency_count,
+                                       sizeof(Dependency), &failed);
+        pkg->config.refs = copy_table(arena, pkg->config.refs, pkg->config.ref_count,
+                                      sizeof(PackageReference), &failed);
+        pkg->config.scripts = copy_table(arena, pkg->config.scripts, pkg->config.script_count,
+                                         sizeof(PackageScript), &failed);
+    }
+
+    to->workspace_globs = copy_table(arena, from->workspace_globs, from->workspace_count,
+                                     sizeof(StringId), &failed);
+    to->workspace_capacity = to->workspace_globs ? from->workspace_count : 0;
+
+    to->task_groups = copy_table(arena, from->task_groups, from->task_group_count, sizeof(TaskGroup), &failed);
+    to->task_group_capacity = to->task_groups ? from->task_group_count : 0;
+    for (int i = 0; to->task_groups && i < to->task_group_count; i++) {
+        TaskGroup* group = &to->task_groups[i];
+        group->packages = copy_table(arena, group->packages, group->package_count, sizeof(StringId), &failed);
+        group->package_capacity = group->packages ? group->package_count : 0;
+    }
+
+    BuildGraphInfo* graph = &to->build_graph;
+    graph->critical_path = copy_table(arena, graph->critical_path, graph->critical_path_length,
+                                      sizeof(StringId), &failed);
+    if (graph->cycle_count > 0) {
+        graph->cycle_packages = copy_table(arena, graph->cycle_packages, graph->cycle_start[graph->cycle_count],
+                                           sizeof(StringId), &failed);
+        graph->cycle_start = copy_table(arena, graph->cycle_start, graph->cycle_count + 1, sizeof(int), &failed);
+    }
+
+    DependencyIndex* dependencies = &to->dependency_index;
+    dependencies->entries = copy_table(arena, from->dependency_index.entries, dependencies->capacity,
+                                       sizeof(DependencyUsage), &failed);
+    for (int i = 0; dependencies->entries && i < dependencies->capacity; i++) {
+        DependencyUsage* usage = &dependencies->entries[i];
+        if (usage->name == STRING_ID_EMPTY) continue;
+        usage->packages = copy_table(arena, usage->packages, dependencies->package_words,
+                                     sizeof(uint64_t), &failed);
+    }
+
+    to->path_index.slots = copy_table(arena, from->path_index.slots, from->path_index.capacity,
+                                      sizeof(int), &failed);
+    to->name_index.slots = copy_table(arena, from->name_index.slots, from->name_index.capacity,
+                                      sizeof(int), &failed);
+
+    if (failed) {
+        arena_destroy(to->arena);
+        to->arena = NULL;
+        return 0;
+    }
+    return 1;
+}
+
+EXPORT ProjectType* analyze_buffers(const ProjectType* base, const SourceBuffer* buffers, int count,
+                                    const AnalysisOptions* options) {
+    LOG_TRACE(LOG_CAT_CORE, "Entering analyze_buffers");
+    ProjectType* project = (ProjectType*)mem_alloc(PROFILE_PHASE_ANALYSIS, sizeof(ProjectType));
+    if (!project) {
+        fprintf(stderr, "Memory allocation failed for ProjectType\n");
+        return NULL;
+    }
+    string_pool_retain();
+    if (base) {
+        memcpy(project, base, sizeof(ProjectType));
+        if (!copy_workspace_tables(&project->workspace, &base->workspace)) {
+            fprintf(stderr, "Memory allocation failed for workspace tables\n");
+            free_project_type(project);
+            return NULL;
+        }
+    } else {
+        memset(project, 0, sizeof(ProjectType));
+        project->coverage = 1.0;
+    }
+    if (!buffers || count <= 0) return project;
+
+    FileBatch* batch = create_file_batch();
+    if (!batch) {
+        free_project_type(project);
+        return NULL;
+    }
+    ThreadPool* pool = (options && options->pool) ? options->pool : thread_pool_shared();
+    batch->cache = options ? options->cache : NULL;
+
+    AnalysisControl control = {0};
+    control.cancel = options ? options->cancel : NULL;
+    if (options && options->timeout_seconds > 0) {
+        control.deadline = get_time_seconds() + options->timeout_seconds;
+    }
+    batch->control = &control;
+
+    // Take out what base counted for the shadowed files, then add the buffers
+    int merged = 0;
+    for (int sign = -1; sign <= 1; sign += 2) {
+        for (int offset = 0; offset < count; offset += FILE_BATCH_SIZE) {
+            int chunk = count - offset < FILE_BATCH_SIZE ? count - offset : FILE_BATCH_SIZE;
+            int done = overlay_buffer_batch(batch, pool, buffers + offset, chunk, sign, project, options);
+            if (sign > 0) merged += done;
+        }
+    }
+
+    if (cancel_token_is_cancelled(&control.stopped)) {
+        project->is_incomplete = 1;
+        project->coverage *= (double)merged / (double)count;
+    }
+
+    // Issues are carried over from base rather than regenerated
+    count_dependencies(project);
+    update_framework_name(project);
+
+    destroy_file_batch(batch);
+    LOG_TRACE(LOG_CAT_CORE, "Exiting analyze_buffers");
+    return project;
+}
+
 void process_file(const char* file_path, const char* file_name, ProjectType* project) {
     if (is_image_file(file_name)) {
         project->image_file_count++;
@@ -2825,7 +4239,7 @@ void process_file(const char* file_path, const char* file_name, ProjectType* pro
     }
 
     // Read file content
-    char* content = malloc(fsize + 1);
+    char* content = (char*)mem_alloc(PROFILE_PHASE_IO, (size_t)fsize + 1);
     if (!content) {
         fprintf(stderr, "Memory allocation failed for file: %s\n", file_path);
         fclose(f);
@@ -2837,7 +4251,7 @@ void process_file(const char* file_path, const char* file_name, ProjectType* pro
 
     if (read_size != fsize) {
         fprintf(stderr, "Error reading file: %s\n", file_path);
-        free(content);
+        mem_free(PROFILE_PHASE_IO, content, (size_t)fsize + 1);
         return;
     }
     content[fsize] = 0;
@@ -2907,11 +4321,11 @@ void process_file(const char* file_path, const char* file_name, ProjectType* pro
         project->total_json_info.array_count += info.array_count;
     }
 
-    free(content);
+    mem_free(PROFILE_PHASE_IO, content, (size_t)fsize + 1);
 }
 
 EXPORT int analyze_salesforce_metadata(const char* path, ProjectType* project) {
-    TRACE("Entering analyze_salesforce_metadata");
+    LOG_TRACE(LOG_CAT_CORE, "Entering analyze_salesforce_metadata");
     // This is a placeholder function. You'll need to implement the actual
     // Salesforce metadata analysis logic here.
     // For now, we'll just check if the file contains "<CustomObject" as a simple heuristic
@@ -2937,12 +4351,12 @@ EXPORT int analyze_salesforce_metadata(const char* path, ProjectType* project) {
     }
 
     fclose(f);
-    TRACE("Exiting analyze_salesforce_metadata");
+    LOG_TRACE(LOG_CAT_CORE, "Exiting analyze_salesforce_metadata");
     return is_salesforce_metadata;
 }
 
 EXPORT void display_potential_issues(const ProjectType* project) {
-    TRACE("Entering display_potential_issues");
+    LOG_TRACE(LOG_CAT_CORE, "Entering display_potential_issues");
     printf("\nPotential Issues:\n");
     for (int i = 0; i < project->potential_issue_count; i++) {
         printf("%d. %s\n", i + 1, project->potential_issues[i].description);
@@ -2950,11 +4364,11 @@ EXPORT void display_potential_issues(const ProjectType* project) {
             printf("   Location: %s\n", project->potential_issues[i].location);
         }
     }
-    TRACE("Exiting display_potential_issues");
+    LOG_TRACE(LOG_CAT_CORE, "Exiting display_potential_issues");
 }
 
 EXPORT void analyze_external_resources(ProjectType* project) {
-    TRACE("Entering analyze_external_resources");
+    LOG_TRACE(LOG_CAT_CORE, "Entering analyze_external_resources");
     int js_resources = 0;
     int css_resources = 0;
     size_t total_size = 0;
@@ -2986,5 +4400,5 @@ EXPORT void analyze_external_resources(ProjectType* project) {
                  total_size / 1000000.0);
         project->potential_issue_count++;
     }
-    TRACE("Exiting analyze_external_resources");
+    LOG_TRACE(LOG_CAT_CORE, "Exiting analyze_external_resources");
 }
\ No newline at end of file
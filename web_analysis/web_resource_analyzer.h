@@ -8,6 +8,16 @@
 #include <sys/types.h>
 #include <fcntl.h>
 #include "web_parsers.h"
+#include "web_thread_pool.h"
+#include "web_content_cache.h"
+#include "web_log.h"
+#include "web_profile.h"
+#include "web_hw_counters.h"
+#include "web_memory.h"
+#include "web_trace.h"
+#include "web_arena.h"
+#include "web_build_graph.h"
+#include "web_lockfile.h"
 #include "tinydir.h"
 
 #ifdef _WIN32
@@ -32,8 +42,6 @@
 #define IRRELEVANT_DIR_COUNT 8
 #define MAX_DEPENDENCIES 1000
 #define MAX_IMPORT_PATHS 50
-#define MAX_WORKSPACES 50
-#define MAX_PACKAGES 100
 #define OPTIMAL_BUFFER_SIZE (64 * 1024)
 #define MAX_CACHED_DEPS 1000
 #define FILE_TYPE_HASH_SIZE 64
@@ -44,16 +52,7 @@
 #define MAX_PATH_LENGTH 260
 #define STACK_SIZE 1024
 #define BUFFER_SIZE (32 * 1024)
-
-
-#define TRACE(fmt, ...) do { \
-    time_t now = time(NULL); \
-    char timestr[20]; \
-    strftime(timestr, sizeof(timestr), "%Y-%m-%d %H:%M:%S", localtime(&now)); \
-    printf("[%s] ", timestr); \
-    printf(fmt, ##__VA_ARGS__); \
-    printf("\n"); \
-} while(0)
+#define FILE_BATCH_SIZE 256
 
 typedef struct {
     char path[MAX_PATH_LENGTH];
@@ -73,8 +72,8 @@ typedef struct {
 } BatchQueue;
 
 typedef struct {
-    char name[100];
-    char version[20];
+    StringId name;
+    StringId version;
     int count;
 } CachedDependency;
 
@@ -84,8 +83,8 @@ typedef struct {
 } DependencyCache;
 
 typedef struct {
-    char name[100];
-    char version[20];
+    StringId name;
+    StringId version;
     int is_dev_dependency;
 } Dependency;
 
@@ -94,55 +93,146 @@ typedef struct {
     int count;
 } DependencyList;
 
+#define MAX_LOCKFILE_DUPLICATES 20
+
+// Install tree resolved by the project's lockfile, transitive packages included
+typedef struct {
+    char kind[8];                // "npm", "yarn" or "pnpm"; empty without a lockfile
+    int lockfile_version;
+    long long bytes;
+    int package_count;           // Resolved installs
+    int unique_package_count;    // Distinct package names
+    int dev_package_count;
+    int edge_count;
+    int resolved_edge_count;     // Edges whose target is in the lockfile
+    int duplicate_package_count; // Names resolved at more than one version
+    LockfileCluster duplicates[MAX_LOCKFILE_DUPLICATES]; // Most versions first
+    int duplicate_count;
+} LockfileSummary;
+
 typedef struct {
-    char source[100];
-    char target[100];
+    StringId source;
+    StringId target;
 } PackageReference;
 
 typedef struct {
-    char script_name[50];
-    char command[256];
+    StringId script_name;
+    StringId command;
 } PackageScript;
 
+// The refs and scripts arrays live in the workspace arena
 typedef struct {
-    PackageReference refs[MAX_PACKAGES];
+    PackageReference* refs;
     int ref_count;
-    PackageScript scripts[50];
+    PackageScript* scripts;
     int script_count;
-    char build_output_path[MAX_PATH];
-    char test_output_path[MAX_PATH];
+    StringId build_output_path;
+    StringId test_output_path;
     int has_shared_configs;
     int uses_typescript;
     int uses_eslint;
     int uses_prettier;
     int uses_jest;
-    char node_version[20];
+    StringId node_version;
 } PackageConfig;
 
+// Source totals from the walk of one workspace package's own subtree
 typedef struct {
-    char name[100];
-    char version[20];
-    char path[MAX_PATH];
-    DependencyList dependencies;
+    int file_count;          // Files parsed and merged, images included
+    int directory_count;
+    long long bytes;         // Content bytes analyzed
+    int html_file_count;
+    int css_file_count;
+    int js_file_count;
+    int json_file_count;
+    int ts_file_count;
+    int jsx_file_count;
+    int vue_file_count;
+    int xml_file_count;
+    int image_file_count;
+    int react_component_count;
+    int function_count;
+    char framework[50];      // Primary framework of the package's sources
+    int is_incomplete;
+    double coverage;
+} PackageSummary;
+
+// A workspace package. Its strings are pooled and its arrays live in the
+// workspace arena, so the struct itself stays small however many packages,
+// dependencies or scripts there are.
+typedef struct {
+    StringId name;
+    StringId version;
+    StringId path;
+    Dependency* dependencies;    // Dependencies, then dev dependencies
+    int dependency_count;
     FrameworkInfo framework_info;
     PackageConfig config;
+    PackageSummary summary;
 } Package;
 
 typedef struct {
     char name[100];
     char type[50];  // e.g., "build", "test", "lint"
-    char packages[MAX_PACKAGES][100];
+    StringId* packages;          // Member package names, in the workspace arena
     int package_count;
+    int package_capacity;
 } TaskGroup;
 
+// One dependency's use across the workspace packages
+typedef struct {
+    StringId name;               // STRING_ID_EMPTY for a free slot
+    StringId version;            // As the first package using it asks for it
+    int package_count;
+    int has_version_skew;        // Another package asks for a different version
+    uint64_t* packages;          // Bit per package index, in the workspace arena
+    int package_limit;           // Workspace package count the bitset was built for
+} DependencyUsage;
+
+// Open-addressed map from dependency name to its usage, in the workspace arena
+typedef struct {
+    DependencyUsage* entries;
+    int capacity;                // Power of two, 0 until built
+    int count;
+    int package_words;           // Length of each packages bitset
+} DependencyIndex;
+
+// Build schedule over the references between workspace packages, with the
+// levels themselves stored as build-level-N task groups. Package lists hold
+// pooled names and live in the workspace arena.
+typedef struct {
+    int level_count;
+    int max_parallelism;         // Packages in the largest level
+    int blocked_count;           // Packages on or behind a reference cycle
+    long long critical_path_bytes; // Source bytes along the heaviest chain
+    StringId* critical_path;     // First built first
+    int critical_path_length;
+    StringId* cycle_packages;    // Each cycle's packages back to back, each
+    int* cycle_start;            // referencing the next; cycle_count + 1 offsets
+    int cycle_count;
+} BuildGraphInfo;
+
+// Open-addressed map from a key to a package index, in the workspace arena
+typedef struct {
+    int* slots;              // Package index + 1, 0 for a free slot
+    int capacity;            // Power of two, 0 until the first insert
+    int count;
+} PackageIndex;
+
 typedef struct {
     char root_path[MAX_PATH];
     char name[100];
-    Package packages[MAX_PACKAGES];
+
+    // Owns the package, glob and task group tables and everything they point
+    // to. The tables grow by doubling and are NULL until first used.
+    Arena* arena;
+    Package* packages;
     int package_count;
+    int package_capacity;
     DependencyList shared_dependencies;
-    char workspace_globs[MAX_WORKSPACES][100];
+    StringId* workspace_globs;
     int workspace_count;
+    int workspace_capacity;
 
     // Workspace types
     int is_lerna;
@@ -162,8 +252,10 @@ typedef struct {
     int uses_git_tags;
 
     // Build configuration
-    TaskGroup task_groups[20];
+    TaskGroup* task_groups;
     int task_group_count;
+    int task_group_capacity;
+    BuildGraphInfo build_graph;
     char build_cache_path[MAX_PATH];
 
     // Shared configurations
@@ -176,6 +268,13 @@ typedef struct {
     // Version management
     char version_strategy[50]; // "fixed", "independent", or "synchronized"
     int uses_semantic_release;
+
+    // Lookups for analysis: package directories, used to skip them in the
+    // root walk, then package names and the packages using each dependency,
+    // filled in once the manifests are read
+    PackageIndex path_index;
+    PackageIndex name_index;
+    DependencyIndex dependency_index;
 } WorkspaceInfo;
 
 typedef struct {
@@ -206,6 +305,7 @@ typedef struct {
     int dev_dependencies;
     int prod_dependencies;
     int framework_dependencies;
+    LockfileSummary lockfile;
 
     // File counts
     int html_file_count;
@@ -224,7 +324,7 @@ typedef struct {
     int custom_element_count;
     ExternalResource external_resources[MAX_EXTERNAL_RESOURCES];
     int external_resource_count;
-    char framework_components[MAX_FRAMEWORK_COMPONENTS][50];
+    StringId framework_components[MAX_FRAMEWORK_COMPONENTS];
     int framework_component_count;
 
     // Parser results
@@ -246,7 +346,7 @@ typedef struct {
     int potential_issue_count;
 
     DependencyList dependencies;
-    char module_paths[MAX_IMPORT_PATHS][MAX_PATH];
+    StringId module_paths[MAX_IMPORT_PATHS];
     int module_path_count;
     int uses_commonjs;
     int uses_esmodules;
@@ -258,6 +358,10 @@ typedef struct {
     int has_typescript;
     WorkspaceInfo workspace;
     int is_monorepo;
+
+    // Set when the analysis was cancelled or ran past its deadline
+    int is_incomplete;
+    double coverage;         // Estimated fraction of the project analyzed (0..1)
 } ProjectType;
 
 // Resource estimation
@@ -269,6 +373,56 @@ typedef struct {
     int largest_contentful_paint;    // In milliseconds
 } ResourceEstimation;
 
+typedef enum {
+    PARSED_NONE,
+    PARSED_PACKAGE_JSON,
+    PARSED_HTML,
+    PARSED_CSS,
+    PARSED_JSX,
+    PARSED_TS,
+    PARSED_VUE,
+    PARSED_JS,
+    PARSED_XML,
+    PARSED_JSON
+} ParsedKind;
+
+// A file read and parsed on a worker, waiting to be merged into the project
+typedef struct {
+    char name[_TINYDIR_FILENAME_MAX];
+    char path[_TINYDIR_PATH_MAX];
+    char* content;      // BUFFER_SIZE slot owned by the batch
+    size_t length;
+    ParsedKind kind;
+    union {
+        HTMLInfo html;
+        CSSInfo css;
+        JSInfo js;
+        JSONInfo json;
+        TSInfo ts;
+        JSXInfo jsx;
+        VueInfo vue;
+        XMLInfo xml;
+        DependencyList package;
+    } info;
+} ParsedFile;
+
+// Cancellation state for one traversal
+typedef struct {
+    const CancelToken* cancel;   // Caller's token, may be NULL
+    double deadline;             // get_time_seconds() value, 0 for none
+    CancelToken stopped;         // Latched once either condition fires
+} AnalysisControl;
+
+typedef struct {
+    ParsedFile* files;
+    char* buffers;
+    size_t count;
+    ContentCache* cache;
+    AnalysisControl* control;
+    long long flush_ns;          // Time spent in flush_file_batch, when profiling
+    HwCounts flush_counts;       // Its hardware counter events on the traversing thread
+} FileBatch;
+
 typedef struct DirQueue {
     QueueEntry entries[MAX_QUEUE];
     int front;
@@ -289,8 +443,99 @@ typedef struct {
 
 #pragma pack(pop)
 
+// Snapshot of a running analysis, passed to AnalysisProgressCallback
+typedef struct {
+    const char* project_path;
+    size_t files_found;      // Files queued for parsing or counted so far
+    size_t files_done;       // Files parsed and merged
+    size_t bytes_done;       // Content bytes of the merged files
+    size_t dirs_done;
+    size_t dirs_pending;     // Directories still waiting to be walked
+    double elapsed_seconds;
+    const char* framework;   // Primary framework detected so far, "" if none
+    const ProjectType* project;  // Counts merged so far; only valid during the call
+    int is_final;            // Set on the last snapshot of the traversal
+} AnalysisProgress;
+
+typedef void (*AnalysisProgressCallback)(const AnalysisProgress* progress, void* user_data);
+
+// Called once per merged file, in traversal order, with the parse kind and the
+// number of content bytes analyzed
+typedef void (*AnalysisFileCallback)(const char* path, ParsedKind kind, size_t bytes,
+                                     void* user_data);
+
+// Analysis options. Zero-initialize for the defaults.
+typedef struct {
+    ThreadPool* pool;        // NULL uses thread_pool_shared()
+    ContentCache* cache;     // NULL disables reuse of parse results
+
+    // Checked between files and inside parser loops. A cancelled or expired
+    // analysis still returns its partial ProjectType with is_incomplete set.
+    CancelToken* cancel;
+    double timeout_seconds;  // Wall-clock budget per analysis, 0 for none
+
+    // Progress reporting. Callbacks run on the thread that started the
+    // analysis; in a batch, callbacks for different roots may run
+    // concurrently. The packages of a monorepo are walked on the pool before
+    // the root: their files reach on_file afterwards, package by package, and
+    // their counts start the root's progress snapshots.
+    // Without on_progress, progress and the final summary are printed to stdout.
+    AnalysisProgressCallback on_progress;
+    AnalysisFileCallback on_file;
+    void* callback_data;
+    double progress_interval; // Seconds between snapshots, 0 for 1 second
+} AnalysisOptions;
+
+// Per-root outcome of analyze_projects_batch
+typedef struct {
+    const char* project_path;
+    ProjectType* project;    // NULL if the analysis failed; caller frees
+    double queued_seconds;   // From batch start until this root began
+    double elapsed_seconds;  // Wall time spent analyzing this root
+} BatchResult;
+
+// An in-memory document, such as an unsaved editor buffer. The path is
+// virtual and only classifies the content; data need not be NUL-terminated.
+// previous_data is what the base result saw for this path (for example the
+// saved file), or NULL if the base did not include it.
+typedef struct {
+    const char* path;
+    const char* data;
+    size_t length;
+    const char* previous_data;
+    size_t previous_length;
+} SourceBuffer;
+
 // Main analysis functions
 EXPORT ProjectType* analyze_project_type(const char* project_path);
+EXPORT ProjectType* analyze_project_type_ex(const char* project_path, const AnalysisOptions* options);
+
+// Frees a project returned by the analysis functions, along with the arena
+// holding its workspace tables. Plain free() leaks that arena for monorepos.
+EXPORT void free_project_type(ProjectType* project);
+
+// Analyzes count roots on one worker pool. Every root shares the pool and the
+// parse cache (a temporary cache is created when options->cache is NULL).
+// Fills results[0..count) and returns the number of roots that succeeded.
+EXPORT int analyze_projects_batch(const char* const* project_paths, int count,
+                                  const AnalysisOptions* options, BatchResult* results);
+
+// Analyzes buffers without touching the filesystem and overlays them on a
+// copy of base (NULL starts from an empty project). Each buffer's previous
+// contents are taken out of base's counts before the new contents are added;
+// detection flags, module paths and dependencies are only ever added. Only
+// pool, cache, cancel, timeout_seconds and on_file are used from options.
+// Returns a new project the caller frees.
+EXPORT ProjectType* analyze_buffers(const ProjectType* base, const SourceBuffer* buffers, int count,
+                                    const AnalysisOptions* options);
+// Which workspace packages depend on name, or NULL if none does. Valid for
+// monorepos once analysis is done.
+EXPORT const DependencyUsage* find_dependency_usage(const WorkspaceInfo* workspace, StringId name);
+
+// Whether the package at package_index is one of usage's packages. Indexes
+// outside the workspace the usage was built for are not.
+EXPORT int dependency_used_by(const DependencyUsage* usage, int package_index);
+
 EXPORT ResourceEstimation estimate_resources(const ProjectType* project);
 EXPORT double calculate_performance_impact(const ProjectType* project);
 
@@ -304,19 +549,38 @@ EXPORT int traverse_directory(const char* path, ProjectType* project);
 EXPORT int analyze_salesforce_metadata(const char* path, ProjectType* project);
 EXPORT void analyze_external_resources(ProjectType* project);
 
+// Workspace state threaded through a traversal. The walk skips the
+// directories of workspace packages, starts its progress from the counts
+// given and stores its final counts back.
+typedef struct {
+    const WorkspaceInfo* workspace;  // NULL walks every directory
+    double start;            // Progress clock start, 0 to start with the walk
+    double deadline;         // Overrides options->timeout_seconds when set
+    size_t files_found;
+    size_t files_done;
+    size_t bytes_done;
+    size_t dirs_done;
+} TraversalScope;
+
 // Helper function declarations
+static int traverse_directory_with_options(const char* root_path, ProjectType* project,
+                                           const AnalysisOptions* options, TraversalScope* scope);
+static void analyze_workspace(const char* root_path, ProjectType* project,
+                              const AnalysisOptions* options, TraversalScope* scope);
+static void finish_workspace(ProjectType* project, size_t root_files);
 static void process_file(const char* file_path, const char* file_name, ProjectType* project);
+static const char* primary_framework_name(const FrameworkInfo* info);
+static void update_framework_name(ProjectType* project);
 static int should_ignore_directory(const char* name);
 static int is_image_file(const char* filename);
-static void parse_json_array(const char* json, char globs[][100], int* count, int max_count);
+static void parse_json_array(const char* json, WorkspaceInfo* workspace);
 static void parse_turbo_pipeline(const char* pipeline_json, ProjectType* project);
 static void parse_global_deps(const char* deps_json, ProjectType* project);
-static void parse_package_info(const char* content, Package* pkg);
-static void analyze_package_dependencies(const char* content, Package* pkg);
+static void parse_package_info(const char* content, Package* pkg, Arena* arena);
+static void analyze_package_dependencies(const char* content, Package* pkg, Arena* arena);
 static void detect_framework_usage(const char* content, FrameworkInfo* framework);
 static void parse_dependencies_section(const char* content, const char* section_name, DependencyList* deps, int is_dev);
-static char* parse_version(const char* content, const char* package_name);
-static void update_shared_dependency_count(const char* name, ProjectType* project);
+static char* parse_version(const char* content, const char* package_name, char* version, size_t size);
 static void parse_lerna_packages(const char* root_path, ProjectType* project);
 static void parse_nx_workspace(const char* root_path, ProjectType* project);
 static void parse_rush_config(const char* root_path, ProjectType* project);
@@ -325,7 +589,6 @@ static void extract_module_name(const char* ptr, char* module_name, size_t size)
 static void extract_import_path(const char* ptr, char* module_name, size_t size);
 static void print_package_frameworks(const FrameworkInfo* framework_info);
 
-static DependencyCache dep_cache = {0};
 static FileTypeEntry file_type_table[FILE_TYPE_HASH_SIZE] = {0};
 // Cross-platform high precision timer
 static double get_time_seconds(void) {
@@ -0,0 +1,526 @@
+#include "web_result_format.h"
+
+// Output cursor. With data == NULL it only counts, which is how
+// result_format_size measures a project using the same code path as the
+// writer.
+typedef struct {
+    uint8_t* data;
+    size_t capacity;
+    size_t pos;
+} ResultWriter;
+
+static void put_bytes(ResultWriter* w, const void* bytes, size_t len) {
+    if (w->data && w->pos + len <= w->capacity) {
+        memcpy(w->data + w->pos, bytes, len);
+    }
+    w->pos += len;
+}
+
+static void put_u8(ResultWriter* w, uint8_t value) {
+    put_bytes(w, &value, 1);
+}
+
+static void put_u16(ResultWriter* w, uint16_t value) {
+    uint8_t b[2] = { (uint8_t)value, (uint8_t)(value >> 8) };
+    put_bytes(w, b, sizeof(b));
+}
+
+static void put_u32(ResultWriter* w, uint32_t value) {
+    uint8_t b[4];
+    for (int i = 0; i < 4; i++) {
+        b[i] = (uint8_t)(value >> (8 * i));
+    }
+    put_bytes(w, b, sizeof(b));
+}
+
+static void put_u64(ResultWriter* w, uint64_t value) {
+    uint8_t b[8];
+    for (int i = 0; i < 8; i++) {
+        b[i] = (uint8_t)(value >> (8 * i));
+    }
+    put_bytes(w, b, sizeof(b));
+}
+
+static void put_i32(ResultWriter* w, int value) {
+    put_u32(w, (uint32_t)value);
+}
+
+static void put_f64(ResultWriter* w, double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    put_u64(w, bits);
+}
+
+// Fixed-size char fields are not guaranteed to be terminated, so the length
+// is bounded by the field size.
+static void put_str_n(ResultWriter* w, const char* s, size_t max_len) {
+    size_t len = s ? strnlen(s, max_len) : 0;
+    if (len > 0xFFFF) len = 0xFFFF;
+    put_u16(w, (uint16_t)len);
+    put_bytes(w, s, len);
+}
+
+#define put_field(w, field) put_str_n(w, field, sizeof(field))
+
+static void put_str(ResultWriter* w, const char* s) {
+    put_str_n(w, s, 0xFFFF);
+}
+
+static uint32_t clamp_count(int count, int max_count) {
+    if (count < 0) return 0;
+    return (uint32_t)(count > max_count ? max_count : count);
+}
+
+// Workspace tables live in an arena and have no fixed limit
+static uint32_t table_count(int count) {
+    return count < 0 ? 0 : (uint32_t)count;
+}
+
+// Writes the section frame and returns the offset of its length field so
+// end_section can patch it once the payload is known.
+static size_t begin_section(ResultWriter* w, ResultSection tag, int* section_count) {
+    put_u16(w, (uint16_t)tag);
+    put_u16(w, 0);
+    size_t length_pos = w->pos;
+    put_u32(w, 0);
+    (*section_count)++;
+    return length_pos;
+}
+
+static void end_section(ResultWriter* w, size_t length_pos) {
+    size_t payload = w->pos - length_pos - 4;
+    if (w->data && w->pos <= w->capacity) {
+        size_t saved = w->pos;
+        w->pos = length_pos;
+        put_u32(w, (uint32_t)payload);
+        w->pos = saved;
+    }
+}
+
+static void put_dependencies(ResultWriter* w, const Dependency* items, uint32_t count) {
+    put_u32(w, count);
+    for (uint32_t i = 0; i < count; i++) {
+        put_str(w, string_pool_get(items[i].name));
+        put_str(w, string_pool_get(items[i].version));
+        put_u8(w, items[i].is_dev_dependency ? 1 : 0);
+    }
+}
+
+static void put_dependency_list(ResultWriter* w, const DependencyList* deps) {
+    put_dependencies(w, deps->items, clamp_count(deps->count, MAX_DEPENDENCIES));
+}
+
+static void put_framework_info(ResultWriter* w, const FrameworkInfo* info) {
+    // Declaration order of the FrameworkInfo booleans; bit i is flags[i]
+    const int flags[] = {
+        info->has_react, info->has_vue, info->has_angular, info->has_svelte,
+        info->has_nodejs, info->has_nextjs, info->has_nuxtjs,
+        info->vue_composition_api, info->uses_typescript, info->has_bundler,
+        info->has_testing, info->has_state_management, info->has_routing,
+        info->has_css_framework, info->has_ui_library, info->has_form_library,
+        info->uses_css_modules, info->uses_css_in_js, info->uses_tailwind,
+        info->uses_sass, info->uses_less, info->has_e2e_testing,
+        info->has_unit_testing, info->has_component_testing, info->has_linting,
+        info->has_formatting, info->has_ci_cd, info->has_docker,
+        info->has_deployment_config, info->has_hot_reload, info->has_dev_server,
+        info->has_debug_config, info->uses_npm, info->uses_yarn, info->uses_pnpm
+    };
+    uint64_t bits = 0;
+    for (size_t i = 0; i < sizeof(flags) / sizeof(flags[0]); i++) {
+        if (flags[i]) bits |= (uint64_t)1 << i;
+    }
+    put_u64(w, bits);
+    put_i32(w, info->react_hooks_count);
+    put_field(w, info->typescript_version);
+    put_field(w, info->node_version);
+    put_field(w, info->primary_bundler);
+    put_field(w, info->primary_ui_library);
+    put_field(w, info->css_solution);
+}
+
+static void put_summary(ResultWriter* w, const ProjectType* project) {
+    put_field(w, project->framework);
+
+    put_i32(w, project->html_file_count);
+    put_i32(w, project->css_file_count);
+    put_i32(w, project->js_file_count);
+    put_i32(w, project->json_file_count);
+    put_i32(w, project->ts_file_count);
+    put_i32(w, project->jsx_file_count);
+    put_i32(w, project->vue_file_count);
+    put_i32(w, project->xml_file_count);
+    put_i32(w, project->image_file_count);
+
+    put_i32(w, project->react_component_count);
+    put_i32(w, project->custom_element_count);
+    put_i32(w, project->external_resource_count);
+
+    put_i32(w, project->total_dependencies);
+    put_i32(w, project->dev_dependencies);
+    put_i32(w, project->prod_dependencies);
+    put_i32(w, project->framework_dependencies);
+
+    uint32_t flags = 0;
+    if (project->uses_commonjs) flags |= RESULT_SUMMARY_USES_COMMONJS;
+    if (project->uses_esmodules) flags |= RESULT_SUMMARY_USES_ESMODULES;
+    if (project->has_webpack) flags |= RESULT_SUMMARY_HAS_WEBPACK;
+    if (project->has_vite) flags |= RESULT_SUMMARY_HAS_VITE;
+    if (project->has_babel) flags |= RESULT_SUMMARY_HAS_BABEL;
+    if (project->has_ci) flags |= RESULT_SUMMARY_HAS_CI;
+    if (project->has_env_config) flags |= RESULT_SUMMARY_HAS_ENV_CONFIG;
+    if (project->has_typescript) flags |= RESULT_SUMMARY_HAS_TYPESCRIPT;
+    if (project->is_monorepo) flags |= RESULT_SUMMARY_IS_MONOREPO;
+    if (project->is_incomplete) flags |= RESULT_SUMMARY_IS_INCOMPLETE;
+    put_u32(w, flags);
+
+    put_f64(w, project->coverage);
+}
+
+static void put_parser_totals(ResultWriter* w, const ProjectType* project) {
+    const HTMLInfo* html = &project->total_html_info;
+    put_i32(w, html->tag_count);
+    put_i32(w, html->script_count);
+    put_i32(w, html->style_count);
+    put_i32(w, html->link_count);
+    uint32_t element_count = clamp_count(html->custom_element_count, MAX_CUSTOM_ELEMENTS);
+    put_u32(w, element_count);
+    for (uint32_t i = 0; i < element_count; i++) {
+        put_str(w, string_pool_get(html->custom_elements[i].name));
+        put_i32(w, html->custom_elements[i].count);
+    }
+
+    const CSSInfo* css = &project->total_css_info;
+    put_i32(w, css->rule_count);
+    put_i32(w, css->selector_count);
+    put_i32(w, css->property_count);
+    put_i32(w, css->media_query_count);
+    put_i32(w, css->keyframe_count);
+
+    const JSInfo* js = &project->total_js_info;
+    put_i32(w, js->function_count);
+    put_i32(w, js->variable_count);
+    put_i32(w, js->class_count);
+    put_i32(w, js->react_component_count);
+    put_i32(w, js->vue_instance_count);
+    put_i32(w, js->angular_module_count);
+    put_i32(w, js->event_listener_count);
+    put_i32(w, js->async_function_count);
+    put_i32(w, js->promise_count);
+    put_i32(w, js->closure_count);
+
+    const JSONInfo* json = &project->total_json_info;
+    put_i32(w, json->object_count);
+    put_i32(w, json->array_count);
+    put_i32(w, json->key_count);
+    put_i32(w, json->max_nesting_level);
+
+    const TSInfo* ts = &project->total_ts_info;
+    put_i32(w, ts->interface_count);
+    put_i32(w, ts->type_definition_count);
+    put_i32(w, ts->type_alias_count);
+    put_i32(w, ts->generic_type_count);
+    put_i32(w, ts->enum_count);
+
+    const JSXInfo* jsx = &project->total_jsx_info;
+    put_i32(w, jsx->custom_component_count);
+    put_i32(w, jsx->hook_count);
+    put_i32(w, jsx->prop_spreading_count);
+    put_i32(w, jsx->max_component_nesting);
+
+    const VueInfo* vue = &project->total_vue_info;
+    put_i32(w, vue->has_template);
+    put_i32(w, vue->has_script);
+    put_i32(w, vue->has_style);
+    put_i32(w, vue->uses_script_setup);
+    put_i32(w, vue->uses_scoped_styles);
+    put_i32(w, vue->directive_count);
+    put_i32(w, vue->computed_property_count);
+    put_i32(w, vue->watcher_count);
+    put_i32(w, vue->event_binding_count);
+    put_i32(w, vue->prop_binding_count);
+    put_i32(w, vue->emit_count);
+    put_i32(w, vue->provide_inject_count);
+
+    const XMLInfo* xml = &project->total_xml_info;
+    put_i32(w, xml->element_count);
+    put_i32(w, xml->attribute_count);
+    put_i32(w, xml->namespace_count);
+    put_i32(w, xml->max_nesting_level);
+    put_i32(w, xml->has_xml_declaration);
+}
+
+static void put_external_resources(ResultWriter* w, const ProjectType* project) {
+    uint32_t count = clamp_count(project->external_resource_count, MAX_EXTERNAL_RESOURCES);
+    put_u32(w, count);
+    for (uint32_t i = 0; i < count; i++) {
+        const ExternalResource* resource = &project->external_resources[i];
+        put_field(w, resource->url);
+        put_field(w, resource->type);
+        put_u64(w, (uint64_t)resource->size);
+    }
+}
+
+static void put_module_paths(ResultWriter* w, const ProjectType* project) {
+    uint32_t count = clamp_count(project->module_path_count, MAX_IMPORT_PATHS);
+    put_u32(w, count);
+    for (uint32_t i = 0; i < count; i++) {
+        put_str(w, string_pool_get(project->module_paths[i]));
+    }
+}
+
+static void put_issues(ResultWriter* w, const ProjectType* project) {
+    uint32_t count = clamp_count(project->potential_issue_count, MAX_POTENTIAL_ISSUES);
+    put_u32(w, count);
+    for (uint32_t i = 0; i < count; i++) {
+        put_field(w, project->potential_issues[i].description);
+        put_field(w, project->potential_issues[i].location);
+    }
+}
+
+static void put_package(ResultWriter* w, const Package* pkg) {
+    put_str(w, string_pool_get(pkg->name));
+    put_str(w, string_pool_get(pkg->version));
+    put_str(w, string_pool_get(pkg->path));
+    put_dependencies(w, pkg->dependencies, table_count(pkg->dependency_count));
+    put_framework_info(w, &pkg->framework_info);
+
+    const PackageConfig* config = &pkg->config;
+    uint32_t flags = 0;
+    if (config->has_shared_configs) flags |= RESULT_CONFIG_HAS_SHARED_CONFIGS;
+    if (config->uses_typescript) flags |= RESULT_CONFIG_USES_TYPESCRIPT;
+    if (config->uses_eslint) flags |= RESULT_CONFIG_USES_ESLINT;
+    if (config->uses_prettier) flags |= RESULT_CONFIG_USES_PRETTIER;
+    if (config->uses_jest) flags |= RESULT_CONFIG_USES_JEST;
+    put_u32(w, flags);
+    put_str(w, string_pool_get(config->build_output_path));
+    put_str(w, string_pool_get(config->test_output_path));
+    put_str(w, string_pool_get(config->node_version));
+
+    uint32_t ref_count = table_count(config->ref_count);
+    put_u32(w, ref_count);
+    for (uint32_t i = 0; i < ref_count; i++) {
+        put_str(w, string_pool_get(config->refs[i].source));
+        put_str(w, string_pool_get(config->refs[i].target));
+    }
+
+    uint32_t script_count = table_count(config->script_count);
+    put_u32(w, script_count);
+    for (uint32_t i = 0; i < script_count; i++) {
+        put_str(w, string_pool_get(config->scripts[i].script_name));
+        put_str(w, string_pool_get(config->scripts[i].command));
+    }
+}
+
+static void put_workspace(ResultWriter* w, const WorkspaceInfo* ws) {
+    put_field(w, ws->root_path);
+    put_field(w, ws->name);
+
+    uint32_t flags = 0;
+    if (ws->is_lerna) flags |= RESULT_WORKSPACE_IS_LERNA;
+    if (ws->is_yarn_workspace) flags |= RESULT_WORKSPACE_IS_YARN_WORKSPACE;
+    if (ws->is_pnpm_workspace) flags |= RESULT_WORKSPACE_IS_PNPM_WORKSPACE;
+    if (ws->is_nx_workspace) flags |= RESULT_WORKSPACE_IS_NX_WORKSPACE;
+    if (ws->is_rush) flags |= RESULT_WORKSPACE_IS_RUSH;
+    if (ws->has_hoisting) flags |= RESULT_WORKSPACE_HAS_HOISTING;
+    if (ws->has_workspaces_prefix) flags |= RESULT_WORKSPACE_HAS_WORKSPACES_PREFIX;
+    if (ws->uses_npm_workspaces) flags |= RESULT_WORKSPACE_USES_NPM_WORKSPACES;
+    if (ws->uses_changesets) flags |= RESULT_WORKSPACE_USES_CHANGESETS;
+    if (ws->uses_turborepo) flags |= RESULT_WORKSPACE_USES_TURBOREPO;
+    if (ws->has_shared_configs) flags |= RESULT_WORKSPACE_HAS_SHARED_CONFIGS;
+    if (ws->uses_conventional_commits) flags |= RESULT_WORKSPACE_USES_CONVENTIONAL_COMMITS;
+    if (ws->uses_git_tags) flags |= RESULT_WORKSPACE_USES_GIT_TAGS;
+    if (ws->uses_semantic_release) flags |= RESULT_WORKSPACE_USES_SEMANTIC_RELEASE;
+    put_u32(w, flags);
+
+    put_field(w, ws->build_cache_path);
+    put_field(w, ws->tsconfig_path);
+    put_field(w, ws->eslint_config_path);
+    put_field(w, ws->prettier_config_path);
+    put_field(w, ws->jest_config_path);
+    put_field(w, ws->babel_config_path);
+    put_field(w, ws->version_strategy);
+
+    uint32_t glob_count = table_count(ws->workspace_count);
+    put_u32(w, glob_count);
+    for (uint32_t i = 0; i < glob_count; i++) {
+        put_str(w, string_pool_get(ws->workspace_globs[i]));
+    }
+
+    put_dependency_list(w, &ws->shared_dependencies);
+
+    uint32_t package_count = table_count(ws->package_count);
+    put_u32(w, package_count);
+    for (uint32_t i = 0; i < package_count; i++) {
+        put_package(w, &ws->packages[i]);
+    }
+
+    uint32_t group_count = table_count(ws->task_group_count);
+    put_u32(w, group_count);
+    for (uint32_t i = 0; i < group_count; i++) {
+        const TaskGroup* group = &ws->task_groups[i];
+        put_field(w, group->name);
+        put_field(w, group->type);
+        uint32_t member_count = table_count(group->package_count);
+        put_u32(w, member_count);
+        for (uint32_t j = 0; j < member_count; j++) {
+            put_str(w, string_pool_get(group->packages[j]));
+        }
+    }
+}
+
+static void put_package_summaries(ResultWriter* w, const WorkspaceInfo* ws) {
+    uint32_t package_count = table_count(ws->package_count);
+    put_u32(w, package_count);
+    for (uint32_t i = 0; i < package_count; i++) {
+        const PackageSummary* summary = &ws->packages[i].summary;
+        put_i32(w, summary->file_count);
+        put_i32(w, summary->directory_count);
+        put_u64(w, (uint64_t)summary->bytes);
+        put_i32(w, summary->html_file_count);
+        put_i32(w, summary->css_file_count);
+        put_i32(w, summary->js_file_count);
+        put_i32(w, summary->json_file_count);
+        put_i32(w, summary->ts_file_count);
+        put_i32(w, summary->jsx_file_count);
+        put_i32(w, summary->vue_file_count);
+        put_i32(w, summary->xml_file_count);
+        put_i32(w, summary->image_file_count);
+        put_i32(w, summary->react_component_count);
+        put_i32(w, summary->function_count);
+        put_field(w, summary->framework);
+        put_u8(w, summary->is_incomplete ? 1 : 0);
+        put_f64(w, summary->coverage);
+    }
+}
+
+static void put_build_graph(ResultWriter* w, const BuildGraphInfo* graph) {
+    put_i32(w, graph->level_count);
+    put_i32(w, graph->max_parallelism);
+    put_i32(w, graph->blocked_count);
+    put_u64(w, (uint64_t)graph->critical_path_bytes);
+
+    uint32_t path_length = table_count(graph->critical_path_length);
+    put_u32(w, path_length);
+    for (uint32_t i = 0; i < path_length; i++) {
+        put_str(w, string_pool_get(graph->critical_path[i]));
+    }
+
+    uint32_t cycle_count = table_count(graph->cycle_count);
+    put_u32(w, cycle_count);
+    for (uint32_t c = 0; c < cycle_count; c++) {
+        int start = graph->cycle_start[c];
+        put_u32(w, table_count(graph->cycle_start[c + 1] - start));
+        for (int i = start; i < graph->cycle_start[c + 1]; i++) {
+            put_str(w, string_pool_get(graph->cycle_packages[i]));
+        }
+    }
+}
+
+static void put_lockfile(ResultWriter* w, const LockfileSummary* lockfile) {
+    put_field(w, lockfile->kind);
+    put_i32(w, lockfile->lockfile_version);
+    put_u64(w, (uint64_t)lockfile->bytes);
+    put_i32(w, lockfile->package_count);
+    put_i32(w, lockfile->unique_package_count);
+    put_i32(w, lockfile->dev_package_count);
+    put_i32(w, lockfile->edge_count);
+    put_i32(w, lockfile->resolved_edge_count);
+    put_i32(w, lockfile->duplicate_package_count);
+
+    uint32_t count = table_count(lockfile->duplicate_count);
+    put_u32(w, count);
+    for (uint32_t i = 0; i < count; i++) {
+        put_str(w, string_pool_get(lockfile->duplicates[i].name));
+        put_i32(w, lockfile->duplicates[i].version_count);
+        put_i32(w, lockfile->duplicates[i].install_count);
+    }
+}
+
+static void write_result(ResultWriter* w, const ProjectType* project) {
+    int section_count = 0;
+    size_t section;
+
+    put_u32(w, RESULT_FORMAT_MAGIC);
+    put_u16(w, RESULT_FORMAT_VERSION);
+    size_t section_count_pos = w->pos;
+    put_u16(w, 0);
+    size_t total_length_pos = w->pos;
+    put_u32(w, 0);
+    put_u32(w, 0);
+
+    section = begin_section(w, RESULT_SECTION_SUMMARY, &section_count);
+    put_summary(w, project);
+    end_section(w, section);
+
+    section = begin_section(w, RESULT_SECTION_FRAMEWORK, &section_count);
+    put_framework_info(w, &project->framework_info);
+    end_section(w, section);
+
+    section = begin_section(w, RESULT_SECTION_PARSER_TOTALS, &section_count);
+    put_parser_totals(w, project);
+    end_section(w, section);
+
+    section = begin_section(w, RESULT_SECTION_DEPENDENCIES, &section_count);
+    put_dependency_list(w, &project->dependencies);
+    end_section(w, section);
+
+    section = begin_section(w, RESULT_SECTION_EXTERNAL_RESOURCES, &section_count);
+    put_external_resources(w, project);
+    end_section(w, section);
+
+    section = begin_section(w, RESULT_SECTION_MODULE_PATHS, &section_count);
+    put_module_paths(w, project);
+    end_section(w, section);
+
+    section = begin_section(w, RESULT_SECTION_ISSUES, &section_count);
+    put_issues(w, project);
+    end_section(w, section);
+
+    if (project->lockfile.kind[0]) {
+        section = begin_section(w, RESULT_SECTION_LOCKFILE, &section_count);
+        put_lockfile(w, &project->lockfile);
+        end_section(w, section);
+    }
+
+    if (project->is_monorepo) {
+        section = begin_section(w, RESULT_SECTION_WORKSPACE, &section_count);
+        put_workspace(w, &project->workspace);
+        end_section(w, section);
+
+        section = begin_section(w, RESULT_SECTION_PACKAGES, &section_count);
+        put_package_summaries(w, &project->workspace);
+        end_section(w, section);
+
+        section = begin_section(w, RESULT_SECTION_BUILD_GRAPH, &section_count);
+        put_build_graph(w, &project->workspace.build_graph);
+        end_section(w, section);
+    }
+
+    if (w->data && w->pos <= w->capacity) {
+        size_t total = w->pos;
+        w->pos = section_count_pos;
+        put_u16(w, (uint16_t)section_count);
+        w->pos = total_length_pos;
+        put_u32(w, (uint32_t)total);
+        w->pos = total;
+    }
+}
+
+size_t result_format_size(const ProjectType* project) {
+    if (!project) return 0;
+
+    ResultWriter counter = { NULL, 0, 0 };
+    write_result(&counter, project);
+    return counter.pos;
+}
+
+size_t result_format_write(const ProjectType* project, void* out, size_t capacity) {
+    if (!project || !out) return 0;
+
+    ResultWriter writer = { (uint8_t*)out, capacity, 0 };
+    write_result(&writer, project);
+    if (writer.pos > capacity) {
+        return 0;
+    }
+    return writer.pos;
+}
@@ -0,0 +1,172 @@
+#ifndef WEB_RESULT_FORMAT_H
+#define WEB_RESULT_FORMAT_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "web_resource_analyzer.h"
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Flat binary encoding of a ProjectType, written in one pass so a host can
+// receive a whole result in a single buffer and decode only what it reads.
+//
+// All integers are little-endian. Strings are a u16 byte length followed by
+// UTF-8 bytes without a terminator. Lists are a u32 element count followed by
+// the elements.
+//
+// Header (16 bytes):
+//   u32 magic          RESULT_FORMAT_MAGIC ("WPFR")
+//   u16 version        RESULT_FORMAT_VERSION
+//   u16 section_count
+//   u32 total_length   Including the header
+//   u32 reserved       0
+//
+// Sections follow back to back, each framed as:
+//   u16 tag, u16 reserved, u32 payload_length, payload
+// Readers skip sections with unknown tags by payload_length, so sections can
+// be added without bumping the version. The payloads are:
+//
+// SUMMARY
+//   str framework
+//   i32 html, css, js, json, ts, jsx, vue, xml, image file counts
+//   i32 react_component_count, custom_element_count, external_resource_count
+//   i32 total_dependencies, dev_dependencies, prod_dependencies,
+//       framework_dependencies
+//   u32 flags          RESULT_SUMMARY_* bits
+//   f64 coverage
+//
+// FRAMEWORK            framework block:
+//   u64 flags          FrameworkInfo booleans in declaration order, bit 0 first
+//   i32 react_hooks_count
+//   str typescript_version, node_version, primary_bundler,
+//       primary_ui_library, css_solution
+//
+// PARSER_TOTALS
+//   i32 html tag, script, style, link counts
+//   list of { str name, i32 count } html custom elements
+//   i32 css rule, selector, property, media_query, keyframe counts
+//   i32 js function, variable, class, react_component, vue_instance,
+//       angular_module, event_listener, async_function, promise, closure
+//   i32 json object, array, key, max_nesting_level
+//   i32 ts interface, type_definition, type_alias, generic_type, enum
+//   i32 jsx custom_component, hook, prop_spreading, max_component_nesting
+//   i32 vue has_template, has_script, has_style, uses_script_setup,
+//       uses_scoped_styles, directive, computed_property, watcher,
+//       event_binding, prop_binding, emit, provide_inject
+//   i32 xml element, attribute, namespace, max_nesting_level,
+//       has_xml_declaration
+//
+// DEPENDENCIES         dependency list: list of { str name, str version, u8 dev }
+// EXTERNAL_RESOURCES   list of { str url, str type, i64 size }
+// MODULE_PATHS         list of str
+// ISSUES               list of { str description, str location }
+//
+// WORKSPACE            present only for monorepos
+//   str root_path, name
+//   u32 flags          RESULT_WORKSPACE_* bits
+//   str build_cache_path, tsconfig_path, eslint_config_path,
+//       prettier_config_path, jest_config_path, babel_config_path,
+//       version_strategy
+//   list of str workspace globs
+//   dependency list of shared dependencies
+//   list of packages:
+//     str name, version, path
+//     dependency list
+//     framework block
+//     u32 config flags  RESULT_CONFIG_* bits
+//     str build_output_path, test_output_path, node_version
+//     list of { str source, str target } references
+//     list of { str name, str command } scripts
+//   list of task groups: { str name, str type, list of str packages }
+//
+// PACKAGES             present only for monorepos, in WORKSPACE package order
+//   list of package source summaries:
+//     i32 file_count, directory_count
+//     i64 bytes
+//     i32 html, css, js, json, ts, jsx, vue, xml, image file counts
+//     i32 react_component_count, function_count
+//     str framework
+//     u8 incomplete
+//     f64 coverage
+//
+// BUILD_GRAPH          present only for monorepos
+//   i32 level_count, max_parallelism, blocked_count
+//   i64 critical_path_bytes
+//   list of str critical path packages, first built first
+//   list of cycles: list of str packages
+//
+// LOCKFILE             present only when the project root has a lockfile
+//   str kind           "npm", "yarn" or "pnpm"
+//   i32 lockfile_version
+//   i64 bytes
+//   i32 package_count, unique_package_count, dev_package_count, edge_count,
+//       resolved_edge_count, duplicate_package_count
+//   list of { str name, i32 version_count, i32 install_count } duplicates,
+//       most versions first, at most MAX_LOCKFILE_DUPLICATES
+
+#define RESULT_FORMAT_MAGIC 0x52465057u
+#define RESULT_FORMAT_VERSION 1
+#define RESULT_FORMAT_HEADER_SIZE 16
+#define RESULT_SECTION_HEADER_SIZE 8
+
+typedef enum {
+    RESULT_SECTION_SUMMARY = 1,
+    RESULT_SECTION_FRAMEWORK = 2,
+    RESULT_SECTION_PARSER_TOTALS = 3,
+    RESULT_SECTION_DEPENDENCIES = 4,
+    RESULT_SECTION_EXTERNAL_RESOURCES = 5,
+    RESULT_SECTION_MODULE_PATHS = 6,
+    RESULT_SECTION_ISSUES = 7,
+    RESULT_SECTION_WORKSPACE = 8,
+    RESULT_SECTION_PACKAGES = 9,
+    RESULT_SECTION_BUILD_GRAPH = 10,
+    RESULT_SECTION_LOCKFILE = 11
+} ResultSection;
+
+// SUMMARY flags
+#define RESULT_SUMMARY_USES_COMMONJS   (1u << 0)
+#define RESULT_SUMMARY_USES_ESMODULES  (1u << 1)
+#define RESULT_SUMMARY_HAS_WEBPACK     (1u << 2)
+#define RESULT_SUMMARY_HAS_VITE        (1u << 3)
+#define RESULT_SUMMARY_HAS_BABEL       (1u << 4)
+#define RESULT_SUMMARY_HAS_CI          (1u << 5)
+#define RESULT_SUMMARY_HAS_ENV_CONFIG  (1u << 6)
+#define RESULT_SUMMARY_HAS_TYPESCRIPT  (1u << 7)
+#define RESULT_SUMMARY_IS_MONOREPO     (1u << 8)
+#define RESULT_SUMMARY_IS_INCOMPLETE   (1u << 9)
+
+// WORKSPACE flags
+#define RESULT_WORKSPACE_IS_LERNA                  (1u << 0)
+#define RESULT_WORKSPACE_IS_YARN_WORKSPACE         (1u << 1)
+#define RESULT_WORKSPACE_IS_PNPM_WORKSPACE         (1u << 2)
+#define RESULT_WORKSPACE_IS_NX_WORKSPACE           (1u << 3)
+#define RESULT_WORKSPACE_IS_RUSH                   (1u << 4)
+#define RESULT_WORKSPACE_HAS_HOISTING              (1u << 5)
+#define RESULT_WORKSPACE_HAS_WORKSPACES_PREFIX     (1u << 6)
+#define RESULT_WORKSPACE_USES_NPM_WORKSPACES       (1u << 7)
+#define RESULT_WORKSPACE_USES_CHANGESETS           (1u << 8)
+#define RESULT_WORKSPACE_USES_TURBOREPO            (1u << 9)
+#define RESULT_WORKSPACE_HAS_SHARED_CONFIGS        (1u << 10)
+#define RESULT_WORKSPACE_USES_CONVENTIONAL_COMMITS (1u << 11)
+#define RESULT_WORKSPACE_USES_GIT_TAGS             (1u << 12)
+#define RESULT_WORKSPACE_USES_SEMANTIC_RELEASE     (1u << 13)
+
+// Package config flags
+#define RESULT_CONFIG_HAS_SHARED_CONFIGS (1u << 0)
+#define RESULT_CONFIG_USES_TYPESCRIPT    (1u << 1)
+#define RESULT_CONFIG_USES_ESLINT        (1u << 2)
+#define RESULT_CONFIG_USES_PRETTIER      (1u << 3)
+#define RESULT_CONFIG_USES_JEST          (1u << 4)
+
+// Number of bytes result_format_write needs for this project
+EXPORT size_t result_format_size(const ProjectType* project);
+
+// Encodes the project into out. Returns the number of bytes written, or 0 if
+// capacity is smaller than result_format_size(project).
+EXPORT size_t result_format_write(const ProjectType* project, void* out, size_t capacity);
+
+#endif // WEB_RESULT_FORMAT_H
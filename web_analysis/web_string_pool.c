@@ -0,0 +1,298 @@
+#include "web_string_pool.h"
+#include "web_log.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+static SRWLOCK pool_lock = SRWLOCK_INIT;
+#define POOL_LOCK() AcquireSRWLockExclusive(&pool_lock)
+#define POOL_UNLOCK() ReleaseSRWLockExclusive(&pool_lock)
+#else
+#include <pthread.h>
+static pthread_mutex_t pool_lock = PTHREAD_MUTEX_INITIALIZER;
+#define POOL_LOCK() pthread_mutex_lock(&pool_lock)
+#define POOL_UNLOCK() pthread_mutex_unlock(&pool_lock)
+#endif
+
+// Entries live in fixed pages that are never moved, so readers can resolve
+// IDs without taking the lock while other threads keep interning. Page
+// pointers are published with release stores and read with acquire loads; the
+// pages go away only when the pool is emptied, which waits for every holder.
+#ifdef _MSC_VER
+#define PAGE_LOAD(slot) ((PoolEntry*)InterlockedCompareExchangePointer((PVOID volatile*)(slot), NULL, NULL))
+#define PAGE_STORE(slot, page) InterlockedExchangePointer((PVOID volatile*)(slot), (page))
+#else
+#define PAGE_LOAD(slot) __atomic_load_n((slot), __ATOMIC_ACQUIRE)
+#define PAGE_STORE(slot, page) __atomic_store_n((slot), (page), __ATOMIC_RELEASE)
+#endif
+
+#define POOL_PAGE_BITS 12
+#define POOL_PAGE_SIZE (1u << POOL_PAGE_BITS)
+#define POOL_MAX_PAGES 4096
+#define POOL_BLOCK_SIZE (64 * 1024)
+#define POOL_INITIAL_SLOTS 1024
+
+typedef struct {
+    const char* str;
+    uint32_t length;
+    uint32_t hash;
+} PoolEntry;
+
+typedef struct PoolBlock {
+    struct PoolBlock* next;
+    size_t used;
+    size_t capacity;
+    char data[];
+} PoolBlock;
+
+typedef struct {
+    PoolEntry* pages[POOL_MAX_PAGES];
+    uint32_t count;          // Next ID to hand out (ID 0 is the empty string)
+    StringId* slots;         // Open-addressed hash table of IDs, 0 = free
+    uint32_t slot_capacity;
+    PoolBlock* blocks;
+    size_t bytes;
+    size_t failed;           // Interns that returned STRING_ID_EMPTY for a real string
+    size_t holders;          // string_pool_retain calls not yet released
+} StringPool;
+
+static StringPool pool = {0};
+static size_t pool_limit = STRING_POOL_DEFAULT_LIMIT;  // Guarded by the lock
+
+static uint32_t hash_string(const char* str, size_t length) {
+    // FNV-1a
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; i++) {
+        hash ^= (unsigned char)str[i];
+        hash *= 16777619u;
+    }
+    return hash;
+}
+
+static PoolEntry* entry_for(StringId id) {
+    PoolEntry* page = PAGE_LOAD(&pool.pages[id >> POOL_PAGE_BITS]);
+    return page ? &page[id & (POOL_PAGE_SIZE - 1)] : NULL;
+}
+
+static char* store_characters(const char* str, size_t length) {
+    PoolBlock* block = pool.blocks;
+    if (!block || block->capacity - block->used < length + 1) {
+        size_t capacity = (length + 1 > POOL_BLOCK_SIZE) ? length + 1 : POOL_BLOCK_SIZE;
+        block = (PoolBlock*)malloc(sizeof(PoolBlock) + capacity);
+        if (!block) return NULL;
+        block->used = 0;
+        block->capacity = capacity;
+        block->next = pool.blocks;
+        pool.blocks = block;
+        pool.bytes += sizeof(PoolBlock) + capacity;
+    }
+
+    char* dest = block->data + block->used;
+    memcpy(dest, str, length);
+    dest[length] = '\0';
+    block->used += length + 1;
+    return dest;
+}
+
+static int grow_slots(void) {
+    uint32_t new_capacity = pool.slot_capacity ? pool.slot_capacity * 2 : POOL_INITIAL_SLOTS;
+    StringId* new_slots = (StringId*)calloc(new_capacity, sizeof(StringId));
+    if (!new_slots) return 0;
+
+    for (uint32_t i = 0; i < pool.slot_capacity; i++) {
+        StringId id = pool.slots[i];
+        if (id == STRING_ID_EMPTY) continue;
+        uint32_t slot = entry_for(id)->hash & (new_capacity - 1);
+        while (new_slots[slot] != STRING_ID_EMPTY) {
+            slot = (slot + 1) & (new_capacity - 1);
+        }
+        new_slots[slot] = id;
+    }
+
+    pool.bytes += (size_t)(new_capacity - pool.slot_capacity) * sizeof(StringId);
+    free(pool.slots);
+    pool.slots = new_slots;
+    pool.slot_capacity = new_capacity;
+    return 1;
+}
+
+// Must be called with the lock held. Returns the slot holding the string or
+// the free slot where it belongs.
+static uint32_t probe(const char* str, size_t length, uint32_t hash) {
+    uint32_t slot = hash & (pool.slot_capacity - 1);
+    while (pool.slots[slot] != STRING_ID_EMPTY) {
+        const PoolEntry* entry = entry_for(pool.slots[slot]);
+        if (entry->hash == hash && entry->length == length &&
+            memcmp(entry->str, str, length) == 0) {
+            break;
+        }
+        slot = (slot + 1) & (pool.slot_capacity - 1);
+    }
+    return slot;
+}
+
+// Must be called with the lock held. Sets *failure to the reason when the
+// string cannot be stored and STRING_ID_EMPTY comes back instead.
+static StringId intern_locked(const char* str, size_t length, uint32_t hash, const char** failure) {
+    // Keep the table at most half full
+    if ((pool.count + 1) * 2 >= pool.slot_capacity && !grow_slots()) {
+        *failure = "failed to grow hash table";
+        return STRING_ID_EMPTY;
+    }
+    if (pool.count == 0) pool.count = 1;
+
+    uint32_t slot = probe(str, length, hash);
+    if (pool.slots[slot] != STRING_ID_EMPTY) return pool.slots[slot];
+
+    uint32_t page_index = pool.count >> POOL_PAGE_BITS;
+    if (page_index >= POOL_MAX_PAGES) {
+        *failure = "capacity exhausted";
+        return STRING_ID_EMPTY;
+    }
+    if (!pool.pages[page_index]) {
+        PoolEntry* page = (PoolEntry*)calloc(POOL_PAGE_SIZE, sizeof(PoolEntry));
+        if (!page) {
+            *failure = "failed to allocate an entry page";
+            return STRING_ID_EMPTY;
+        }
+        PAGE_STORE(&pool.pages[page_index], page);
+        pool.bytes += POOL_PAGE_SIZE * sizeof(PoolEntry);
+    }
+
+    char* stored = store_characters(str, length);
+    if (!stored) {
+        *failure = "failed to allocate characters";
+        return STRING_ID_EMPTY;
+    }
+
+    StringId id = pool.count++;
+    PoolEntry* entry = entry_for(id);
+    entry->str = stored;
+    entry->length = (uint32_t)length;
+    entry->hash = hash;
+    pool.slots[slot] = id;
+    return id;
+}
+
+EXPORT StringId string_pool_intern_n(const char* str, size_t length) {
+    if (!str || length == 0) return STRING_ID_EMPTY;
+    if (length > STRING_POOL_MAX_LENGTH) length = STRING_POOL_MAX_LENGTH;
+
+    uint32_t hash = hash_string(str, length);
+    const char* failure = NULL;
+
+    POOL_LOCK();
+    StringId id = intern_locked(str, length, hash, &failure);
+    int first_failure = failure && pool.failed++ == 0;
+    uint32_t count = pool.count;
+    POOL_UNLOCK();
+
+    // The string reads as "" wherever it was meant to be stored, so the first
+    // failure is logged; all are counted. Logged unlocked, since the sink may
+    // intern or resolve strings itself.
+    if (first_failure) {
+        LOG_WARN(LOG_CAT_CORE, "String pool: %s at %u strings; \"%.*s\" and later failures read as empty",
+                 failure, count, (int)(length > 64 ? 64 : length), str);
+    }
+    return id;
+}
+
+EXPORT StringId string_pool_intern(const char* str) {
+    if (!str) return STRING_ID_EMPTY;
+    return string_pool_intern_n(str, strlen(str));
+}
+
+EXPORT StringId string_pool_find(const char* str) {
+    if (!str || !*str) return STRING_ID_EMPTY;
+
+    size_t length = strlen(str);
+    if (length > STRING_POOL_MAX_LENGTH) length = STRING_POOL_MAX_LENGTH;
+    uint32_t hash = hash_string(str, length);
+
+    POOL_LOCK();
+    StringId id = STRING_ID_EMPTY;
+    if (pool.slot_capacity > 0) {
+        id = pool.slots[probe(str, length, hash)];
+    }
+    POOL_UNLOCK();
+    return id;
+}
+
+EXPORT const char* string_pool_get(StringId id) {
+    if (id == STRING_ID_EMPTY || (id >> POOL_PAGE_BITS) >= POOL_MAX_PAGES) return "";
+    const PoolEntry* entry = entry_for(id);
+    return (entry && entry->str) ? entry->str : "";
+}
+
+// Lock held, no holders. Frees every page, block and the hash table; IDs
+// start over from 1.
+static void empty_pool_locked(void) {
+    for (int i = 0; i < POOL_MAX_PAGES; i++) {
+        PoolEntry* page = pool.pages[i];
+        if (!page) continue;
+        PAGE_STORE(&pool.pages[i], (PoolEntry*)NULL);
+        free(page);
+    }
+    while (pool.blocks) {
+        PoolBlock* next = pool.blocks->next;
+        free(pool.blocks);
+        pool.blocks = next;
+    }
+    free(pool.slots);
+    pool.slots = NULL;
+    pool.slot_capacity = 0;
+    pool.count = 0;
+    pool.bytes = 0;
+}
+
+EXPORT void string_pool_retain(void) {
+    POOL_LOCK();
+    pool.holders++;
+    POOL_UNLOCK();
+}
+
+EXPORT void string_pool_release(void) {
+    uint32_t strings = 0;
+    size_t bytes = 0;
+
+    POOL_LOCK();
+    if (pool.holders > 0 && --pool.holders == 0 && pool_limit > 0 && pool.bytes > pool_limit) {
+        strings = pool.count ? pool.count - 1 : 0;
+        bytes = pool.bytes;
+        empty_pool_locked();
+    }
+    POOL_UNLOCK();
+
+    if (bytes > 0) {
+        LOG_DEBUG(LOG_CAT_CORE, "String pool emptied: %u strings, %zu bytes", strings, bytes);
+    }
+}
+
+EXPORT void string_pool_set_limit(size_t bytes) {
+    POOL_LOCK();
+    pool_limit = bytes;
+    POOL_UNLOCK();
+}
+
+EXPORT size_t string_pool_count(void) {
+    POOL_LOCK();
+    size_t count = pool.count ? pool.count - 1 : 0;
+    POOL_UNLOCK();
+    return count;
+}
+
+EXPORT size_t string_pool_memory_usage(void) {
+    POOL_LOCK();
+    size_t bytes = pool.bytes;
+    POOL_UNLOCK();
+    return bytes;
+}
+
+EXPORT size_t string_pool_failed_count(void) {
+    POOL_LOCK();
+    size_t failed = pool.failed;
+    POOL_UNLOCK();
+    return failed;
+}
@@ -0,0 +1,62 @@
+#ifndef WEB_STRING_POOL_H
+#define WEB_STRING_POOL_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Interned string handle. Dependency names, element names, module paths and
+// package references are stored as IDs so tables compare by integer and each
+// distinct string is kept exactly once.
+typedef uint32_t StringId;
+
+// ID 0 is reserved for the empty string, so zero-initialized structs resolve
+// to "" without touching the pool.
+#define STRING_ID_EMPTY 0
+
+// Longest string the pool will store; longer input is truncated.
+#define STRING_POOL_MAX_LENGTH 4095
+
+// Default size past which an idle pool is emptied (see string_pool_release)
+#define STRING_POOL_DEFAULT_LIMIT (64 * 1024 * 1024)
+
+// Interning is thread-safe. The pool is process-wide and costs about 24 bytes
+// of entry and hash slots per string plus its characters. Past 16M strings
+// (4096 pages of 4096), or when memory runs out, interning returns
+// STRING_ID_EMPTY so the string reads as ""; the first such failure is logged
+// and all are counted in string_pool_failed_count.
+EXPORT StringId string_pool_intern(const char* str);
+EXPORT StringId string_pool_intern_n(const char* str, size_t length);
+
+// IDs stay valid while the pool is held. Every analysis result holds it from
+// creation until free_project_type, and so does a ContentCache until it is
+// destroyed, so results of one analysis can still be read after the next one
+// starts. Code that interns or resolves IDs outside of those holds it itself.
+// When the last holder releases a pool grown past its limit, the pool is
+// emptied and IDs start over, which keeps a long-lived host analyzing many
+// unrelated projects bounded by what its live results need.
+EXPORT void string_pool_retain(void);
+EXPORT void string_pool_release(void);
+
+// 0 never empties the pool. Defaults to STRING_POOL_DEFAULT_LIMIT.
+EXPORT void string_pool_set_limit(size_t bytes);
+
+// Returns the ID of an already interned string, or STRING_ID_EMPTY if the
+// string has never been interned. Never inserts.
+EXPORT StringId string_pool_find(const char* str);
+
+// Resolves an ID back to its characters. Unknown IDs resolve to "".
+EXPORT const char* string_pool_get(StringId id);
+
+// Pool statistics
+EXPORT size_t string_pool_count(void);
+EXPORT size_t string_pool_memory_usage(void);
+// Interns that could not store their string and returned STRING_ID_EMPTY
+EXPORT size_t string_pool_failed_count(void);
+
+#endif // WEB_STRING_POOL_H
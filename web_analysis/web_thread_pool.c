@@ -0,0 +1,614 @@
+#include "web_thread_pool.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <windows.h>
+#include <process.h>
+typedef HANDLE pool_thread_t;
+typedef SRWLOCK pool_mutex_t;
+typedef CONDITION_VARIABLE pool_cond_t;
+#define POOL_MUTEX_INIT SRWLOCK_INIT
+#define mutex_init(m) InitializeSRWLock(m)
+#define mutex_destroy(m) ((void)(m))
+#define mutex_lock(m) AcquireSRWLockExclusive(m)
+#define mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#define cond_init(c) InitializeConditionVariable(c)
+#define cond_destroy(c) ((void)(c))
+#define cond_wait(c, m) SleepConditionVariableSRW(c, m, INFINITE, 0)
+#define cond_signal(c) WakeConditionVariable(c)
+#define cond_broadcast(c) WakeAllConditionVariable(c)
+#else
+#include <pthread.h>
+#include <unistd.h>
+typedef pthread_t pool_thread_t;
+typedef pthread_mutex_t pool_mutex_t;
+typedef pthread_cond_t pool_cond_t;
+#define POOL_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define mutex_init(m) pthread_mutex_init(m, NULL)
+#define mutex_destroy(m) pthread_mutex_destroy(m)
+#define mutex_lock(m) pthread_mutex_lock(m)
+#define mutex_unlock(m) pthread_mutex_unlock(m)
+#define cond_init(c) pthread_cond_init(c, NULL)
+#define cond_destroy(c) pthread_cond_destroy(c)
+#define cond_wait(c, m) pthread_cond_wait(c, m)
+#define cond_signal(c) pthread_cond_signal(c)
+#define cond_broadcast(c) pthread_cond_broadcast(c)
+#endif
+
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+#else
+#define THREAD_LOCAL __thread
+#endif
+
+// Atomic helpers. Everything is sequentially consistent, which keeps the
+// deque and the sleep/wake handshake simple to reason about.
+#ifdef _MSC_VER
+static __forceinline long long load_i64(volatile long long* p) { return InterlockedCompareExchange64(p, 0, 0); }
+static __forceinline void store_i64(volatile long long* p, long long v) { InterlockedExchange64(p, v); }
+static __forceinline int cas_i64(volatile long long* p, long long expected, long long desired) {
+    return InterlockedCompareExchange64(p, desired, expected) == expected;
+}
+static __forceinline void* load_ptr(void* volatile* p) { return InterlockedCompareExchangePointer(p, NULL, NULL); }
+static __forceinline void store_ptr(void* volatile* p, void* v) { InterlockedExchangePointer(p, v); }
+static __forceinline long load_long(volatile long* p) { return InterlockedCompareExchange(p, 0, 0); }
+static __forceinline void store_long(volatile long* p, long v) { InterlockedExchange(p, v); }
+static __forceinline long add_long(volatile long* p, long v) { return InterlockedExchangeAdd(p, v) + v; }
+#define full_fence() MemoryBarrier()
+#else
+static inline long long load_i64(volatile long long* p) { return __atomic_load_n(p, __ATOMIC_SEQ_CST); }
+static inline void store_i64(volatile long long* p, long long v) { __atomic_store_n(p, v, __ATOMIC_SEQ_CST); }
+static inline int cas_i64(volatile long long* p, long long expected, long long desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+static inline void* load_ptr(void* volatile* p) { return __atomic_load_n(p, __ATOMIC_SEQ_CST); }
+static inline void store_ptr(void* volatile* p, void* v) { __atomic_store_n(p, v, __ATOMIC_SEQ_CST); }
+static inline long load_long(volatile long* p) { return __atomic_load_n(p, __ATOMIC_SEQ_CST); }
+static inline void store_long(volatile long* p, long v) { __atomic_store_n(p, v, __ATOMIC_SEQ_CST); }
+static inline long add_long(volatile long* p, long v) { return __atomic_add_fetch(p, v, __ATOMIC_SEQ_CST); }
+#define full_fence() __atomic_thread_fence(__ATOMIC_SEQ_CST)
+#endif
+
+#define DEQUE_INITIAL_CAPACITY 256
+// Workers run whole analyses during a batch, so give them a roomy stack
+#define WORKER_STACK_SIZE (8 * 1024 * 1024)
+#define CACHE_LINE_SIZE 64
+
+typedef struct PoolTask {
+    ThreadPoolTask fn;
+    void* arg;
+    TaskCounter* counter;
+    struct PoolTask* next;   // Injection queue link
+} PoolTask;
+
+// The counter sits next to the task so a waiter can tell whether a slot
+// belongs to it without touching a task another thread may be freeing
+typedef struct {
+    void* volatile task;
+    void* volatile counter;
+} DequeSlot;
+
+typedef struct DequeBuffer {
+    long long capacity;              // Always a power of two
+    struct DequeBuffer* retired;     // Older buffer, freed with the pool
+    DequeSlot slots[];
+} DequeBuffer;
+
+// Chase-Lev work-stealing deque. The owning worker pushes and pops at the
+// bottom; any other thread steals from the top.
+typedef struct {
+    volatile long long top;
+    char pad_top[CACHE_LINE_SIZE - sizeof(long long)];
+    volatile long long bottom;
+    char pad_bottom[CACHE_LINE_SIZE - sizeof(long long)];
+    void* volatile buffer;
+} WorkDeque;
+
+typedef struct {
+    ThreadPool* pool;
+    int index;
+    unsigned int seed;
+    pool_thread_t thread;
+    WorkDeque deque;
+} PoolWorker;
+
+struct ThreadPool {
+    PoolWorker* workers;
+    int deque_count;         // Fixed once workers start; thieves scan these
+    int worker_count;
+    int started_count;
+
+    pool_mutex_t lock;       // Guards the injection queue, sleeping workers and waiters
+    pool_cond_t wake;
+    pool_cond_t done;        // Broadcast when a counter with waiters drops to zero
+    PoolTask* inject_head;
+    PoolTask* inject_tail;
+
+    volatile long queued;    // Tasks sitting in any queue
+    volatile long sleeping;
+    volatile long waiting;   // Threads blocked in thread_pool_wait
+    volatile long shutdown;
+};
+
+static THREAD_LOCAL PoolWorker* current_worker = NULL;
+
+static volatile long configured_worker_count = 0;
+static pool_mutex_t shared_pool_lock = POOL_MUTEX_INIT;
+static ThreadPool* shared_pool = NULL;
+
+static DequeBuffer* deque_buffer_create(long long capacity) {
+    DequeBuffer* buffer = (DequeBuffer*)malloc(sizeof(DequeBuffer) + (size_t)capacity * sizeof(DequeSlot));
+    if (!buffer) return NULL;
+    buffer->capacity = capacity;
+    buffer->retired = NULL;
+    return buffer;
+}
+
+static int deque_init(WorkDeque* deque) {
+    memset(deque, 0, sizeof(*deque));
+    DequeBuffer* buffer = deque_buffer_create(DEQUE_INITIAL_CAPACITY);
+    if (!buffer) return 0;
+    deque->buffer = buffer;
+    return 1;
+}
+
+static void deque_free(WorkDeque* deque) {
+    DequeBuffer* buffer = (DequeBuffer*)deque->buffer;
+    while (buffer) {
+        DequeBuffer* retired = buffer->retired;
+        free(buffer);
+        buffer = retired;
+    }
+    deque->buffer = NULL;
+}
+
+// Owner only. Returns 0 if the deque had to grow and allocation failed.
+static int deque_push(WorkDeque* deque, PoolTask* task) {
+    long long bottom = load_i64(&deque->bottom);
+    long long top = load_i64(&deque->top);
+    DequeBuffer* buffer = (DequeBuffer*)load_ptr(&deque->buffer);
+
+    if (bottom - top >= buffer->capacity) {
+        DequeBuffer* grown = deque_buffer_create(buffer->capacity * 2);
+        if (!grown) return 0;
+        for (long long i = top; i < bottom; i++) {
+            grown->slots[i & (grown->capacity - 1)] = buffer->slots[i & (buffer->capacity - 1)];
+        }
+        // Thieves may still be reading the old buffer, so keep it alive
+        grown->retired = buffer;
+        store_ptr(&deque->buffer, grown);
+        buffer = grown;
+    }
+
+    DequeSlot* slot = &buffer->slots[bottom & (buffer->capacity - 1)];
+    store_ptr(&slot->counter, task->counter);
+    store_ptr(&slot->task, task);
+    store_i64(&deque->bottom, bottom + 1);
+    return 1;
+}
+
+// Owner only. With a counter, pops only a task spawned under it.
+static PoolTask* deque_pop(WorkDeque* deque, TaskCounter* counter) {
+    long long bottom = load_i64(&deque->bottom) - 1;
+    DequeBuffer* buffer = (DequeBuffer*)load_ptr(&deque->buffer);
+    if (counter) {
+        // Thieves never write slots, so the owner can look before popping
+        if (bottom < load_i64(&deque->top)) return NULL;
+        if (load_ptr(&buffer->slots[bottom & (buffer->capacity - 1)].counter) != counter) return NULL;
+    }
+    store_i64(&deque->bottom, bottom);
+    full_fence();
+    long long top = load_i64(&deque->top);
+
+    if (top > bottom) {
+        store_i64(&deque->bottom, bottom + 1);
+        return NULL;
+    }
+
+    PoolTask* task = (PoolTask*)load_ptr(&buffer->slots[bottom & (buffer->capacity - 1)].task);
+    if (top == bottom) {
+        // Last item: race any thief for it
+        if (!cas_i64(&deque->top, top, top + 1)) {
+            task = NULL;
+        }
+        store_i64(&deque->bottom, bottom + 1);
+    }
+    return task;
+}
+
+// Any thread. With a counter, steals only a task spawned under it. The slot
+// at top is not rewritten while top stays put, so what is read before the
+// CAS is what the CAS takes.
+static PoolTask* deque_steal(WorkDeque* deque, TaskCounter* counter) {
+    long long top = load_i64(&deque->top);
+    full_fence();
+    long long bottom = load_i64(&deque->bottom);
+    if (top >= bottom) return NULL;
+
+    DequeBuffer* buffer = (DequeBuffer*)load_ptr(&deque->buffer);
+    DequeSlot* slot = &buffer->slots[top & (buffer->capacity - 1)];
+    if (counter && load_ptr(&slot->counter) != counter) return NULL;
+    PoolTask* task = (PoolTask*)load_ptr(&slot->task);
+    if (!cas_i64(&deque->top, top, top + 1)) {
+        return NULL;
+    }
+    return task;
+}
+
+static void inject_task(ThreadPool* pool, PoolTask* task) {
+    task->next = NULL;
+    mutex_lock(&pool->lock);
+    if (pool->inject_tail) {
+        pool->inject_tail->next = task;
+    } else {
+        store_ptr((void* volatile*)&pool->inject_head, task);
+    }
+    pool->inject_tail = task;
+    mutex_unlock(&pool->lock);
+}
+
+// With a counter, takes the oldest task spawned under it
+static PoolTask* take_injected(ThreadPool* pool, TaskCounter* counter) {
+    if (!load_ptr((void* volatile*)&pool->inject_head)) return NULL;
+
+    mutex_lock(&pool->lock);
+    PoolTask* previous = NULL;
+    PoolTask* task = pool->inject_head;
+    while (task && counter && task->counter != counter) {
+        previous = task;
+        task = task->next;
+    }
+    if (task) {
+        if (previous) {
+            previous->next = task->next;
+        } else {
+            store_ptr((void* volatile*)&pool->inject_head, task->next);
+        }
+        if (pool->inject_tail == task) pool->inject_tail = previous;
+    }
+    mutex_unlock(&pool->lock);
+    return task;
+}
+
+// Any task when counter is NULL, else only one spawned under counter
+static PoolTask* find_task(ThreadPool* pool, PoolWorker* self, TaskCounter* counter) {
+    PoolTask* task = NULL;
+
+    if (self) {
+        task = deque_pop(&self->deque, counter);
+    }
+    if (!task) {
+        task = take_injected(pool, counter);
+    }
+    if (!task) {
+        // Start at a random victim so thieves spread out
+        unsigned int seed = self ? self->seed : (unsigned int)(size_t)&task;
+        seed = seed * 1103515245u + 12345u;
+        if (self) self->seed = seed;
+
+        int start = (int)((seed >> 16) % (unsigned int)pool->deque_count);
+        for (int i = 0; i < pool->deque_count && !task; i++) {
+            PoolWorker* victim = &pool->workers[(start + i) % pool->deque_count];
+            if (victim != self) {
+                task = deque_steal(&victim->deque, counter);
+            }
+        }
+    }
+
+    if (task) {
+        add_long(&pool->queued, -1);
+    }
+    return task;
+}
+
+static void run_task(ThreadPool* pool, PoolTask* task) {
+    ThreadPoolTask fn = task->fn;
+    void* arg = task->arg;
+    TaskCounter* counter = task->counter;
+    free(task);
+
+    fn(arg);
+
+    // The counter may live on the waiter's stack, so it is not touched again
+    // once it reaches zero
+    if (counter && add_long(&counter->pending, -1) == 0 && load_long(&pool->waiting) > 0) {
+        mutex_lock(&pool->lock);
+        cond_broadcast(&pool->done);
+        mutex_unlock(&pool->lock);
+    }
+}
+
+#ifdef _WIN32
+static unsigned __stdcall worker_main(void* arg)
+#else
+static void* worker_main(void* arg)
+#endif
+{
+    PoolWorker* self = (PoolWorker*)arg;
+    ThreadPool* pool = self->pool;
+    current_worker = self;
+
+    for (;;) {
+        PoolTask* task = find_task(pool, self, NULL);
+        if (task) {
+            run_task(pool, task);
+            continue;
+        }
+
+        mutex_lock(&pool->lock);
+        add_long(&pool->sleeping, 1);
+        while (load_long(&pool->queued) <= 0 && !load_long(&pool->shutdown)) {
+            cond_wait(&pool->wake, &pool->lock);
+        }
+        add_long(&pool->sleeping, -1);
+        int stop = load_long(&pool->shutdown) && load_long(&pool->queued) <= 0;
+        mutex_unlock(&pool->lock);
+
+        if (stop) break;
+    }
+
+    current_worker = NULL;
+    return 0;
+}
+
+static int clamp_worker_count(long count) {
+    if (count < 1) return 1;
+    if (count > THREAD_POOL_MAX_WORKERS) return THREAD_POOL_MAX_WORKERS;
+    return (int)count;
+}
+
+EXPORT int thread_pool_default_worker_count(void) {
+    long configured = load_long(&configured_worker_count);
+    if (configured > 0) {
+        return clamp_worker_count(configured);
+    }
+
+    const char* env = getenv(THREAD_POOL_ENV_VAR);
+    if (env && *env) {
+        long value = strtol(env, NULL, 10);
+        if (value > 0) return clamp_worker_count(value);
+    }
+
+#ifdef _WIN32
+    SYSTEM_INFO info;
+    GetSystemInfo(&info);
+    return clamp_worker_count((long)info.dwNumberOfProcessors);
+#else
+    return clamp_worker_count(sysconf(_SC_NPROCESSORS_ONLN));
+#endif
+}
+
+EXPORT void thread_pool_set_default_worker_count(int worker_count) {
+    store_long(&configured_worker_count, worker_count > 0 ? worker_count : 0);
+}
+
+EXPORT ThreadPool* thread_pool_create(int worker_count) {
+    if (worker_count <= 0) {
+        worker_count = thread_pool_default_worker_count();
+    }
+    worker_count = clamp_worker_count(worker_count);
+
+    ThreadPool* pool = (ThreadPool*)calloc(1, sizeof(ThreadPool));
+    if (!pool) {
+        fprintf(stderr, "Memory allocation failed for ThreadPool\n");
+        return NULL;
+    }
+
+    pool->workers = (PoolWorker*)calloc((size_t)worker_count, sizeof(PoolWorker));
+    if (!pool->workers) {
+        fprintf(stderr, "Memory allocation failed for thread pool workers\n");
+        free(pool);
+        return NULL;
+    }
+    pool->worker_count = worker_count;
+    mutex_init(&pool->lock);
+    cond_init(&pool->wake);
+    cond_init(&pool->done);
+
+    for (int i = 0; i < worker_count; i++) {
+        PoolWorker* worker = &pool->workers[i];
+        worker->pool = pool;
+        worker->index = i;
+        worker->seed = 2166136261u ^ (unsigned int)i;
+        if (!deque_init(&worker->deque)) {
+            fprintf(stderr, "Memory allocation failed for worker deque\n");
+            thread_pool_destroy(pool);
+            return NULL;
+        }
+        pool->deque_count++;
+    }
+
+    // Deques must all exist before any worker starts stealing
+    for (int i = 0; i < worker_count; i++) {
+        PoolWorker* worker = &pool->workers[i];
+#ifdef _WIN32
+        worker->thread = (HANDLE)_beginthreadex(NULL, WORKER_STACK_SIZE, worker_main, worker, 0, NULL);
+        int failed = worker->thread == 0;
+#else
+        pthread_attr_t attr;
+        pthread_attr_init(&attr);
+        pthread_attr_setstacksize(&attr, WORKER_STACK_SIZE);
+        int failed = pthread_create(&worker->thread, &attr, worker_main, worker) != 0;
+        pthread_attr_destroy(&attr);
+#endif
+        if (failed) {
+            fprintf(stderr, "Failed to start thread pool worker %d\n", i);
+            break;
+        }
+        pool->started_count++;
+    }
+
+    if (pool->started_count == 0) {
+        thread_pool_destroy(pool);
+        return NULL;
+    }
+    pool->worker_count = pool->started_count;
+    return pool;
+}
+
+EXPORT void thread_pool_destroy(ThreadPool* pool) {
+    if (!pool) return;
+
+    mutex_lock(&pool->lock);
+    add_long(&pool->shutdown, 1);
+    cond_broadcast(&pool->wake);
+    mutex_unlock(&pool->lock);
+
+    for (int i = 0; i < pool->started_count; i++) {
+#ifdef _WIN32
+        WaitForSingleObject(pool->workers[i].thread, INFINITE);
+        CloseHandle(pool->workers[i].thread);
+#else
+        pthread_join(pool->workers[i].thread, NULL);
+#endif
+    }
+
+    if (pool->workers) {
+        for (int i = 0; i < pool->deque_count; i++) {
+            deque_free(&pool->workers[i].deque);
+        }
+        free(pool->workers);
+    }
+
+    while (pool->inject_head) {
+        PoolTask* next = pool->inject_head->next;
+        free(pool->inject_head);
+        pool->inject_head = next;
+    }
+
+    cond_destroy(&pool->done);
+    cond_destroy(&pool->wake);
+    mutex_destroy(&pool->lock);
+    free(pool);
+}
+
+EXPORT int thread_pool_worker_count(const ThreadPool* pool) {
+    return pool ? pool->worker_count : 0;
+}
+
+EXPORT ThreadPool* thread_pool_shared(void) {
+    mutex_lock(&shared_pool_lock);
+    if (!shared_pool) {
+        shared_pool = thread_pool_create(0);
+    }
+    ThreadPool* pool = shared_pool;
+    mutex_unlock(&shared_pool_lock);
+    return pool;
+}
+
+EXPORT int thread_pool_spawn(ThreadPool* pool, TaskCounter* counter, ThreadPoolTask task, void* arg) {
+    if (!task) return 1;
+
+    PoolTask* pool_task = pool ? (PoolTask*)malloc(sizeof(PoolTask)) : NULL;
+    if (!pool_task) {
+        task(arg);
+        return 1;
+    }
+    pool_task->fn = task;
+    pool_task->arg = arg;
+    pool_task->counter = counter;
+    pool_task->next = NULL;
+
+    if (counter) {
+        add_long(&counter->pending, 1);
+    }
+
+    // Count the task before publishing it so a worker that takes it
+    // immediately never drives the counter negative
+    add_long(&pool->queued, 1);
+
+    PoolWorker* self = current_worker;
+    if (!self || self->pool != pool || !deque_push(&self->deque, pool_task)) {
+        inject_task(pool, pool_task);
+    }
+
+    if (load_long(&pool->sleeping) > 0) {
+        mutex_lock(&pool->lock);
+        cond_signal(&pool->wake);
+        mutex_unlock(&pool->lock);
+    }
+    return 0;
+}
+
+EXPORT void thread_pool_wait(ThreadPool* pool, TaskCounter* counter) {
+    if (!counter) return;
+
+    PoolWorker* self = current_worker;
+    if (self && self->pool != pool) self = NULL;
+
+    while (pool && load_long(&counter->pending) > 0) {
+        PoolTask* task = find_task(pool, self, counter);
+        if (task) {
+            run_task(pool, task);
+            continue;
+        }
+
+        // Whatever is left is running on other threads. run_task checks
+        // waiting after its decrement and this checks pending after the
+        // increment, so one of the two always sees the other.
+        mutex_lock(&pool->lock);
+        add_long(&pool->waiting, 1);
+        while (load_long(&counter->pending) > 0) {
+            cond_wait(&pool->done, &pool->lock);
+        }
+        add_long(&pool->waiting, -1);
+        mutex_unlock(&pool->lock);
+    }
+}
+
+EXPORT void cancel_token_init(CancelToken* token) {
+    if (token) store_long(&token->cancelled, 0);
+}
+
+EXPORT void cancel_token_cancel(CancelToken* token) {
+    if (token) store_long(&token->cancelled, 1);
+}
+
+EXPORT int cancel_token_is_cancelled(const CancelToken* token) {
+    return token ? load_long((volatile long*)&token->cancelled) != 0 : 0;
+}
+
+typedef struct {
+    ThreadPoolRangeTask fn;
+    void* context;
+    size_t begin;
+    size_t end;
+} RangeChunk;
+
+static void run_range_chunk(void* arg) {
+    RangeChunk* chunk = (RangeChunk*)arg;
+    chunk->fn(chunk->context, chunk->begin, chunk->end);
+}
+
+EXPORT void thread_pool_parallel_for(ThreadPool* pool, size_t count, size_t grain,
+                                     ThreadPoolRangeTask task, void* context) {
+    if (!task || count == 0) return;
+
+    if (grain == 0) {
+        // About four chunks per worker balances stealing against overhead
+        size_t workers = pool ? (size_t)pool->worker_count : 1;
+        grain = count / (workers * 4);
+        if (grain == 0) grain = 1;
+    }
+
+    size_t chunk_count = (count + grain - 1) / grain;
+    RangeChunk* chunks = (pool && chunk_count > 1) ?
+                         (RangeChunk*)malloc(chunk_count * sizeof(RangeChunk)) : NULL;
+    if (!chunks) {
+        task(context, 0, count);
+        return;
+    }
+
+    TaskCounter counter = {0};
+    for (size_t i = 0; i < chunk_count; i++) {
+        chunks[i].fn = task;
+        chunks[i].context = context;
+        chunks[i].begin = i * grain;
+        chunks[i].end = (i + 1) * grain < count ? (i + 1) * grain : count;
+        thread_pool_spawn(pool, &counter, run_range_chunk, &chunks[i]);
+    }
+    thread_pool_wait(pool, &counter);
+    free(chunks);
+}
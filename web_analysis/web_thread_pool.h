@@ -0,0 +1,76 @@
+#ifndef WEB_THREAD_POOL_H
+#define WEB_THREAD_POOL_H
+
+#include <stddef.h>
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Environment variable that overrides the default worker count
+#define THREAD_POOL_ENV_VAR "WEB_ANALYSIS_THREADS"
+#define THREAD_POOL_MAX_WORKERS 256
+
+typedef struct ThreadPool ThreadPool;
+
+typedef void (*ThreadPoolTask)(void* arg);
+
+// Called with a half-open index range [begin, end) by thread_pool_parallel_for
+typedef void (*ThreadPoolRangeTask)(void* context, size_t begin, size_t end);
+
+// Tracks a group of spawned tasks. Zero-initialize before the first spawn and
+// pass it to thread_pool_wait to join the whole group.
+typedef struct {
+    volatile long pending;
+} TaskCounter;
+
+// Cooperative cancellation flag shared between a caller and running work.
+// Zero-initialize (or cancel_token_init) before use.
+typedef struct {
+    volatile long cancelled;
+} CancelToken;
+
+EXPORT void cancel_token_init(CancelToken* token);
+EXPORT void cancel_token_cancel(CancelToken* token);
+EXPORT int cancel_token_is_cancelled(const CancelToken* token);
+
+// Creates a pool with the given number of workers. Zero or a negative count
+// uses thread_pool_default_worker_count(). Returns NULL on failure.
+EXPORT ThreadPool* thread_pool_create(int worker_count);
+
+// Runs any queued tasks to completion, then stops and frees the workers.
+EXPORT void thread_pool_destroy(ThreadPool* pool);
+
+EXPORT int thread_pool_worker_count(const ThreadPool* pool);
+
+// Worker count used when none is given: the value set through
+// thread_pool_set_default_worker_count, else WEB_ANALYSIS_THREADS, else the
+// number of online processors.
+EXPORT int thread_pool_default_worker_count(void);
+EXPORT void thread_pool_set_default_worker_count(int worker_count);
+
+// Process-wide pool created on first use with the default worker count.
+EXPORT ThreadPool* thread_pool_shared(void);
+
+// Queues task(arg) and adds it to counter. Spawning from inside a task pushes
+// onto the calling worker's own deque; idle workers steal from there. If the
+// pool is NULL or the task cannot be queued it runs inline. Returns 0 when
+// queued, 1 when it ran inline.
+EXPORT int thread_pool_spawn(ThreadPool* pool, TaskCounter* counter, ThreadPoolTask task, void* arg);
+
+// Blocks until every task in counter has finished. The waiting thread runs
+// queued tasks of that counter meanwhile, never anyone else's, so waiting
+// from inside a task cannot deadlock and a waiter is never held up by
+// unrelated work. Once the rest are all running elsewhere it sleeps until
+// the last one finishes. Tasks spawned inside a task should be waited for
+// before it returns.
+EXPORT void thread_pool_wait(ThreadPool* pool, TaskCounter* counter);
+
+// Splits [0, count) into chunks of at most grain indices (0 picks a grain
+// from the worker count), runs them across the pool and waits for all.
+EXPORT void thread_pool_parallel_for(ThreadPool* pool, size_t count, size_t grain,
+                                     ThreadPoolRangeTask task, void* context);
+
+#endif // WEB_THREAD_POOL_H
@@ -0,0 +1,271 @@
+#include "web_trace.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#include <windows.h>
+typedef SRWLOCK trace_mutex_t;
+#define TRACE_MUTEX_INIT SRWLOCK_INIT
+#define mutex_lock(m) AcquireSRWLockExclusive(m)
+#define mutex_unlock(m) ReleaseSRWLockExclusive(m)
+#define thread_yield() SwitchToThread()
+#define trace_pid() ((int)GetCurrentProcessId())
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+typedef pthread_mutex_t trace_mutex_t;
+#define TRACE_MUTEX_INIT PTHREAD_MUTEX_INITIALIZER
+#define mutex_lock(m) pthread_mutex_lock(m)
+#define mutex_unlock(m) pthread_mutex_unlock(m)
+#define thread_yield() sched_yield()
+#define trace_pid() ((int)getpid())
+#endif
+
+#ifdef _MSC_VER
+#define THREAD_LOCAL __declspec(thread)
+static __forceinline long load_long(volatile long* p) { return InterlockedCompareExchange(p, 0, 0); }
+static __forceinline long add_long(volatile long* p, long v) { return InterlockedExchangeAdd(p, v) + v; }
+static __forceinline int cas_long(volatile long* p, long expected, long desired) {
+    return InterlockedCompareExchange(p, desired, expected) == expected;
+}
+static __forceinline void store_int(volatile int* p, int v) { InterlockedExchange((volatile long*)p, v); }
+#else
+#define THREAD_LOCAL __thread
+static inline long load_long(volatile long* p) { return __atomic_load_n(p, __ATOMIC_SEQ_CST); }
+static inline long add_long(volatile long* p, long v) { return __atomic_add_fetch(p, v, __ATOMIC_SEQ_CST); }
+static inline int cas_long(volatile long* p, long expected, long desired) {
+    return __atomic_compare_exchange_n(p, &expected, desired, 0, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+}
+static inline void store_int(volatile int* p, int v) { __atomic_store_n(p, v, __ATOMIC_SEQ_CST); }
+#endif
+
+#define TRACE_CHUNK_EVENTS 4096
+#define TRACE_PATH_SIZE 1024
+
+typedef struct {
+    const char* name;
+    const char* category;
+    long long start_ns;
+    long long duration_ns;
+    long long bytes;
+    char detail[TRACE_DETAIL_SIZE];
+} TraceEvent;
+
+typedef struct TraceChunk {
+    struct TraceChunk* next;
+    int count;
+    TraceEvent events[TRACE_CHUNK_EVENTS];
+} TraceChunk;
+
+// One per thread per trace. Only its owner appends; trace_stop reads it once
+// every writer has left (see writers below).
+typedef struct ThreadTrace {
+    struct ThreadTrace* next;
+    int tid;
+    TraceChunk* head;
+    TraceChunk* tail;
+} ThreadTrace;
+
+volatile int trace_active;
+
+static trace_mutex_t trace_lock = TRACE_MUTEX_INIT;   // Guards the fields below
+static ThreadTrace* threads;
+static int next_tid;
+static long generation;
+static long long origin_ns;
+static char output_path[TRACE_PATH_SIZE];
+
+// Threads inside trace_record; trace_stop waits for it to drain
+static volatile long writers;
+static volatile long env_checked;
+
+static THREAD_LOCAL ThreadTrace* local_trace;
+static THREAD_LOCAL long local_generation;
+
+long long trace_now_ns(void) {
+#ifdef _WIN32
+    static LARGE_INTEGER freq;
+    LARGE_INTEGER counter;
+    if (freq.QuadPart == 0) QueryPerformanceFrequency(&freq);
+    QueryPerformanceCounter(&counter);
+    return (long long)((double)counter.QuadPart * 1.0e9 / (double)freq.QuadPart);
+#else
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (long long)ts.tv_sec * 1000000000LL + ts.tv_nsec;
+#endif
+}
+
+int trace_start(const char* path) {
+    if (!path || !*path) return -1;
+
+    mutex_lock(&trace_lock);
+    if (trace_active) {
+        mutex_unlock(&trace_lock);
+        return -1;
+    }
+    strncpy(output_path, path, sizeof(output_path) - 1);
+    output_path[sizeof(output_path) - 1] = '\0';
+    threads = NULL;
+    next_tid = 1;
+    generation++;
+    origin_ns = trace_now_ns();
+    store_int(&trace_active, 1);
+    mutex_unlock(&trace_lock);
+    return 0;
+}
+
+static ThreadTrace* register_thread(void) {
+    ThreadTrace* trace = calloc(1, sizeof(ThreadTrace));
+    if (!trace) return NULL;
+
+    mutex_lock(&trace_lock);
+    trace->tid = next_tid++;
+    trace->next = threads;
+    threads = trace;
+    local_generation = generation;
+    mutex_unlock(&trace_lock);
+
+    local_trace = trace;
+    return trace;
+}
+
+void trace_record(const char* name, const char* category, long long start_ns,
+                  const char* detail, long long bytes) {
+    long long end_ns = trace_now_ns();
+
+    add_long(&writers, 1);
+    if (!trace_active) {
+        add_long(&writers, -1);
+        return;
+    }
+
+    // A buffer from an earlier trace was freed by its trace_stop
+    ThreadTrace* trace = (local_trace && local_generation == generation) ? local_trace : register_thread();
+    if (trace) {
+        TraceChunk* chunk = trace->tail;
+        if (!chunk || chunk->count == TRACE_CHUNK_EVENTS) {
+            chunk = malloc(sizeof(TraceChunk));
+            if (chunk) {
+                chunk->next = NULL;
+                chunk->count = 0;
+                if (trace->tail) trace->tail->next = chunk;
+                else trace->head = chunk;
+                trace->tail = chunk;
+            }
+        }
+        if (chunk) {
+            TraceEvent* event = &chunk->events[chunk->count++];
+            event->name = name;
+            event->category = category;
+            event->start_ns = start_ns;
+            event->duration_ns = end_ns - start_ns;
+            event->bytes = bytes;
+            event->detail[0] = '\0';
+            if (detail) {
+                size_t length = strlen(detail);
+                if (length >= sizeof(event->detail)) detail += length - (sizeof(event->detail) - 1);
+                strncpy(event->detail, detail, sizeof(event->detail) - 1);
+                event->detail[sizeof(event->detail) - 1] = '\0';
+            }
+        }
+    }
+    add_long(&writers, -1);
+}
+
+static void write_json_string(FILE* f, const char* s) {
+    fputc('"', f);
+    for (; *s; s++) {
+        unsigned char c = (unsigned char)*s;
+        if (c == '"' || c == '\\') {
+            fputc('\\', f);
+            fputc(c, f);
+        } else if (c < 0x20) {
+            fprintf(f, "\\u%04x", c);
+        } else {
+            fputc(c, f);
+        }
+    }
+    fputc('"', f);
+}
+
+int trace_stop(void) {
+    mutex_lock(&trace_lock);
+    if (!trace_active) {
+        mutex_unlock(&trace_lock);
+        return -1;
+    }
+    // Sequentially consistent so the writers check below cannot pass it
+    store_int(&trace_active, 0);
+    ThreadTrace* list = threads;
+    threads = NULL;
+    mutex_unlock(&trace_lock);
+
+    // Let spans already past the active check finish appending
+    while (load_long(&writers) != 0) thread_yield();
+
+    FILE* f = fopen(output_path, "w");
+    if (!f) fprintf(stderr, "Failed to write trace file: %s\n", output_path);
+
+    int written = 0;
+    int pid = trace_pid();
+    if (f) fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+
+    while (list) {
+        ThreadTrace* trace = list;
+        list = list->next;
+
+        if (f) {
+            fprintf(f, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                       "\"args\":{\"name\":\"thread %d\"}}",
+                    written ? ",\n" : "", pid, trace->tid, trace->tid);
+            written++;
+        }
+
+        TraceChunk* chunk = trace->head;
+        while (chunk) {
+            for (int i = 0; f && i < chunk->count; i++) {
+                const TraceEvent* e = &chunk->events[i];
+                fprintf(f, ",\n{\"name\":");
+                write_json_string(f, e->name);
+                fprintf(f, ",\"cat\":");
+                write_json_string(f, e->category);
+                fprintf(f, ",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f,\"args\":{",
+                        pid, trace->tid, (e->start_ns - origin_ns) / 1000.0, e->duration_ns / 1000.0);
+                fprintf(f, "\"bytes\":%lld", e->bytes);
+                if (e->detail[0]) {
+                    fprintf(f, ",\"path\":");
+                    write_json_string(f, e->detail);
+                }
+                fprintf(f, "}}");
+                written++;
+            }
+            TraceChunk* next = chunk->next;
+            free(chunk);
+            chunk = next;
+        }
+        free(trace);
+    }
+
+    if (!f) return -1;
+    fprintf(f, "\n]}\n");
+    int failed = ferror(f);
+    fclose(f);
+    return failed ? -1 : written;
+}
+
+static void stop_at_exit(void) {
+    trace_stop();
+}
+
+void trace_start_from_env(void) {
+    if (load_long(&env_checked) || !cas_long(&env_checked, 0, 1)) return;
+
+    const char* path = getenv(TRACE_ENV_VAR);
+    if (path && *path && trace_start(path) == 0) {
+        atexit(stop_at_exit);
+    }
+}
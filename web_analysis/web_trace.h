@@ -0,0 +1,52 @@
+#ifndef WEB_TRACE_H
+#define WEB_TRACE_H
+
+#include <stddef.h>
+
+#ifdef _WIN32
+#define EXPORT __declspec(dllexport)
+#else
+#define EXPORT __attribute__((visibility("default")))
+#endif
+
+// Timeline capture in the Chrome trace-event format, readable by
+// chrome://tracing and ui.perfetto.dev. While a trace is active, spans are
+// appended to per-thread buffers without locking; trace_stop writes them all
+// as complete ("X") events, one track per thread.
+//
+// Setting TRACE_ENV_VAR to a file path starts a trace on the first analysis
+// and writes it at process exit.
+#define TRACE_ENV_VAR "WEB_ANALYSIS_TRACE"
+
+// Longest path or label kept per span; longer ones keep their tail
+#define TRACE_DETAIL_SIZE 160
+
+// Checked inline by TRACE_SPAN_START so an inactive trace costs one load
+extern EXPORT volatile int trace_active;
+
+// Begins capturing spans, to be written to path by trace_stop. Returns 0, or
+// -1 if a trace is already active or path is empty.
+EXPORT int trace_start(const char* path);
+
+// Stops capturing and writes the file. Returns the number of events written,
+// or -1 if no trace was active or the file could not be written.
+EXPORT int trace_stop(void);
+
+// Starts a trace from TRACE_ENV_VAR the first time it is called
+EXPORT void trace_start_from_env(void);
+
+EXPORT long long trace_now_ns(void);
+
+// Records a span from start_ns to now on the calling thread. category groups
+// spans in the viewer; detail (a path, usually) and bytes go into args.
+// name and category must be string literals or otherwise outlive the trace.
+EXPORT void trace_record(const char* name, const char* category, long long start_ns,
+                         const char* detail, long long bytes);
+
+#define TRACE_SPAN_START(mark) long long mark = trace_active ? trace_now_ns() : 0
+
+#define TRACE_SPAN_END(mark, name, category, detail, bytes) do { \
+    if (mark) trace_record(name, category, mark, detail, bytes); \
+} while (0)
+
+#endif // WEB_TRACE_H